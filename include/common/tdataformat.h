@@ -158,7 +158,8 @@ int32_t parseJsontoTagData(const char *json, SArray *pTagVals, STag **ppTag, voi
 
 // SColData ================================
 typedef struct {
-  uint32_t cmprAlg;  // filled by caller
+  uint32_t cmprAlg;    // filled by caller
+  bool     allowDict;  // filled by caller, var data may be dictionary encoded
   int8_t   columnFlag;
   int8_t   flag;
   int8_t   dataType;
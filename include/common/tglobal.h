@@ -62,6 +62,8 @@ extern char tsEncryptKey[];
 extern int32_t tsMaxShellConns;
 extern int32_t tsShellActivityTimer;
 extern int32_t tsCompressMsgSize;
+extern int32_t tsCompressMsgAlg;
+extern int32_t tsCompressMsgLevel;
 extern int64_t tsTickPerMin[3];
 extern int64_t tsTickPerHour[3];
 extern int32_t tsCountAlwaysReturnValue;
@@ -158,6 +160,10 @@ extern char    *tsSvrCrashReportUri;
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;    // maximum allowed usage buffer size in byte for each data node
 extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row loading cache as much as possible
+extern int32_t tsSmaCacheSize;            // size of the block statistics cache of each vnode in MB
+extern int32_t tsQueryFetchCredits;       // result blocks a task may produce ahead of the fetch of its consumer
+extern int32_t tsQueryHashJoinMemLimit;   // size in MB of the build side a hash join keeps in memory before spilling
+extern int64_t tsQueryHashJoinMemLimitBytes;  // the same in bytes, never above tsQueryBufferSizeBytes
 
 // query client
 extern int32_t tsQueryPolicy;
@@ -192,6 +198,8 @@ extern bool    tsMultiResultFunctionStarReturnTags;
 extern int32_t tsMinSlidingTime;
 extern int32_t tsMinIntervalTime;
 extern int32_t tsMaxInsertBatchRows;
+extern int32_t tsNumOfCsvParseThreads;
+extern int32_t tsQueryPlanCacheSize;
 
 // build info
 extern char version[];
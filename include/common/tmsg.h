@@ -641,6 +641,7 @@ void tFreeSSubmitRsp(SSubmitRsp* pRsp);
 #define COL_SMA_ON     ((int8_t)0x1)
 #define COL_IDX_ON     ((int8_t)0x2)
 #define COL_IS_KEY     ((int8_t)0x4)
+#define COL_DICT_ENC   ((int8_t)0x8)  // storage only, var data of the column block is dictionary encoded
 #define COL_SET_NULL   ((int8_t)0x10)
 #define COL_SET_VAL    ((int8_t)0x20)
 #define COL_IS_SYSINFO ((int8_t)0x40)
@@ -2275,12 +2276,26 @@ typedef struct {
   char    data[];
 } SRetrieveMetaTableRsp;
 
+typedef struct SExplainProfInfo {
+  uint64_t inputRows;
+  uint64_t inputBlocks;
+  uint64_t loadBlocks;     // data blocks loaded from file
+  uint64_t skipBlocks;     // data blocks skipped by sma, block range or top-k bound
+  uint64_t loadBytes;      // bytes of column data loaded and decoded
+  double   loadTime;       // ms, including io wait and decompression
+  double   filterTime;     // ms
+  double   aggTime;        // ms
+  uint64_t hashProbes;
+  uint64_t hashMatchRows;  // build rows matched by all probes
+} SExplainProfInfo;
+
 typedef struct SExplainExecInfo {
-  double   startupCost;
-  double   totalCost;
-  uint64_t numOfRows;
-  uint32_t verboseLen;
-  void*    verboseInfo;
+  double           startupCost;
+  double           totalCost;
+  uint64_t         numOfRows;
+  uint32_t         verboseLen;
+  void*            verboseInfo;
+  SExplainProfInfo prof;
 } SExplainExecInfo;
 
 typedef struct {
@@ -2758,6 +2773,8 @@ void    tFreeSSchedulerHbReq(SSchedulerHbReq* pReq);
 typedef struct {
   SQueryNodeEpId epId;
   SArray*        taskStatus;  // SArray<STaskStatus>
+  int32_t        queryInQueue;  // query msgs waiting in the node's query queue
+  int64_t        queryWaitUs;   // recent average wait time of query msgs in the queue
 } SSchedulerHbRsp;
 
 int32_t tSerializeSSchedulerHbRsp(void* buf, int32_t bufLen, SSchedulerHbRsp* pRsp);
@@ -116,6 +116,17 @@ void dsGetDataLength(DataSinkHandle handle, int64_t* pLen, int64_t* pRawLen, boo
  */
 int32_t dsGetDataBlock(DataSinkHandle handle, SOutputData* pOutput);
 
+/**
+ * Get data by reference, no copy is made. The block buffer is handed over to the caller.
+ * The buffer starts with room for a SRetrieveTableRsp head that ends right at the length info of the block, so the
+ * buffer itself can be used as a local fetch rsp without copying the block.
+ * @param handle
+ * @param pOutput output, pData points into *ppBuf and is preceded by PAYLOAD_PREFIX_LEN bytes of length info
+ * @param ppBuf output, NULL if no block is returned, otherwise should be released by taosMemoryFree
+ * @return error code, TSDB_CODE_OPS_NOT_SUPPORT if the sinker can not hand over its buffer
+ */
+int32_t dsGetDataBlockRef(DataSinkHandle handle, SOutputData* pOutput, void** ppBuf);
+
 int32_t dsGetCacheSize(DataSinkHandle handle, uint64_t* pSize);
 
 /**
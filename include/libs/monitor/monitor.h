@@ -50,6 +50,10 @@ typedef struct {
   char      name[TSDB_FILENAME_LEN];
   int8_t    level;
   SDiskSize size;
+  int64_t   allocNum;     // # of files placed on the disk
+  int64_t   hotAllocNum;  // # of hot files placed on the disk
+  int64_t   writeBytes;   // bytes synced to the disk
+  int64_t   writeCost;    // smoothed sync cost, us per MB
 } SMonDiskDesc;
 
 typedef struct {
@@ -123,6 +123,7 @@ int32_t qExtractResultSchema(const SNode* pRoot, int32_t* numOfCols, SSchema** p
 int32_t qSetSTableIdForRsma(SNode* pStmt, int64_t uid);
 int32_t qInitKeywordsTable();
 void    qCleanupKeywordsTable();
+void    qCleanupCsvParsePool();
 
 int32_t qAppendStmtTableOutput(SQuery* pQuery, SHashObj* pAllVgHash, STableColsData* pTbData, STableDataCxt* pTbCtx,
                                SStbInterlaceInfo* pBuildInfo);
@@ -32,6 +32,11 @@ typedef struct {
   int32_t id;
 } SDiskID;
 
+typedef enum {
+  TFS_FILE_WARM = 0,  // data, sma and compaction output
+  TFS_FILE_HOT,       // stt and head files rewritten by every commit
+} ETfsFileTemp;
+
 typedef struct {
   SDiskID did;
   char    aname[TSDB_FILENAME_LEN];  // TABS name
@@ -94,6 +99,28 @@ int32_t tfsGetLevel(STfs *pTfs);
  */
 int32_t tfsAllocDisk(STfs *pTfs, int32_t expLevel, SDiskID *pDiskId);
 
+/**
+ * @brief Allocate a disk for a file of the given temperature. Hot files are
+ * kept on the disks with the lowest observed write latency of the tier.
+ *
+ * @param pTfs The fs object.
+ * @param expLevel Disk level want to allocate.
+ * @param temp Temperature of the file to be placed.
+ * @param pDiskId The disk ID after allocation.
+ * @return int32_t 0 for success, -1 for failure.
+ */
+int32_t tfsAllocDiskByTemp(STfs *pTfs, int32_t expLevel, ETfsFileTemp temp, SDiskID *pDiskId);
+
+/**
+ * @brief Feed a finished write back to the placement policy.
+ *
+ * @param pTfs The fs object.
+ * @param path Absolute path of the file written.
+ * @param bytes Bytes written since the last record.
+ * @param costUs Time spent to sync the bytes, in microseconds.
+ */
+void tfsRecordWrite(STfs *pTfs, const char *path, int64_t bytes, int64_t costUs);
+
 /**
  * @brief Get the primary path.
  *
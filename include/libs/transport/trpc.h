@@ -29,6 +29,17 @@ extern "C" {
 #define TAOS_CONN_CLIENT 1
 #define IsReq(pMsg)      (pMsg->msgType & 1U)
 
+#define RPC_COMP_AUTO 0  // pick none/lz4/zstd per conn by observed ratio and link bandwidth
+#define RPC_COMP_LZ4  1
+#define RPC_COMP_ZSTD 2  // falls back to lz4 if the peer does not accept zstd
+
+typedef struct SRpcCompStat {
+  int64_t numOfMsg[3];  // by codec, none/lz4/zstd
+  int64_t rawBytes;
+  int64_t compBytes;  // bytes of the compressed msgs, no compressed ones included
+  int64_t compUs;
+} SRpcCompStat;
+
 extern int32_t tsRpcHeadSize;
 
 typedef struct {
@@ -69,12 +80,22 @@ typedef struct SRpcHandleInfo {
   int32_t      msgType;
 } SRpcHandleInfo;
 
+typedef void (*RpcIovFreeFp)(void *param);
+
+typedef struct SRpcIov {
+  void        *base;
+  int32_t      len;
+  void        *param;   // owner of base, released by freeFp once the msg is sent or dropped
+  RpcIovFreeFp freeFp;
+} SRpcIov;
+
 typedef struct SRpcMsg {
   tmsg_t         msgType;
   void          *pCont;
   int32_t        contLen;
   int32_t        code;
   SRpcHandleInfo info;
+  SArray        *pIov;  // SArray<SRpcIov>, rsp only, payload written after pCont by reference
 } SRpcMsg;
 
 typedef void (*RpcCfp)(void *parent, SRpcMsg *, SEpSet *epset);
@@ -102,8 +123,10 @@ typedef struct SRpcInit {
   int32_t failFastThreshold;
   int32_t failFastInterval;
 
-  int32_t compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
-  int8_t  encryption;    // encrypt or not
+  int32_t compressSize;   // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t  compressAlg;    // RPC_COMP_AUTO, RPC_COMP_LZ4, RPC_COMP_ZSTD
+  int8_t  compressLevel;  // zstd level
+  int8_t  encryption;     // encrypt or not
 
   // the following is for client app ecurity only
   char *user;  // user name
@@ -165,6 +188,11 @@ void *rpcMallocCont(int64_t contLen);
 void  rpcFreeCont(void *pCont);
 void *rpcReallocCont(void *ptr, int64_t contLen);
 
+// scatter-gather rsp payload, the buffers are handed over to rpc and released after being written out
+int32_t rpcMsgAppendIov(SRpcMsg *pMsg, void *base, int32_t len, void *param, RpcIovFreeFp freeFp);
+int32_t rpcMsgIovLen(const SArray *pIov);
+void    rpcFreeIov(SArray *pIov);
+
 // Because taosd supports multi-process mode
 // These functions should not be used on the server side
 // Please use tmsg<xx> functions, which are defined in tmsgcb.h
@@ -187,6 +215,9 @@ int32_t rpcSetIpWhite(void *thandl, void *arg);
 
 int32_t rpcUtilSIpRangeToStr(SIpV4Range *pRange, char *buf);
 
+// compression statistics of the msgs sent out, by msg type
+int32_t rpcGetCompStat(tmsg_t msgType, SRpcCompStat *pStat);
+
 int32_t rpcUtilSWhiteListToStr(SIpWhiteList *pWhiteList, char **ppBuf);
 int32_t rpcCvtErrCode(int32_t code);
 
@@ -95,6 +95,14 @@ int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
 int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count);
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
+
+typedef struct {
+  const void *buf;
+  int64_t     len;
+} SFileIov;
+
+// write the segments in order with as few system calls as possible
+int64_t taosWritevFile(TdFilePtr pFile, const SFileIov *iov, int32_t iovcnt);
 void    taosFprintfFile(TdFilePtr pFile, const char *format, ...);
 
 int64_t taosGetLineFile(TdFilePtr pFile, char **__restrict ptrBuf);
@@ -155,6 +155,8 @@ int32_t getWordLength(char type);
 int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type);
 int32_t tsDecompressFloatImpAvx2(const char *input, int32_t nelements, char *output);
 int32_t tsDecompressDoubleImpAvx2(const char *input, int32_t nelements, char *output);
+int32_t tsDecompressAlpImpAvx2(const uint64_t *input, int32_t nelements, int64_t base, double factor, double fraction,
+                               char *output, char type);
 int32_t tsDecompressTimestampAvx2(const char *input, int32_t nelements, char *output, bool bigEndian);
 int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
                                     bool bigEndian);
@@ -242,6 +244,7 @@ typedef enum {
   L1_XOR,
   L1_RLE,
   L1_DELTAD,
+  L1_ALP,
   L1_DISABLED = 0xFF,
 } TCmprL1Type;
 
@@ -381,6 +381,21 @@ int32_t parseSql(SRequestObj* pRequest, bool topicQuery, SQuery** pQuery, SStmtC
 
 int32_t getPlan(SRequestObj* pRequest, SQuery* pQuery, SQueryPlan** pPlan, SArray* pNodeList);
 
+#define PLAN_CACHE_KEY_LEN 16  // md5 digest
+
+typedef struct SPlanCacheKey {
+  bool    cacheable;
+  uint8_t digest[PLAN_CACHE_KEY_LEN];
+} SPlanCacheKey;
+
+int32_t planCacheInit();
+void    planCacheCleanup();
+int32_t createQueryPlanWithCache(SRequestObj* pRequest, SQuery* pQuery, SPlanContext* pCxt, SQueryPlan** ppPlan,
+                                 SArray* pMnodeList);
+int32_t planCacheGet(SRequestObj* pRequest, SQuery* pQuery, SPlanContext* pCxt, SPlanCacheKey* pKey,
+                     SQueryPlan** ppPlan, SArray* pMnodeList);
+void    planCachePut(SRequestObj* pRequest, const SPlanCacheKey* pKey, SQueryPlan* pPlan, SArray* pMnodeList);
+
 int32_t buildRequest(uint64_t connId, const char* sql, int sqlLen, void* param, bool validateSql,
                      SRequestObj** pRequest, int64_t reqid);
 
@@ -359,6 +359,8 @@ int32_t openTransporter(const char *user, const char *auth, int32_t numOfThread,
   rpcInit.user = (char *)user;
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
   rpcInit.dfp = destroyAhandle;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
@@ -989,6 +991,7 @@ void taos_init_imp(void) {
   ENV_ERR_RET(initTaskQueue(), "failed to init task queue");
   ENV_ERR_RET(fmFuncMgtInit(), "failed to init funcMgt");
   ENV_ERR_RET(nodesInitAllocatorSet(), "failed to init allocator set");
+  ENV_ERR_RET(planCacheInit(), "failed to init plan cache");
 
   clientConnRefPool = taosOpenRef(200, destroyTscObj);
   clientReqRefPool = taosOpenRef(40960, doDestroyRequest);
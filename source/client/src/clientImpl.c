@@ -509,7 +509,7 @@ int32_t getPlan(SRequestObj* pRequest, SQuery* pQuery, SQueryPlan** pPlan, SArra
                       .pUser = pRequest->pTscObj->user,
                       .sysInfo = pRequest->pTscObj->sysInfo};
 
-  return qCreateQueryPlan(&cxt, pPlan, pNodeList);
+  return createQueryPlanWithCache(pRequest, pQuery, &cxt, pPlan, pNodeList);
 }
 
 int32_t setResSchemaInfo(SReqResultInfo* pResInfo, const SSchema* pSchema, int32_t numOfCols) {
@@ -1363,7 +1363,7 @@ static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaDat
                         .sysInfo = pRequest->pTscObj->sysInfo,
                         .allocatorId = pRequest->allocatorRefId};
     if (TSDB_CODE_SUCCESS == code) {
-      code = qCreateQueryPlan(&cxt, &pDag, pMnodeList);
+      code = createQueryPlanWithCache(pRequest, pQuery, &cxt, &pDag, pMnodeList);
     }
     if (code) {
       tscError("0x%" PRIx64 " failed to create query plan, code:%s 0x%" PRIx64, pRequest->self, tstrerror(code),
@@ -2565,6 +2565,8 @@ TSDB_SERVER_STATUS taos_check_server_status(const char* fqdn, int port, char* de
   rpcInit.connType = TAOS_CONN_CLIENT;
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
   rpcInit.user = "_dnd";
 
   int32_t connLimitNum = tsNumOfRpcSessions / (tsNumOfRpcThreads * 3);
@@ -64,10 +64,12 @@ void taos_cleanup(void) {
   hbMgrCleanUp();
 
   catalogDestroy();
+  planCacheCleanup();
   schedulerDestroy();
 
   fmFuncMgtDestroy();
   qCleanupKeywordsTable();
+  qCleanupCsvParsePool();
 
   if (TSDB_CODE_SUCCESS != cleanupTaskQueue()) {
     tscWarn("failed to cleanup task queue");
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clientInt.h"
+#include "clientLog.h"
+#include "tglobal.h"
+#include "tlrucache.h"
+#include "tmd5.h"
+
+/*
+ * Physical plans are cached by the digest of everything the planner reads: the plan context including the mnode
+ * epset, the sql text and the analysed statement. The analysed statement carries the table metas (uid, sversion,
+ * tversion) and vgroup lists used by the query and every constant after folding, so a schema change, a vgroup move, an
+ * mnode leader change or a NOW() evaluated at another time gives another digest and the plan is built again. Plans are
+ * kept as subplan messages, a hit decodes a fresh plan for the request and the scheduler owns it as usual.
+ *
+ * Only a query sent again with the same text and the same folded constants hits. The constants are not parameterized:
+ * they end up in the time range and filters of the scan subplans and in the vgroups picked for them, so another literal
+ * is another plan. Every lookup serializes the statement, so the cache is off by default and meant for dashboards that
+ * repeat fixed queries.
+ */
+
+typedef struct SPlanCacheSubplan {
+  int32_t        level;
+  int32_t        msgLen;
+  char*          pMsg;
+  SQueryNodeStat execNodeStat;  // not part of the subplan message
+  int32_t        numOfChildren;
+  int32_t*       pChildren;  // index of the children subplans
+} SPlanCacheSubplan;
+
+typedef struct SPlanCacheEntry {
+  int32_t            numOfLevels;
+  int32_t            numOfSubplans;
+  SExplainInfo       explainInfo;
+  SArray*            pMnodeList;  // SArray<SQueryNodeLoad>
+  SPlanCacheSubplan* pSubplans;
+} SPlanCacheEntry;
+
+static SLRUCache* planCache = NULL;
+
+static void destroyPlanCacheEntry(SPlanCacheEntry* pEntry) {
+  if (NULL == pEntry) return;
+
+  for (int32_t i = 0; NULL != pEntry->pSubplans && i < pEntry->numOfSubplans; ++i) {
+    taosMemoryFree(pEntry->pSubplans[i].pMsg);
+    taosMemoryFree(pEntry->pSubplans[i].pChildren);
+  }
+  taosMemoryFree(pEntry->pSubplans);
+  taosArrayDestroy(pEntry->pMnodeList);
+  taosMemoryFree(pEntry);
+}
+
+static void freePlanCacheEntry(const void* key, size_t keyLen, void* value, void* ud) {
+  (void)key;
+  (void)keyLen;
+  (void)ud;
+  destroyPlanCacheEntry((SPlanCacheEntry*)value);
+}
+
+int32_t planCacheInit() {
+  if (tsQueryPlanCacheSize <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  planCache = taosLRUCacheInit((size_t)tsQueryPlanCacheSize * 1024 * 1024, -1, .5);
+  if (NULL == planCache) {
+    return terrno;
+  }
+  taosLRUCacheSetStrictCapacity(planCache, false);
+
+  tscInfo("query plan cache initialized, size:%dMB", tsQueryPlanCacheSize);
+  return TSDB_CODE_SUCCESS;
+}
+
+void planCacheCleanup() {
+  if (NULL == planCache) return;
+
+  taosLRUCacheEraseUnrefEntries(planCache);
+  taosLRUCacheCleanup(planCache);
+  planCache = NULL;
+}
+
+static bool isPlanCacheable(SQuery* pQuery) {
+  if (NULL == planCache || NULL == pQuery->pRoot || NULL != pQuery->pPrevRoot || NULL != pQuery->pPostRoot) {
+    return false;
+  }
+
+  ENodeType type = nodeType(pQuery->pRoot);
+  return QUERY_NODE_SELECT_STMT == type || QUERY_NODE_SET_OPERATOR == type;
+}
+
+static void updatePlanCacheKeyByEpSet(T_MD5_CTX* pMd5, const SEpSet* pEpSet) {
+  char    ep[TSDB_FQDN_LEN + 16] = {0};
+  int32_t epLen = snprintf(ep, sizeof(ep), "%d|%d", pEpSet->inUse, pEpSet->numOfEps);
+  tMD5Update(pMd5, (uint8_t*)ep, epLen + 1);
+  for (int32_t i = 0; i < pEpSet->numOfEps && i < TSDB_MAX_REPLICA; ++i) {
+    epLen = snprintf(ep, sizeof(ep), "%s:%u", pEpSet->eps[i].fqdn, pEpSet->eps[i].port);
+    tMD5Update(pMd5, (uint8_t*)ep, epLen + 1);
+  }
+}
+
+static int32_t buildPlanCacheKey(SRequestObj* pRequest, SQuery* pQuery, const SPlanContext* pCxt, uint8_t* pKey) {
+  char*   pAst = NULL;
+  int32_t astLen = 0;
+  int32_t code = nodesNodeToString(pQuery->pRoot, false, &pAst, &astLen);
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+
+  char    ctx[TSDB_USER_LEN + 64] = {0};
+  int32_t ctxLen = snprintf(ctx, sizeof(ctx), "%d|%s|%d|%d|%d|%d|%d|%d", pCxt->acctId, pCxt->pUser, pCxt->sysInfo,
+                            pCxt->isView, pCxt->isAudit, pCxt->showRewrite, tsQueryPolicy, tsQuerySmaOptimize);
+
+  T_MD5_CTX md5;
+  tMD5Init(&md5);
+  tMD5Update(&md5, (uint8_t*)ctx, ctxLen + 1);
+  // the sys table scans and the mnode list of the plan point to the mnodes
+  updatePlanCacheKeyByEpSet(&md5, &pCxt->mgmtEpSet);
+  tMD5Update(&md5, (uint8_t*)pRequest->sqlstr, pRequest->sqlLen + 1);
+  tMD5Update(&md5, (uint8_t*)pAst, astLen);
+  tMD5Final(&md5);
+  (void)memcpy(pKey, md5.digest, sizeof(md5.digest));
+
+  taosMemoryFree(pAst);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t buildPlanCacheEntry(SQueryPlan* pPlan, SArray* pMnodeList, SPlanCacheEntry** ppEntry, size_t* pCharge) {
+  int32_t          code = TSDB_CODE_SUCCESS;
+  SHashObj*        pIdx = NULL;
+  SSubplan**       ppSubplans = NULL;
+  SPlanCacheEntry* pEntry = taosMemoryCalloc(1, sizeof(SPlanCacheEntry));
+  if (NULL == pEntry) {
+    return terrno;
+  }
+
+  pEntry->numOfLevels = LIST_LENGTH(pPlan->pSubplans);
+  pEntry->explainInfo = pPlan->explainInfo;
+  pEntry->pSubplans = taosMemoryCalloc(TMAX(pPlan->numOfSubplans, 1), sizeof(SPlanCacheSubplan));
+  ppSubplans = taosMemoryCalloc(TMAX(pPlan->numOfSubplans, 1), POINTER_BYTES);
+  pIdx = taosHashInit(pPlan->numOfSubplans, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+  if (NULL == pEntry->pSubplans || NULL == ppSubplans || NULL == pIdx) {
+    code = terrno;
+    goto _end;
+  }
+  if (NULL != pMnodeList && taosArrayGetSize(pMnodeList) > 0) {
+    pEntry->pMnodeList = taosArrayDup(pMnodeList, NULL);
+    if (NULL == pEntry->pMnodeList) {
+      code = terrno;
+      goto _end;
+    }
+  }
+
+  *pCharge = sizeof(SPlanCacheEntry);
+
+  SNode*  pLevel = NULL;
+  int32_t level = 0;
+  FOREACH(pLevel, pPlan->pSubplans) {
+    SNode* pNode = NULL;
+    FOREACH(pNode, ((SNodeListNode*)pLevel)->pNodeList) {
+      if (pEntry->numOfSubplans >= pPlan->numOfSubplans) {
+        code = TSDB_CODE_PLAN_INTERNAL_ERROR;
+        goto _end;
+      }
+
+      SPlanCacheSubplan* pCached = &pEntry->pSubplans[pEntry->numOfSubplans];
+      pCached->level = level;
+      pCached->execNodeStat = ((SSubplan*)pNode)->execNodeStat;
+      code = nodesNodeToMsg(pNode, &pCached->pMsg, &pCached->msgLen);
+      if (TSDB_CODE_SUCCESS != code) {
+        goto _end;
+      }
+      code = taosHashPut(pIdx, &pNode, POINTER_BYTES, &pEntry->numOfSubplans, sizeof(int32_t));
+      if (TSDB_CODE_SUCCESS != code) {
+        goto _end;
+      }
+      ppSubplans[pEntry->numOfSubplans++] = (SSubplan*)pNode;
+      *pCharge += sizeof(SPlanCacheSubplan) + pCached->msgLen;
+    }
+    ++level;
+  }
+
+  for (int32_t i = 0; i < pEntry->numOfSubplans; ++i) {
+    SPlanCacheSubplan* pCached = &pEntry->pSubplans[i];
+    pCached->numOfChildren = LIST_LENGTH(ppSubplans[i]->pChildren);
+    if (pCached->numOfChildren <= 0) {
+      continue;
+    }
+    pCached->pChildren = taosMemoryMalloc(pCached->numOfChildren * sizeof(int32_t));
+    if (NULL == pCached->pChildren) {
+      code = terrno;
+      goto _end;
+    }
+
+    int32_t c = 0;
+    SNode*  pNode = NULL;
+    FOREACH(pNode, ppSubplans[i]->pChildren) {
+      int32_t* pChildIdx = taosHashGet(pIdx, &pNode, POINTER_BYTES);
+      if (NULL == pChildIdx) {
+        code = TSDB_CODE_PLAN_INTERNAL_ERROR;
+        goto _end;
+      }
+      pCached->pChildren[c++] = *pChildIdx;
+    }
+    *pCharge += pCached->numOfChildren * sizeof(int32_t);
+  }
+
+_end:
+  taosHashCleanup(pIdx);
+  taosMemoryFree(ppSubplans);
+  if (TSDB_CODE_SUCCESS != code) {
+    destroyPlanCacheEntry(pEntry);
+    pEntry = NULL;
+  }
+  *ppEntry = pEntry;
+  return code;
+}
+
+static int32_t buildPlanFromCacheEntry(const SPlanCacheEntry* pEntry, uint64_t queryId, SQueryPlan** ppPlan,
+                                       SArray* pMnodeList) {
+  SQueryPlan* pPlan = NULL;
+  SSubplan**  ppSubplans = NULL;
+  int32_t     code = nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN, (SNode**)&pPlan);
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+
+  pPlan->queryId = queryId;
+  pPlan->numOfSubplans = pEntry->numOfSubplans;
+  pPlan->explainInfo = pEntry->explainInfo;
+
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < pEntry->numOfLevels; ++i) {
+    SNodeListNode* pLevel = NULL;
+    code = nodesMakeNode(QUERY_NODE_NODE_LIST, (SNode**)&pLevel);
+    if (TSDB_CODE_SUCCESS == code) {
+      code = nodesListMakeStrictAppend(&pPlan->pSubplans, (SNode*)pLevel);
+    }
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    ppSubplans = taosMemoryCalloc(TMAX(pEntry->numOfSubplans, 1), POINTER_BYTES);
+    if (NULL == ppSubplans) {
+      code = terrno;
+    }
+  }
+
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < pEntry->numOfSubplans; ++i) {
+    const SPlanCacheSubplan* pCached = &pEntry->pSubplans[i];
+    SSubplan*                pSubplan = NULL;
+    code = nodesMsgToNode(pCached->pMsg, pCached->msgLen, (SNode**)&pSubplan);
+    if (TSDB_CODE_SUCCESS != code) {
+      break;
+    }
+    pSubplan->id.queryId = queryId;
+    pSubplan->execNodeStat = pCached->execNodeStat;
+
+    SNodeListNode* pLevel = (SNodeListNode*)nodesListGetNode(pPlan->pSubplans, pCached->level);
+    code = nodesListMakeStrictAppend(&pLevel->pNodeList, (SNode*)pSubplan);
+    if (TSDB_CODE_SUCCESS == code) {
+      ppSubplans[i] = pSubplan;
+    }
+  }
+
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < pEntry->numOfSubplans; ++i) {
+    const SPlanCacheSubplan* pCached = &pEntry->pSubplans[i];
+    for (int32_t c = 0; TSDB_CODE_SUCCESS == code && c < pCached->numOfChildren; ++c) {
+      SSubplan* pChild = ppSubplans[pCached->pChildren[c]];
+      code = nodesListMakeAppend(&ppSubplans[i]->pChildren, (SNode*)pChild);
+      if (TSDB_CODE_SUCCESS == code) {
+        code = nodesListMakeAppend(&pChild->pParents, (SNode*)ppSubplans[i]);
+      }
+    }
+  }
+
+  if (TSDB_CODE_SUCCESS == code && NULL != pEntry->pMnodeList && NULL != pMnodeList) {
+    if (NULL == taosArrayAddAll(pMnodeList, pEntry->pMnodeList)) {
+      code = terrno;
+    }
+  }
+
+  taosMemoryFree(ppSubplans);
+  if (TSDB_CODE_SUCCESS != code) {
+    nodesDestroyNode((SNode*)pPlan);
+    pPlan = NULL;
+  }
+  *ppPlan = pPlan;
+  return code;
+}
+
+static void putPlanCache(SRequestObj* pRequest, const uint8_t* pKey, SQueryPlan* pPlan, SArray* pMnodeList) {
+  SPlanCacheEntry* pEntry = NULL;
+  size_t           charge = 0;
+  int32_t          code = buildPlanCacheEntry(pPlan, pMnodeList, &pEntry, &charge);
+  if (TSDB_CODE_SUCCESS != code) {
+    tscDebug("0x%" PRIx64 " plan not cached since %s, QID:0x%" PRIx64, pRequest->self, tstrerror(code),
+             pRequest->requestId);
+    return;
+  }
+
+  LRUStatus status = taosLRUCacheInsert(planCache, pKey, PLAN_CACHE_KEY_LEN, pEntry, charge, freePlanCacheEntry, NULL,
+                                        NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+  if (TAOS_LRU_STATUS_OK != status && TAOS_LRU_STATUS_OK_OVERWRITTEN != status) {
+    tscDebug("0x%" PRIx64 " failed to insert plan cache, status:%d, QID:0x%" PRIx64, pRequest->self, status,
+             pRequest->requestId);
+  }
+}
+
+static int32_t getPlanCache(SRequestObj* pRequest, const uint8_t* pKey, uint64_t queryId, SQueryPlan** ppPlan,
+                            SArray* pMnodeList) {
+  LRUHandle* h = taosLRUCacheLookup(planCache, pKey, PLAN_CACHE_KEY_LEN);
+  if (NULL == h) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SPlanCacheEntry* pEntry = (SPlanCacheEntry*)taosLRUCacheValue(planCache, h);
+  int32_t          code = buildPlanFromCacheEntry(pEntry, queryId, ppPlan, pMnodeList);
+  (void)taosLRUCacheRelease(planCache, h, false);
+  if (TSDB_CODE_SUCCESS == code) {
+    tscDebug("0x%" PRIx64 " plan cache hit, subplans:%d, QID:0x%" PRIx64, pRequest->self, (*ppPlan)->numOfSubplans,
+             pRequest->requestId);
+  } else {
+    tscWarn("0x%" PRIx64 " failed to build plan from cache since %s, QID:0x%" PRIx64, pRequest->self, tstrerror(code),
+            pRequest->requestId);
+  }
+  return code;
+}
+
+// pKey is set for planCachePut, it is not cacheable if the query is not or the key can not be built
+int32_t planCacheGet(SRequestObj* pRequest, SQuery* pQuery, SPlanContext* pCxt, SPlanCacheKey* pKey,
+                     SQueryPlan** ppPlan, SArray* pMnodeList) {
+  *ppPlan = NULL;
+  (void)memset(pKey, 0, sizeof(SPlanCacheKey));
+  if (!isPlanCacheable(pQuery) || TSDB_CODE_SUCCESS != buildPlanCacheKey(pRequest, pQuery, pCxt, pKey->digest)) {
+    return TSDB_CODE_SUCCESS;
+  }
+  pKey->cacheable = true;
+  return getPlanCache(pRequest, pKey->digest, pCxt->queryId, ppPlan, pMnodeList);
+}
+
+void planCachePut(SRequestObj* pRequest, const SPlanCacheKey* pKey, SQueryPlan* pPlan, SArray* pMnodeList) {
+  if (!pKey->cacheable || NULL != pPlan->pPostPlan) {
+    return;
+  }
+  putPlanCache(pRequest, pKey->digest, pPlan, pMnodeList);
+}
+
+int32_t createQueryPlanWithCache(SRequestObj* pRequest, SQuery* pQuery, SPlanContext* pCxt, SQueryPlan** ppPlan,
+                                 SArray* pMnodeList) {
+  SPlanCacheKey key = {0};
+  if (TSDB_CODE_SUCCESS == planCacheGet(pRequest, pQuery, pCxt, &key, ppPlan, pMnodeList) && NULL != *ppPlan) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = qCreateQueryPlan(pCxt, ppPlan, pMnodeList);
+  if (TSDB_CODE_SUCCESS == code) {
+    planCachePut(pRequest, &key, *ppPlan, pMnodeList);
+  }
+  return code;
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <string>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "clientInt.h"
+#include "tglobal.h"
+
+namespace {
+
+SSubplan* createTestSubplan(int32_t subplanId, int32_t level, ESubplanType type) {
+  SSubplan* pSubplan = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_PHYSICAL_SUBPLAN, (SNode**)&pSubplan), TSDB_CODE_SUCCESS);
+  pSubplan->id.queryId = 1;
+  pSubplan->id.groupId = 1;
+  pSubplan->id.subplanId = subplanId;
+  pSubplan->subplanType = type;
+  pSubplan->level = level;
+  pSubplan->msgType = TDMT_SCH_QUERY;
+  pSubplan->execNodeStat.tableNum = subplanId * 10;
+  strcpy(pSubplan->dbFName, "1.db");
+  return pSubplan;
+}
+
+// a merge subplan over two scan subplans
+SQueryPlan* createTestPlan() {
+  SQueryPlan* pPlan = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN, (SNode**)&pPlan), TSDB_CODE_SUCCESS);
+  pPlan->queryId = 1;
+  pPlan->numOfSubplans = 3;
+
+  SNodeListNode* pTop = NULL;
+  SNodeListNode* pBottom = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_NODE_LIST, (SNode**)&pTop), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_NODE_LIST, (SNode**)&pBottom), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesListMakeStrictAppend(&pPlan->pSubplans, (SNode*)pTop), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesListMakeStrictAppend(&pPlan->pSubplans, (SNode*)pBottom), TSDB_CODE_SUCCESS);
+
+  SSubplan* pMerge = createTestSubplan(1, 0, SUBPLAN_TYPE_MERGE);
+  EXPECT_EQ(nodesListMakeStrictAppend(&pTop->pNodeList, (SNode*)pMerge), TSDB_CODE_SUCCESS);
+  for (int32_t i = 0; i < 2; ++i) {
+    SSubplan* pScan = createTestSubplan(2 + i, 1, SUBPLAN_TYPE_SCAN);
+    EXPECT_EQ(nodesListMakeStrictAppend(&pBottom->pNodeList, (SNode*)pScan), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(nodesListMakeAppend(&pMerge->pChildren, (SNode*)pScan), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(nodesListMakeAppend(&pScan->pParents, (SNode*)pMerge), TSDB_CODE_SUCCESS);
+  }
+  return pPlan;
+}
+
+// an analysed select with a constant condition, the constant is part of the cache key
+SQuery* createTestQuery(int64_t constant) {
+  SQuery*      pQuery = NULL;
+  SSelectStmt* pSelect = NULL;
+  SValueNode*  pVal = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_QUERY, (SNode**)&pQuery), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_SELECT_STMT, (SNode**)&pSelect), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_VALUE, (SNode**)&pVal), TSDB_CODE_SUCCESS);
+  pVal->node.resType.type = TSDB_DATA_TYPE_BIGINT;
+  pVal->node.resType.bytes = tDataTypes[TSDB_DATA_TYPE_BIGINT].bytes;
+  pVal->literal = taosStrdup(std::to_string(constant).c_str());
+  pVal->translate = true;
+  pVal->datum.i = constant;
+  pSelect->pWhere = (SNode*)pVal;
+  pQuery->pRoot = (SNode*)pSelect;
+  return pQuery;
+}
+
+void initTestRequest(SRequestObj* pRequest, const char* sql) {
+  memset(pRequest, 0, sizeof(*pRequest));
+  pRequest->self = 1;
+  pRequest->requestId = 1;
+  pRequest->sqlstr = (char*)sql;
+  pRequest->sqlLen = strlen(sql);
+}
+
+void initTestPlanContext(SPlanContext* pCxt, uint64_t queryId) {
+  memset(pCxt, 0, sizeof(*pCxt));
+  pCxt->queryId = queryId;
+  pCxt->acctId = 1;
+  pCxt->pUser = "root";
+  pCxt->sysInfo = true;
+  pCxt->mgmtEpSet.numOfEps = 2;
+  strcpy(pCxt->mgmtEpSet.eps[0].fqdn, "mnode1");
+  strcpy(pCxt->mgmtEpSet.eps[1].fqdn, "mnode2");
+  pCxt->mgmtEpSet.eps[0].port = 6030;
+  pCxt->mgmtEpSet.eps[1].port = 6030;
+}
+
+SSubplan* getTestSubplan(SQueryPlan* pPlan, int32_t level, int32_t index) {
+  SNodeListNode* pLevel = (SNodeListNode*)nodesListGetNode(pPlan->pSubplans, level);
+  return (SSubplan*)nodesListGetNode(pLevel->pNodeList, index);
+}
+
+}  // namespace
+
+TEST(clientPlanCacheTest, disabledByDefault) {
+  EXPECT_EQ(tsQueryPlanCacheSize, 0);
+  ASSERT_EQ(planCacheInit(), TSDB_CODE_SUCCESS);
+
+  const char*   sql = "select * from db.t1 where c1 > 10";
+  SRequestObj   request;
+  SPlanContext  cxt;
+  SQuery*       pQuery = createTestQuery(10);
+  SQueryPlan*   pPlan = createTestPlan();
+  SQueryPlan*   pCached = NULL;
+  SPlanCacheKey key;
+  initTestRequest(&request, sql);
+  initTestPlanContext(&cxt, 100);
+
+  ASSERT_EQ(planCacheGet(&request, pQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+  EXPECT_FALSE(key.cacheable);
+  planCachePut(&request, &key, pPlan, NULL);
+  ASSERT_EQ(planCacheGet(&request, pQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+
+  nodesDestroyNode((SNode*)pPlan);
+  qDestroyQuery(pQuery);
+  planCacheCleanup();
+}
+
+TEST(clientPlanCacheTest, hitRebuildsPlan) {
+  int32_t oldSize = tsQueryPlanCacheSize;
+  tsQueryPlanCacheSize = 1;
+  ASSERT_EQ(planCacheInit(), TSDB_CODE_SUCCESS);
+
+  const char*   sql = "select * from db.t1 where c1 > 10";
+  SRequestObj   request;
+  SPlanContext  cxt;
+  SQuery*       pQuery = createTestQuery(10);
+  SQueryPlan*   pPlan = createTestPlan();
+  SQueryPlan*   pCached = NULL;
+  SPlanCacheKey key;
+  initTestRequest(&request, sql);
+  initTestPlanContext(&cxt, 100);
+
+  ASSERT_EQ(planCacheGet(&request, pQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+  EXPECT_TRUE(key.cacheable);
+  planCachePut(&request, &key, pPlan, NULL);
+  nodesDestroyNode((SNode*)pPlan);
+
+  // the same query sent again by another request
+  SQuery* pSameQuery = createTestQuery(10);
+  initTestPlanContext(&cxt, 200);
+  ASSERT_EQ(planCacheGet(&request, pSameQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  ASSERT_NE(pCached, nullptr);
+  EXPECT_EQ(pCached->queryId, 200);
+  EXPECT_EQ(pCached->numOfSubplans, 3);
+  ASSERT_EQ(LIST_LENGTH(pCached->pSubplans), 2);
+
+  SSubplan* pMerge = getTestSubplan(pCached, 0, 0);
+  EXPECT_EQ(pMerge->subplanType, SUBPLAN_TYPE_MERGE);
+  EXPECT_EQ(pMerge->id.queryId, 200);
+  ASSERT_EQ(LIST_LENGTH(pMerge->pChildren), 2);
+  for (int32_t i = 0; i < 2; ++i) {
+    SSubplan* pScan = getTestSubplan(pCached, 1, i);
+    EXPECT_EQ(pScan->subplanType, SUBPLAN_TYPE_SCAN);
+    EXPECT_EQ(pScan->id.subplanId, 2 + i);
+    EXPECT_EQ(pScan->id.queryId, 200);
+    EXPECT_EQ(pScan->execNodeStat.tableNum, (2 + i) * 10);
+    EXPECT_EQ((SSubplan*)nodesListGetNode(pMerge->pChildren, i), pScan);
+    ASSERT_EQ(LIST_LENGTH(pScan->pParents), 1);
+    EXPECT_EQ((SSubplan*)nodesListGetNode(pScan->pParents, 0), pMerge);
+  }
+  nodesDestroyNode((SNode*)pCached);
+  pCached = NULL;
+
+  // another constant or another sql text is another key
+  SQuery* pOtherQuery = createTestQuery(11);
+  ASSERT_EQ(planCacheGet(&request, pOtherQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+
+  SRequestObj otherRequest;
+  initTestRequest(&otherRequest, "select * from db.t1 where c1 > 10 ");
+  ASSERT_EQ(planCacheGet(&otherRequest, pSameQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+
+  // and so is another mnode leader or mnode list
+  cxt.mgmtEpSet.inUse = 1;
+  ASSERT_EQ(planCacheGet(&request, pSameQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+  cxt.mgmtEpSet.inUse = 0;
+  strcpy(cxt.mgmtEpSet.eps[1].fqdn, "mnode3");
+  ASSERT_EQ(planCacheGet(&request, pSameQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+  strcpy(cxt.mgmtEpSet.eps[1].fqdn, "mnode2");
+
+  // and so is another user
+  cxt.pUser = "user1";
+  ASSERT_EQ(planCacheGet(&request, pSameQuery, &cxt, &key, &pCached, NULL), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pCached, nullptr);
+
+  qDestroyQuery(pQuery);
+  qDestroyQuery(pSameQuery);
+  qDestroyQuery(pOtherQuery);
+  planCacheCleanup();
+  tsQueryPlanCacheSize = oldSize;
+}
+
+#pragma GCC diagnostic pop
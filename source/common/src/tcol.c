@@ -17,8 +17,9 @@
 #include "tcompression.h"
 #include "tutil.h"
 
-const char* supportedEncode[5] = {TSDB_COLUMN_ENCODE_SIMPLE8B, TSDB_COLUMN_ENCODE_XOR, TSDB_COLUMN_ENCODE_RLE,
-                                  TSDB_COLUMN_ENCODE_DELTAD, TSDB_COLUMN_ENCODE_DISABLED};
+const char* supportedEncode[6] = {TSDB_COLUMN_ENCODE_SIMPLE8B, TSDB_COLUMN_ENCODE_XOR,
+                                  TSDB_COLUMN_ENCODE_RLE,      TSDB_COLUMN_ENCODE_DELTAD,
+                                  TSDB_COLUMN_ENCODE_ALP,      TSDB_COLUMN_ENCODE_DISABLED};
 
 const char* supportedCompress[6] = {TSDB_COLUMN_COMPRESS_LZ4,  TSDB_COLUMN_COMPRESS_TSZ,
                                     TSDB_COLUMN_COMPRESS_XZ,   TSDB_COLUMN_COMPRESS_ZLIB,
@@ -127,6 +128,9 @@ const char* columnEncodeStr(uint8_t type) {
     case TSDB_COLVAL_ENCODE_DELTAD:
       encode = TSDB_COLUMN_ENCODE_DELTAD;
       break;
+    case TSDB_COLVAL_ENCODE_ALP:
+      encode = TSDB_COLUMN_ENCODE_ALP;
+      break;
     case TSDB_COLVAL_ENCODE_DISABLED:
       encode = TSDB_COLUMN_ENCODE_DISABLED;
       break;
@@ -209,6 +213,8 @@ uint8_t columnEncodeVal(const char* encode) {
     e = TSDB_COLVAL_ENCODE_RLE;
   } else if (0 == strcmp(encode, TSDB_COLUMN_ENCODE_DELTAD)) {
     e = TSDB_COLVAL_ENCODE_DELTAD;
+  } else if (0 == strcmp(encode, TSDB_COLUMN_ENCODE_ALP)) {
+    e = TSDB_COLVAL_ENCODE_ALP;
   } else if (0 == strcmp(encode, TSDB_COLUMN_ENCODE_DISABLED)) {
     e = TSDB_COLVAL_ENCODE_DISABLED;
   } else {
@@ -357,7 +363,7 @@ int8_t validColCompress(uint8_t type, uint8_t l2) {
 // |tinyint/smallint/int/bigint/utinyint/usmallinit/uint/ubiginint| simple8b |
 // | timestamp/bigint/ubigint | delta-i  |
 // | bool  |  bit-packing   |
-// | flout/double | delta-d |
+// | flout/double | delta-d/alp |
 //
 int8_t validColEncode(uint8_t type, uint8_t l1) {
   if (l1 == TSDB_COLVAL_ENCODE_NOCHANGE) {
@@ -373,7 +379,7 @@ int8_t validColEncode(uint8_t type, uint8_t l1) {
   } else if (type == TSDB_DATA_TYPE_BIGINT) {
     return TSDB_COLVAL_ENCODE_SIMPLE8B == l1 || TSDB_COLVAL_ENCODE_XOR == l1 ? 1 : 0;
   } else if (type >= TSDB_DATA_TYPE_FLOAT && type <= TSDB_DATA_TYPE_DOUBLE) {
-    return TSDB_COLVAL_ENCODE_DELTAD == l1 ? 1 : 0;
+    return TSDB_COLVAL_ENCODE_DELTAD == l1 || TSDB_COLVAL_ENCODE_ALP == l1 ? 1 : 0;
   } else if ((type == TSDB_DATA_TYPE_VARCHAR || type == TSDB_DATA_TYPE_NCHAR) || type == TSDB_DATA_TYPE_JSON ||
              type == TSDB_DATA_TYPE_VARBINARY || type == TSDB_DATA_TYPE_BINARY || type == TSDB_DATA_TYPE_GEOMETRY) {
     return l1 == TSDB_COLVAL_ENCODE_DISABLED ? 1 : 0;
@@ -1237,6 +1237,211 @@ int32_t dataBlockCompar(const void* p1, const void* p2, const void* param) {
   return 0;
 }
 
+#define BLOCK_SORT_KEY_MAX_LEN 64
+
+// normalized sort keys are [rowIdx][key], the key holds the leading order columns of the row so that memcmp gives the
+// order of dataBlockCompar
+typedef struct SBlockSortKeyHelper {
+  SSDataBlockSortHelper helper;
+  int32_t               keyLen;
+  bool                  fullKey;  // all order columns are in the key, no need to compare the columns on ties
+} SBlockSortKeyHelper;
+
+static int32_t blockSortKeyCompar(const void* p1, const void* p2, const void* param) {
+  const SBlockSortKeyHelper* pHelper = (const SBlockSortKeyHelper*)param;
+
+  int32_t ret = memcmp((const char*)p1 + sizeof(int32_t), (const char*)p2 + sizeof(int32_t), pHelper->keyLen);
+  if (ret != 0 || pHelper->fullKey) {
+    return ret;
+  }
+
+  return dataBlockCompar(p1, p2, &pHelper->helper);
+}
+
+static void blockSortKeyEncodeVal(const SColumnInfoData* pCol, int32_t rowIdx, uint8_t* p, int32_t width) {
+  int32_t type = pCol->info.type;
+  if (IS_VAR_DATA_TYPE(type)) {
+    char*   pData = colDataGetVarData(pCol, rowIdx);
+    int32_t len = TMIN(varDataLen(pData), width);
+    if (type != TSDB_DATA_TYPE_VARBINARY) {
+      // strings are compared by strncmp which stops at the first '\0'
+      char* pEnd = memchr(varDataVal(pData), 0, len);
+      if (pEnd != NULL) {
+        len = pEnd - varDataVal(pData);
+      }
+    }
+    memcpy(p, varDataVal(pData), len);
+    return;
+  }
+
+  int32_t  bytes = pCol->info.bytes;
+  uint64_t val = 0;
+  char*    pData = colDataGetNumData(pCol, rowIdx);
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      val = (uint8_t)(*(int8_t*)pData) ^ 0x80u;
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      val = (uint16_t)(*(int16_t*)pData) ^ 0x8000u;
+      break;
+    case TSDB_DATA_TYPE_INT:
+      val = (uint32_t)(*(int32_t*)pData) ^ 0x80000000u;
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      val = (uint64_t)(*(int64_t*)pData) ^ 0x8000000000000000ULL;
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      val = *(uint8_t*)pData;
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      val = *(uint16_t*)pData;
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      val = *(uint32_t*)pData;
+      break;
+    default:
+      val = *(uint64_t*)pData;
+      break;
+  }
+
+  for (int32_t i = 0; i < width; ++i) {
+    p[i] = (uint8_t)(val >> (8 * (bytes - 1 - i)));
+  }
+}
+
+static bool blockSortKeyColSupported(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_BINARY:
+    case TSDB_DATA_TYPE_VARBINARY:
+    case TSDB_DATA_TYPE_GEOMETRY:
+      return true;
+    default:
+      // float and double are compared with a tolerance, nchar and json by their own rules
+      return false;
+  }
+}
+
+// a var column is kept exactly when zero padding can't make two values equal, i.e. no value contains '\0'
+static int32_t blockSortKeyVarColWidth(const SColumnInfoData* pCol, int32_t rows, bool* pExact) {
+  int32_t maxLen = 0;
+
+  *pExact = true;
+  for (int32_t j = 0; j < rows; ++j) {
+    if (pCol->hasNull && colDataIsNull_var(pCol, j)) {
+      continue;
+    }
+
+    char* pData = colDataGetVarData(pCol, j);
+    if (memchr(varDataVal(pData), 0, varDataLen(pData)) != NULL) {
+      *pExact = false;
+    }
+    maxLen = TMAX(maxLen, varDataLen(pData));
+  }
+
+  return maxLen;
+}
+
+/*
+ * Each order column takes a null flag byte and its value in big endian with the sign bit flipped, or the zero padded
+ * string, all bytes of the value are inverted for descending order. Encoding stops at the first column that can't be
+ * encoded or doesn't fit completely, rows with equal keys are compared by the columns then.
+ */
+static int32_t blockDataBuildSortKeys(const SSDataBlock* pDataBlock, SBlockSortKeyHelper* pHelper, char** ppKeys) {
+  SArray* pOrderInfo = pHelper->helper.orderInfo;
+  int32_t rows = pDataBlock->info.rows;
+  int32_t numOfOrders = taosArrayGetSize(pOrderInfo);
+  int32_t widths[BLOCK_SORT_KEY_MAX_LEN / 2] = {0};
+  int32_t numOfKeyCols = 0;
+
+  *ppKeys = NULL;
+  pHelper->keyLen = 0;
+  pHelper->fullKey = false;
+
+  for (int32_t i = 0; i < numOfOrders && numOfKeyCols < tListLen(widths); ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = pOrder->pColData;
+    int32_t          remain = BLOCK_SORT_KEY_MAX_LEN - pHelper->keyLen - 1;
+    if (pCol == NULL || remain <= 0 || !blockSortKeyColSupported(pCol->info.type)) {
+      break;
+    }
+
+    bool    exact = true;
+    int32_t width = pCol->info.bytes;
+    if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+      width = blockSortKeyVarColWidth(pCol, rows, &exact);
+    }
+    if (width > remain) {
+      width = remain;
+      exact = false;
+    }
+
+    widths[numOfKeyCols++] = width;
+    pHelper->keyLen += 1 + width;
+    if (!exact) {
+      break;
+    }
+
+    pHelper->fullKey = (i == numOfOrders - 1);
+  }
+
+  if (numOfKeyCols == 0) {
+    pHelper->keyLen = 0;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t elemSize = sizeof(int32_t) + pHelper->keyLen;
+  char*   pKeys = taosMemoryCalloc(rows, elemSize);
+  if (pKeys == NULL) {
+    return terrno;
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    *(int32_t*)(pKeys + (int64_t)j * elemSize) = j;
+  }
+
+  int32_t offset = sizeof(int32_t);
+  for (int32_t i = 0; i < numOfKeyCols; ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = pOrder->pColData;
+    int32_t          width = widths[i];
+    uint8_t          nullFlag = pOrder->nullFirst ? 0 : 1;
+    bool             desc = (pOrder->order == TSDB_ORDER_DESC);
+
+    for (int32_t j = 0; j < rows; ++j) {
+      uint8_t* p = (uint8_t*)pKeys + (int64_t)j * elemSize + offset;
+      if (pCol->hasNull && colDataIsNull(pCol, rows, j, NULL)) {
+        p[0] = nullFlag;
+        continue;
+      }
+
+      p[0] = nullFlag ^ 1;
+      blockSortKeyEncodeVal(pCol, j, p + 1, width);
+      if (desc) {
+        for (int32_t k = 1; k <= width; ++k) {
+          p[k] = ~p[k];
+        }
+      }
+    }
+
+    offset += 1 + width;
+  }
+
+  *ppKeys = pKeys;
+  return TSDB_CODE_SUCCESS;
+}
+
 static void blockDataAssign(SColumnInfoData* pCols, const SSDataBlock* pDataBlock, const int32_t* index) {
   size_t numOfCols = taosArrayGetSize(pDataBlock->pDataBlock);
   for (int32_t i = 0; i < numOfCols; ++i) {
@@ -1441,14 +1646,34 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
     pInfo->compFn = getKeyComparFunc(pInfo->pColData->info.type, pInfo->order);
   }
 
+  SBlockSortKeyHelper keyHelper = {.helper = helper};
+  char*               pKeys = NULL;
+  int32_t             code = blockDataBuildSortKeys(pDataBlock, &keyHelper, &pKeys);
+  if (code != 0) {
+    destroyTupleIndex(index);
+    return code;
+  }
+
   terrno = 0;
-  taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
-  if (terrno) return terrno;
+  if (pKeys != NULL) {
+    int32_t elemSize = sizeof(int32_t) + keyHelper.keyLen;
+    taosqsort_r(pKeys, rows, elemSize, &keyHelper, blockSortKeyCompar);
+    for (int32_t i = 0; i < rows; ++i) {
+      index[i] = *(int32_t*)(pKeys + (int64_t)i * elemSize);
+    }
+    taosMemoryFree(pKeys);
+  } else {
+    taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
+  }
+  if (terrno) {
+    destroyTupleIndex(index);
+    return terrno;
+  }
 
   int64_t p1 = taosGetTimestampUs();
 
   SColumnInfoData* pCols = NULL;
-  int32_t code = createHelpColInfoData(pDataBlock, &pCols);
+  code = createHelpColInfoData(pDataBlock, &pCols);
   if (code != 0) {
     destroyTupleIndex(index);
     return code;
@@ -1462,8 +1687,8 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
 
   int64_t p4 = taosGetTimestampUs();
   uDebug("blockDataSort complex sort:%" PRId64 ", create:%" PRId64 ", assign:%" PRId64 ", copyback:%" PRId64
-         ", rows:%d\n",
-         p1 - p0, p2 - p1, p3 - p2, p4 - p3, rows);
+         ", rows:%d, keyLen:%d, fullKey:%d\n",
+         p1 - p0, p2 - p1, p3 - p2, p4 - p3, rows, keyHelper.keyLen, keyHelper.fullKey);
 
   destroyTupleIndex(index);
   return TSDB_CODE_SUCCESS;
@@ -2736,6 +2736,190 @@ _exit:
   return code;
 }
 
+/*
+ * Dictionary encoding of var data columns with few distinct values in a block. The encoded form replaces both the
+ * offset and the value part of the column:
+ * +-----------------+------------+-------------------------------------+-----------------------------------+
+ * | dict size (u32v)| code bits  | dict values (u32v length + bytes)   | row codes, bit packed, LSB first  |
+ * +-----------------+------------+-------------------------------------+-----------------------------------+
+ * A row without value keeps a zero length value as its offset does, so it is just one more dict value.
+ */
+#define COL_DICT_MAX_SIZE   1024
+#define COL_DICT_MIN_REPEAT 4
+#define COL_DICT_HASH_SIZE  (COL_DICT_MAX_SIZE * 2)
+
+static FORCE_INLINE int32_t tColDataGetVarLen(const SColData *colData, int32_t iVal) {
+  return ((iVal + 1 < colData->nVal) ? colData->aOffset[iVal + 1] : colData->nData) - colData->aOffset[iVal];
+}
+
+// leave output empty if the column is not worth a dictionary
+static int32_t tColDataDictEncode(SColData *colData, SBuffer *output) {
+  int32_t code = 0;
+  int32_t maxDictSize = TMIN(COL_DICT_MAX_SIZE, colData->nVal / COL_DICT_MIN_REPEAT);
+  int32_t dictSize = 0;
+  int64_t dictBytes = 0;
+
+  if (maxDictSize < 2) {
+    return 0;
+  }
+
+  int32_t  *slots = taosMemoryMalloc(sizeof(int32_t) * COL_DICT_HASH_SIZE);
+  int32_t  *dictRows = taosMemoryMalloc(sizeof(int32_t) * maxDictSize);
+  uint16_t *codes = taosMemoryMalloc(sizeof(uint16_t) * colData->nVal);
+  if (slots == NULL || dictRows == NULL || codes == NULL) {
+    code = terrno;
+    goto _exit;
+  }
+  (void)memset(slots, -1, sizeof(int32_t) * COL_DICT_HASH_SIZE);
+
+  _hash_fn_t hashFp = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
+  for (int32_t iVal = 0; iVal < colData->nVal; iVal++) {
+    const char *val = (const char *)colData->pData + colData->aOffset[iVal];
+    int32_t     len = tColDataGetVarLen(colData, iVal);
+    uint32_t    slot = (*hashFp)(val, len) & (COL_DICT_HASH_SIZE - 1);
+
+    while (slots[slot] >= 0) {
+      int32_t dictRow = dictRows[slots[slot]];
+      if (tColDataGetVarLen(colData, dictRow) == len &&
+          memcmp(colData->pData + colData->aOffset[dictRow], val, len) == 0) {
+        break;
+      }
+      slot = (slot + 1) & (COL_DICT_HASH_SIZE - 1);
+    }
+
+    if (slots[slot] < 0) {
+      if (dictSize >= maxDictSize) {
+        goto _exit;  // too many distinct values
+      }
+      dictRows[dictSize] = iVal;
+      slots[slot] = dictSize++;
+      dictBytes += len + sizeof(int32_t);
+    }
+
+    codes[iVal] = slots[slot];
+  }
+
+  uint8_t bits = 0;
+  while ((1 << bits) < dictSize) {
+    bits++;
+  }
+
+  int64_t packedSize = ((int64_t)colData->nVal * bits + 7) / 8;
+  if (dictBytes + packedSize >= colData->nData + (int64_t)sizeof(int32_t) * colData->nVal) {
+    goto _exit;
+  }
+
+  if ((code = tBufferPutU32v(output, dictSize))) goto _exit;
+  if ((code = tBufferPutU8(output, bits))) goto _exit;
+  for (int32_t i = 0; i < dictSize; i++) {
+    int32_t dictRow = dictRows[i];
+    code = tBufferPutBinary(output, colData->pData + colData->aOffset[dictRow], tColDataGetVarLen(colData, dictRow));
+    if (code) goto _exit;
+  }
+
+  uint64_t acc = 0;
+  int32_t  accBits = 0;
+  for (int32_t iVal = 0; iVal < colData->nVal; iVal++) {
+    acc |= ((uint64_t)codes[iVal]) << accBits;
+    accBits += bits;
+    while (accBits >= 8) {
+      if ((code = tBufferPutU8(output, (uint8_t)acc))) goto _exit;
+      acc >>= 8;
+      accBits -= 8;
+    }
+  }
+  if (accBits > 0) {
+    if ((code = tBufferPutU8(output, (uint8_t)acc))) goto _exit;
+  }
+
+_exit:
+  if (code) {
+    tBufferClear(output);
+  }
+  taosMemoryFree(slots);
+  taosMemoryFree(dictRows);
+  taosMemoryFree(codes);
+  return code;
+}
+
+static int32_t tColDataDictDecode(SBuffer *input, SColData *colData) {
+  int32_t       code = 0;
+  SBufferReader reader = BUFFER_READER_INITIALIZER(0, input);
+  uint32_t      dictSize = 0;
+  uint8_t       bits = 0;
+  const void  **dictVals = NULL;
+  uint32_t     *dictLens = NULL;
+
+  if ((code = tBufferGetU32v(&reader, &dictSize))) return code;
+  if ((code = tBufferGetU8(&reader, &bits))) return code;
+  if (dictSize == 0 || dictSize > COL_DICT_MAX_SIZE || bits > 16 || (dictSize > 1 && (1u << bits) < dictSize)) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+
+  dictVals = taosMemoryMalloc(sizeof(void *) * dictSize);
+  dictLens = taosMemoryMalloc(sizeof(uint32_t) * dictSize);
+  if (dictVals == NULL || dictLens == NULL) {
+    code = terrno;
+    goto _exit;
+  }
+
+  for (uint32_t i = 0; i < dictSize; i++) {
+    if ((code = tBufferGetBinary(&reader, &dictVals[i], &dictLens[i]))) goto _exit;
+  }
+
+  const uint8_t *packed = (const uint8_t *)BR_PTR(&reader);
+  if (reader.offset + ((int64_t)colData->nVal * bits + 7) / 8 > input->size) {
+    code = TSDB_CODE_INVALID_DATA_FMT;
+    goto _exit;
+  }
+
+  if ((code = tRealloc((uint8_t **)&colData->aOffset, sizeof(int32_t) * colData->nVal))) goto _exit;
+
+  // the codes are unpacked twice, first for the offsets and then for the values
+  uint32_t mask = (1u << bits) - 1;
+  int64_t  nData = 0;
+  for (int32_t pass = 0; pass < 2; pass++) {
+    uint64_t acc = 0;
+    int32_t  accBits = 0;
+    int32_t  iByte = 0;
+    for (int32_t iVal = 0; iVal < colData->nVal; iVal++) {
+      while (accBits < bits) {
+        acc |= ((uint64_t)packed[iByte++]) << accBits;
+        accBits += 8;
+      }
+      uint32_t dictCode = (uint32_t)(acc & mask);
+      acc >>= bits;
+      accBits -= bits;
+
+      if (dictCode >= dictSize) {
+        code = TSDB_CODE_INVALID_DATA_FMT;
+        goto _exit;
+      }
+
+      if (pass == 0) {
+        colData->aOffset[iVal] = nData;
+        nData += dictLens[dictCode];
+      } else if (dictLens[dictCode] > 0) {
+        (void)memcpy(colData->pData + colData->aOffset[iVal], dictVals[dictCode], dictLens[dictCode]);
+      }
+    }
+
+    if (pass == 0) {
+      if (nData > INT32_MAX) {
+        code = TSDB_CODE_INVALID_DATA_FMT;
+        goto _exit;
+      }
+      colData->nData = nData;
+      if ((code = tRealloc(&colData->pData, colData->nData))) goto _exit;
+    }
+  }
+
+_exit:
+  taosMemoryFree(dictVals);
+  taosMemoryFree(dictLens);
+  return code;
+}
+
 int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer *output, SBuffer *assist) {
   int32_t code;
   SBuffer local;
@@ -2790,6 +2974,34 @@ int32_t tColDataCompress(SColData *colData, SColDataCompressInfo *info, SBuffer
     return 0;
   }
 
+  // dictionary, in place of offset and data
+  if (info->allowDict && IS_VAR_DATA_TYPE(colData->type) && (colData->cflag & COL_IS_KEY) == 0) {
+    SBuffer dict;
+    tBufferInit(&dict);
+
+    code = tColDataDictEncode(colData, &dict);
+    if (code == 0 && dict.size > 0) {
+      info->columnFlag |= COL_DICT_ENC;
+      info->dataOriginalSize = dict.size;
+
+      SCompressInfo cinfo = {
+          .dataType = colData->type,
+          .cmprAlg = info->cmprAlg,
+          .originalSize = info->dataOriginalSize,
+      };
+
+      code = tCompressDataToBuffer(dict.data, &cinfo, output, assist);
+      info->dataCompressedSize = cinfo.compressedSize;
+    }
+
+    bool encoded = (dict.size > 0);
+    tBufferDestroy(&dict);
+    if (code || encoded) {
+      tBufferDestroy(&local);
+      return code;
+    }
+  }
+
   // offset
   if (IS_VAR_DATA_TYPE(colData->type)) {
     info->offsetOriginalSize = sizeof(int32_t) * info->numOfData;
@@ -2845,7 +3057,7 @@ int32_t tColDataDecompress(void *input, SColDataCompressInfo *info, SColData *co
   tColDataClear(colData);
   colData->cid = info->columnId;
   colData->type = info->dataType;
-  colData->cflag = info->columnFlag;
+  colData->cflag = info->columnFlag & (~COL_DICT_ENC);
   colData->nVal = info->numOfData;
   colData->flag = info->flag;
 
@@ -2881,6 +3093,30 @@ int32_t tColDataDecompress(void *input, SColDataCompressInfo *info, SColData *co
     goto _exit;
   }
 
+  // dictionary
+  if (info->columnFlag & COL_DICT_ENC) {
+    SBuffer       dict;
+    SCompressInfo cinfo = {
+        .cmprAlg = info->cmprAlg,
+        .dataType = colData->type,
+        .originalSize = info->dataOriginalSize,
+        .compressedSize = info->dataCompressedSize,
+    };
+
+    tBufferInit(&dict);
+    code = tDecompressDataToBuffer(data, &cinfo, &dict, assist);
+    if (code == 0) {
+      code = tColDataDictDecode(&dict, colData);
+    }
+    tBufferDestroy(&dict);
+    if (code) {
+      tBufferDestroy(&local);
+      return code;
+    }
+
+    goto _exit;
+  }
+
   // offset
   if (info->offsetOriginalSize > 0) {
     SCompressInfo cinfo = {
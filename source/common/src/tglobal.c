@@ -201,6 +201,13 @@ bool    tsMultiResultFunctionStarReturnTags = false;
  */
 int32_t tsCompressMsgSize = -1;
 
+/*
+ * codec of the compressed messages, 0: picked per connection by the observed compression ratio and link bandwidth,
+ * 1: lz4, 2: zstd if the peer supports it, otherwise lz4
+ */
+int32_t tsCompressMsgAlg = 1;
+int32_t tsCompressMsgLevel = 3;
+
 // count/hyperloglog function always return values in case of all NULL data or Empty data set.
 int32_t tsCountAlwaysReturnValue = 1;
 
@@ -212,6 +219,8 @@ int32_t tsMinIntervalTime = 1;
 
 // maximum batch rows numbers imported from a single csv load
 int32_t tsMaxInsertBatchRows = 1000000;
+int32_t tsNumOfCsvParseThreads = 4;
+int32_t tsQueryPlanCacheSize = 0;  // MB, 0 means disabled
 
 float   tsSelectivityRatio = 1.0;
 int32_t tsTagFilterResCacheSize = 1024 * 10;
@@ -224,6 +233,11 @@ char    tsTagFilterCache = 0;
 int32_t tsQueryBufferSize = -1;
 int64_t tsQueryBufferSizeBytes = -1;
 int32_t tsCacheLazyLoadThreshold = 500;
+int32_t tsSmaCacheSize = 0;  // MB per vnode
+int32_t tsQueryFetchCredits = 50;  // result blocks a task may produce ahead of the fetch of its consumer, at most the
+                                   // 500 blocks of the data sink
+int32_t tsQueryHashJoinMemLimit = 256;  // MB of the build side a hash join keeps in memory before spilling
+int64_t tsQueryHashJoinMemLimitBytes = 256 * 1048576L;
 
 int32_t  tsDiskCfgNum = 0;
 SDiskCfg tsDiskCfg[TFS_MAX_DISKS] = {0};
@@ -527,6 +541,7 @@ int32_t taosAddClientLogCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "numOfLogLines", tsNumOfLogLines, 1000, 2000000000, CFG_SCOPE_BOTH, CFG_DYN_ENT_BOTH));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "asyncLog", tsAsyncLog, CFG_SCOPE_BOTH, CFG_DYN_BOTH));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "asyncLogRingNum", tsAsyncLogRingNum, 0, 256, CFG_SCOPE_BOTH, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "logKeepDays", 0, -365000, 365000, CFG_SCOPE_BOTH, CFG_DYN_ENT_BOTH));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "debugFlag", 0, 0, 255, CFG_SCOPE_BOTH, CFG_DYN_BOTH));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "simDebugFlag", simDebugFlag, 0, 255, CFG_SCOPE_BOTH, CFG_DYN_BOTH));
@@ -577,6 +592,8 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
       cfgAddInt32(pCfg, "shellActivityTimer", tsShellActivityTimer, 1, 120, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "compressMsgSize", tsCompressMsgSize, -1, 100000000, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "compressMsgAlg", tsCompressMsgAlg, 0, 2, CFG_SCOPE_BOTH, CFG_DYN_NONE));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "compressMsgLevel", tsCompressMsgLevel, 1, 22, CFG_SCOPE_BOTH, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryPolicy", tsQueryPolicy, 1, 4, CFG_SCOPE_CLIENT, CFG_DYN_ENT_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddBool(pCfg, "queryTableNotExistAsEmpty", tsQueryTbNotExistAsEmpty, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
@@ -598,6 +615,12 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "maxShellConns", tsMaxShellConns, 10, 50000000, CFG_SCOPE_CLIENT, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "maxInsertBatchRows", tsMaxInsertBatchRows, 1, INT32_MAX, CFG_SCOPE_CLIENT,
                                 CFG_DYN_CLIENT) != 0);
+  tsNumOfCsvParseThreads = tsNumOfCores / 2;
+  TRANGE(tsNumOfCsvParseThreads, 1, 8);
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfCsvParseThreads", tsNumOfCsvParseThreads, 1, 64, CFG_SCOPE_CLIENT,
+                                CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(
+      cfgAddInt32(pCfg, "queryPlanCacheSize", tsQueryPlanCacheSize, 0, 1024, CFG_SCOPE_CLIENT, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "maxRetryWaitTime", tsMaxRetryWaitTime, 0, 86400000, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "useAdapter", tsUseAdapter, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
@@ -825,6 +848,9 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "concurrentCheckpoint", tsMaxConcurrentCheckpoint, 1, 10, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
 
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "cacheLazyLoadThreshold", tsCacheLazyLoadThreshold, 0, 100000, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "smaCacheSize", tsSmaCacheSize, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryFetchCredits", tsQueryFetchCredits, 1, 500, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryHashJoinMemLimit", tsQueryHashJoinMemLimit, 1, 1048576, CFG_SCOPE_SERVER, CFG_DYN_NONE));
 
   TAOS_CHECK_RETURN(cfgAddFloat(pCfg, "fPrecision", tsFPrecision, 0.0f, 100000.0f, CFG_SCOPE_SERVER, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddFloat(pCfg, "dPrecision", tsDPrecision, 0.0f, 1000000.0f, CFG_SCOPE_SERVER, CFG_DYN_NONE));
@@ -1025,6 +1051,9 @@ static int32_t taosSetClientLogCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "asyncLog");
   tsAsyncLog = pItem->bval;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "asyncLogRingNum");
+  tsAsyncLogRingNum = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "logKeepDays");
   tsLogKeepDays = pItem->i32;
 
@@ -1213,12 +1242,24 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "maxInsertBatchRows");
   tsMaxInsertBatchRows = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfCsvParseThreads");
+  tsNumOfCsvParseThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryPlanCacheSize");
+  tsQueryPlanCacheSize = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "shellActivityTimer");
   tsShellActivityTimer = pItem->i32;
 
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgSize");
   tsCompressMsgSize = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgAlg");
+  tsCompressMsgAlg = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "compressMsgLevel");
+  tsCompressMsgLevel = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "numOfTaskQueueThreads");
   tsNumOfTaskQueueThreads = pItem->i32;
 
@@ -1616,6 +1657,19 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "cacheLazyLoadThreshold");
   tsCacheLazyLoadThreshold = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "smaCacheSize");
+  tsSmaCacheSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryFetchCredits");
+  tsQueryFetchCredits = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryHashJoinMemLimit");
+  tsQueryHashJoinMemLimit = pItem->i32;
+  tsQueryHashJoinMemLimitBytes = tsQueryHashJoinMemLimit * 1048576L;
+  if (tsQueryBufferSizeBytes > 0 && tsQueryHashJoinMemLimitBytes > tsQueryBufferSizeBytes) {
+    tsQueryHashJoinMemLimitBytes = tsQueryBufferSizeBytes;
+  }
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "fPrecision");
   tsFPrecision = pItem->fval;
 
@@ -2028,6 +2082,7 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
                                          {"maxStreamBackendCache", &tsMaxStreamBackendCache},
                                          {"mqRebalanceInterval", &tsMqRebalanceInterval},
                                          {"numOfLogLines", &tsNumOfLogLines},
+                                         {"queryFetchCredits", &tsQueryFetchCredits},
                                          {"queryRspPolicy", &tsQueryRspPolicy},
                                          {"timeseriesThreshold", &tsTimeSeriesThreshold},
                                          {"tmqMaxTopicNum", &tmqMaxTopicNum},
@@ -2286,6 +2341,7 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
                                          {"maxRetryWaitTime", &tsMaxRetryWaitTime},
                                          {"minSlidingTime", &tsMinSlidingTime},
                                          {"minIntervalTime", &tsMinIntervalTime},
+                                         {"numOfCsvParseThreads", &tsNumOfCsvParseThreads},
                                          {"numOfLogLines", &tsNumOfLogLines},
                                          {"querySmaOptimize", &tsQuerySmaOptimize},
                                          {"queryPolicy", &tsQueryPolicy},
@@ -8153,6 +8153,20 @@ int32_t tSerializeSExplainRsp(void *buf, int32_t bufLen, SExplainRsp *pRsp) {
     TAOS_CHECK_EXIT(tEncodeBinary(&encoder, info->verboseInfo, info->verboseLen));
   }
 
+  for (int32_t i = 0; i < pRsp->numOfPlans; ++i) {
+    SExplainProfInfo *prof = &pRsp->subplanInfo[i].prof;
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->inputRows));
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->inputBlocks));
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->loadBlocks));
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->skipBlocks));
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->loadBytes));
+    TAOS_CHECK_EXIT(tEncodeDouble(&encoder, prof->loadTime));
+    TAOS_CHECK_EXIT(tEncodeDouble(&encoder, prof->filterTime));
+    TAOS_CHECK_EXIT(tEncodeDouble(&encoder, prof->aggTime));
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->hashProbes));
+    TAOS_CHECK_EXIT(tEncodeU64(&encoder, prof->hashMatchRows));
+  }
+
   tEndEncode(&encoder);
 
 _exit:
@@ -8187,6 +8201,22 @@ int32_t tDeserializeSExplainRsp(void *buf, int32_t bufLen, SExplainRsp *pRsp) {
     TAOS_CHECK_EXIT(tDecodeBinaryAlloc(&decoder, &pRsp->subplanInfo[i].verboseInfo, NULL));
   }
 
+  if (!tDecodeIsEnd(&decoder)) {
+    for (int32_t i = 0; i < pRsp->numOfPlans; ++i) {
+      SExplainProfInfo *prof = &pRsp->subplanInfo[i].prof;
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->inputRows));
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->inputBlocks));
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->loadBlocks));
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->skipBlocks));
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->loadBytes));
+      TAOS_CHECK_EXIT(tDecodeDouble(&decoder, &prof->loadTime));
+      TAOS_CHECK_EXIT(tDecodeDouble(&decoder, &prof->filterTime));
+      TAOS_CHECK_EXIT(tDecodeDouble(&decoder, &prof->aggTime));
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->hashProbes));
+      TAOS_CHECK_EXIT(tDecodeU64(&decoder, &prof->hashMatchRows));
+    }
+  }
+
   tEndDecode(&decoder);
 
 _exit:
@@ -9284,6 +9314,8 @@ int32_t tSerializeSSchedulerHbRsp(void *buf, int32_t bufLen, SSchedulerHbRsp *pR
   } else {
     TAOS_CHECK_EXIT(tEncodeI32(&encoder, 0));
   }
+  TAOS_CHECK_EXIT(tEncodeI32(&encoder, pRsp->queryInQueue));
+  TAOS_CHECK_EXIT(tEncodeI64(&encoder, pRsp->queryWaitUs));
   tEndEncode(&encoder);
 
 _exit:
@@ -9327,6 +9359,10 @@ int32_t tDeserializeSSchedulerHbRsp(void *buf, int32_t bufLen, SSchedulerHbRsp *
   } else {
     pRsp->taskStatus = NULL;
   }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pRsp->queryInQueue));
+    TAOS_CHECK_EXIT(tDecodeI64(&decoder, &pRsp->queryWaitUs));
+  }
   tEndDecode(&decoder);
 
 _exit:
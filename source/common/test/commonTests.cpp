@@ -10,9 +10,11 @@
 
 #include "taos.h"
 #include "tcommon.h"
+#include "tcompare.h"
 #include "tdatablock.h"
 #include "tdef.h"
 #include "tmisce.h"
+#include "tmsg.h"
 #include "ttime.h"
 #include "ttokendef.h"
 #include "tvariant.h"
@@ -304,6 +306,94 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+TEST(testCase, Datablock_sort_key_test) {
+  SSDataBlock* b = NULL;
+  int32_t code = createDataBlock(&b);
+  ASSERT(code == 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, 8, 2);
+  blockDataAppendColInfo(b, &infoData1);
+
+  SColumnInfoData infoData2 = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 3);
+  blockDataAppendColInfo(b, &infoData2);
+
+  int32_t numOfRows = 1000;
+  blockDataEnsureCapacity(b, numOfRows);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  SColumnInfoData* p2 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 2);
+
+  // long tags share a prefix longer than the normalized key, so ties have to be resolved by the columns
+  const char* tags[] = {"d1001", "d1002", "", "california.sanfrancisco.d1001", "california.sanfrancisco.d1002"};
+  char        varbuf[128] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int32_t tagIdx = taosRand() % 6;
+    if (tagIdx == 5) {
+      colDataSetNULL(p0, i);
+    } else {
+      STR_TO_VARSTR(varbuf, tags[tagIdx]);
+      colDataSetVal(p0, i, (const char*)varbuf, false);
+    }
+
+    int64_t ts = 1700000000000 + (taosRand() % 100) - 50;
+    colDataSetVal(p1, i, (const char*)&ts, false);
+    colDataSetVal(p2, i, (const char*)&i, (i % 7) == 0);
+    b->info.rows++;
+  }
+
+  SArray*         pOrderInfo = taosArrayInit(3, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo order = {true, TSDB_ORDER_ASC, 0, NULL};
+  taosArrayPush(pOrderInfo, &order);
+  order = {false, TSDB_ORDER_DESC, 1, NULL};
+  taosArrayPush(pOrderInfo, &order);
+  order = {false, TSDB_ORDER_ASC, 2, NULL};
+  taosArrayPush(pOrderInfo, &order);
+
+  ASSERT_EQ(blockDataSort(b, pOrderInfo), 0);
+  ASSERT_EQ(b->info.rows, numOfRows);
+
+  p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  p2 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 2);
+  for (int32_t i = 1; i < numOfRows; ++i) {
+    bool prevNull = colDataIsNull_s(p0, i - 1);
+    bool curNull = colDataIsNull_s(p0, i);
+    ASSERT_FALSE(!prevNull && curNull);
+    if (prevNull != curNull) {
+      continue;
+    }
+
+    if (!curNull) {
+      int32_t ret = compareLenPrefixedStr(colDataGetData(p0, i - 1), colDataGetData(p0, i));
+      ASSERT_LE(ret, 0);
+      if (ret < 0) {
+        continue;
+      }
+    }
+
+    int64_t prevTs = *(int64_t*)colDataGetData(p1, i - 1);
+    int64_t curTs = *(int64_t*)colDataGetData(p1, i);
+    ASSERT_GE(prevTs, curTs);
+    if (prevTs != curTs) {
+      continue;
+    }
+
+    prevNull = colDataIsNull_f(p2->nullbitmap, i - 1);
+    curNull = colDataIsNull_f(p2->nullbitmap, i);
+    ASSERT_FALSE(prevNull && !curNull);
+    if (!prevNull && !curNull) {
+      ASSERT_LT(*(int32_t*)colDataGetData(p2, i - 1), *(int32_t*)colDataGetData(p2, i));
+    }
+  }
+
+  blockDataDestroy(b);
+  taosArrayDestroy(pOrderInfo);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
@@ -867,4 +957,122 @@ TEST(TaosSetSlowLogScopeTest, MixedScopesInputWithSpaces) {
   EXPECT_EQ(scope, (SLOW_LOG_TYPE_QUERY | SLOW_LOG_TYPE_INSERT | SLOW_LOG_TYPE_OTHERS));
 }
 
+namespace {
+
+void explainRspInit(SExplainRsp* pRsp, int32_t numOfPlans) {
+  pRsp->numOfPlans = numOfPlans;
+  pRsp->subplanInfo = (SExplainExecInfo*)taosMemoryCalloc(numOfPlans, sizeof(SExplainExecInfo));
+  for (int32_t i = 0; i < numOfPlans; ++i) {
+    SExplainExecInfo* pInfo = &pRsp->subplanInfo[i];
+    pInfo->startupCost = 0.5 + i;
+    pInfo->totalCost = 10.25 + i;
+    pInfo->numOfRows = 1000 + i;
+    pInfo->verboseLen = 8;
+    pInfo->verboseInfo = taosMemoryCalloc(1, pInfo->verboseLen);
+    memset(pInfo->verboseInfo, 'a' + i, pInfo->verboseLen);
+
+    SExplainProfInfo* prof = &pInfo->prof;
+    prof->inputRows = 100 * i + 1;
+    prof->inputBlocks = 100 * i + 2;
+    prof->loadBlocks = 100 * i + 3;
+    prof->skipBlocks = 100 * i + 4;
+    prof->loadBytes = 100 * i + 5;
+    prof->loadTime = 1.5 * i;
+    prof->filterTime = 2.5 * i;
+    prof->aggTime = 3.5 * i;
+    prof->hashProbes = 100 * i + 6;
+    prof->hashMatchRows = 100 * i + 7;
+  }
+}
+
+void explainRspCheck(const SExplainRsp* pExpect, const SExplainRsp* pRsp, bool withProf) {
+  ASSERT_EQ(pRsp->numOfPlans, pExpect->numOfPlans);
+  for (int32_t i = 0; i < pRsp->numOfPlans; ++i) {
+    const SExplainExecInfo* pExpectInfo = &pExpect->subplanInfo[i];
+    const SExplainExecInfo* pInfo = &pRsp->subplanInfo[i];
+    EXPECT_EQ(pInfo->startupCost, pExpectInfo->startupCost);
+    EXPECT_EQ(pInfo->totalCost, pExpectInfo->totalCost);
+    EXPECT_EQ(pInfo->numOfRows, pExpectInfo->numOfRows);
+    ASSERT_EQ(pInfo->verboseLen, pExpectInfo->verboseLen);
+    EXPECT_EQ(memcmp(pInfo->verboseInfo, pExpectInfo->verboseInfo, pInfo->verboseLen), 0);
+
+    SExplainProfInfo empty = {0};
+    EXPECT_EQ(memcmp(&pInfo->prof, withProf ? &pExpectInfo->prof : &empty, sizeof(SExplainProfInfo)), 0);
+  }
+}
+
+// the response of a peer that does not know the profile section
+int32_t explainRspSerializeWithoutProf(void* buf, int32_t bufLen, SExplainRsp* pRsp) {
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, (uint8_t*)buf, bufLen);
+  EXPECT_EQ(tStartEncode(&encoder), 0);
+  EXPECT_EQ(tEncodeI32(&encoder, pRsp->numOfPlans), 0);
+  for (int32_t i = 0; i < pRsp->numOfPlans; ++i) {
+    SExplainExecInfo* pInfo = &pRsp->subplanInfo[i];
+    EXPECT_EQ(tEncodeDouble(&encoder, pInfo->startupCost), 0);
+    EXPECT_EQ(tEncodeDouble(&encoder, pInfo->totalCost), 0);
+    EXPECT_EQ(tEncodeU64(&encoder, pInfo->numOfRows), 0);
+    EXPECT_EQ(tEncodeU32(&encoder, pInfo->verboseLen), 0);
+    EXPECT_EQ(tEncodeBinary(&encoder, (const uint8_t*)pInfo->verboseInfo, pInfo->verboseLen), 0);
+  }
+  tEndEncode(&encoder);
+  int32_t tlen = encoder.pos;
+  tEncoderClear(&encoder);
+  return tlen;
+}
+
+}  // namespace
+
+TEST(explainRspTest, roundTripWithProf) {
+  SExplainRsp rsp = {0};
+  explainRspInit(&rsp, 3);
+
+  int32_t len = tSerializeSExplainRsp(NULL, 0, &rsp);
+  ASSERT_GT(len, 0);
+  void* buf = taosMemoryMalloc(len);
+  ASSERT_EQ(tSerializeSExplainRsp(buf, len, &rsp), len);
+
+  SExplainRsp res = {0};
+  ASSERT_EQ(tDeserializeSExplainRsp(buf, len, &res), 0);
+  explainRspCheck(&rsp, &res, true);
+
+  tFreeSExplainRsp(&res);
+  tFreeSExplainRsp(&rsp);
+  taosMemoryFree(buf);
+}
+
+TEST(explainRspTest, roundTripWithoutProf) {
+  SExplainRsp rsp = {0};
+  explainRspInit(&rsp, 2);
+
+  int32_t len = explainRspSerializeWithoutProf(NULL, 0, &rsp);
+  ASSERT_GT(len, 0);
+  ASSERT_LT(len, tSerializeSExplainRsp(NULL, 0, &rsp));
+  void* buf = taosMemoryMalloc(len);
+  ASSERT_EQ(explainRspSerializeWithoutProf(buf, len, &rsp), len);
+
+  // the profile section is optional, the counters are left zero
+  SExplainRsp res = {0};
+  ASSERT_EQ(tDeserializeSExplainRsp(buf, len, &res), 0);
+  explainRspCheck(&rsp, &res, false);
+
+  tFreeSExplainRsp(&res);
+  tFreeSExplainRsp(&rsp);
+  taosMemoryFree(buf);
+}
+
+TEST(explainRspTest, roundTripNoPlan) {
+  SExplainRsp rsp = {0};
+  int32_t     len = tSerializeSExplainRsp(NULL, 0, &rsp);
+  ASSERT_GT(len, 0);
+  void* buf = taosMemoryMalloc(len);
+  ASSERT_EQ(tSerializeSExplainRsp(buf, len, &rsp), len);
+
+  SExplainRsp res = {0};
+  ASSERT_EQ(tDeserializeSExplainRsp(buf, len, &res), 0);
+  EXPECT_EQ(res.numOfPlans, 0);
+  EXPECT_EQ(res.subplanInfo, nullptr);
+  taosMemoryFree(buf);
+}
+
 #pragma GCC diagnostic pop
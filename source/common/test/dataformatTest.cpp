@@ -563,6 +563,58 @@ TEST(testCase, StreamWithLongStbName) {
   taosMemoryFree(stbName);
 }
 
+static void checkColDataCompress(int32_t nDistinct, bool allowDict, bool expectDict) {
+  const int32_t nRows = 4096;
+  SColData      colData = {0};
+  SColData      outData = {0};
+  char          buf[32];
+
+  tColDataInit(&colData, 2, TSDB_DATA_TYPE_VARCHAR, 0);
+  for (int32_t i = 0; i < nRows; ++i) {
+    SColVal cv = COL_VAL_NULL(2, TSDB_DATA_TYPE_VARCHAR);
+    if (i % 7 != 0) {
+      int32_t len = snprintf(buf, sizeof(buf), "model-%d", i % nDistinct);
+      cv = COL_VAL_VALUE(2, ((SValue){.type = TSDB_DATA_TYPE_VARCHAR, .pData = (uint8_t *)buf, .nData = (uint32_t)len}));
+    }
+    ASSERT_EQ(tColDataAppendValue(&colData, &cv), 0);
+  }
+
+  SBuffer              output;
+  SColDataCompressInfo info = {.cmprAlg = ONE_STAGE_COMP, .allowDict = allowDict};
+  tBufferInit(&output);
+  ASSERT_EQ(tColDataCompress(&colData, &info, &output, NULL), 0);
+  ASSERT_EQ((info.columnFlag & COL_DICT_ENC) != 0, expectDict);
+
+  ASSERT_EQ(tColDataDecompress(output.data, &info, &outData, NULL), 0);
+  ASSERT_EQ(outData.cflag & COL_DICT_ENC, 0);
+  ASSERT_EQ(outData.nVal, colData.nVal);
+  ASSERT_EQ(outData.nData, colData.nData);
+  for (int32_t i = 0; i < nRows; ++i) {
+    SColVal cv1, cv2;
+    tColDataGetValue(&colData, i, &cv1);
+    tColDataGetValue(&outData, i, &cv2);
+    ASSERT_EQ(cv1.flag, cv2.flag);
+    if (COL_VAL_IS_VALUE(&cv1)) {
+      ASSERT_EQ(cv1.value.nData, cv2.value.nData);
+      ASSERT_EQ(memcmp(cv1.value.pData, cv2.value.pData, cv1.value.nData), 0);
+    }
+  }
+
+  tBufferDestroy(&output);
+  tColDataDestroy(&colData);
+  tColDataDestroy(&outData);
+}
+
+TEST(testCase, ColDataDictCompressTest) {
+  checkColDataCompress(1, true, true);
+  checkColDataCompress(37, true, true);
+  checkColDataCompress(4000, true, false);
+
+  // blocks of the older format versions never carry a dictionary
+  checkColDataCompress(1, false, false);
+  checkColDataCompress(37, false, false);
+}
+
 #if 1
 TEST(testCase, NoneTest) {
   const static int nCols = 14;
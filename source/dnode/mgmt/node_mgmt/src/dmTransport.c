@@ -398,6 +398,8 @@ int32_t dmInitClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
   rpcInit.dfp = destroyAhandle;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
@@ -452,6 +454,8 @@ int32_t dmInitStatusClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
   rpcInit.retryStepFactor = tsRedirectFactor;
@@ -502,6 +506,8 @@ int32_t dmInitSyncClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
   rpcInit.retryStepFactor = tsRedirectFactor;
@@ -577,6 +583,8 @@ int32_t dmInitServer(SDnode *pDnode) {
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.parent = pDnode;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
   rpcInit.shareConnLimit = tsShareConnLimit * 16;
 
   if (taosVersionStrToInt(version, &(rpcInit.compatibilityVer)) != 0) {
@@ -193,6 +193,8 @@ void    tsdbCacheSetCapacity(SVnode *pVnode, size_t capacity);
 size_t  tsdbCacheGetCapacity(SVnode *pVnode);
 size_t  tsdbCacheGetUsage(SVnode *pVnode);
 int32_t tsdbCacheGetElems(SVnode *pVnode);
+size_t  tsdbSmaCacheGetUsage(SVnode *pVnode);
+int32_t tsdbSmaCacheGetElems(SVnode *pVnode);
 
 //// tq
 typedef struct SIdInfo {
@@ -370,6 +370,7 @@ struct STsdb {
   TdThreadMutex        bMutex;
   SLRUCache           *pgCache;
   TdThreadMutex        pgMutex;
+  SLRUCache           *smaCache;
   struct STFileSystem *pFS;  // new
   SRocksCache          rCache;
   SCompMonitor        *pCompMonitor;
@@ -653,6 +654,7 @@ typedef struct {
   int64_t     pgno;
   uint8_t    *pBuf;
   int64_t     szFile;
+  int64_t     szSynced;  // # of pages when the file was last synced
   STsdb      *pTsdb;
   const char *objName;
   uint8_t     s3File;
@@ -952,6 +954,16 @@ int32_t tsdbCacheGetBlockS3(SLRUCache *pCache, STsdbFD *pFD, LRUHandle **handle)
 int32_t tsdbCacheGetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, LRUHandle **handle);
 void    tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *pPage);
 
+// block sma of data files, keyed by (fid, commit id, sma offset) so a rewritten file never hits stale entries
+typedef struct {
+  int32_t        numOfAggs;
+  SColumnDataAgg aggs[];
+} SSmaCacheEntry;
+
+int32_t tsdbCacheGetBlockSma(SLRUCache *pCache, int32_t fid, int64_t cid, int64_t offset, LRUHandle **handle);
+void    tsdbCacheSetBlockSma(SLRUCache *pCache, int32_t fid, int64_t cid, int64_t offset, const SColumnDataAgg *pAggs,
+                             int32_t numOfAggs);
+
 int32_t tsdbCacheDeleteLastrow(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDeleteLast(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDelete(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
@@ -105,6 +105,41 @@ static void tsdbClosePgCache(STsdb *pTsdb) {
   }
 }
 
+static int32_t tsdbOpenSmaCache(STsdb *pTsdb) {
+  int32_t code = 0, lino = 0;
+
+  if (tsSmaCacheSize <= 0) {
+    TAOS_RETURN(code);
+  }
+
+  SLRUCache *pCache = taosLRUCacheInit((int64_t)tsSmaCacheSize * 1024 * 1024, 0, .5);
+  if (pCache == NULL) {
+    TAOS_CHECK_GOTO(TSDB_CODE_OUT_OF_MEMORY, &lino, _err);
+  }
+
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  pTsdb->smaCache = pCache;
+
+_err:
+  if (code) {
+    tsdbError("tsdb/smacache: vgId:%d, open failed at line %d since %s.", TD_VID(pTsdb->pVnode), lino, tstrerror(code));
+  }
+
+  TAOS_RETURN(code);
+}
+
+static void tsdbCloseSmaCache(STsdb *pTsdb) {
+  SLRUCache *pCache = pTsdb->smaCache;
+  if (pCache) {
+    taosLRUCacheEraseUnrefEntries(pCache);
+
+    taosLRUCacheCleanup(pCache);
+
+    pTsdb->smaCache = NULL;
+  }
+}
+
 #define ROCKS_KEY_LEN (sizeof(tb_uid_t) + sizeof(int16_t) + sizeof(int8_t))
 
 enum {
@@ -2029,6 +2064,8 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
 
   TAOS_CHECK_GOTO(tsdbOpenRocksCache(pTsdb), &lino, _err);
 
+  TAOS_CHECK_GOTO(tsdbOpenSmaCache(pTsdb), &lino, _err);
+
   taosLRUCacheSetStrictCapacity(pCache, false);
 
   (void)taosThreadMutexInit(&pTsdb->lruMutex, NULL);
@@ -2056,6 +2093,7 @@ void tsdbCloseCache(STsdb *pTsdb) {
   tsdbCloseBCache(pTsdb);
   tsdbClosePgCache(pTsdb);
   tsdbCloseRocksCache(pTsdb);
+  tsdbCloseSmaCache(pTsdb);
 }
 
 static void getTableCacheKey(tb_uid_t uid, int cacheType, char *key, int *len) {
@@ -3493,6 +3531,24 @@ int32_t tsdbCacheGetElems(SVnode *pVnode) {
   return elems;
 }
 
+size_t tsdbSmaCacheGetUsage(SVnode *pVnode) {
+  size_t usage = 0;
+  if (pVnode->pTsdb != NULL && pVnode->pTsdb->smaCache != NULL) {
+    usage = taosLRUCacheGetUsage(pVnode->pTsdb->smaCache);
+  }
+
+  return usage;
+}
+
+int32_t tsdbSmaCacheGetElems(SVnode *pVnode) {
+  int32_t elems = 0;
+  if (pVnode->pTsdb != NULL && pVnode->pTsdb->smaCache != NULL) {
+    elems = taosLRUCacheGetElems(pVnode->pTsdb->smaCache);
+  }
+
+  return elems;
+}
+
 // block cache
 static void getBCacheKey(int32_t fid, int64_t commitID, int64_t blkno, char *key, int *len) {
   struct {
@@ -3612,3 +3668,42 @@ void tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *
 
   tsdbCacheRelease(pFD->pTsdb->pgCache, handle);
 }
+
+// block sma cache
+int32_t tsdbCacheGetBlockSma(SLRUCache *pCache, int32_t fid, int64_t cid, int64_t offset, LRUHandle **handle) {
+  int32_t code = 0;
+  char    key[128] = {0};
+  int     keyLen = 0;
+
+  getBCacheKey(fid, cid, offset, key, &keyLen);
+  *handle = taosLRUCacheLookup(pCache, key, keyLen);
+
+  return code;
+}
+
+void tsdbCacheSetBlockSma(SLRUCache *pCache, int32_t fid, int64_t cid, int64_t offset, const SColumnDataAgg *pAggs,
+                          int32_t numOfAggs) {
+  char       key[128] = {0};
+  int        keyLen = 0;
+  LRUHandle *handle = NULL;
+
+  getBCacheKey(fid, cid, offset, key, &keyLen);
+
+  size_t          charge = sizeof(SSmaCacheEntry) + numOfAggs * sizeof(SColumnDataAgg);
+  SSmaCacheEntry *pEntry = taosMemoryMalloc(charge);
+  if (!pEntry) {
+    return;  // the cache is only a shortcut of the sma file, ignore the error
+  }
+  pEntry->numOfAggs = numOfAggs;
+  memcpy(pEntry->aggs, pAggs, numOfAggs * sizeof(SColumnDataAgg));
+
+  LRUStatus status =
+      taosLRUCacheInsert(pCache, key, keyLen, pEntry, charge, deleteBCache, NULL, &handle, TAOS_LRU_PRIORITY_LOW, NULL);
+  if (status != TAOS_LRU_STATUS_OK) {
+    // ignore cache updating if not ok
+  }
+
+  if (handle) {
+    tsdbCacheRelease(pCache, handle);
+  }
+}
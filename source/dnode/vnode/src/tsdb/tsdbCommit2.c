@@ -328,8 +328,11 @@ static int32_t tsdbCommitFileSetBegin(SCommitter2 *committer) {
   tsdbFidKeyRange(committer->ctx->info->fid, committer->minutes, committer->precision, &committer->ctx->minKey,
                   &committer->ctx->maxKey);
 
-  TAOS_CHECK_GOTO(tfsAllocDisk(committer->tsdb->pVnode->pTfs, committer->ctx->expLevel, &committer->ctx->did), &lino,
-                  _exit);
+  // commits land in stt files unless sttTrigger is 1, keep them on the fast disks of the tier
+  ETfsFileTemp temp = (committer->sttTrigger == 1) ? TFS_FILE_WARM : TFS_FILE_HOT;
+  TAOS_CHECK_GOTO(
+      tfsAllocDiskByTemp(committer->tsdb->pVnode->pTfs, committer->ctx->expLevel, temp, &committer->ctx->did), &lino,
+      _exit);
 
   if (tfsMkdirRecurAt(committer->tsdb->pVnode->pTfs, committer->tsdb->path, committer->ctx->did) != 0) {
     tsdbError("vgId:%d failed to create directory %s", TD_VID(committer->tsdb->pVnode), committer->tsdb->path);
@@ -513,12 +513,27 @@ _exit:
 
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray) {
-  int32_t  code = 0;
-  int32_t  lino = 0;
-  SBuffer *buffer = reader->buffers + 0;
+  int32_t    code = 0;
+  int32_t    lino = 0;
+  SBuffer   *buffer = reader->buffers + 0;
+  SLRUCache *pCache = reader->config->tsdb->smaCache;
+  STFile    *pFile = &reader->config->files[TSDB_FTYPE_SMA].file;
 
   TARRAY2_CLEAR(columnDataAggArray, NULL);
   if (record->smaSize > 0) {
+    // dashboards aggregate the same blocks again and again, reuse the decoded sma of immutable files
+    if (pCache) {
+      LRUHandle *h = NULL;
+      TAOS_CHECK_GOTO(tsdbCacheGetBlockSma(pCache, pFile->fid, pFile->cid, record->smaOffset, &h), &lino, _exit);
+      if (h) {
+        SSmaCacheEntry *pEntry = taosLRUCacheValue(pCache, h);
+        code = TARRAY2_APPEND_BATCH(columnDataAggArray, pEntry->aggs, pEntry->numOfAggs);
+        tsdbCacheRelease(pCache, h);
+        TSDB_CHECK_CODE(code, lino, _exit);
+        goto _exit;
+      }
+    }
+
     tBufferClear(buffer);
     int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
     char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
@@ -537,6 +552,11 @@ int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *rec
     if (br.offset != record->smaSize) {
       TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
     }
+
+    if (pCache) {
+      tsdbCacheSetBlockSma(pCache, pFile->fid, pFile->cid, record->smaOffset, TARRAY2_DATA(columnDataAggArray),
+                           TARRAY2_SIZE(columnDataAggArray));
+    }
   }
 
 _exit:
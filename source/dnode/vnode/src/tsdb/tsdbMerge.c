@@ -268,7 +268,8 @@ static int32_t tsdbMergeFileSetBeginOpenWriter(SMerger *merger) {
   SDiskID did;
   int32_t level = tsdbFidLevel(merger->ctx->fset->fid, &merger->tsdb->keepCfg, merger->ctx->now);
 
-  TAOS_CHECK_GOTO(tfsAllocDisk(merger->tsdb->pVnode->pTfs, level, &did), &lino, _exit);
+  ETfsFileTemp temp = merger->ctx->toData ? TFS_FILE_WARM : TFS_FILE_HOT;
+  TAOS_CHECK_GOTO(tfsAllocDiskByTemp(merger->tsdb->pVnode->pTfs, level, temp, &did), &lino, _exit);
 
   code = tfsMkdirRecurAt(merger->tsdb->pVnode->pTfs, merger->tsdb->path, did);
   TSDB_CHECK_CODE(code, lino, _exit);
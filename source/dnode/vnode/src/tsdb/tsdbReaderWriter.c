@@ -81,6 +81,7 @@ static int32_t tsdbOpenFileImpl(STsdbFD *pFD) {
     TSDB_CHECK_CODE(code = TSDB_CODE_INVALID_PARA, lino, _exit);
   }
   pFD->szFile = pFD->szFile / szPage;
+  pFD->szSynced = pFD->szFile;
 
 _exit:
   if (code) {
@@ -569,10 +570,18 @@ int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey)
   code = tsdbWriteFilePage(pFD, encryptAlgorithm, encryptKey);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  int64_t stime = taosGetTimestampUs();
   if (taosFsyncFile(pFD->pFD) < 0) {
     TSDB_CHECK_CODE(code = TAOS_SYSTEM_ERROR(errno), lino, _exit);
   }
 
+  // feed the sync cost back to tfs so that new files avoid slow disks
+  if (pFD->szFile > pFD->szSynced) {
+    tfsRecordWrite(pFD->pTsdb->pVnode->pTfs, pFD->path, (pFD->szFile - pFD->szSynced) * pFD->szPage,
+                   taosGetTimestampUs() - stime);
+    pFD->szSynced = pFD->szFile;
+  }
+
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(pFD->pTsdb->pVnode), lino, code);
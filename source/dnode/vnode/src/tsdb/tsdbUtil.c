@@ -399,6 +399,7 @@ int32_t tGetSttBlk(uint8_t *p, void *ph) {
 // SBlockCol ======================================================
 
 static const int32_t BLOCK_WITH_ALG_VER = 2;
+static const int32_t BLOCK_WITH_DICT_VER = 3;
 
 int32_t tPutBlockCol(SBuffer *buffer, const SBlockCol *pBlockCol, int32_t ver, uint32_t defaultCmprAlg) {
   int32_t code;
@@ -1391,7 +1392,7 @@ int32_t tBlockDataCompress(SBlockData *bData, void *pCompr, SBuffer *buffers, SB
 
   SDiskDataHdr hdr = {
       .delimiter = TSDB_FILE_DLMT,
-      .fmtVer = 2,
+      .fmtVer = BLOCK_WITH_DICT_VER,
       .suid = bData->suid,
       .uid = bData->uid,
       .szUid = 0,     // filled by compress key
@@ -1423,6 +1424,7 @@ int32_t tBlockDataCompress(SBlockData *bData, void *pCompr, SBuffer *buffers, SB
 
     SColDataCompressInfo cinfo = {
         .cmprAlg = pInfo->defaultCmprAlg,
+        .allowDict = (hdr.fmtVer >= BLOCK_WITH_DICT_VER),
     };
     code = tsdbGetColCmprAlgFromSet(pInfo->pColCmpr, colData->cid, &cinfo.cmprAlg);
     if (code < 0) {
@@ -1509,10 +1511,8 @@ int32_t tPutDiskDataHdr(SBuffer *buffer, const SDiskDataHdr *pHdr) {
   if ((code = tBufferPutI32v(buffer, pHdr->nRow))) return code;
   if (pHdr->fmtVer < 2) {
     if ((code = tBufferPutI8(buffer, pHdr->cmprAlg))) return code;
-  } else if (pHdr->fmtVer == 2) {
-    if ((code = tBufferPutU32(buffer, pHdr->cmprAlg))) return code;
   } else {
-    // more data fmt ver
+    if ((code = tBufferPutU32(buffer, pHdr->cmprAlg))) return code;
   }
   if (pHdr->fmtVer >= 1) {
     if ((code = tBufferPutI8(buffer, pHdr->numOfPKs))) return code;
@@ -1540,10 +1540,8 @@ int32_t tGetDiskDataHdr(SBufferReader *br, SDiskDataHdr *pHdr) {
     int8_t cmprAlg = 0;
     if ((code = tBufferGetI8(br, &cmprAlg))) return code;
     pHdr->cmprAlg = cmprAlg;
-  } else if (pHdr->fmtVer == 2) {
-    if ((code = tBufferGetU32(br, &pHdr->cmprAlg))) return code;
   } else {
-    // more data fmt ver
+    if ((code = tBufferGetU32(br, &pHdr->cmprAlg))) return code;
   }
   if (pHdr->fmtVer >= 1) {
     if ((code = tBufferGetI8(br, &pHdr->numOfPKs))) return code;
@@ -1673,6 +1671,11 @@ int32_t tBlockDataDecompressColData(const SDiskDataHdr *hdr, const SBlockCol *bl
 
   SColData *colData;
 
+  // a dictionary encoded column only comes with a block of the dictionary format version
+  if ((blockCol->cflag & COL_DICT_ENC) && hdr->fmtVer < BLOCK_WITH_DICT_VER) {
+    TSDB_CHECK_CODE(code = TSDB_CODE_FILE_CORRUPTED, lino, _exit);
+  }
+
   code = tBlockDataAddColData(blockData, blockCol->cid, blockCol->type, blockCol->cflag, &colData);
   TSDB_CHECK_CODE(code, lino, _exit);
 
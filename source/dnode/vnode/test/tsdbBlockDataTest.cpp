@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tsdb.h"
+#include "tsdbDef.h"
+
+namespace {
+
+const int32_t blockTestRows = 4096;
+
+// a child table block of a ts column, a low cardinality varchar column and an int column
+void buildTestBlockData(SBlockData* bData) {
+  ASSERT_EQ(tBlockDataCreate(bData), 0);
+  bData->suid = 1;
+  bData->uid = 2;
+  bData->nRow = blockTestRows;
+  ASSERT_EQ(tRealloc((uint8_t**)&bData->aVersion, sizeof(int64_t) * blockTestRows), 0);
+  ASSERT_EQ(tRealloc((uint8_t**)&bData->aTSKEY, sizeof(TSKEY) * blockTestRows), 0);
+
+  SColData* pVarCol = NULL;
+  SColData* pIntCol = NULL;
+  ASSERT_EQ(tBlockDataAddColData(bData, 2, TSDB_DATA_TYPE_VARCHAR, 0, &pVarCol), 0);
+  ASSERT_EQ(tBlockDataAddColData(bData, 3, TSDB_DATA_TYPE_INT, 0, &pIntCol), 0);
+
+  char buf[32];
+  for (int32_t i = 0; i < blockTestRows; ++i) {
+    bData->aVersion[i] = 100 + i;
+    bData->aTSKEY[i] = 1700000000000LL + i;
+
+    SColVal cv = COL_VAL_NULL(2, TSDB_DATA_TYPE_VARCHAR);
+    if (i % 7 != 0) {
+      SValue value = {0};
+      value.type = TSDB_DATA_TYPE_VARCHAR;
+      value.pData = (uint8_t*)buf;
+      value.nData = snprintf(buf, sizeof(buf), "device-%d", i % 13);
+      cv = COL_VAL_VALUE(2, value);
+    }
+    ASSERT_EQ(tColDataAppendValue(pVarCol, &cv), 0);
+
+    SValue value = {0};
+    value.type = TSDB_DATA_TYPE_INT;
+    value.val = i;
+    cv = COL_VAL_VALUE(3, value);
+    ASSERT_EQ(tColDataAppendValue(pIntCol, &cv), 0);
+  }
+}
+
+// compress the block as the writer does and join the parts in the order they are laid out on disk
+void compressTestBlockData(SBlockData* bData, SBuffer* pOutput, SDiskDataHdr* pHdr, std::vector<SBlockCol>* pCols) {
+  SColCompressInfo info = {0};
+  SBuffer          buffers[4];
+  SBuffer          assist;
+  info.defaultCmprAlg = ONE_STAGE_COMP;
+  for (int32_t i = 0; i < 4; ++i) {
+    tBufferInit(&buffers[i]);
+  }
+  tBufferInit(&assist);
+
+  ASSERT_EQ(tBlockDataCompress(bData, &info, buffers, &assist), 0);
+  tBufferClear(pOutput);
+  for (int32_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(tBufferPut(pOutput, buffers[i].data, buffers[i].size), 0);
+  }
+
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, &buffers[0]);
+  ASSERT_EQ(tGetDiskDataHdr(&br, pHdr), 0);
+  br = BUFFER_READER_INITIALIZER(0, &buffers[2]);
+  while (br.offset < buffers[2].size) {
+    SBlockCol blockCol;
+    ASSERT_EQ(tGetBlockCol(&br, &blockCol, pHdr->fmtVer, pHdr->cmprAlg), 0);
+    pCols->push_back(blockCol);
+  }
+
+  for (int32_t i = 0; i < 4; ++i) {
+    tBufferDestroy(&buffers[i]);
+  }
+  tBufferDestroy(&assist);
+}
+
+// the layout of a block written before the dictionary format: same key part, plain columns and a version 2 header
+void compressTestBlockDataV2(SBlockData* bData, SBuffer* pOutput) {
+  SBuffer      hdrBuf, keyBuf, colBuf, dataBuf;
+  SDiskDataHdr hdr;
+  std::vector<SBlockCol> cols;
+  tBufferInit(&hdrBuf);
+  tBufferInit(&colBuf);
+  tBufferInit(&dataBuf);
+  tBufferInit(&keyBuf);
+
+  compressTestBlockData(bData, pOutput, &hdr, &cols);
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, pOutput);
+  ASSERT_EQ(tGetDiskDataHdr(&br, &hdr), 0);
+  ASSERT_EQ(tBufferPut(&keyBuf, (uint8_t*)pOutput->data + br.offset, hdr.szUid + hdr.szVer + hdr.szKey), 0);
+
+  hdr.fmtVer = 2;
+  for (int32_t i = 0; i < bData->nColData; ++i) {
+    SColData*            colData = tBlockDataGetColDataByIdx(bData, i);
+    SColDataCompressInfo cinfo = {0};
+    cinfo.cmprAlg = hdr.cmprAlg;
+
+    int32_t offset = dataBuf.size;
+    ASSERT_EQ(tColDataCompress(colData, &cinfo, &dataBuf, NULL), 0);
+    ASSERT_EQ(cinfo.columnFlag & COL_DICT_ENC, 0);
+
+    SBlockCol blockCol = {0};
+    blockCol.cid = cinfo.columnId;
+    blockCol.type = cinfo.dataType;
+    blockCol.cflag = cinfo.columnFlag;
+    blockCol.flag = cinfo.flag;
+    blockCol.szOrigin = cinfo.dataOriginalSize;
+    blockCol.szBitmap = cinfo.bitmapCompressedSize;
+    blockCol.szOffset = cinfo.offsetCompressedSize;
+    blockCol.szValue = cinfo.dataCompressedSize;
+    blockCol.offset = offset;
+    blockCol.alg = cinfo.cmprAlg;
+    ASSERT_EQ(tPutBlockCol(&colBuf, &blockCol, hdr.fmtVer, hdr.cmprAlg), 0);
+  }
+  hdr.szBlkCol = colBuf.size;
+  ASSERT_EQ(tPutDiskDataHdr(&hdrBuf, &hdr), 0);
+
+  tBufferClear(pOutput);
+  ASSERT_EQ(tBufferPut(pOutput, hdrBuf.data, hdrBuf.size), 0);
+  ASSERT_EQ(tBufferPut(pOutput, keyBuf.data, keyBuf.size), 0);
+  ASSERT_EQ(tBufferPut(pOutput, colBuf.data, colBuf.size), 0);
+  ASSERT_EQ(tBufferPut(pOutput, dataBuf.data, dataBuf.size), 0);
+
+  tBufferDestroy(&hdrBuf);
+  tBufferDestroy(&keyBuf);
+  tBufferDestroy(&colBuf);
+  tBufferDestroy(&dataBuf);
+}
+
+void checkTestBlockData(SBlockData* pExpect, SBlockData* bData) {
+  ASSERT_EQ(bData->suid, pExpect->suid);
+  ASSERT_EQ(bData->uid, pExpect->uid);
+  ASSERT_EQ(bData->nRow, pExpect->nRow);
+  ASSERT_EQ(memcmp(bData->aVersion, pExpect->aVersion, sizeof(int64_t) * bData->nRow), 0);
+  ASSERT_EQ(memcmp(bData->aTSKEY, pExpect->aTSKEY, sizeof(TSKEY) * bData->nRow), 0);
+  ASSERT_EQ(bData->nColData, pExpect->nColData);
+
+  for (int32_t c = 0; c < bData->nColData; ++c) {
+    SColData* pExpCol = tBlockDataGetColDataByIdx(pExpect, c);
+    SColData* pCol = tBlockDataGetColDataByIdx(bData, c);
+    ASSERT_EQ(pCol->cid, pExpCol->cid);
+    ASSERT_EQ(pCol->cflag & COL_DICT_ENC, 0);
+    ASSERT_EQ(pCol->nVal, pExpCol->nVal);
+    for (int32_t i = 0; i < pExpCol->nVal; ++i) {
+      SColVal cv1, cv2;
+      tColDataGetValue(pExpCol, i, &cv1);
+      tColDataGetValue(pCol, i, &cv2);
+      ASSERT_EQ(cv1.flag, cv2.flag);
+      if (!COL_VAL_IS_VALUE(&cv1)) {
+        continue;
+      }
+      if (IS_VAR_DATA_TYPE(cv1.value.type)) {
+        ASSERT_EQ(cv1.value.nData, cv2.value.nData);
+        ASSERT_EQ(memcmp(cv1.value.pData, cv2.value.pData, cv1.value.nData), 0);
+      } else {
+        ASSERT_EQ(cv1.value.val, cv2.value.val);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(tsdbBlockDataTest, dictFormatRoundTrip) {
+  SBlockData             bData, outData;
+  SBuffer                output;
+  SDiskDataHdr           hdr;
+  std::vector<SBlockCol> cols;
+  tBufferInit(&output);
+  buildTestBlockData(&bData);
+  ASSERT_EQ(tBlockDataCreate(&outData), 0);
+
+  compressTestBlockData(&bData, &output, &hdr, &cols);
+  EXPECT_EQ(hdr.fmtVer, 3);
+  ASSERT_EQ(cols.size(), 2);
+  EXPECT_NE(cols[0].cflag & COL_DICT_ENC, 0);
+  EXPECT_EQ(cols[1].cflag & COL_DICT_ENC, 0);
+
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, &output);
+  ASSERT_EQ(tBlockDataDecompress(&br, &outData, NULL), 0);
+  EXPECT_EQ(br.offset, output.size);
+  checkTestBlockData(&bData, &outData);
+
+  tBlockDataDestroy(&bData);
+  tBlockDataDestroy(&outData);
+  tBufferDestroy(&output);
+}
+
+TEST(tsdbBlockDataTest, readFormatV2Block) {
+  SBlockData bData, outData;
+  SBuffer    output;
+  tBufferInit(&output);
+  buildTestBlockData(&bData);
+  ASSERT_EQ(tBlockDataCreate(&outData), 0);
+
+  compressTestBlockDataV2(&bData, &output);
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, &output);
+  SDiskDataHdr  hdr;
+  ASSERT_EQ(tGetDiskDataHdr(&br, &hdr), 0);
+  EXPECT_EQ(hdr.fmtVer, 2);
+
+  br = BUFFER_READER_INITIALIZER(0, &output);
+  ASSERT_EQ(tBlockDataDecompress(&br, &outData, NULL), 0);
+  EXPECT_EQ(br.offset, output.size);
+  checkTestBlockData(&bData, &outData);
+
+  tBlockDataDestroy(&bData);
+  tBlockDataDestroy(&outData);
+  tBufferDestroy(&output);
+}
+
+TEST(tsdbBlockDataTest, rejectDictColumnInV2Block) {
+  SBlockData             bData, outData;
+  SBuffer                output, patched;
+  SDiskDataHdr           hdr;
+  std::vector<SBlockCol> cols;
+  tBufferInit(&output);
+  tBufferInit(&patched);
+  buildTestBlockData(&bData);
+  ASSERT_EQ(tBlockDataCreate(&outData), 0);
+
+  // a version 3 block whose header claims version 2, the dictionary column can not be trusted
+  compressTestBlockData(&bData, &output, &hdr, &cols);
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, &output);
+  ASSERT_EQ(tGetDiskDataHdr(&br, &hdr), 0);
+  uint32_t hdrSize = br.offset;
+
+  hdr.fmtVer = 2;
+  SBuffer colBuf;
+  tBufferInit(&colBuf);
+  for (auto& blockCol : cols) {
+    ASSERT_EQ(tPutBlockCol(&colBuf, &blockCol, hdr.fmtVer, hdr.cmprAlg), 0);
+  }
+  uint32_t keySize = hdr.szUid + hdr.szVer + hdr.szKey;
+  uint32_t colOffset = hdrSize + keySize + hdr.szBlkCol;
+  hdr.szBlkCol = colBuf.size;
+  ASSERT_EQ(tPutDiskDataHdr(&patched, &hdr), 0);
+  ASSERT_EQ(tBufferPut(&patched, (uint8_t*)output.data + hdrSize, keySize), 0);
+  ASSERT_EQ(tBufferPut(&patched, colBuf.data, colBuf.size), 0);
+  ASSERT_EQ(tBufferPut(&patched, (uint8_t*)output.data + colOffset, output.size - colOffset), 0);
+
+  br = BUFFER_READER_INITIALIZER(0, &patched);
+  EXPECT_EQ(tBlockDataDecompress(&br, &outData, NULL), TSDB_CODE_FILE_CORRUPTED);
+
+  tBlockDataDestroy(&bData);
+  tBlockDataDestroy(&outData);
+  tBufferDestroy(&output);
+  tBufferDestroy(&patched);
+  tBufferDestroy(&colBuf);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,884 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Standalone micro-benchmark of the tsdb read path.
+ *
+ * A single vnode is built offline: the super table, child tables, rows, out of order rows and delete tombstones are
+ * written straight through vnodeProcessWriteMsg, without dnode, sync or rpc, and committed in several rounds so the
+ * data ends up spread over data files and stt files. The reader is then driven directly for full scans, last/last_row
+ * cache scans, SMA only scans and filtered scans. The first loop of every scan is reported as cold, the rest as warm.
+ * Running the SMA only scan with "-m 0" and with a block SMA cache shows what the cache saves on repeated aggregations.
+ */
+
+#include "functionResInfo.h"
+#include "tcompare.h"
+#include "tfs.h"
+#include "tglobal.h"
+#include "vnd.h"
+#include "wal.h"
+
+#define BENCH_VGID           2
+#define BENCH_DB_NAME        "1.bench"
+#define BENCH_STB_NAME       "meters"
+#define BENCH_VNODE_PATH     "vnode/vnode2"
+#define BENCH_TS_STEP        1000
+#define BENCH_SUBMIT_ROWS    4096
+#define BENCH_CREATE_BATCH   1000
+#define BENCH_FILTER_MOD     1000
+#define BENCH_FILTER_VAL     100
+#define BENCH_NUM_OF_COLS    6
+#define BENCH_BINARY_LEN     16
+#define BENCH_MAX_OF_LOOPS   100
+
+typedef struct {
+  char    path[PATH_MAX];
+  int32_t numOfTables;
+  int32_t numOfRows;
+  int32_t numOfCommits;
+  int32_t sttTrigger;
+  int32_t disorder;
+  int32_t deletes;
+  int32_t loops;
+  int32_t maxRows;
+  int32_t bufferMB;
+  int32_t smaCacheMB;
+  int8_t  cacheLast;
+} SBenchCfg;
+
+typedef struct {
+  const char *name;
+  int32_t     loop;
+  int64_t     rows;
+  int64_t     qualified;
+  int64_t     blocks;
+  int64_t     loaded;
+  int64_t     elapsed;
+  SArray     *pLatency;  // SArray<int64_t>, us per block
+} SBenchStat;
+
+typedef struct {
+  SBenchCfg cfg;
+  STfs     *pTfs;
+  SVnode   *pVnode;
+  int64_t   suid;
+  int64_t   skey;
+  int64_t   rowsWritten;
+  STSchema *pTSchema;
+  SArray   *pTableList;  // SArray<STableKeyInfo>
+} SBench;
+
+static SSchema benchCols[BENCH_NUM_OF_COLS] = {
+    {.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = COL_SMA_ON, .colId = 1, .bytes = 8, .name = "ts"},
+    {.type = TSDB_DATA_TYPE_INT, .flags = COL_SMA_ON, .colId = 2, .bytes = 4, .name = "i"},
+    {.type = TSDB_DATA_TYPE_BIGINT, .flags = COL_SMA_ON, .colId = 3, .bytes = 8, .name = "b"},
+    {.type = TSDB_DATA_TYPE_DOUBLE, .flags = COL_SMA_ON, .colId = 4, .bytes = 8, .name = "d"},
+    {.type = TSDB_DATA_TYPE_FLOAT, .flags = COL_SMA_ON, .colId = 5, .bytes = 4, .name = "f"},
+    {.type = TSDB_DATA_TYPE_BINARY,
+     .flags = COL_SMA_ON,
+     .colId = 6,
+     .bytes = BENCH_BINARY_LEN + VARSTR_HEADER_SIZE,
+     .name = "s"},
+};
+
+static SSchema benchTags[] = {
+    {.type = TSDB_DATA_TYPE_INT, .flags = 0, .colId = BENCH_NUM_OF_COLS + 1, .bytes = 4, .name = "t1"},
+};
+
+static void benchInitLog(const char *path) {
+  const char   *defaultLogFileNamePrefix = "taoslog";
+  const int32_t maxLogFileNum = 10;
+
+  tsAsyncLog = 0;
+  snprintf(tsLogDir, PATH_MAX, "%s/log", path);
+  (void)taosMkDir(tsLogDir);
+
+  if (taosInitLog(defaultLogFileNamePrefix, maxLogFileNum, false) < 0) {
+    printf("failed to open log file in directory:%s\n", tsLogDir);
+  }
+}
+
+static void benchStopDnode() { printf("vnode asked to stop the dnode, ignored\n"); }
+
+static int32_t benchWriteMsg(SBench *pBench, tmsg_t msgType, void *pCont, int32_t contLen) {
+  SVnode *pVnode = pBench->pVnode;
+  SRpcMsg msg = {.msgType = msgType, .pCont = pCont, .contLen = contLen};
+  SRpcMsg rsp = {0};
+
+  SMsgHead *pHead = pCont;
+  pHead->vgId = htonl(TD_VID(pVnode));
+  pHead->contLen = htonl(contLen);
+
+  int32_t code = vnodePreProcessWriteMsg(pVnode, &msg);
+  if (code == 0) {
+    code = vnodeProcessWriteMsg(pVnode, &msg, pVnode->state.applied + 1, &rsp);
+  }
+  if (code == 0) {
+    code = rsp.code;
+  }
+
+  rpcFreeCont(rsp.pCont);
+  rpcFreeCont(pCont);
+  return code;
+}
+
+static int32_t benchCommit(SBench *pBench) {
+  int32_t code = vnodeSyncCommit(pBench->pVnode);
+  if (code == 0) {
+    code = vnodeBegin(pBench->pVnode);
+  }
+  return code;
+}
+
+static int32_t benchCreateStb(SBench *pBench) {
+  int32_t  code = 0;
+  int32_t  lino = 0;
+  int32_t  len = 0;
+  SEncoder encoder = {0};
+  SColCmpr cmpr[BENCH_NUM_OF_COLS] = {0};
+
+  for (int32_t i = 0; i < BENCH_NUM_OF_COLS; ++i) {
+    cmpr[i].id = benchCols[i].colId;
+    cmpr[i].alg = createDefaultColCmprByType(benchCols[i].type);
+  }
+
+  SVCreateStbReq req = {.name = BENCH_STB_NAME,
+                        .suid = pBench->suid,
+                        .schemaRow = {.nCols = BENCH_NUM_OF_COLS, .version = 1, .pSchema = benchCols},
+                        .schemaTag = {.nCols = tListLen(benchTags), .version = 1, .pSchema = benchTags},
+                        .colCmpred = 1,
+                        .colCmpr = {.nCols = BENCH_NUM_OF_COLS, .version = 1, .pColCmpr = cmpr}};
+
+  tEncodeSize(tEncodeSVCreateStbReq, &req, len, code);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  char *pCont = rpcMallocCont(sizeof(SMsgHead) + len);
+  TSDB_CHECK_NULL(pCont, code, lino, _exit, terrno);
+
+  tEncoderInit(&encoder, (uint8_t *)pCont + sizeof(SMsgHead), len);
+  code = tEncodeSVCreateStbReq(&encoder, &req);
+  tEncoderClear(&encoder);
+  if (code < 0) {
+    rpcFreeCont(pCont);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  code = benchWriteMsg(pBench, TDMT_VND_CREATE_STB, pCont, sizeof(SMsgHead) + len);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    printf("failed to create super table at line %d since %s\n", lino, tstrerror(code));
+  }
+  return code;
+}
+
+static int32_t benchCreateTables(SBench *pBench, int32_t start, int32_t num) {
+  int32_t            code = 0;
+  int32_t            lino = 0;
+  int32_t            len = 0;
+  SEncoder           encoder = {0};
+  SVCreateTbBatchReq req = {0};
+  SArray            *pTagVals = taosArrayInit(1, sizeof(STagVal));
+  SArray            *pTagName = taosArrayInit(1, TSDB_COL_NAME_LEN);
+
+  req.pArray = taosArrayInit(num, sizeof(SVCreateTbReq));
+  TSDB_CHECK_NULL(pTagVals, code, lino, _exit, terrno);
+  TSDB_CHECK_NULL(pTagName, code, lino, _exit, terrno);
+  TSDB_CHECK_NULL(req.pArray, code, lino, _exit, terrno);
+  TSDB_CHECK_NULL(taosArrayPush(pTagName, benchTags[0].name), code, lino, _exit, terrno);
+
+  for (int32_t i = start; i < start + num; ++i) {
+    SVCreateTbReq tbReq = {.type = TSDB_CHILD_TABLE,
+                           .commentLen = -1,
+                           .ctb = {.stbName = BENCH_STB_NAME, .tagNum = 1, .suid = pBench->suid, .tagName = pTagName}};
+    STagVal       tagVal = {.cid = benchTags[0].colId, .type = TSDB_DATA_TYPE_INT, .i64 = i};
+    STag         *pTag = NULL;
+
+    taosArrayClear(pTagVals);
+    TSDB_CHECK_NULL(taosArrayPush(pTagVals, &tagVal), code, lino, _exit, terrno);
+    code = tTagNew(pTagVals, 1, false, &pTag);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    tbReq.ctb.pTag = (uint8_t *)pTag;
+    tbReq.name = taosMemoryMalloc(TSDB_TABLE_NAME_LEN);
+    if (tbReq.name == NULL || taosArrayPush(req.pArray, &tbReq) == NULL) {
+      taosMemoryFree(tbReq.name);
+      taosMemoryFree(pTag);
+      TSDB_CHECK_CODE(code = terrno, lino, _exit);
+    }
+    snprintf(tbReq.name, TSDB_TABLE_NAME_LEN, "d%d", i);
+  }
+
+  tEncodeSize(tEncodeSVCreateTbBatchReq, &req, len, code);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  char *pCont = rpcMallocCont(sizeof(SMsgHead) + len);
+  TSDB_CHECK_NULL(pCont, code, lino, _exit, terrno);
+
+  tEncoderInit(&encoder, (uint8_t *)pCont + sizeof(SMsgHead), len);
+  code = tEncodeSVCreateTbBatchReq(&encoder, &req);
+  tEncoderClear(&encoder);
+  if (code < 0) {
+    rpcFreeCont(pCont);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  code = benchWriteMsg(pBench, TDMT_VND_CREATE_TABLE, pCont, sizeof(SMsgHead) + len);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    printf("failed to create child tables at line %d since %s\n", lino, tstrerror(code));
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(req.pArray); ++i) {
+    SVCreateTbReq *pReq = taosArrayGet(req.pArray, i);
+    taosMemoryFree(pReq->name);
+    taosMemoryFree(pReq->ctb.pTag);
+  }
+  taosArrayDestroy(req.pArray);
+  taosArrayDestroy(pTagVals);
+  taosArrayDestroy(pTagName);
+  return code;
+}
+
+static int32_t benchBuildRow(SBench *pBench, SArray *pColVals, int64_t ts, int64_t seq, SRow **ppRow) {
+  char    str[BENCH_BINARY_LEN + 1] = {0};
+  int32_t val = (int32_t)(seq % BENCH_FILTER_MOD);
+  int64_t big = seq * 10;
+  double  d = seq * 0.5;
+  float   f = (float)(seq % 10000) * 0.25f;
+  int32_t len = snprintf(str, sizeof(str), "s%" PRId64, seq % 10000);
+
+  SColVal colVals[BENCH_NUM_OF_COLS] = {
+      COL_VAL_VALUE(benchCols[0].colId, ((SValue){.type = TSDB_DATA_TYPE_TIMESTAMP, .val = ts})),
+      COL_VAL_VALUE(benchCols[1].colId, ((SValue){.type = TSDB_DATA_TYPE_INT, .val = val})),
+      COL_VAL_VALUE(benchCols[2].colId, ((SValue){.type = TSDB_DATA_TYPE_BIGINT, .val = big})),
+      COL_VAL_VALUE(benchCols[3].colId, ((SValue){.type = TSDB_DATA_TYPE_DOUBLE})),
+      COL_VAL_VALUE(benchCols[4].colId, ((SValue){.type = TSDB_DATA_TYPE_FLOAT})),
+      COL_VAL_VALUE(benchCols[5].colId,
+                    ((SValue){.type = TSDB_DATA_TYPE_BINARY, .pData = (uint8_t *)str, .nData = (uint32_t)len})),
+  };
+  memcpy(&colVals[3].value.val, &d, sizeof(double));
+  memcpy(&colVals[4].value.val, &f, sizeof(float));
+
+  taosArrayClear(pColVals);
+  if (taosArrayAddBatch(pColVals, colVals, BENCH_NUM_OF_COLS) == NULL) {
+    return terrno;
+  }
+  return tRowBuild(pColVals, pBench->pTSchema, ppRow);
+}
+
+/*
+ * Rows of a table are numbered 0..numOfRows-1 and row k lands at skey + k * BENCH_TS_STEP. Commit round r writes the
+ * r-th slice of every table in order. From the second round on, a disorder percentage of the previous slice is written
+ * again in between its timestamps, so those rows overlap data that has already been committed.
+ */
+static int32_t benchSubmitTable(SBench *pBench, const STableKeyInfo *pInfo, int64_t first, int64_t last, int64_t step,
+                                int64_t offset, SArray *pColVals) {
+  int32_t     code = 0;
+  int32_t     lino = 0;
+  int32_t     len = 0;
+  SEncoder    encoder = {0};
+  SSubmitReq2 req = {0};
+
+  req.aSubmitTbData = taosArrayInit(1, sizeof(SSubmitTbData));
+  TSDB_CHECK_NULL(req.aSubmitTbData, code, lino, _exit, terrno);
+
+  SSubmitTbData tbData = {.suid = pBench->suid, .uid = pInfo->uid, .sver = 1};
+  tbData.aRowP = taosArrayInit(BENCH_SUBMIT_ROWS, POINTER_BYTES);
+  if (tbData.aRowP == NULL || taosArrayPush(req.aSubmitTbData, &tbData) == NULL) {
+    taosArrayDestroy(tbData.aRowP);
+    TSDB_CHECK_CODE(code = terrno, lino, _exit);
+  }
+
+  for (int64_t k = first; k < last; k += step) {
+    SRow *pRow = NULL;
+    code = benchBuildRow(pBench, pColVals, pBench->skey + k * BENCH_TS_STEP + offset, k, &pRow);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    if (taosArrayPush(tbData.aRowP, &pRow) == NULL) {
+      tRowDestroy(pRow);
+      TSDB_CHECK_CODE(code = terrno, lino, _exit);
+    }
+  }
+
+  int32_t numOfRows = taosArrayGetSize(tbData.aRowP);
+  if (numOfRows == 0) {
+    goto _exit;
+  }
+
+  tEncodeSize(tEncodeSubmitReq, &req, len, code);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  char *pCont = rpcMallocCont(sizeof(SSubmitReq2Msg) + len);
+  TSDB_CHECK_NULL(pCont, code, lino, _exit, terrno);
+  ((SSubmitReq2Msg *)pCont)->version = htobe64(1);
+
+  tEncoderInit(&encoder, (uint8_t *)pCont + sizeof(SSubmitReq2Msg), len);
+  code = tEncodeSubmitReq(&encoder, &req);
+  tEncoderClear(&encoder);
+  if (code < 0) {
+    rpcFreeCont(pCont);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  code = benchWriteMsg(pBench, TDMT_VND_SUBMIT, pCont, sizeof(SSubmitReq2Msg) + len);
+  TSDB_CHECK_CODE(code, lino, _exit);
+  pBench->rowsWritten += numOfRows;
+
+_exit:
+  if (code) {
+    printf("failed to submit rows of uid:%" PRIu64 " at line %d since %s\n", pInfo->uid, lino, tstrerror(code));
+  }
+  tDestroySubmitReq(&req, TSDB_MSG_FLG_ENCODE);
+  return code;
+}
+
+static int32_t benchWriteRound(SBench *pBench, int32_t round, SArray *pColVals) {
+  int32_t code = 0;
+  int64_t rowsPerRound = (pBench->cfg.numOfRows + pBench->cfg.numOfCommits - 1) / pBench->cfg.numOfCommits;
+  int64_t first = rowsPerRound * round;
+  int64_t last = TMIN(first + rowsPerRound, pBench->cfg.numOfRows);
+  int64_t disorderStep = pBench->cfg.disorder > 0 ? 100 / pBench->cfg.disorder : 0;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pBench->pTableList) && code == 0; ++i) {
+    STableKeyInfo *pInfo = taosArrayGet(pBench->pTableList, i);
+    for (int64_t k = first; k < last && code == 0; k += BENCH_SUBMIT_ROWS) {
+      code = benchSubmitTable(pBench, pInfo, k, TMIN(k + BENCH_SUBMIT_ROWS, last), 1, 0, pColVals);
+    }
+
+    if (code == 0 && round > 0 && disorderStep > 0) {
+      code = benchSubmitTable(pBench, pInfo, first - rowsPerRound, first, disorderStep, BENCH_TS_STEP / 2, pColVals);
+    }
+  }
+
+  return code;
+}
+
+static int32_t benchDelete(SBench *pBench) {
+  int32_t         code = 0;
+  int32_t         lino = 0;
+  int32_t         len = 0;
+  SEncoder        encoder = {0};
+  SBatchDeleteReq req = {.suid = pBench->suid};
+
+  req.deleteReqs = taosArrayInit(pBench->cfg.numOfTables, sizeof(SSingleDeleteReq));
+  TSDB_CHECK_NULL(req.deleteReqs, code, lino, _exit, terrno);
+
+  // tombstones cover the 45%~55% slice of a table, so the filtered scan window runs into them
+  for (int32_t i = 0; i < pBench->cfg.numOfTables; ++i) {
+    if (i % 100 >= pBench->cfg.deletes) continue;
+
+    SSingleDeleteReq delReq = {.startTs = pBench->skey + (int64_t)pBench->cfg.numOfRows * 45 / 100 * BENCH_TS_STEP,
+                               .endTs = pBench->skey + (int64_t)pBench->cfg.numOfRows * 55 / 100 * BENCH_TS_STEP};
+    snprintf(delReq.tbname, TSDB_TABLE_NAME_LEN, "d%d", i);
+    TSDB_CHECK_NULL(taosArrayPush(req.deleteReqs, &delReq), code, lino, _exit, terrno);
+  }
+
+  if (taosArrayGetSize(req.deleteReqs) == 0) {
+    goto _exit;
+  }
+
+  tEncodeSize(tEncodeSBatchDeleteReq, &req, len, code);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  char *pCont = rpcMallocCont(sizeof(SMsgHead) + len);
+  TSDB_CHECK_NULL(pCont, code, lino, _exit, terrno);
+
+  tEncoderInit(&encoder, (uint8_t *)pCont + sizeof(SMsgHead), len);
+  code = tEncodeSBatchDeleteReq(&encoder, &req);
+  tEncoderClear(&encoder);
+  if (code < 0) {
+    rpcFreeCont(pCont);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  code = benchWriteMsg(pBench, TDMT_VND_BATCH_DEL, pCont, sizeof(SMsgHead) + len);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    printf("failed to delete rows at line %d since %s\n", lino, tstrerror(code));
+  }
+  taosArrayDestroy(req.deleteReqs);
+  return code;
+}
+
+static int32_t benchLoadTableList(SBench *pBench) {
+  int32_t code = 0;
+  SArray *pUids = taosArrayInit(pBench->cfg.numOfTables, sizeof(uint64_t));
+  if (pUids == NULL) {
+    return terrno;
+  }
+
+  code = vnodeGetCtbIdList(pBench->pVnode, pBench->suid, pUids);
+  for (int32_t i = 0; i < taosArrayGetSize(pUids) && code == 0; ++i) {
+    STableKeyInfo info = {.uid = *(uint64_t *)taosArrayGet(pUids, i), .groupId = 0};
+    if (taosArrayPush(pBench->pTableList, &info) == NULL) {
+      code = terrno;
+    }
+  }
+
+  taosArrayDestroy(pUids);
+  return code;
+}
+
+static int32_t benchBuild(SBench *pBench) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  int64_t st = taosGetTimestampUs();
+  SArray *pColVals = taosArrayInit(BENCH_NUM_OF_COLS, sizeof(SColVal));
+  TSDB_CHECK_NULL(pColVals, code, lino, _exit, terrno);
+
+  code = benchCreateStb(pBench);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  for (int32_t i = 0; i < pBench->cfg.numOfTables; i += BENCH_CREATE_BATCH) {
+    code = benchCreateTables(pBench, i, TMIN(BENCH_CREATE_BATCH, pBench->cfg.numOfTables - i));
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  code = benchLoadTableList(pBench);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  for (int32_t round = 0; round < pBench->cfg.numOfCommits; ++round) {
+    code = benchWriteRound(pBench, round, pColVals);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    code = benchCommit(pBench);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  if (pBench->cfg.deletes > 0) {
+    code = benchDelete(pBench);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    code = benchCommit(pBench);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  printf("vnode built, tables:%d rows:%" PRId64 " commits:%d elapsed:%.2f s\n",
+         (int32_t)taosArrayGetSize(pBench->pTableList), pBench->rowsWritten, pBench->cfg.numOfCommits,
+         (taosGetTimestampUs() - st) / 1000000.0);
+
+_exit:
+  if (code) {
+    printf("failed to build vnode at line %d since %s\n", lino, tstrerror(code));
+  }
+  taosArrayDestroy(pColVals);
+  return code;
+}
+
+static int32_t benchCreateResBlock(const SColumnInfo *pCols, int32_t numOfCols, int32_t capacity, SSDataBlock **ppRes) {
+  SSDataBlock *pRes = NULL;
+  int32_t      code = createDataBlock(&pRes);
+  if (code) {
+    return code;
+  }
+
+  for (int32_t i = 0; i < numOfCols && code == 0; ++i) {
+    SColumnInfoData colInfo = createColumnInfoData(pCols[i].type, pCols[i].bytes, pCols[i].colId);
+    code = blockDataAppendColInfo(pRes, &colInfo);
+  }
+  if (code == 0) {
+    code = blockDataEnsureCapacity(pRes, capacity);
+  }
+
+  if (code) {
+    blockDataDestroy(pRes);
+    pRes = NULL;
+  }
+  *ppRes = pRes;
+  return code;
+}
+
+static void benchFillColumns(SColumnInfo *pCols, int32_t *pSlots) {
+  for (int32_t i = 0; i < BENCH_NUM_OF_COLS; ++i) {
+    pCols[i] = (SColumnInfo){.colId = benchCols[i].colId, .type = benchCols[i].type, .bytes = benchCols[i].bytes};
+    pSlots[i] = i;
+  }
+}
+
+/*
+ * Scan the super table with tsdbReaderOpen2 like the table scan operator does. With useSma the SMA of every block is
+ * tried first and the block is loaded only when the SMA is not enough: always for the SMA only scan, and for the
+ * filtered scan when min(i) of the block does not already exclude all rows from "i < BENCH_FILTER_VAL".
+ */
+static int32_t benchTableScan(SBench *pBench, STimeWindow win, bool useSma, bool filter, SBenchStat *pStat) {
+  int32_t      code = 0;
+  int32_t      lino = 0;
+  SColumnInfo  cols[BENCH_NUM_OF_COLS] = {0};
+  int32_t      slots[BENCH_NUM_OF_COLS] = {0};
+  SSDataBlock *pRes = NULL;
+  STsdbReader *pReader = NULL;
+
+  benchFillColumns(cols, slots);
+
+  SQueryTableDataCond cond = {.suid = pBench->suid,
+                              .order = TSDB_ORDER_ASC,
+                              .numOfCols = BENCH_NUM_OF_COLS,
+                              .colList = cols,
+                              .pSlotList = slots,
+                              .type = TIMEWINDOW_RANGE_CONTAINED,
+                              .twindows = win,
+                              .startVersion = -1,
+                              .endVersion = -1};
+
+  code = benchCreateResBlock(cols, BENCH_NUM_OF_COLS, pBench->cfg.maxRows, &pRes);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  int64_t st = taosGetTimestampUs();
+  code = tsdbReaderOpen2(pBench->pVnode, &cond, TARRAY_DATA(pBench->pTableList),
+                         taosArrayGetSize(pBench->pTableList), pRes, (void **)&pReader, pStat->name, NULL);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  while (true) {
+    bool    hasNext = false;
+    int64_t bst = taosGetTimestampUs();
+
+    code = tsdbNextDataBlock2(pReader, &hasNext);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    if (!hasNext) break;
+
+    bool needLoad = !useSma;
+    if (useSma) {
+      bool allHave = false;
+      bool hasNullSMA = false;
+      code = tsdbRetrieveDatablockSMA2(pReader, pRes, &allHave, &hasNullSMA);
+      TSDB_CHECK_CODE(code, lino, _exit);
+
+      if (!allHave || hasNullSMA) {
+        needLoad = true;
+      } else if (filter) {
+        needLoad = pRes->pBlockAgg[1].min < BENCH_FILTER_VAL;
+      }
+    }
+
+    int64_t rows = pRes->info.rows;
+    if (needLoad) {
+      SSDataBlock *pBlock = NULL;
+      code = tsdbRetrieveDataBlock2(pReader, &pBlock, NULL);
+      TSDB_CHECK_CODE(code, lino, _exit);
+
+      rows = pBlock->info.rows;
+      pStat->loaded += 1;
+      if (filter) {
+        SColumnInfoData *pCol = taosArrayGet(pBlock->pDataBlock, 1);
+        for (int32_t j = 0; j < rows; ++j) {
+          if (!colDataIsNull_s(pCol, j) && *(int32_t *)colDataGetData(pCol, j) < BENCH_FILTER_VAL) {
+            pStat->qualified += 1;
+          }
+        }
+      }
+    }
+
+    pStat->rows += rows;
+    pStat->blocks += 1;
+    if (taosArrayPush(pStat->pLatency, &(int64_t){taosGetTimestampUs() - bst}) == NULL) {
+      TSDB_CHECK_CODE(code = terrno, lino, _exit);
+    }
+  }
+
+  pStat->elapsed = taosGetTimestampUs() - st;
+
+_exit:
+  if (code) {
+    printf("%s failed at line %d since %s\n", pStat->name, lino, tstrerror(code));
+  }
+  tsdbReaderClose2(pReader);
+  blockDataDestroy(pRes);
+  return code;
+}
+
+/*
+ * Read last_row or last of all columns of every table from the last cache, in batches of a result block, the same way
+ * the cache scan operator does for "select last_row(*) from stb partition by tbname".
+ */
+static int32_t benchCacheScan(SBench *pBench, int32_t type, SBenchStat *pStat) {
+  int32_t      code = 0;
+  int32_t      lino = 0;
+  SColumnInfo  cols[BENCH_NUM_OF_COLS] = {0};
+  int32_t      slots[BENCH_NUM_OF_COLS] = {0};
+  SSDataBlock *pRes = NULL;
+  void        *pReader = NULL;
+  SArray      *pCidList = taosArrayInit(BENCH_NUM_OF_COLS, sizeof(int16_t));
+  SArray      *pUids = taosArrayInit(pBench->cfg.maxRows, sizeof(int64_t));
+  TSDB_CHECK_NULL(pCidList, code, lino, _exit, terrno);
+  TSDB_CHECK_NULL(pUids, code, lino, _exit, terrno);
+
+  benchFillColumns(cols, slots);
+  for (int32_t i = 0; i < BENCH_NUM_OF_COLS; ++i) {
+    TSDB_CHECK_NULL(taosArrayPush(pCidList, &cols[i].colId), code, lino, _exit, terrno);
+    if (type & CACHESCAN_RETRIEVE_LAST) {
+      cols[i].type = TSDB_DATA_TYPE_BINARY;
+      cols[i].bytes = sizeof(SFirstLastRes) + benchCols[i].bytes + VARSTR_HEADER_SIZE;
+    }
+  }
+
+  code = benchCreateResBlock(cols, BENCH_NUM_OF_COLS, pBench->cfg.maxRows, &pRes);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  int64_t st = taosGetTimestampUs();
+  code = tsdbCacherowsReaderOpen(pBench->pVnode, CACHESCAN_RETRIEVE_TYPE_ALL | type, TARRAY_DATA(pBench->pTableList),
+                                 taosArrayGetSize(pBench->pTableList), BENCH_NUM_OF_COLS, pCidList, slots,
+                                 pBench->suid, &pReader, pStat->name, NULL, NULL, 0);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  bool gotAll = false;
+  while (!gotAll) {
+    int64_t bst = taosGetTimestampUs();
+
+    blockDataCleanup(pRes);
+    taosArrayClear(pUids);
+    code = tsdbRetrieveCacheRows(pReader, pRes, slots, slots, pUids, &gotAll);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    if (pRes->info.rows == 0 && !gotAll) {
+      break;
+    }
+
+    pStat->rows += pRes->info.rows;
+    pStat->blocks += 1;
+    pStat->loaded += 1;
+    if (taosArrayPush(pStat->pLatency, &(int64_t){taosGetTimestampUs() - bst}) == NULL) {
+      TSDB_CHECK_CODE(code = terrno, lino, _exit);
+    }
+  }
+
+  pStat->elapsed = taosGetTimestampUs() - st;
+
+_exit:
+  if (code) {
+    printf("%s failed at line %d since %s\n", pStat->name, lino, tstrerror(code));
+  }
+  tsdbCacherowsReaderClose(pReader);
+  blockDataDestroy(pRes);
+  taosArrayDestroy(pCidList);
+  taosArrayDestroy(pUids);
+  return code;
+}
+
+static int64_t benchPercentile(SArray *pLatency, int32_t percent) {
+  int32_t size = taosArrayGetSize(pLatency);
+  if (size == 0) {
+    return 0;
+  }
+  int32_t idx = TMIN((int64_t)size * percent / 100, size - 1);
+  return *(int64_t *)taosArrayGet(pLatency, idx);
+}
+
+static void benchReport(SBenchStat *pStat) {
+  taosArraySort(pStat->pLatency, compareInt64Val);
+
+  double seconds = pStat->elapsed / 1000000.0;
+  printf("%-10s %-5s rows:%-10" PRId64 " blocks:%-7" PRId64 " loaded:%-7" PRId64 " qualified:%-9" PRId64
+         " elapsed:%9.3f ms rows/s:%12.0f block p50:%" PRId64 "us p99:%" PRId64 "us max:%" PRId64 "us\n",
+         pStat->name, pStat->loop == 0 ? "cold" : "warm", pStat->rows, pStat->blocks, pStat->loaded, pStat->qualified,
+         pStat->elapsed / 1000.0, seconds > 0 ? pStat->rows / seconds : 0, benchPercentile(pStat->pLatency, 50),
+         benchPercentile(pStat->pLatency, 99), benchPercentile(pStat->pLatency, 100));
+}
+
+static int32_t benchRun(SBench *pBench) {
+  int32_t code = 0;
+  int64_t ekey = pBench->skey + (int64_t)pBench->cfg.numOfRows * BENCH_TS_STEP;
+  int64_t span = ekey - pBench->skey;
+
+  STimeWindow all = {.skey = pBench->skey, .ekey = ekey};
+  STimeWindow part = {.skey = pBench->skey + span * 45 / 100, .ekey = pBench->skey + span * 55 / 100};
+
+  for (int32_t loop = 0; loop < pBench->cfg.loops && code == 0; ++loop) {
+    SBenchStat stats[] = {
+        {.name = "full"}, {.name = "last_row"}, {.name = "last"}, {.name = "sma"}, {.name = "filter"},
+    };
+
+    for (int32_t i = 0; i < tListLen(stats); ++i) {
+      stats[i].loop = loop;
+      stats[i].pLatency = taosArrayInit(1024, sizeof(int64_t));
+      if (stats[i].pLatency == NULL) code = terrno;
+    }
+
+    if (code == 0) code = benchTableScan(pBench, all, false, false, &stats[0]);
+    if (code == 0) code = benchCacheScan(pBench, CACHESCAN_RETRIEVE_LAST_ROW, &stats[1]);
+    if (code == 0) code = benchCacheScan(pBench, CACHESCAN_RETRIEVE_LAST, &stats[2]);
+    if (code == 0) code = benchTableScan(pBench, all, true, false, &stats[3]);
+    if (code == 0) code = benchTableScan(pBench, part, true, true, &stats[4]);
+
+    for (int32_t i = 0; i < tListLen(stats); ++i) {
+      if (code == 0) benchReport(&stats[i]);
+      taosArrayDestroy(stats[i].pLatency);
+    }
+
+    if (code == 0) {
+      printf("last cache usage:%" PRIu64 " bytes elems:%d\n", (uint64_t)tsdbCacheGetUsage(pBench->pVnode),
+             tsdbCacheGetElems(pBench->pVnode));
+    }
+
+    if (code == 0) {
+      printf("sma cache usage:%" PRIu64 " bytes elems:%d\n\n", (uint64_t)tsdbSmaCacheGetUsage(pBench->pVnode),
+             tsdbSmaCacheGetElems(pBench->pVnode));
+    }
+  }
+
+  return code;
+}
+
+static int32_t benchOpen(SBench *pBench) {
+  int32_t  code = 0;
+  int32_t  lino = 0;
+  SDiskCfg diskCfg = {.level = 0, .primary = 1, .disable = 0};
+
+  tstrncpy(diskCfg.dir, pBench->cfg.path, sizeof(diskCfg.dir));
+  code = tfsOpen(&diskCfg, 1, &pBench->pTfs);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  SVnodeCfg cfg = vnodeCfgDefault;
+  cfg.vgId = BENCH_VGID;
+  cfg.dbId = 1;
+  tstrncpy(cfg.dbname, BENCH_DB_NAME, sizeof(cfg.dbname));
+  cfg.szBuf = (uint64_t)pBench->cfg.bufferMB * 1024 * 1024;
+  cfg.cacheLast = pBench->cfg.cacheLast;
+  cfg.sttTrigger = pBench->cfg.sttTrigger;
+  cfg.tsdbCfg.maxRows = pBench->cfg.maxRows;
+  cfg.tsdbCfg.minRows = TMIN(cfg.tsdbCfg.minRows, pBench->cfg.maxRows);
+  cfg.hashBegin = 0;
+  cfg.hashEnd = UINT32_MAX;
+  cfg.walCfg.vgId = BENCH_VGID;
+  cfg.syncCfg.replicaNum = 1;
+  cfg.syncCfg.totalReplicaNum = 1;
+  cfg.syncCfg.myIndex = 0;
+  cfg.syncCfg.nodeInfo[0].nodeId = 1;
+  cfg.syncCfg.nodeInfo[0].nodePort = 6030;
+  cfg.syncCfg.nodeInfo[0].nodeRole = TAOS_SYNC_ROLE_VOTER;
+  tstrncpy(cfg.syncCfg.nodeInfo[0].nodeFqdn, "localhost", sizeof(cfg.syncCfg.nodeInfo[0].nodeFqdn));
+
+  code = vnodeCreate(BENCH_VNODE_PATH, &cfg, 0, pBench->pTfs);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  pBench->pVnode = vnodeOpen(BENCH_VNODE_PATH, 0, pBench->pTfs, (SMsgCb){0}, false);
+  TSDB_CHECK_NULL(pBench->pVnode, code, lino, _exit, terrno);
+
+  pBench->pTSchema = tBuildTSchema(benchCols, BENCH_NUM_OF_COLS, 1);
+  TSDB_CHECK_NULL(pBench->pTSchema, code, lino, _exit, terrno);
+
+  pBench->pTableList = taosArrayInit(pBench->cfg.numOfTables, sizeof(STableKeyInfo));
+  TSDB_CHECK_NULL(pBench->pTableList, code, lino, _exit, terrno);
+
+  pBench->suid = tGenIdPI64();
+  pBench->skey = (taosGetTimestampMs() - (int64_t)(pBench->cfg.numOfRows + 1) * BENCH_TS_STEP) / 1000 * 1000;
+
+_exit:
+  if (code) {
+    printf("failed to open vnode under %s at line %d since %s\n", pBench->cfg.path, lino, tstrerror(code));
+  }
+  return code;
+}
+
+static void benchClose(SBench *pBench) {
+  if (pBench->pVnode) {
+    vnodePreClose(pBench->pVnode);
+    vnodePostClose(pBench->pVnode);
+    vnodeClose(pBench->pVnode);
+  }
+  tfsClose(pBench->pTfs);
+  taosMemoryFree(pBench->pTSchema);
+  taosArrayDestroy(pBench->pTableList);
+}
+
+int main(int argc, char *argv[]) {
+  SBench bench = {.cfg = {.path = "/tmp/tsdbReadBench",
+                          .numOfTables = 100,
+                          .numOfRows = 10000,
+                          .numOfCommits = 4,
+                          .sttTrigger = 1,
+                          .disorder = 0,
+                          .deletes = 0,
+                          .loops = 3,
+                          .maxRows = 4096,
+                          .bufferMB = 96,
+                          .smaCacheMB = tsSmaCacheSize,
+                          .cacheLast = 3}};
+  SBenchCfg *pCfg = &bench.cfg;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-p") == 0 && i < argc - 1) {
+      tstrncpy(pCfg->path, argv[++i], sizeof(pCfg->path));
+    } else if (strcmp(argv[i], "-t") == 0 && i < argc - 1) {
+      pCfg->numOfTables = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      pCfg->numOfRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0 && i < argc - 1) {
+      pCfg->numOfCommits = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0 && i < argc - 1) {
+      pCfg->sttTrigger = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-o") == 0 && i < argc - 1) {
+      pCfg->disorder = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-x") == 0 && i < argc - 1) {
+      pCfg->deletes = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      pCfg->loops = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i < argc - 1) {
+      pCfg->maxRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0 && i < argc - 1) {
+      pCfg->bufferMB = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-m") == 0 && i < argc - 1) {
+      pCfg->smaCacheMB = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-L") == 0 && i < argc - 1) {
+      pCfg->cacheLast = (int8_t)atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-p path]: directory of the vnode, removed first, default is:%s\n", pCfg->path);
+      printf("  [-t tables]: number of child tables, default is:%d\n", pCfg->numOfTables);
+      printf("  [-n rows]: number of rows per table, default is:%d\n", pCfg->numOfRows);
+      printf("  [-c commits]: number of commit rounds the rows are spread over, default is:%d\n", pCfg->numOfCommits);
+      printf("  [-s sttTrigger]: stt files that trigger a merge, default is:%d\n", pCfg->sttTrigger);
+      printf("  [-o disorder]: percent of rows rewritten out of order, default is:%d\n", pCfg->disorder);
+      printf("  [-x deletes]: percent of tables with a delete tombstone, default is:%d\n", pCfg->deletes);
+      printf("  [-l loops]: scan loops, the first one is cold, default is:%d\n", pCfg->loops);
+      printf("  [-r maxRows]: max rows of a file block, default is:%d\n", pCfg->maxRows);
+      printf("  [-b buffer]: write buffer in MB, default is:%d\n", pCfg->bufferMB);
+      printf("  [-m smaCache]: block sma cache of the vnode in MB, 0 disables it, default is:%d\n", pCfg->smaCacheMB);
+      printf("  [-L cacheLast]: cachemodel, 0 none, 1 last_row, 2 last, 3 both, default is:%d\n", pCfg->cacheLast);
+      printf("  [-h help]: print out this help\n\n");
+      exit(0);
+    }
+  }
+
+  if (pCfg->numOfTables <= 0 || pCfg->numOfRows <= 0 || pCfg->numOfCommits <= 0 || pCfg->loops <= 0 ||
+      pCfg->loops > BENCH_MAX_OF_LOOPS || pCfg->disorder < 0 || pCfg->disorder > 100 || pCfg->deletes < 0 ||
+      pCfg->deletes > 100 || pCfg->maxRows < TSDB_MIN_MAXROWS_FBLOCK || pCfg->maxRows > TSDB_MAX_MAXROWS_FBLOCK ||
+      pCfg->sttTrigger < TSDB_MIN_STT_TRIGGER || pCfg->sttTrigger > TSDB_MAX_STT_TRIGGER || pCfg->bufferMB <= 0 ||
+      pCfg->smaCacheMB < 0 || pCfg->smaCacheMB > 1024 || pCfg->cacheLast < 0 || pCfg->cacheLast > 3) {
+    printf("invalid options, run with -h for help\n");
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  taosRemoveDir(pCfg->path);
+  (void)taosMkDir(pCfg->path);
+  benchInitLog(pCfg->path);
+  tsSmaCacheSize = pCfg->smaCacheMB;
+
+  int32_t code = walInit(benchStopDnode);
+  if (code == 0) code = syncInit();
+  if (code == 0) code = vnodeInit(2, benchStopDnode);
+  if (code == 0) code = benchOpen(&bench);
+  if (code == 0) code = benchBuild(&bench);
+  if (code == 0) code = benchRun(&bench);
+
+  benchClose(&bench);
+  vnodeCleanup();
+  syncCleanUp();
+  walCleanUp();
+  taosCloseLog();
+  return code;
+}
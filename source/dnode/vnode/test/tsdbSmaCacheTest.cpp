@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tsdb.h"
+
+namespace {
+
+const int32_t smaTestNumOfAggs = 3;
+
+void buildTestAggs(SColumnDataAgg* pAggs, int64_t base) {
+  for (int32_t i = 0; i < smaTestNumOfAggs; ++i) {
+    pAggs[i].colId = 2 + i;
+    pAggs[i].numOfNull = i;
+    pAggs[i].sum = base * 100 + i;
+    pAggs[i].max = base + i;
+    pAggs[i].min = base - i;
+  }
+}
+
+// copy the cached aggs of the block, false if the lookup misses
+bool getTestAggs(SLRUCache* pCache, int32_t fid, int64_t cid, int64_t offset, SColumnDataAgg* pAggs) {
+  LRUHandle* h = NULL;
+  EXPECT_EQ(tsdbCacheGetBlockSma(pCache, fid, cid, offset, &h), 0);
+  if (h == NULL) {
+    return false;
+  }
+
+  SSmaCacheEntry* pEntry = (SSmaCacheEntry*)taosLRUCacheValue(pCache, h);
+  EXPECT_EQ(pEntry->numOfAggs, smaTestNumOfAggs);
+  memcpy(pAggs, pEntry->aggs, smaTestNumOfAggs * sizeof(SColumnDataAgg));
+  tsdbCacheRelease(pCache, h);
+  return true;
+}
+
+}  // namespace
+
+TEST(tsdbSmaCacheTest, hitByFileAndOffset) {
+  SLRUCache* pCache = taosLRUCacheInit(1024 * 1024, 0, .5);
+  ASSERT_NE(pCache, nullptr);
+
+  SColumnDataAgg aggs[smaTestNumOfAggs], other[smaTestNumOfAggs], res[smaTestNumOfAggs];
+  buildTestAggs(aggs, 1000);
+  buildTestAggs(other, 2000);
+  tsdbCacheSetBlockSma(pCache, 1700, 10, 4096, aggs, smaTestNumOfAggs);
+  tsdbCacheSetBlockSma(pCache, 1700, 10, 8192, other, smaTestNumOfAggs);
+
+  ASSERT_TRUE(getTestAggs(pCache, 1700, 10, 4096, res));
+  EXPECT_EQ(memcmp(res, aggs, sizeof(aggs)), 0);
+  ASSERT_TRUE(getTestAggs(pCache, 1700, 10, 8192, res));
+  EXPECT_EQ(memcmp(res, other, sizeof(other)), 0);
+
+  // another block of the file or the same offset in another file set
+  EXPECT_FALSE(getTestAggs(pCache, 1700, 10, 0, res));
+  EXPECT_FALSE(getTestAggs(pCache, 1701, 10, 4096, res));
+
+  taosLRUCacheEraseUnrefEntries(pCache);
+  taosLRUCacheCleanup(pCache);
+}
+
+TEST(tsdbSmaCacheTest, missAfterFileRewrite) {
+  SLRUCache* pCache = taosLRUCacheInit(1024 * 1024, 0, .5);
+  ASSERT_NE(pCache, nullptr);
+
+  SColumnDataAgg aggs[smaTestNumOfAggs], merged[smaTestNumOfAggs], res[smaTestNumOfAggs];
+  buildTestAggs(aggs, 1000);
+  buildTestAggs(merged, 3000);
+  tsdbCacheSetBlockSma(pCache, 1700, 10, 4096, aggs, smaTestNumOfAggs);
+
+  // a merge or a compaction writes the file set again under a new commit id, the sma at the same offset is another one
+  EXPECT_FALSE(getTestAggs(pCache, 1700, 11, 4096, res));
+  tsdbCacheSetBlockSma(pCache, 1700, 11, 4096, merged, smaTestNumOfAggs);
+  ASSERT_TRUE(getTestAggs(pCache, 1700, 11, 4096, res));
+  EXPECT_EQ(memcmp(res, merged, sizeof(merged)), 0);
+
+  // the entries of the old file are only left for readers still on it
+  ASSERT_TRUE(getTestAggs(pCache, 1700, 10, 4096, res));
+  EXPECT_EQ(memcmp(res, aggs, sizeof(aggs)), 0);
+
+  taosLRUCacheEraseUnrefEntries(pCache);
+  taosLRUCacheCleanup(pCache);
+}
+
+#pragma GCC diagnostic pop
@@ -42,6 +42,8 @@ extern "C" {
 #define CTG_DEFAULT_CACHE_MON_MSEC       5000
 #define CTG_CLEAR_CACHE_ROUND_TB_NUM     3000
 
+#define CTG_RCU_IDLE -1
+
 #define CTG_RENT_SLOT_SECOND 1.5
 
 #define CTG_DEFAULT_INVALID_VERSION (-1)
@@ -317,7 +319,8 @@ typedef struct SCtgTbCache {
 } SCtgTbCache;
 
 typedef struct SCtgVgCache {
-  SRWLatch   vgLock;
+  SRWLatch   vgLock;   // serializes writers, readers are protected by rcu
+  int8_t     dropped;  // vgInfo is kept for readers still using it but no longer valid
   SDBVgInfo* vgInfo;
 } SCtgVgCache;
 
@@ -338,7 +341,6 @@ typedef struct SCtgTSMACache {
 } SCtgTSMACache;
 
 typedef struct SCtgDBCache {
-  SRWLatch     dbLock;  // RC between destroy tbCache/stbCache and all reads
   uint64_t     dbId;
   int8_t       deleted;
   SCtgVgCache  vgCache;
@@ -652,11 +654,37 @@ typedef struct SCtgQueue {
   uint64_t   qRemainNum;
 } SCtgQueue;
 
+typedef void (*FCtgRcuFree)(void*);
+
+typedef struct SCtgRcuRecord {
+  int64_t               epoch;  // epoch the thread entered with, CTG_RCU_IDLE when it is not reading
+  int8_t                inUse;  // owned by a live thread
+  struct SCtgRcuRecord* next;
+  char                  pad[64 - sizeof(int64_t) - sizeof(int8_t) - sizeof(void*)];
+} SCtgRcuRecord;
+
+typedef struct SCtgRcuNode {
+  int64_t             epoch;
+  void*               p;
+  FCtgRcuFree         freeFp;
+  struct SCtgRcuNode* next;
+} SCtgRcuNode;
+
+typedef struct SCtgRcu {
+  int64_t      epoch;
+  SRWLatch     lock;
+  SCtgRcuNode* head;  // retired objects, in epoch order
+  SCtgRcuNode* tail;
+  int64_t      retiredNum;
+  int64_t      unrecordedReaders;  // readers that failed to get a record, nothing is freed while there are any
+} SCtgRcu;
+
 typedef struct SCatalogMgmt {
   bool         exit;
   int32_t      jobPool;
   SRWLatch     lock;
   SCtgQueue    queue;
+  SCtgRcu      rcu;
   void*        timer;
   tmr_h        cacheTimer;
   TdThread     updateThread;
@@ -999,6 +1027,13 @@ typedef struct SCtgCacheItemInfo {
     }                                                     \
   } while (0)
 
+void    ctgRcuReadLock(void);
+void    ctgRcuReadUnlock(void);
+int32_t ctgRcuRetire(void* p, FCtgRcuFree freeFp);
+void    ctgRcuReclaim(bool force);
+int64_t ctgRcuGetSafeEpoch(void);
+void    ctgRcuFreeRetired(int64_t minEpoch);
+
 void    ctgdShowTableMeta(SCatalog* pCtg, const char* tbName, STableMeta* p);
 void    ctgdShowClusterCache(SCatalog* pCtg);
 int32_t ctgdShowCacheInfo(void);
@@ -1127,6 +1162,8 @@ int32_t ctgGetVgIdsFromHashValue(SCatalog* pCtg, SDBVgInfo* dbInfo, char* dbFNam
                                  int32_t* vgId);
 void    ctgResetTbMetaTask(SCtgTask* pTask);
 void    ctgFreeDbCache(SCtgDBCache* dbCache);
+void    ctgFreeRetiredDbCache(void* p);
+void    ctgFreeRetiredVgInfo(void* p);
 int32_t ctgStbVersionSortCompare(const void* key1, const void* key2);
 int32_t ctgViewVersionSortCompare(const void* key1, const void* key2);
 int32_t ctgDbCacheInfoSortCompare(const void* key1, const void* key2);
@@ -698,6 +698,8 @@ void ctgProcessTimerEvent(void *param, void *tmrId) {
   (void)ctgdShowCacheInfo();
   (void)ctgdShowStatInfo();
 
+  ctgRcuReclaim(false);
+
   int32_t cacheMaxSize = atomic_load_32(&tsMetaCacheMaxSize);
   if (cacheMaxSize >= 0) {
     uint64_t cacheSize = 0;
@@ -1994,6 +1996,7 @@ void catalogDestroy(void) {
   if (!taosCheckCurrentInDll()) {
     (void)ctgClearCacheEnqueue(NULL, false, true, true, true);
     (void)taosThreadJoin(gCtgMgmt.updateThread, NULL);
+    ctgRcuReclaim(true);
   }
 
   taosHashCleanup(gCtgMgmt.pCluster);
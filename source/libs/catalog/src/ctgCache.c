@@ -61,21 +61,16 @@ SCtgCacheItemInfo gCtgStatItem[CTG_CI_MAX_VALUE] = {
     {"SvrVer    ", CTG_CI_FLAG_LEVEL_CLUSTER}  //CTG_CI_SVR_VER,
 };
 
+// vgInfo is read within the rcu section entered by ctgAcquireDBCache, writers replace it and retire the old one
 int32_t ctgRLockVgInfo(SCatalog *pCtg, SCtgDBCache *dbCache, bool *inCache) {
-  CTG_LOCK(CTG_READ, &dbCache->vgCache.vgLock);
-
-  if (dbCache->deleted) {
-    CTG_UNLOCK(CTG_READ, &dbCache->vgCache.vgLock);
-
+  if (atomic_load_8(&dbCache->deleted)) {
     ctgDebug("db is dropping, dbId:0x%" PRIx64, dbCache->dbId);
 
     *inCache = false;
     return TSDB_CODE_SUCCESS;
   }
 
-  if (NULL == dbCache->vgCache.vgInfo) {
-    CTG_UNLOCK(CTG_READ, &dbCache->vgCache.vgLock);
-
+  if (NULL == atomic_load_ptr(&dbCache->vgCache.vgInfo) || atomic_load_8(&dbCache->vgCache.dropped)) {
     *inCache = false;
     ctgDebug("db vgInfo is empty, dbId:0x%" PRIx64, dbCache->dbId);
     return TSDB_CODE_SUCCESS;
@@ -101,15 +96,15 @@ int32_t ctgWLockVgInfo(SCatalog *pCtg, SCtgDBCache *dbCache) {
 void ctgRLockDbCfgInfo(SCtgDBCache *dbCache) {  CTG_LOCK(CTG_READ, &dbCache->cfgCache.cfgLock); }
 void ctgWLockDbCfgInfo(SCtgDBCache *dbCache) {  CTG_LOCK(CTG_WRITE, &dbCache->cfgCache.cfgLock); }
 
-void ctgRUnlockVgInfo(SCtgDBCache *dbCache) { CTG_UNLOCK(CTG_READ, &dbCache->vgCache.vgLock); }
+void ctgRUnlockVgInfo(SCtgDBCache *dbCache) {}  // the rcu section is left in ctgReleaseDBCache
 void ctgWUnlockVgInfo(SCtgDBCache *dbCache) { CTG_UNLOCK(CTG_WRITE, &dbCache->vgCache.vgLock); }
 
 void ctgRUnlockDbCfgInfo(SCtgDBCache *dbCache) { CTG_UNLOCK(CTG_READ, &dbCache->cfgCache.cfgLock); }
 void ctgWUnlockDbCfgInfo(SCtgDBCache *dbCache) { CTG_UNLOCK(CTG_WRITE, &dbCache->cfgCache.cfgLock); }
 
 void ctgReleaseDBCache(SCatalog *pCtg, SCtgDBCache *dbCache) {
-  CTG_UNLOCK(CTG_READ, &dbCache->dbLock);
   taosHashRelease(pCtg->dbCache, dbCache);
+  ctgRcuReadUnlock();
 }
 
 int32_t ctgAcquireDBCacheImpl(SCatalog *pCtg, const char *dbFName, SCtgDBCache **pCache, bool acquire) {
@@ -121,23 +116,23 @@ int32_t ctgAcquireDBCacheImpl(SCatalog *pCtg, const char *dbFName, SCtgDBCache *
   SCtgDBCache *dbCache = NULL;
 
   if (acquire) {
+    ctgRcuReadLock();
     dbCache = (SCtgDBCache *)taosHashAcquire(pCtg->dbCache, dbFName, strlen(dbFName));
   } else {
     dbCache = (SCtgDBCache *)taosHashGet(pCtg->dbCache, dbFName, strlen(dbFName));
   }
 
   if (NULL == dbCache) {
+    if (acquire) {
+      ctgRcuReadUnlock();
+    }
     *pCache = NULL;
     CTG_CACHE_NHIT_INC(CTG_CI_DB, 1);
     ctgDebug("db not in cache, dbFName:%s", dbFName);
     return TSDB_CODE_SUCCESS;
   }
 
-  if (acquire) {
-    CTG_LOCK(CTG_READ, &dbCache->dbLock);
-  }
-
-  if (dbCache->deleted) {
+  if (atomic_load_8(&dbCache->deleted)) {
     if (acquire) {
       ctgReleaseDBCache(pCtg, dbCache);
     }
@@ -169,7 +164,6 @@ void ctgReleaseVgInfoToCache(SCatalog *pCtg, SCtgDBCache *dbCache) {
 
 void ctgReleaseTbMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache *pCache) {
   if (pCache && dbCache) {
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
     taosHashRelease(dbCache->tbCache, pCache);
   }
 
@@ -203,7 +197,6 @@ void ctgReleaseTbIndexToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache
 
 void ctgReleaseVgMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache *pCache) {
   if (pCache && dbCache) {
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
     taosHashRelease(dbCache->tbCache, pCache);
   }
 
@@ -278,7 +271,6 @@ int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, const char *dbFName, const cha
     goto _return;
   }
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
   if (NULL == pCache->pMeta) {
     ctgDebug("tb %s meta not in cache, dbFName:%s", tbName, dbFName);
     goto _return;
@@ -336,7 +328,6 @@ int32_t ctgAcquireVgMetaFromCache(SCatalog *pCtg, const char *dbFName, const cha
     goto _return;
   }
 
-  CTG_LOCK(CTG_READ, &tbCache->metaLock);
   if (NULL == tbCache->pMeta) {
     ctgDebug("tb %s meta not in cache, dbFName:%s", tbName, dbFName);
     CTG_META_NHIT_INC();
@@ -354,7 +345,6 @@ int32_t ctgAcquireVgMetaFromCache(SCatalog *pCtg, const char *dbFName, const cha
 _return:
 
   if (tbCache) {
-    CTG_UNLOCK(CTG_READ, &tbCache->metaLock);
     taosHashRelease(dbCache->tbCache, tbCache);
   }
 
@@ -397,7 +387,6 @@ int32_t ctgAcquireStbMetaFromCache(SCatalog *pCtg, char *dbFName, uint64_t suid,
 
   taosHashRelease(dbCache->stbCache, stName);
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
   if (NULL == pCache->pMeta) {
     ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", suid, dbFName);
     goto _return;
@@ -443,7 +432,6 @@ int32_t ctgAcquireStbMetaFromCache(SCtgDBCache *dbCache, SCatalog *pCtg, char *d
 
   taosHashRelease(dbCache->stbCache, stName);
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
   if (NULL == pCache->pMeta) {
     ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", suid, dbFName);
     goto _return;
@@ -573,7 +561,6 @@ int32_t ctgCopyTbMeta(SCatalog *pCtg, SCtgTbMetaCtx *ctx, SCtgDBCache **pDb, SCt
 
   // ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
-  CTG_UNLOCK(CTG_READ, &tbCache->metaLock);
   taosHashRelease(dbCache->tbCache, tbCache);
   *pTb = NULL;
 
@@ -680,7 +667,6 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
 
   // ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
   if (tbCache) {
-    CTG_UNLOCK(CTG_READ, &tbCache->metaLock);
     taosHashRelease(dbCache->tbCache, tbCache);
   }
 
@@ -1749,24 +1735,33 @@ int32_t ctgRemoveDBFromCache(SCatalog *pCtg, SCtgDBCache *dbCache, const char *d
 
   ctgInfo("start to remove db from cache, dbFName:%s, dbId:0x%" PRIx64, dbFName, dbCache->dbId);
 
-  CTG_LOCK(CTG_WRITE, &dbCache->dbLock);
-
   atomic_store_8(&dbCache->deleted, 1);
   ctgRemoveStbRent(pCtg, dbCache);
   ctgRemoveViewRent(pCtg, dbCache);
   ctgRemoveTSMARent(pCtg, dbCache);
-  ctgFreeDbCache(dbCache);
 
-  CTG_UNLOCK(CTG_WRITE, &dbCache->dbLock);
+  // readers may still be using the caches of the db, they are freed after the readers leave
+  SCtgDBCache *pRetired = taosMemoryMalloc(sizeof(SCtgDBCache));
+  if (NULL == pRetired) {
+    CTG_ERR_RET(terrno);
+  }
+  TAOS_MEMCPY(pRetired, dbCache, sizeof(SCtgDBCache));
 
-  CTG_ERR_RET(ctgMetaRentRemove(&pCtg->dbRent, dbId, ctgDbCacheInfoSortCompare, ctgDbCacheInfoSearchCompare));
+  int32_t code = ctgMetaRentRemove(&pCtg->dbRent, dbId, ctgDbCacheInfoSortCompare, ctgDbCacheInfoSearchCompare);
+  if (code) {
+    taosMemoryFree(pRetired);
+    CTG_ERR_RET(code);
+  }
   ctgDebug("db removed from rent, dbFName:%s, dbId:0x%" PRIx64, dbFName, dbId);
 
   if (taosHashRemove(pCtg->dbCache, dbFName, strlen(dbFName))) {
     ctgInfo("taosHashRemove from dbCache failed, may be removed, dbFName:%s", dbFName);
+    taosMemoryFree(pRetired);
     CTG_ERR_RET(TSDB_CODE_CTG_DB_DROPPED);
   }
 
+  CTG_ERR_RET(ctgRcuRetire(pRetired, ctgFreeRetiredDbCache));
+
   CTG_CACHE_NUM_DEC(CTG_CI_DB, 1);
   ctgInfo("db removed from cache, dbFName:%s, dbId:0x%" PRIx64, dbFName, dbId);
 
@@ -1874,10 +1869,12 @@ int32_t ctgWriteTbMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, char *dbFNam
 
     (void)atomic_add_fetch_64(&dbCache->dbCacheSize, ctgGetTbMetaCacheSize(meta) - ctgGetTbMetaCacheSize(pCache->pMeta));
 
-    taosMemoryFree(pCache->pMeta);
-    pCache->pMeta = meta;
+    STableMeta *pRetired = pCache->pMeta;
+    atomic_store_ptr(&pCache->pMeta, meta);
     
     CTG_UNLOCK(CTG_WRITE, &pCache->metaLock);
+
+    (void)ctgRcuRetire(pRetired, taosMemoryFree);
   }
 
   CTG_META_NUM_INC(pCache->pMeta->tableType);
@@ -2224,9 +2221,8 @@ int32_t ctgOpUpdateVgroup(SCtgCacheOperation *operation) {
   
   CTG_ERR_JRET(ctgWLockVgInfo(msg->pCtg, dbCache));
 
-  if (vgCache->vgInfo) {
-    SDBVgInfo *vgInfo = vgCache->vgInfo;
-
+  SDBVgInfo *vgInfo = vgCache->vgInfo;
+  if (vgInfo && !vgCache->dropped) {
     if (dbInfo->vgVersion < vgInfo->vgVersion) {
       ctgDebug("db updateVgroup is ignored, dbFName:%s, vgVer:%d, curVer:%d", dbFName, dbInfo->vgVersion,
                vgInfo->vgVersion);
@@ -2249,7 +2245,6 @@ int32_t ctgOpUpdateVgroup(SCtgCacheOperation *operation) {
 
     (void)atomic_sub_fetch_64(&dbCache->dbCacheSize, groupCacheSize);
     
-    freeVgInfo(vgInfo);
     CTG_DB_NUM_RESET(CTG_CI_DB_VGROUP);
   }
 
@@ -2258,7 +2253,8 @@ int32_t ctgOpUpdateVgroup(SCtgCacheOperation *operation) {
     dbCacheInfo.tsmaVersion = dbCache->tsmaVersion;
   }
 
-  vgCache->vgInfo = dbInfo;
+  atomic_store_ptr(&vgCache->vgInfo, dbInfo);
+  atomic_store_8(&vgCache->dropped, 0);
   msg->dbInfo = NULL;
   CTG_DB_NUM_SET(CTG_CI_DB_VGROUP);
 
@@ -2267,6 +2263,8 @@ int32_t ctgOpUpdateVgroup(SCtgCacheOperation *operation) {
 
   ctgWUnlockVgInfo(dbCache);
 
+  (void)ctgRcuRetire(vgInfo, ctgFreeRetiredVgInfo);
+
   uint64_t groupCacheSize = ctgGetDbVgroupCacheSize(vgCache->vgInfo);
   (void)atomic_add_fetch_64(&dbCache->dbCacheSize, groupCacheSize);
   ctgDebug("add dbGroupCacheSize %" PRIu64 " from db, dbFName:%s", groupCacheSize, dbFName);
@@ -2316,7 +2314,7 @@ int32_t ctgOpUpdateDbCfg(SCtgCacheOperation *operation) {
   cacheInfo.cfgVersion = cfgInfo->cfgVersion;
 
   SCtgVgCache *vgCache = &dbCache->vgCache;
-  if (vgCache->vgInfo) {
+  if (vgCache->vgInfo && !vgCache->dropped) {
     cacheInfo.vgVersion = vgCache->vgInfo->vgVersion;
     cacheInfo.numOfTable = vgCache->vgInfo->numOfTable;
     cacheInfo.stateTs = vgCache->vgInfo->stateTs;
@@ -2396,10 +2394,11 @@ int32_t ctgOpDropDbVgroup(SCtgCacheOperation *operation) {
 
   CTG_ERR_JRET(ctgWLockVgInfo(pCtg, dbCache));
 
-  (void)atomic_sub_fetch_64(&dbCache->dbCacheSize, ctgGetDbVgroupCacheSize(dbCache->vgCache.vgInfo));
-
-  freeVgInfo(dbCache->vgCache.vgInfo);
-  dbCache->vgCache.vgInfo = NULL;
+  // readers that already passed the check keep using vgInfo, it is released by the next update
+  if (dbCache->vgCache.vgInfo && !dbCache->vgCache.dropped) {
+    (void)atomic_sub_fetch_64(&dbCache->dbCacheSize, ctgGetDbVgroupCacheSize(dbCache->vgCache.vgInfo));
+    atomic_store_8(&dbCache->vgCache.dropped, 1);
+  }
 
   CTG_DB_NUM_RESET(CTG_CI_DB_VGROUP);
   ctgDebug("db vgInfo removed, dbFName:%s", msg->dbFName);
@@ -2684,20 +2683,29 @@ int32_t ctgOpUpdateEpset(SCtgCacheOperation *operation) {
   CTG_ERR_JRET(ctgWLockVgInfo(pCtg, dbCache));
 
   SDBVgInfo *vgInfo = dbCache->vgCache.vgInfo;
-  if (NULL == vgInfo) {
+  if (NULL == vgInfo || dbCache->vgCache.dropped) {
     ctgDebug("vgroup in db %s not cached, ignore epset update", msg->dbFName);
     goto _return;
   }
 
-  SVgroupInfo *pInfo = taosHashGet(vgInfo->vgHash, &msg->vgId, sizeof(msg->vgId));
-  if (NULL == pInfo) {
+  if (NULL == taosHashGet(vgInfo->vgHash, &msg->vgId, sizeof(msg->vgId))) {
     ctgDebug("no vgroup %d in db %s vgHash, ignore epset update", msg->vgId, msg->dbFName);
     goto _return;
   }
 
-  SVgroupInfo *pInfo2 = taosArraySearch(vgInfo->vgArray, &msg->vgId, ctgVgInfoIdComp, TD_EQ);
-  if (NULL == pInfo2) {
-    ctgDebug("no vgroup %d in db %s vgArray, ignore epset update", msg->vgId, msg->dbFName);
+  // readers go without lock, update a copy and publish it
+  SDBVgInfo *pNewInfo = NULL;
+  code = ctgCloneVgInfo(vgInfo, &pNewInfo);
+  if (code) {
+    ctgWUnlockVgInfo(dbCache);
+    goto _return;
+  }
+
+  SVgroupInfo *pInfo = taosHashGet(pNewInfo->vgHash, &msg->vgId, sizeof(msg->vgId));
+  SVgroupInfo *pInfo2 = taosArraySearch(pNewInfo->vgArray, &msg->vgId, ctgVgInfoIdComp, TD_EQ);
+  if (NULL == pInfo || NULL == pInfo2) {
+    ctgDebug("no vgroup %d in db %s vgHash or vgArray, ignore epset update", msg->vgId, msg->dbFName);
+    freeVgInfo(pNewInfo);
     goto _return;
   }
 
@@ -2710,6 +2718,9 @@ int32_t ctgOpUpdateEpset(SCtgCacheOperation *operation) {
   pInfo->epSet = msg->epSet;
   pInfo2->epSet = msg->epSet;
 
+  atomic_store_ptr(&dbCache->vgCache.vgInfo, pNewInfo);
+  (void)ctgRcuRetire(vgInfo, ctgFreeRetiredVgInfo);
+
 _return:
 
   if (code == TSDB_CODE_SUCCESS && dbCache) {
@@ -3080,7 +3091,7 @@ static int32_t ctgOpUpdateDbRentForTsmaVersion(SCtgDBCache* pDbCache, SCtgUpdate
       tstrncpy(cacheInfo.dbFName, pDbCache->cfgCache.cfgInfo->db, TSDB_DB_FNAME_LEN);
     }
 
-    if (pDbCache->vgCache.vgInfo) {
+    if (pDbCache->vgCache.vgInfo && !pDbCache->vgCache.dropped) {
       cacheInfo.vgVersion = pDbCache->vgCache.vgInfo->vgVersion;
       cacheInfo.numOfTable = pDbCache->vgCache.vgInfo->numOfTable;
       cacheInfo.stateTs = pDbCache->vgCache.vgInfo->stateTs;
@@ -3293,6 +3304,8 @@ void *ctgUpdateThreadFunc(void *param) {
 
     CTG_STAT_RT_INC(numOfOpDequeue, 1);
 
+    ctgRcuReclaim(false);
+
     (void)ctgdShowCacheInfo();
     (void)ctgdShowStatInfo();
   }
@@ -3463,9 +3476,7 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    CTG_LOCK(CTG_READ, &pCache->metaLock);
     if (NULL == pCache->pMeta) {
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
       taosHashRelease(dbCache->tbCache, pCache);
       
       ctgDebug("tb %s meta not in cache, dbFName:%s", pName->tname, dbFName);
@@ -3514,7 +3525,6 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
         pTableMeta->schemaExt = NULL;
       }
 
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, pTableMeta->tableType, dbFName);
@@ -3532,14 +3542,12 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
     if (lastSuid && tbMeta->suid == lastSuid && lastTableMeta) {
       code = cloneTableMeta(lastTableMeta, &pTableMeta);
       if (code) {
-        CTG_UNLOCK(CTG_READ, &pCache->metaLock);
         taosHashRelease(dbCache->tbCache, pCache);
         CTG_ERR_JRET(code);
       }
       
       TAOS_MEMCPY(pTableMeta, tbMeta, sizeof(SCTableMeta));
 
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, pTableMeta->tableType, dbFName);
@@ -3561,7 +3569,6 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     TAOS_MEMCPY(pTableMeta, tbMeta, metaSize);
 
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
     taosHashRelease(dbCache->tbCache, pCache);
 
     ctgDebug("Got ctb %s meta from cache, will continue to get its stb meta, type:%d, dbFName:%s", pName->tname,
@@ -3598,10 +3605,8 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     taosHashRelease(dbCache->stbCache, stName);
 
-    CTG_LOCK(CTG_READ, &pCache->metaLock);
     if (NULL == pCache->pMeta) {
       ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", pTableMeta->suid, dbFName);
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
       taosHashRelease(dbCache->tbCache, pCache);
 
       CTG_ERR_JRET(ctgAddFetch(&ctx->pFetchs, dbIdx, i, fetchIdx, baseResIdx + i, flag));
@@ -3617,7 +3622,6 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     STableMeta *stbMeta = pCache->pMeta;
     if (stbMeta->suid != nctx.tbInfo.suid) {
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid 0x%" PRIx64, stbMeta->suid,
@@ -3652,7 +3656,6 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       pTableMeta->schemaExt = NULL;
     }
 
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
     taosHashRelease(dbCache->tbCache, pCache);
 
     CTG_META_HIT_INC(pTableMeta->tableType);
@@ -3947,9 +3950,7 @@ int32_t ctgGetTbTSMAFromCache(SCatalog* pCtg, SCtgTbTSMACtx* pCtx, int32_t dbIdx
       continue;
     }
     
-    CTG_LOCK(CTG_READ, &pTbCache->metaLock);
     if (!pTbCache->pMeta) {
-      CTG_UNLOCK(CTG_READ, &pTbCache->metaLock);
       ctgDebug("tb: %s.%s not in cache", dbFName, pName->tname);
       
       CTG_ERR_JRET(ctgAddTSMAFetch(&pCtx->pFetches, dbIdx, i, fetchIdx, baseResIdx + i, flag, FETCH_TSMA_SOURCE_TB_META, NULL));
@@ -3961,9 +3962,9 @@ int32_t ctgGetTbTSMAFromCache(SCatalog* pCtg, SCtgTbTSMACtx* pCtx, int32_t dbIdx
       
       continue;
     }
-    uint64_t suid = pTbCache->pMeta->suid;
-    int8_t   tbType = pTbCache->pMeta->tableType;
-    CTG_UNLOCK(CTG_READ, &pTbCache->metaLock);
+    STableMeta *pTbMeta = pTbCache->pMeta;
+    uint64_t    suid = pTbMeta->suid;
+    int8_t      tbType = pTbMeta->tableType;
     
     taosHashRelease(dbCache->tbCache, pTbCache);
     SName tsmaSourceTbName = *pName;
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catalogInt.h"
+
+/*
+ * Epoch based reclamation for the db cache, db vgroup info and table meta read by many threads.
+ *
+ * Every reading thread owns a record and stamps it with the global epoch on its outermost read lock. Writers publish a
+ * new object and retire the old one with the current epoch, then advance the epoch. A retired object is freed once no
+ * record holds an epoch not newer than its own, so no reader that could have seen it is left. A record only pins the
+ * epoch of its own thread, so a busy reader never holds back objects retired after it entered.
+ *
+ * Records are released when their thread exits and taken over by new threads, they are never freed.
+ */
+
+static SCtgRcuRecord             *ctgRcuRecords = NULL;
+static TdThreadOnce               ctgRcuKeyInit = PTHREAD_ONCE_INIT;
+static TdThreadKey                ctgRcuKey;
+static threadlocal SCtgRcuRecord *ctgRcuRecord = NULL;
+static threadlocal int32_t        ctgRcuNesting = 0;
+static threadlocal bool           ctgRcuUnrecorded = false;
+
+static void ctgRcuReleaseRecord(void *param) {
+  SCtgRcuRecord *pRecord = param;
+  atomic_store_64(&pRecord->epoch, CTG_RCU_IDLE);
+  atomic_store_8(&pRecord->inUse, 0);
+}
+
+static void ctgRcuInitKey(void) {
+  if (taosThreadKeyCreate(&ctgRcuKey, ctgRcuReleaseRecord) != 0) {
+    qError("failed to create catalog rcu thread key, records of exited threads are not reused");
+  }
+}
+
+static SCtgRcuRecord *ctgRcuAcquireRecord(void) {
+  SCtgRcuRecord *pRecord = atomic_load_ptr(&ctgRcuRecords);
+  for (; pRecord; pRecord = pRecord->next) {
+    if (0 == atomic_val_compare_exchange_8(&pRecord->inUse, 0, 1)) {
+      break;
+    }
+  }
+
+  if (NULL == pRecord) {
+    pRecord = taosMemoryCalloc(1, sizeof(SCtgRcuRecord));
+    if (NULL == pRecord) {
+      return NULL;
+    }
+    pRecord->epoch = CTG_RCU_IDLE;
+    pRecord->inUse = 1;
+    while (true) {
+      pRecord->next = atomic_load_ptr(&ctgRcuRecords);
+      if (atomic_val_compare_exchange_ptr(&ctgRcuRecords, pRecord->next, pRecord) == pRecord->next) {
+        break;
+      }
+    }
+  }
+
+  (void)taosThreadOnce(&ctgRcuKeyInit, ctgRcuInitKey);
+  (void)taosThreadSetSpecific(ctgRcuKey, pRecord);
+  return pRecord;
+}
+
+void ctgRcuReadLock(void) {
+  if (ctgRcuNesting++ > 0) {
+    return;
+  }
+
+  if (NULL == ctgRcuRecord) {
+    ctgRcuRecord = ctgRcuAcquireRecord();
+  }
+  if (NULL == ctgRcuRecord) {
+    ctgRcuUnrecorded = true;
+    (void)atomic_add_fetch_64(&gCtgMgmt.rcu.unrecordedReaders, 1);
+    return;
+  }
+
+  // the epoch must be visible in the record before any pointer is read, retry if a writer advanced it meanwhile
+  int64_t epoch = atomic_load_64(&gCtgMgmt.rcu.epoch);
+  while (true) {
+    atomic_store_64(&ctgRcuRecord->epoch, epoch);
+    int64_t curr = atomic_load_64(&gCtgMgmt.rcu.epoch);
+    if (curr == epoch) {
+      break;
+    }
+    epoch = curr;
+  }
+}
+
+void ctgRcuReadUnlock(void) {
+  if (--ctgRcuNesting > 0) {
+    return;
+  }
+
+  if (ctgRcuUnrecorded) {
+    ctgRcuUnrecorded = false;
+    (void)atomic_sub_fetch_64(&gCtgMgmt.rcu.unrecordedReaders, 1);
+  } else {
+    atomic_store_64(&ctgRcuRecord->epoch, CTG_RCU_IDLE);
+  }
+}
+
+int32_t ctgRcuRetire(void *p, FCtgRcuFree freeFp) {
+  if (NULL == p) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SCtgRcuNode *pNode = taosMemoryCalloc(1, sizeof(SCtgRcuNode));
+  if (NULL == pNode) {
+    qError("calloc %d failed, retired object %p leaked", (int32_t)sizeof(SCtgRcuNode), p);
+    CTG_ERR_RET(terrno);
+  }
+
+  pNode->p = p;
+  pNode->freeFp = freeFp;
+
+  CTG_LOCK(CTG_WRITE, &gCtgMgmt.rcu.lock);
+  pNode->epoch = atomic_fetch_add_64(&gCtgMgmt.rcu.epoch, 1);
+  if (gCtgMgmt.rcu.tail) {
+    gCtgMgmt.rcu.tail->next = pNode;
+  } else {
+    gCtgMgmt.rcu.head = pNode;
+  }
+  gCtgMgmt.rcu.tail = pNode;
+  gCtgMgmt.rcu.retiredNum++;
+  CTG_UNLOCK(CTG_WRITE, &gCtgMgmt.rcu.lock);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * The epoch before which retired objects can not be seen by any reader. It is bounded by the global epoch taken before
+ * the records are scanned: a reader not seen by the scan entered after that and stamps an epoch not older than it, and
+ * an object retired meanwhile gets an epoch not older than it either.
+ */
+int64_t ctgRcuGetSafeEpoch(void) {
+  int64_t minEpoch = atomic_load_64(&gCtgMgmt.rcu.epoch);
+  if (atomic_load_64(&gCtgMgmt.rcu.unrecordedReaders) > 0) {
+    return INT64_MIN;
+  }
+  for (SCtgRcuRecord *pRecord = atomic_load_ptr(&ctgRcuRecords); pRecord; pRecord = pRecord->next) {
+    int64_t epoch = atomic_load_64(&pRecord->epoch);
+    if (CTG_RCU_IDLE != epoch && epoch < minEpoch) {
+      minEpoch = epoch;
+    }
+  }
+
+  return minEpoch;
+}
+
+void ctgRcuFreeRetired(int64_t minEpoch) {
+  SCtgRcuNode *pFree = NULL;
+  SCtgRcuNode *pLast = NULL;
+  int64_t      freeNum = 0;
+
+  CTG_LOCK(CTG_WRITE, &gCtgMgmt.rcu.lock);
+  while (gCtgMgmt.rcu.head && gCtgMgmt.rcu.head->epoch < minEpoch) {
+    SCtgRcuNode *pNode = gCtgMgmt.rcu.head;
+    gCtgMgmt.rcu.head = pNode->next;
+    pNode->next = NULL;
+    if (pLast) {
+      pLast->next = pNode;
+    } else {
+      pFree = pNode;
+    }
+    pLast = pNode;
+    freeNum++;
+  }
+  if (NULL == gCtgMgmt.rcu.head) {
+    gCtgMgmt.rcu.tail = NULL;
+  }
+  gCtgMgmt.rcu.retiredNum -= freeNum;
+  CTG_UNLOCK(CTG_WRITE, &gCtgMgmt.rcu.lock);
+
+  while (pFree) {
+    SCtgRcuNode *pNode = pFree;
+    pFree = pNode->next;
+    (*pNode->freeFp)(pNode->p);
+    taosMemoryFree(pNode);
+  }
+
+  if (freeNum > 0) {
+    qDebug("%" PRId64 " retired catalog objects freed, %" PRId64 " left", freeNum,
+           atomic_load_64(&gCtgMgmt.rcu.retiredNum));
+  }
+}
+
+void ctgRcuReclaim(bool force) { ctgRcuFreeRetired(force ? INT64_MAX : ctgRcuGetSafeEpoch()); }
@@ -248,11 +248,10 @@ void ctgFreeStbMetaCache(SCtgDBCache* dbCache) {
 void ctgFreeTbCacheImpl(SCtgTbCache* pCache, bool lock) {
   if (pCache->pMeta) {
     if (lock) {
-      CTG_LOCK(CTG_WRITE, &pCache->metaLock);
-    }
-    taosMemoryFreeClear(pCache->pMeta);
-    if (lock) {
-      CTG_UNLOCK(CTG_WRITE, &pCache->metaLock);
+      // the entry is being removed, readers that still hold it keep the meta until they leave
+      (void)ctgRcuRetire(pCache->pMeta, taosMemoryFree);
+    } else {
+      taosMemoryFreeClear(pCache->pMeta);
     }
   }
 
@@ -350,6 +349,13 @@ void ctgFreeDbCache(SCtgDBCache* dbCache) {
   ctgFreeTSMACache(dbCache);
 }
 
+void ctgFreeRetiredDbCache(void* p) {
+  ctgFreeDbCache((SCtgDBCache*)p);
+  taosMemoryFree(p);
+}
+
+void ctgFreeRetiredVgInfo(void* p) { freeVgInfo((SDBVgInfo*)p); }
+
 void ctgFreeInstDbCache(SHashObj* pDbCache) {
   if (NULL == pDbCache) {
     return;
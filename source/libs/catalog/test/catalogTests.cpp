@@ -3232,6 +3232,210 @@ TEST(intTest, autoCreateTableTest) {
 
 #endif
 
+int32_t ctgTestRcuFreedNum = 0;
+void    ctgTestRcuFree(void *p) {
+  ++ctgTestRcuFreedNum;
+  taosMemoryFree(p);
+}
+
+TEST(rcuTest, reclaimAfterReaders) {
+  ctgRcuReclaim(true);
+  ctgTestRcuFreedNum = 0;
+
+  ctgRcuReadLock();
+  ASSERT_EQ(ctgRcuRetire(taosMemoryMalloc(8), ctgTestRcuFree), 0);
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 0);
+
+  ctgRcuReadLock();
+  ctgRcuReadUnlock();
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 0);
+
+  ctgRcuReadUnlock();
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 1);
+
+  ASSERT_EQ(ctgRcuRetire(taosMemoryMalloc(8), ctgTestRcuFree), 0);
+  ctgRcuReadLock();
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 2);
+  ctgRcuReadUnlock();
+}
+
+TEST(rcuTest, nestedAndOtherThreadReaders) {
+  ctgRcuReclaim(true);
+  ctgTestRcuFreedNum = 0;
+
+  // a reader that entered after the retire does not hold the object back
+  ASSERT_EQ(ctgRcuRetire(taosMemoryMalloc(8), ctgTestRcuFree), 0);
+  ctgRcuReadLock();
+  ctgRcuReadLock();
+  ASSERT_EQ(ctgRcuRetire(taosMemoryMalloc(8), ctgTestRcuFree), 0);
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 1);
+  ctgRcuReadUnlock();
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 1);
+  ctgRcuReadUnlock();
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 2);
+}
+
+TEST(rcuTest, scanBeforeReaderEnters) {
+  ctgRcuReclaim(true);
+  ctgTestRcuFreedNum = 0;
+
+  // the records are scanned while no reader is in, then a reader enters and sees the object before it is retired
+  int64_t safeEpoch = ctgRcuGetSafeEpoch();
+  ctgRcuReadLock();
+  ASSERT_EQ(ctgRcuRetire(taosMemoryMalloc(8), ctgTestRcuFree), 0);
+  ctgRcuFreeRetired(safeEpoch);
+  ASSERT_EQ(ctgTestRcuFreedNum, 0);
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 0);
+  ctgRcuReadUnlock();
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 1);
+
+  // the same for a reader that got no record
+  safeEpoch = ctgRcuGetSafeEpoch();
+  (void)atomic_add_fetch_64(&gCtgMgmt.rcu.unrecordedReaders, 1);
+  ASSERT_EQ(ctgRcuRetire(taosMemoryMalloc(8), ctgTestRcuFree), 0);
+  ctgRcuFreeRetired(safeEpoch);
+  ASSERT_EQ(ctgTestRcuFreedNum, 1);
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 1);
+  (void)atomic_sub_fetch_64(&gCtgMgmt.rcu.unrecordedReaders, 1);
+  ctgRcuReclaim(false);
+  ASSERT_EQ(ctgTestRcuFreedNum, 2);
+}
+
+#define CTG_TEST_RCU_LIVE 0x1234567887654321LL
+#define CTG_TEST_RCU_DEAD 0x0LL
+
+typedef struct SCtgTestRcuObj {
+  int64_t magic;
+  int64_t version;
+} SCtgTestRcuObj;
+
+SCtgTestRcuObj *ctgTestRcuObj = NULL;
+int32_t         ctgTestRcuStop = 0;
+int64_t         ctgTestRcuReads = 0;
+int64_t         ctgTestRcuBadReads = 0;
+int64_t         ctgTestRcuRetiredFreed = 0;
+SArray         *ctgTestRcuGraveyard = NULL;
+TdThreadMutex   ctgTestRcuGraveLock;
+
+// retired objects are poisoned and kept until the end of the test, so a reader that sees one is caught
+void ctgTestRcuPoison(void *p) {
+  SCtgTestRcuObj *pObj = (SCtgTestRcuObj *)p;
+  atomic_store_64(&pObj->magic, CTG_TEST_RCU_DEAD);
+  (void)atomic_add_fetch_64(&ctgTestRcuRetiredFreed, 1);
+  (void)taosThreadMutexLock(&ctgTestRcuGraveLock);
+  (void)taosArrayPush(ctgTestRcuGraveyard, &p);
+  (void)taosThreadMutexUnlock(&ctgTestRcuGraveLock);
+}
+
+void *ctgTestRcuReaderThread(void *param) {
+  int64_t lastVersion = 0;
+  while (0 == atomic_load_32(&ctgTestRcuStop)) {
+    ctgRcuReadLock();
+    SCtgTestRcuObj *pObj = (SCtgTestRcuObj *)atomic_load_ptr(&ctgTestRcuObj);
+    for (int32_t i = 0; i < 8; ++i) {
+      if (CTG_TEST_RCU_LIVE != atomic_load_64(&pObj->magic)) {
+        (void)atomic_add_fetch_64(&ctgTestRcuBadReads, 1);
+        break;
+      }
+      if (0 == (i & 3)) {
+        (void)sched_yield();
+      }
+    }
+    if (pObj->version < lastVersion) {
+      (void)atomic_add_fetch_64(&ctgTestRcuBadReads, 1);
+    }
+    lastVersion = pObj->version;
+    ctgRcuReadUnlock();
+    (void)atomic_add_fetch_64(&ctgTestRcuReads, 1);
+  }
+  return NULL;
+}
+
+void *ctgTestRcuReclaimThread(void *param) {
+  while (0 == atomic_load_32(&ctgTestRcuStop)) {
+    ctgRcuReclaim(false);
+    taosUsleep(100);
+  }
+  return NULL;
+}
+
+TEST(rcuTest, concurrentReadersAndWriter) {
+  const int32_t readerNum = 8;
+  const int64_t writeNum = 20000;
+  TdThread      readers[readerNum];
+  TdThread      reclaimer;
+  TdThreadAttr  thattr;
+
+  ctgRcuReclaim(true);
+  ctgTestRcuStop = 0;
+  ctgTestRcuReads = 0;
+  ctgTestRcuBadReads = 0;
+  ctgTestRcuRetiredFreed = 0;
+  ctgTestRcuGraveyard = taosArrayInit(writeNum, POINTER_BYTES);
+  ASSERT_NE(ctgTestRcuGraveyard, nullptr);
+  ASSERT_EQ(taosThreadMutexInit(&ctgTestRcuGraveLock, NULL), 0);
+
+  ctgTestRcuObj = (SCtgTestRcuObj *)taosMemoryMalloc(sizeof(SCtgTestRcuObj));
+  ctgTestRcuObj->magic = CTG_TEST_RCU_LIVE;
+  ctgTestRcuObj->version = 0;
+
+  ASSERT_EQ(taosThreadAttrInit(&thattr), 0);
+  ASSERT_EQ(taosThreadAttrSetDetachState(&thattr, PTHREAD_CREATE_JOINABLE), 0);
+  for (int32_t i = 0; i < readerNum; ++i) {
+    ASSERT_EQ(taosThreadCreate(&readers[i], &thattr, ctgTestRcuReaderThread, NULL), 0);
+  }
+  ASSERT_EQ(taosThreadCreate(&reclaimer, &thattr, ctgTestRcuReclaimThread, NULL), 0);
+
+  // the readers never leave the read side all together, retired objects must still be freed while they run
+  int64_t freedWhileReading = 0;
+  for (int64_t v = 1; v <= writeNum; ++v) {
+    SCtgTestRcuObj *pNew = (SCtgTestRcuObj *)taosMemoryMalloc(sizeof(SCtgTestRcuObj));
+    pNew->magic = CTG_TEST_RCU_LIVE;
+    pNew->version = v;
+    SCtgTestRcuObj *pOld = (SCtgTestRcuObj *)atomic_exchange_ptr(&ctgTestRcuObj, pNew);
+    ASSERT_EQ(ctgRcuRetire(pOld, ctgTestRcuPoison), 0);
+    if (0 == (v % 1000)) {
+      taosMsleep(1);
+    }
+  }
+  for (int32_t i = 0; i < 1000 && atomic_load_64(&ctgTestRcuRetiredFreed) < writeNum; ++i) {
+    taosMsleep(10);
+  }
+  freedWhileReading = atomic_load_64(&ctgTestRcuRetiredFreed);
+
+  atomic_store_32(&ctgTestRcuStop, 1);
+  for (int32_t i = 0; i < readerNum; ++i) {
+    (void)taosThreadJoin(readers[i], NULL);
+  }
+  (void)taosThreadJoin(reclaimer, NULL);
+  (void)taosThreadAttrDestroy(&thattr);
+
+  EXPECT_EQ(ctgTestRcuBadReads, 0);
+  EXPECT_GT(ctgTestRcuReads, 0);
+  EXPECT_EQ(freedWhileReading, writeNum);
+
+  ctgRcuReclaim(false);
+  EXPECT_EQ(ctgTestRcuRetiredFreed, writeNum);
+  EXPECT_EQ(atomic_load_64(&gCtgMgmt.rcu.retiredNum), 0);
+
+  for (int32_t i = 0; i < taosArrayGetSize(ctgTestRcuGraveyard); ++i) {
+    taosMemoryFree(*(void **)taosArrayGet(ctgTestRcuGraveyard, i));
+  }
+  taosArrayDestroy(ctgTestRcuGraveyard);
+  (void)taosThreadMutexDestroy(&ctgTestRcuGraveLock);
+  taosMemoryFreeClear(ctgTestRcuObj);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -79,6 +79,7 @@ extern "C" {
 #define EXPLAIN_COUNT_NUM_FORMAT "Window Count=%" PRId64
 #define EXPLAIN_COUNT_SLIDING_FORMAT "Window Sliding=%" PRId64
 #define EXPLAIN_TABLE_TIMERANGE_FORMAT "%s Table Time Range: [%" PRId64 ", %" PRId64 "]"
+#define EXPLAIN_PROFILE_FORMAT "Profile: "
 
 #define EXPLAIN_PLANNING_TIME_FORMAT "Planning Time: %.3f ms"
 #define EXPLAIN_EXEC_TIME_FORMAT "Execution Time: %.3f ms"
@@ -123,6 +124,11 @@ extern "C" {
 #define EXPLAIN_SEQ_WIN_GRP_FORMAT "seq_win_grp=%d"
 #define EXPLAIN_GRP_JOIN_FORMAT "group_join=%d"
 #define EXPLAIN_JOIN_ALGO "algo=%s"
+#define EXPLAIN_PROF_INPUT_FORMAT "input_rows=%.1f input_blocks=%.1f"
+#define EXPLAIN_PROF_LOAD_FORMAT "load_blocks=%.1f skip_blocks=%.1f load_bytes=%.1f load_time=%.3f"
+#define EXPLAIN_PROF_FILTER_FORMAT "filter_time=%.3f"
+#define EXPLAIN_PROF_AGG_FORMAT "agg_time=%.3f"
+#define EXPLAIN_PROF_HASH_FORMAT "hash_probes=%.1f avg_match_rows=%.2f"
 
 #define COMMAND_RESET_LOG "resetLog"
 #define COMMAND_SCHEDULE_POLICY "schedulePolicy"
@@ -1900,6 +1900,66 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t qExplainAppendProfRow(SArray *pExecInfo, SExplainCtx *ctx, int32_t level) {
+  int32_t          tlen = 0;
+  bool             isVerboseLine = true;
+  char            *tbuf = ctx->tbuf;
+  int32_t          nodeNum = taosArrayGetSize(pExecInfo);
+  SExplainProfInfo prof = {0};
+
+  for (int32_t i = 0; i < nodeNum; ++i) {
+    SExplainProfInfo *p = &((SExplainExecInfo *)taosArrayGet(pExecInfo, i))->prof;
+    prof.inputRows += p->inputRows;
+    prof.inputBlocks += p->inputBlocks;
+    prof.loadBlocks += p->loadBlocks;
+    prof.skipBlocks += p->skipBlocks;
+    prof.loadBytes += p->loadBytes;
+    prof.loadTime += p->loadTime;
+    prof.filterTime += p->filterTime;
+    prof.aggTime += p->aggTime;
+    prof.hashProbes += p->hashProbes;
+    prof.hashMatchRows += p->hashMatchRows;
+  }
+
+  bool gotLoad = prof.loadBlocks > 0 || prof.skipBlocks > 0;
+  if (0 == nodeNum || (0 == prof.inputBlocks && !gotLoad && 0 == prof.filterTime && 0 == prof.aggTime &&
+                       0 == prof.hashProbes)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // values are averaged over the tasks of the node, the same as the I/O row of table scan
+  EXPLAIN_ROW_NEW(level, EXPLAIN_PROFILE_FORMAT);
+  if (prof.inputBlocks > 0) {
+    EXPLAIN_ROW_APPEND(EXPLAIN_PROF_INPUT_FORMAT, ((double)prof.inputRows) / nodeNum,
+                       ((double)prof.inputBlocks) / nodeNum);
+    EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  }
+  if (gotLoad) {
+    EXPLAIN_ROW_APPEND(EXPLAIN_PROF_LOAD_FORMAT, ((double)prof.loadBlocks) / nodeNum,
+                       ((double)prof.skipBlocks) / nodeNum, ((double)prof.loadBytes) / nodeNum,
+                       prof.loadTime / nodeNum);
+    EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  }
+  if (prof.filterTime > 0) {
+    EXPLAIN_ROW_APPEND(EXPLAIN_PROF_FILTER_FORMAT, prof.filterTime / nodeNum);
+    EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  }
+  if (prof.aggTime > 0) {
+    EXPLAIN_ROW_APPEND(EXPLAIN_PROF_AGG_FORMAT, prof.aggTime / nodeNum);
+    EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  }
+  if (prof.hashProbes > 0) {
+    EXPLAIN_ROW_APPEND(EXPLAIN_PROF_HASH_FORMAT, ((double)prof.hashProbes) / nodeNum,
+                       ((double)prof.hashMatchRows) / prof.hashProbes);
+    EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  }
+  EXPLAIN_ROW_END();
+
+  QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t qExplainResNodeToRows(SExplainResNode *pResNode, SExplainCtx *ctx, int32_t level) {
   if (NULL == pResNode) {
     qError("explain res node is NULL");
@@ -1908,6 +1968,9 @@ int32_t qExplainResNodeToRows(SExplainResNode *pResNode, SExplainCtx *ctx, int32
 
   int32_t code = 0;
   QRY_ERR_RET(qExplainResNodeToRowsImpl(pResNode, ctx, level));
+  if (EXPLAIN_MODE_ANALYZE == ctx->mode && ctx->verbose && pResNode->pExecInfo) {
+    QRY_ERR_RET(qExplainAppendProfRow(pResNode->pExecInfo, ctx, level + 1));
+  }
 
   SNode *pNode = NULL;
   FOREACH(pNode, pResNode->pChildren) { QRY_ERR_RET(qExplainResNodeToRows((SExplainResNode *)pNode, ctx, level + 1)); }
@@ -156,6 +156,12 @@ typedef struct SLimitInfo {
   int64_t  numOfOutputRows;
 } SLimitInfo;
 
+typedef struct SSTabFltArg {
+  void*        pMeta;
+  void*        pVnode;
+  SStorageAPI* pAPI;
+} SSTabFltArg;
+
 typedef struct SSortMergeJoinOperatorParam {
   bool initDownstream;
 } SSortMergeJoinOperatorParam;
@@ -264,6 +270,7 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  SSortTopKBound* pTopKBound;  // owned by the upstream sort with limit, if any
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -573,11 +580,44 @@ typedef struct SMergeAlignedIntervalAggOperatorInfo {
   SResultRow*  pResultRow;
 } SMergeAlignedIntervalAggOperatorInfo;
 
+typedef struct STimeSliceOperatorInfo {
+  SSDataBlock*         pRes;
+  STimeWindow          win;
+  SInterval            interval;
+  int64_t              current;
+  SArray*              pPrevRow;     // SArray<SGroupValue>
+  SArray*              pNextRow;     // SArray<SGroupValue>
+  SArray*              pLinearInfo;  // SArray<SFillLinearInfo>
+  bool                 isPrevRowSet;
+  bool                 isNextRowSet;
+  int32_t              fillType;      // fill type
+  SColumn              tsCol;         // primary timestamp column
+  SExprSupp            scalarSup;     // scalar calculation
+  struct SFillColInfo* pFillColInfo;  // fill column info
+  SRowKey              prevKey;
+  bool                 prevTsSet;
+  uint64_t             groupId;
+  SArray*              pPrevGroupKeys;
+  SSDataBlock*         pNextGroupRes;
+  SSDataBlock*         pRemainRes;   // save block unfinished processing
+  int32_t              remainIndex;  // the remaining index in the block to be processed
+  bool                 hasPk;
+  SColumn              pkCol;
+  bool                 batchInterp;  // generate the grid points of a gap at once rather than one by one
+} STimeSliceOperatorInfo;
+
 typedef struct SOpCheckPointInfo {
   uint16_t  checkPointId;
   SHashObj* children;  // key:child id
 } SOpCheckPointInfo;
 
+// rows [startPos, startPos + rows) of a block fall into window win
+typedef struct SStreamIntervalRun {
+  STimeWindow win;
+  int32_t     startPos;
+  int32_t     rows;
+} SStreamIntervalRun;
+
 typedef struct SStreamIntervalOperatorInfo {
   SOptrBasicInfo      binfo;  // basic info
   SSteamOpBasicInfo   basic;
@@ -622,6 +662,7 @@ typedef struct SStreamIntervalOperatorInfo {
   int32_t             midDelIndex;
   SSHashObj*          pDeletedMap;
   bool                destHasPrimaryKey;
+  SArray*             pWinRuns;  // SStreamIntervalRun, the window runs of an append-only block
   struct SOperatorInfo* pOperator;
 } SStreamIntervalOperatorInfo;
 
@@ -870,8 +911,11 @@ int32_t     getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, uint32_t* de
 extern void doDestroyExchangeOperatorInfo(void* param);
 
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo);
+bool    doPruneBlockByTopKBound(const SSortTopKBound* pBound, const SColumnDataAgg* pColsAgg, int32_t numOfRows);
 int32_t addTagPseudoColumnData(SReadHandle* pHandle, const SExprInfo* pExpr, int32_t numOfExpr, SSDataBlock* pBlock,
                                int32_t rows, SExecTaskInfo* pTask, STableMetaCacheInfo* pCache);
+int32_t optSysTabFilte(void* arg, SNode* cond, SArray* result);
+int32_t sysTableGetBatchRows(const SLimitInfo* pLimitInfo, bool hasFilter, int32_t capacity);
 
 int32_t appendOneRowToDataBlock(SSDataBlock* pBlock, STupleHandle* pTupleHandle);
 int32_t setTbNameColData(const SSDataBlock* pBlock, SColumnInfoData* pColInfoData, int32_t functionId,
@@ -24,6 +24,12 @@ extern "C" {
 #define HJOIN_BLK_SIZE_LIMIT 10485760
 #define HJOIN_ROW_BITMAP_SIZE (2 * 1048576)
 #define HJOIN_BLK_THRESHOLD_RATIO 0.9
+#define HJOIN_PART_BITS 6
+#define HJOIN_PART_NUM (1 << HJOIN_PART_BITS)
+#define HJOIN_PART_MAX_LEVEL (32 / HJOIN_PART_BITS - 1)
+#define HJOIN_NMATCH_PART HJOIN_PART_NUM
+#define HJOIN_SPILL_PAGE_SIZE 65536
+#define HJOIN_SPILL_BUF_SIZE (32 * 1048576)
 
 typedef int32_t (*hJoinImplFp)(SOperatorInfo*);
 
@@ -126,8 +132,44 @@ typedef struct SHJoinExecInfo {
   int64_t probeBlkRows;
   int64_t resRows;
   int64_t expectRows;
+  int64_t hashRows;
+  int64_t spillBuildRows;
+  int64_t spillProbeRows;
+  int64_t spillPartSplits;
+  int64_t spillMaxLevel;
 } SHJoinExecInfo;
 
+typedef struct SHJoinPartition {
+  SArray*      pBuildPages;   // SArray<int32_t>, pages of build rows in the build buffer
+  SArray*      pProbePages;   // SArray<int32_t>, pages of probe blocks in the probe buffer
+  SSDataBlock* pProbeBlk;     // probe rows not written to a page yet
+  int64_t      buildRows;
+  int64_t      buildSize;     // bytes of the build records
+  int32_t      level;         // which HJOIN_PART_BITS of the key hash choose this partition
+  int32_t      childIdx;      // first of its HJOIN_PART_NUM sub partitions once split, -1 otherwise
+} SHJoinPartition;
+
+// build side rows are kept as [keyLen][valLen][key][val] records, probe side rows as serialized blocks.
+// pParts starts with HJOIN_PART_NUM partitions and an extra one holding the probe rows out of the time range,
+// which can only be output as not matched. A partition too large to be loaded is split by the next bits of
+// the key hash into sub partitions appended to pParts.
+typedef struct SHJoinSpillCtx {
+  _hash_fn_t      hashFp;
+  SDiskbasedBuf*  pBuildBuf;
+  SDiskbasedBuf*  pProbeBuf;
+  int32_t         buildPageSize;
+  int32_t         probeBlkRows;
+  bool            probePartitioned;
+  int32_t*        pRowPart;
+  int32_t*        pRowIdx;
+  int32_t         rowBufSize;
+  int32_t         partIdx;
+  int32_t         loadedPartIdx;
+  int32_t         pageIdx;
+  SSDataBlock*    pProbeBlk;
+  SArray*         pParts;  // SArray<SHJoinPartition>
+} SHJoinSpillCtx;
+
 
 typedef struct SHJoinOperatorInfo {
   EJoinType        joinType;
@@ -145,6 +187,8 @@ typedef struct SHJoinOperatorInfo {
   SArray*          pRowBufs;
   SSHashObj*       pKeyHash;
   bool             keyHashBuilt;
+  SHJoinSpillCtx*  pSpill;
+  int64_t          buildMemLimit;
   SHJoinCtx        ctx;
   SHJoinExecInfo   execInfo;
   int32_t          blkThreshold;
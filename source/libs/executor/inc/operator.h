@@ -68,6 +68,7 @@ typedef struct SOperatorInfo {
   SExprSupp              exprSupp;
   SExecTaskInfo*         pTaskInfo;
   SOperatorCostInfo      cost;
+  SExplainProfInfo       prof;
   SResultInfo            resultInfo;
   SOperatorParam*        pOperatorGetParam;
   SOperatorParam*        pOperatorNotifyParam;
@@ -28,6 +28,12 @@ void saveStreamOperatorStateComplete(SSteamOpBasicInfo* pBasicInfo);
 
 void reuseOutputBuf(void* pState, SRowBuffPos* pPos, SStateStore* pAPI);
 
+int32_t getNexWindowPos(SInterval* pInterval, SDataBlockInfo* pBlockInfo, TSKEY* tsCols, int32_t startPos, TSKEY eKey,
+                        STimeWindow* pNextWin);
+
+int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock, uint64_t groupId,
+                                SSHashObj* pUpdatedMap, SSHashObj* pDeletedMap);
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,7 @@ typedef struct SFillInfo {
   SRowVal      next;
   SSDataBlock* pSrcBlock;
   int32_t      alloc;  // data buffer size in rows
+  bool         fillNRows;  // generate the missing windows of a gap column by column rather than row by row
 
   SFillColInfo*    pFillCol;  // column info for fill operations
   SFillTagColInfo* pTags;     // tags value for filling gap
@@ -66,6 +66,16 @@ typedef struct SMsortComparParam {
 typedef struct SSortHandle  SSortHandle;
 typedef struct STupleHandle STupleHandle;
 
+// the worst row kept by a pq sort on its first sort key, a block whose SMA is worse can not enter the result
+typedef struct SSortTopKBound {
+  bool    valid;      // the pq is full and the first sort key of its worst row is not null
+  bool    nullFirst;
+  int32_t order;
+  int32_t slotId;
+  int32_t type;
+  int64_t val;        // laid out like the min/max of SColumnDataAgg, i.e. double for float types
+} SSortTopKBound;
+
 typedef int32_t (*_sort_fetch_block_fn_t)(void* param, SSDataBlock** ppBlock);
 typedef int32_t (*_sort_merge_compar_fn_t)(const void* p1, const void* p2, void* param);
 
@@ -83,6 +93,11 @@ int32_t tsortCreateSortHandle(SArray* pOrderInfo, int32_t type, int32_t pageSize
 
 void tsortSetForceUsePQSort(SSortHandle* pHandle);
 
+/**
+ * @brief let the pq sort keep pBound updated after every input block, it is never touched if pq sort is not used
+ */
+void tsortSetTopKBound(SSortHandle* pHandle, SSortTopKBound* pBound);
+
 /**
  *
  * @param pSortHandle
@@ -329,6 +329,7 @@ static SSDataBlock* getAggregateResult(SOperatorInfo* pOperator) {
 
 int32_t doAggregateImpl(SOperatorInfo* pOperator, SqlFunctionCtx* pCtx) {
   int32_t code = TSDB_CODE_SUCCESS;
+  int64_t st = taosGetTimestampUs();
   for (int32_t k = 0; k < pOperator->exprSupp.numOfExprs; ++k) {
     if (functionNeedToExecute(&pCtx[k])) {
       // todo add a dummy function to avoid process check
@@ -353,6 +354,7 @@ int32_t doAggregateImpl(SOperatorInfo* pOperator, SqlFunctionCtx* pCtx) {
     }
   }
 
+  pOperator->prof.aggTime += (taosGetTimestampUs() - st) / 1000.0;
   return TSDB_CODE_SUCCESS;
 }
 
@@ -24,21 +24,27 @@
 
 extern SDataSinkStat gDataSinkStat;
 
-typedef struct SDataDispatchBuf {
-  int32_t useSize;
-  int32_t allocSize;
-  char*   pData;
-} SDataDispatchBuf;
-
 typedef struct SDataCacheEntry {
-  int32_t rawLen;
-  int32_t dataLen;
   int32_t numOfRows;
   int32_t numOfCols;
   int8_t  compressed;
-  char    data[];
+  int32_t dataLen;
+  int32_t rawLen;
 } SDataCacheEntry;
 
+// The entry head is kept with the queue item, the buffer only holds the encoded block behind room for a
+// SRetrieveTableRsp head and the payload prefix. A block handed over by getDataBlockRef can then serve as a local
+// fetch rsp in place, starting at the buffer itself, and no entry field is read from the packed rsp area.
+typedef struct SDataDispatchBuf {
+  int32_t         useSize;
+  int32_t         allocSize;
+  SDataCacheEntry entry;
+  char*           pData;
+} SDataDispatchBuf;
+
+#define DS_BUF_HEADROOM    ((int32_t)(offsetof(SRetrieveTableRsp, data) + PAYLOAD_PREFIX_LEN))
+#define DS_BUF_DATA(_data) ((char*)(_data) + DS_BUF_HEADROOM)
+
 typedef struct SDataDispatchHandle {
   SDataSinkHandle     sink;
   SDataSinkManager*   pManager;
@@ -57,7 +63,7 @@ typedef struct SDataDispatchHandle {
 // clang-format off
 // data format:
 // +----------------+------------------+--------------+--------------+------------------+--------------------------------------------+------------------------------------+-------------+-----------+-------------+-----------+
-// |SDataCacheEntry |  version         | total length | numOfRows    |     group id     | col1_schema | col2_schema | col3_schema... | column#1 length, column#2 length...| col1 bitmap | col1 data | col2 bitmap | col2 data |
+// |rsp headroom    |  version         | total length | numOfRows    |     group id     | col1_schema | col2_schema | col3_schema... | column#1 length, column#2 length...| col1 bitmap | col1 data | col2 bitmap | col2 data |
 // |                |  sizeof(int32_t) |sizeof(int32) | sizeof(int32)| sizeof(uint64_t) | (sizeof(int8_t)+sizeof(int32_t))*numOfCols | sizeof(int32_t) * numOfCols        | actual size |           |                         |
 // +----------------+------------------+--------------+--------------+------------------+--------------------------------------------+------------------------------------+-------------+-----------+-------------+-----------+
 // The length of bitmap is decided by number of rows of this data block, and the length of each column data is
@@ -74,14 +80,15 @@ static int32_t toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData*
     }
   }
 
-  SDataCacheEntry* pEntry = (SDataCacheEntry*)pBuf->pData;
+  SDataCacheEntry* pEntry = &pBuf->entry;
+  char*            pData = DS_BUF_DATA(pBuf->pData);
   pEntry->compressed = 0;
   pEntry->numOfRows = pInput->pData->info.rows;
   pEntry->numOfCols = numOfCols;
   pEntry->dataLen = 0;
   pEntry->rawLen = 0;
 
-  pBuf->useSize = sizeof(SDataCacheEntry);
+  pBuf->useSize = DS_BUF_HEADROOM;
 
   {
     if ((pBuf->allocSize > tsCompressMsgSize) && (tsCompressMsgSize > 0) && pHandle->pManager->cfg.compress) {
@@ -111,7 +118,8 @@ static int32_t toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData*
         return terrno;
       }
       int32_t len =
-          tsCompressString(pHandle->pCompressBuf, dataLen, 1, pEntry->data, pBuf->allocSize, ONE_STAGE_COMP, NULL, 0);
+          tsCompressString(pHandle->pCompressBuf, dataLen, 1, pData, pBuf->allocSize - pBuf->useSize,
+                           ONE_STAGE_COMP, NULL, 0);
       if (len < dataLen) {
         pEntry->compressed = 1;
         pEntry->dataLen = len;
@@ -120,10 +128,10 @@ static int32_t toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData*
         pEntry->compressed = 0;
         pEntry->dataLen = dataLen;
         pEntry->rawLen = dataLen;
-        TAOS_MEMCPY(pEntry->data, pHandle->pCompressBuf, dataLen);
+        TAOS_MEMCPY(pData, pHandle->pCompressBuf, dataLen);
       }
     } else {
-      pEntry->dataLen = blockEncode(pInput->pData, pEntry->data, numOfCols);
+      pEntry->dataLen = blockEncode(pInput->pData, pData, numOfCols);
       if(pEntry->dataLen < 0) {
         qError("failed to encode data block, code: %d", pEntry->dataLen);
         return terrno;
@@ -150,7 +158,7 @@ static int32_t allocBuf(SDataDispatchHandle* pDispatcher, const SInputData* pInp
     }
   */
 
-  pBuf->allocSize = sizeof(SDataCacheEntry) + blockGetEncodeSize(pInput->pData);
+  pBuf->allocSize = DS_BUF_HEADROOM + blockGetEncodeSize(pInput->pData);
 
   pBuf->pData = taosMemoryMalloc(pBuf->allocSize);
   if (pBuf->pData == NULL) {
@@ -239,13 +247,12 @@ static void getDataLength(SDataSinkHandle* pHandle, int64_t* pLen, int64_t* pRow
     taosFreeQitem(pBuf);
   }
 
-  SDataCacheEntry* pEntry = (SDataCacheEntry*)pDispatcher->nextOutput.pData;
+  SDataCacheEntry* pEntry = &pDispatcher->nextOutput.entry;
   *pLen = pEntry->dataLen;
   *pRowLen = pEntry->rawLen;
 
   *pQueryEnd = pDispatcher->queryEnd;
-  qDebug("got data len %" PRId64 ", row num %d in sink", *pLen,
-         ((SDataCacheEntry*)(pDispatcher->nextOutput.pData))->numOfRows);
+  qDebug("got data len %" PRId64 ", row num %d in sink", *pLen, pEntry->numOfRows);
 }
 
 static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
@@ -263,8 +270,8 @@ static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
     return TSDB_CODE_SUCCESS;
   }
 
-  SDataCacheEntry* pEntry = (SDataCacheEntry*)(pDispatcher->nextOutput.pData);
-  TAOS_MEMCPY(pOutput->pData, pEntry->data, pEntry->dataLen);
+  SDataCacheEntry* pEntry = &pDispatcher->nextOutput.entry;
+  TAOS_MEMCPY(pOutput->pData, DS_BUF_DATA(pDispatcher->nextOutput.pData), pEntry->dataLen);
   pOutput->numOfRows = pEntry->numOfRows;
   pOutput->numOfCols = pEntry->numOfCols;
   pOutput->compressed = pEntry->compressed;
@@ -284,6 +291,39 @@ static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t getDataBlockRef(SDataSinkHandle* pHandle, SOutputData* pOutput, void** ppBuf) {
+  SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
+  *ppBuf = NULL;
+  if (NULL == pDispatcher->nextOutput.pData) {
+    return getDataBlock(pHandle, pOutput);
+  }
+
+  SDataCacheEntry* pEntry = &pDispatcher->nextOutput.entry;
+  char*            pData = DS_BUF_DATA(pDispatcher->nextOutput.pData);
+  int32_t          prefix[2] = {pEntry->dataLen, pEntry->rawLen};  // not aligned behind the packed rsp head
+  TAOS_MEMCPY(pData - PAYLOAD_PREFIX_LEN, prefix, PAYLOAD_PREFIX_LEN);
+  pOutput->pData = pData;
+  pOutput->numOfRows = pEntry->numOfRows;
+  pOutput->numOfCols = pEntry->numOfCols;
+  pOutput->compressed = pEntry->compressed;
+
+  (void)atomic_sub_fetch_64(&pDispatcher->cachedSize, pEntry->dataLen);
+  (void)atomic_sub_fetch_64(&gDataSinkStat.cachedSize, pEntry->dataLen);
+
+  // ownership of the entry goes to the caller
+  *ppBuf = pDispatcher->nextOutput.pData;
+  pDispatcher->nextOutput.pData = NULL;
+  pOutput->bufStatus = updateStatus(pDispatcher);
+
+  (void)taosThreadMutexLock(&pDispatcher->mutex);
+  pOutput->queryEnd = pDispatcher->queryEnd;
+  pOutput->useconds = pDispatcher->useconds;
+  pOutput->precision = pDispatcher->pSchema->precision;
+  (void)taosThreadMutexUnlock(&pDispatcher->mutex);
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t destroyDataSinker(SDataSinkHandle* pHandle) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
   (void)atomic_sub_fetch_64(&gDataSinkStat.cachedSize, pDispatcher->cachedSize);
@@ -327,6 +367,7 @@ int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pD
   dispatcher->sink.fReset = resetDispatcher;
   dispatcher->sink.fGetLen = getDataLength;
   dispatcher->sink.fGetData = getDataBlock;
+  dispatcher->sink.fGetDataRef = getDataBlockRef;
   dispatcher->sink.fDestroy = destroyDataSinker;
   dispatcher->sink.fGetCacheSize = getCacheSize;
 
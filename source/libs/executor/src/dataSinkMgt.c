@@ -87,6 +87,14 @@ int32_t dsGetDataBlock(DataSinkHandle handle, SOutputData* pOutput) {
   return pHandleImpl->fGetData(pHandleImpl, pOutput);
 }
 
+int32_t dsGetDataBlockRef(DataSinkHandle handle, SOutputData* pOutput, void** ppBuf) {
+  SDataSinkHandle* pHandleImpl = (SDataSinkHandle*)handle;
+  if (NULL == pHandleImpl->fGetDataRef) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+  return pHandleImpl->fGetDataRef(pHandleImpl, pOutput, ppBuf);
+}
+
 int32_t dsGetCacheSize(DataSinkHandle handle, uint64_t* pSize) {
   SDataSinkHandle* pHandleImpl = (SDataSinkHandle*)handle;
   return pHandleImpl->fGetCacheSize(pHandleImpl, pSize);
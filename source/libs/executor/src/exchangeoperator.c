@@ -43,6 +43,7 @@ typedef struct SSourceDataInfo {
   bool               tableSeq;
   char*              decompBuf;
   int32_t            decompBufSize;
+  bool               prefetched;  // the fetch of the next result is already sent
 } SSourceDataInfo;
 
 static void destroyExchangeOperatorInfo(void* param);
@@ -952,14 +953,17 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
       pTaskInfo->code = terrno;
       T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
     }
-    pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+    if (!pDataInfo->prefetched) {
+      pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
 
-    code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
-    if (code != TSDB_CODE_SUCCESS) {
-      qError("%s failed at line %d since %s", __func__, __LINE__, tstrerror(code));
-      pTaskInfo->code = code;
-      T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+      code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
+      if (code != TSDB_CODE_SUCCESS) {
+        qError("%s failed at line %d since %s", __func__, __LINE__, tstrerror(code));
+        pTaskInfo->code = code;
+        T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+      }
     }
+    pDataInfo->prefetched = false;
 
     code = exchangeWait(pOperator, pExchangeInfo);
     if (code != TSDB_CODE_SUCCESS || isTaskKilled(pTaskInfo)) {
@@ -1021,6 +1025,17 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
     pDataInfo->totalRows += pRetrieveRsp->numOfRows;
 
     taosMemoryFreeClear(pDataInfo->pRsp);
+
+    // the upstream task keeps producing into its sink, so ask for the next result now and let it travel while the
+    // blocks extracted above are consumed. The rsp is waited for by the next call.
+    if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED && !pExchangeInfo->dynamicOp && !pSource->localExec) {
+      pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+      code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
+      if (code != TSDB_CODE_SUCCESS) {
+        goto _error;
+      }
+      pDataInfo->prefetched = true;
+    }
     return TSDB_CODE_SUCCESS;
   }
 
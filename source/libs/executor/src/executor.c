@@ -19,6 +19,7 @@
 #include "planner.h"
 #include "querytask.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "tref.h"
 #include "trpc.h"
 #include "tudf.h"
@@ -614,7 +615,9 @@ int32_t qCreateExecTask(SReadHandle* readHandle, int32_t vgId, uint64_t taskId,
   }
 
   if (handle) {
-    SDataSinkMgtCfg cfg = {.maxDataBlockNum = 500, .maxDataBlockNumPerQuery = 50, .compress = compressResult};
+    // queryFetchCredits is bounded by the sink-wide block count, so the per query credits never exceed it
+    SDataSinkMgtCfg cfg = {
+        .maxDataBlockNum = 500, .maxDataBlockNumPerQuery = tsQueryFetchCredits, .compress = compressResult};
     void*           pSinkManager = NULL;
     code = dsDataSinkMgtInit(&cfg, &(*pTask)->storageAPI, &pSinkManager);
     if (code != TSDB_CODE_SUCCESS) {
@@ -1304,6 +1304,9 @@ FORCE_INLINE int32_t getNextBlockFromDownstreamImpl(struct SOperatorInfo* pOpera
 
     if (code) {
       qError("failed to get next data block from upstream at %s, line:%d code:%s", __func__, __LINE__, tstrerror(code));
+    } else if (*pResBlock) {
+      pOperator->prof.inputBlocks += 1;
+      pOperator->prof.inputRows += (*pResBlock)->info.rows;
     }
     return code;
   }
@@ -1311,6 +1314,9 @@ FORCE_INLINE int32_t getNextBlockFromDownstreamImpl(struct SOperatorInfo* pOpera
   code = pOperator->pDownstream[idx]->fpSet.getNextFn(pOperator->pDownstream[idx], pResBlock);
   if (code) {
     qError("failed to get next data block from upstream at %s, %d code:%s", __func__, __LINE__, tstrerror(code));
+  } else if (*pResBlock) {
+    pOperator->prof.inputBlocks += 1;
+    pOperator->prof.inputRows += (*pResBlock)->info.rows;
   }
   return code;
 }
@@ -57,6 +57,7 @@ int32_t hInnerJoinDo(struct SOperatorInfo* pOperator) {
     }
     
     SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    pOperator->prof.hashProbes += 1;
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -142,6 +143,7 @@ int32_t hLeftJoinHandleSeqProbeRows(struct SOperatorInfo* pOperator, SHJoinOpera
     }
     
     SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    pOperator->prof.hashProbes += 1;
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -245,6 +247,7 @@ int32_t hLeftJoinHandleProbeRows(struct SOperatorInfo* pOperator, SHJoinOperator
     }
     
     SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    pOperator->prof.hashProbes += 1;
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
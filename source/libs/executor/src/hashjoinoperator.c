@@ -444,14 +444,10 @@ static void hJoinFreeBufPage(void* param) {
   taosMemoryFree(pInfo->data);
 }
 
-static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
-  if (NULL == ppHash || NULL == (*ppHash)) {
-    return;
-  }
-
+static void hJoinFreeKeyHashRows(SSHashObj* pHash) {
   void*   pIte = NULL;
   int32_t iter = 0;
-  while ((pIte = tSimpleHashIterate(*ppHash, pIte, &iter)) != NULL) {
+  while ((pIte = tSimpleHashIterate(pHash, pIte, &iter)) != NULL) {
     SGroupData* pGroup = pIte;
     SBufRowInfo* pRow = pGroup->rows;
     SBufRowInfo* pNext = NULL;
@@ -461,11 +457,60 @@ static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
       pRow = pNext;
     }
   }
+}
+
+static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
+  if (NULL == ppHash || NULL == (*ppHash)) {
+    return;
+  }
+
+  hJoinFreeKeyHashRows(*ppHash);
 
   tSimpleHashCleanup(*ppHash);
   *ppHash = NULL;
 }
 
+static void hJoinResetKeyHash(SHJoinOperatorInfo* pJoin) {
+  hJoinFreeKeyHashRows(pJoin->pKeyHash);
+  tSimpleHashClear(pJoin->pKeyHash);
+
+  int32_t pageNum = taosArrayGetSize(pJoin->pRowBufs);
+  for (int32_t i = 1; i < pageNum; ++i) {
+    hJoinFreeBufPage(taosArrayGet(pJoin->pRowBufs, i));
+  }
+  taosArrayPopTailBatch(pJoin->pRowBufs, pageNum - 1);
+
+  SBufPageInfo* pPage = taosArrayGet(pJoin->pRowBufs, 0);
+  if (pPage) {
+    pPage->offset = 0;
+  }
+
+  pJoin->execInfo.hashRows = 0;
+}
+
+static void hJoinDestroySpill(SHJoinSpillCtx** ppSpill) {
+  SHJoinSpillCtx* pSpill = *ppSpill;
+  if (NULL == pSpill) {
+    return;
+  }
+
+  int32_t partNum = taosArrayGetSize(pSpill->pParts);
+  for (int32_t i = 0; i < partNum; ++i) {
+    SHJoinPartition* pPart = taosArrayGet(pSpill->pParts, i);
+    taosArrayDestroy(pPart->pBuildPages);
+    taosArrayDestroy(pPart->pProbePages);
+    blockDataDestroy(pPart->pProbeBlk);
+  }
+  taosArrayDestroy(pSpill->pParts);
+
+  blockDataDestroy(pSpill->pProbeBlk);
+  destroyDiskbasedBuf(pSpill->pBuildBuf);
+  destroyDiskbasedBuf(pSpill->pProbeBuf);
+  taosMemoryFree(pSpill->pRowPart);
+  taosMemoryFree(pSpill->pRowIdx);
+  taosMemoryFreeClear(*ppSpill);
+}
+
 static FORCE_INLINE int32_t hJoinRetrieveColDataFromRowBufs(SArray* pRowBufs, SBufRowInfo* pRow, char** ppData) {
   *ppData = NULL;
   
@@ -584,6 +629,7 @@ void hJoinAppendResToBlock(struct SOperatorInfo* pOperator, SSDataBlock* pRes, b
   }
 
   pJoin->execInfo.resRows += rowNum;
+  pOperator->prof.hashMatchRows += rowNum;
 
   int32_t code = hJoinCopyResRowsToBlock(pJoin, rowNum, pStart, pRes);
   if (code) {
@@ -769,6 +815,9 @@ static FORCE_INLINE int32_t hJoinGetValBufSize(SHJoinTableCtx* pTable, int32_t r
   int32_t varColNum = taosArrayGetSize(pTable->valVarCols);
   for (int32_t i = 0; i < varColNum; ++i) {
     varColIdx = taosArrayGet(pTable->valVarCols, i);
+    if (-1 == pTable->valCols[*varColIdx].offset[rowIdx]) {
+      continue;
+    }
     char* pData = pTable->valCols[*varColIdx].data + pTable->valCols[*varColIdx].offset[rowIdx];
     bufLen += varDataTLen(pData);
   }
@@ -777,7 +826,7 @@ static FORCE_INLINE int32_t hJoinGetValBufSize(SHJoinTableCtx* pTable, int32_t r
 }
 
 
-static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, SHJoinTableCtx* pTable, size_t keyLen, int32_t rowIdx) {
+static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, const char* pKey, size_t keyLen, int32_t bufSize, char** ppValBuf) {
   SGroupData group = {0};
   SBufRowInfo* pRow = NULL;
 
@@ -794,7 +843,7 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
     }
   }
 
-  int32_t code = hJoinGetValBufFromPages(pJoin->pRowBufs, hJoinGetValBufSize(pTable, rowIdx), &pTable->valData, pRow);
+  int32_t code = hJoinGetValBufFromPages(pJoin->pRowBufs, bufSize, ppValBuf, pRow);
   if (code) {
     taosMemoryFree(pRow);
     return code;
@@ -802,7 +851,7 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
 
   if (NULL == pGroup) {
     pRow->next = NULL;
-    if (tSimpleHashPut(pJoin->pKeyHash, pTable->keyData, keyLen, &group, sizeof(group))) {
+    if (tSimpleHashPut(pJoin->pKeyHash, pKey, keyLen, &group, sizeof(group))) {
       taosMemoryFree(pRow);
       return TSDB_CODE_OUT_OF_MEMORY;
     }
@@ -811,6 +860,8 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
     pGroup->rows = pRow;
   }
 
+  pJoin->execInfo.hashRows++;
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -822,7 +873,7 @@ static int32_t hJoinAddRowToHash(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock,
   }
 
   SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pBuild->keyData, keyLen);
-  code = hJoinAddRowToHashImpl(pJoin, pGroup, pBuild, keyLen, rowIdx);
+  code = hJoinAddRowToHashImpl(pJoin, pGroup, pBuild->keyData, keyLen, hJoinGetValBufSize(pBuild, rowIdx), &pBuild->valData);
   if (code) {
     return code;
   }
@@ -832,6 +883,255 @@ static int32_t hJoinAddRowToHash(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock,
   return TSDB_CODE_SUCCESS;
 }
 
+static FORCE_INLINE int32_t hJoinGetPartIdx(SHJoinSpillCtx* pSpill, int32_t level, const char* pKey, size_t keyLen) {
+  // the low bits are taken by the buckets of the key hash, partition by the high ones, the next ones at each level
+  uint32_t hashVal = (*pSpill->hashFp)(pKey, keyLen);
+  return (int32_t)((hashVal >> (32 - HJOIN_PART_BITS * (level + 1))) & (HJOIN_PART_NUM - 1));
+}
+
+static FORCE_INLINE SHJoinPartition* hJoinGetPart(SHJoinSpillCtx* pSpill, int32_t partIdx) {
+  return taosArrayGet(pSpill->pParts, partIdx);
+}
+
+static FORCE_INLINE int64_t hJoinGetPartMemSize(SHJoinPartition* pPart) {
+  return pPart->buildSize + pPart->buildRows * (int64_t)sizeof(SBufRowInfo);
+}
+
+static FORCE_INLINE int64_t hJoinGetBuildMemSize(SHJoinOperatorInfo* pJoin) {
+  return (int64_t)taosArrayGetSize(pJoin->pRowBufs) * HASH_JOIN_DEFAULT_PAGE_SIZE + tSimpleHashGetMemSize(pJoin->pKeyHash) +
+         pJoin->execInfo.hashRows * (int64_t)sizeof(SBufRowInfo);
+}
+
+static FORCE_INLINE void hJoinReleaseSpillPage(SDiskbasedBuf* pBuf, void* pPage) {
+  setBufPageDirty(pPage, true);
+  releaseBufPage(pBuf, pPage);
+}
+
+static int32_t hJoinGetRowValLen(SHJoinTableCtx* pTable, const char* pData) {
+  if (NULL == pData) {
+    return 0;
+  }
+
+  int32_t len = pTable->valBitMapSize;
+  for (int32_t i = 0, m = 0; i < pTable->valNum; ++i) {
+    if (pTable->valCols[i].keyCol) {
+      continue;
+    }
+    if (!colDataIsNull_f(pData, m)) {
+      len += pTable->valCols[i].vardata ? varDataTLen(pData + len) : pTable->valCols[i].bytes;
+    }
+    m++;
+  }
+
+  return len;
+}
+
+static int32_t hJoinGetSpillRowBuf(SHJoinSpillCtx* pSpill, SHJoinPartition* pPart, const char* pKey, int32_t keyLen,
+                                   int32_t valLen, void** ppPage, char** ppValBuf) {
+  int32_t          recLen = 2 * sizeof(int32_t) + keyLen + valLen;
+  int32_t          pageId = 0;
+  char*            pPage = NULL;
+
+  if (recLen + (int32_t)sizeof(int32_t) > pSpill->buildPageSize) {
+    qError("invalid hash join spill row size:%d, pageSize:%d", recLen, pSpill->buildPageSize);
+    return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
+  }
+
+  if (taosArrayGetSize(pPart->pBuildPages) > 0) {
+    pageId = *(int32_t*)taosArrayGetLast(pPart->pBuildPages);
+    pPage = getBufPage(pSpill->pBuildBuf, pageId);
+    if (NULL == pPage) {
+      return terrno;
+    }
+    if (*(int32_t*)pPage + recLen > pSpill->buildPageSize) {
+      releaseBufPage(pSpill->pBuildBuf, pPage);
+      pPage = NULL;
+    }
+  }
+
+  if (NULL == pPage) {
+    pPage = getNewBufPage(pSpill->pBuildBuf, &pageId);
+    if (NULL == pPage) {
+      return terrno;
+    }
+    if (NULL == taosArrayPush(pPart->pBuildPages, &pageId)) {
+      releaseBufPage(pSpill->pBuildBuf, pPage);
+      return terrno;
+    }
+    *(int32_t*)pPage = sizeof(int32_t);
+  }
+
+  char* pRec = pPage + *(int32_t*)pPage;
+  *(int32_t*)pRec = keyLen;
+  *(int32_t*)(pRec + sizeof(int32_t)) = valLen;
+  TAOS_MEMCPY(pRec + 2 * sizeof(int32_t), pKey, keyLen);
+  *(int32_t*)pPage += recLen;
+  pPart->buildRows++;
+  pPart->buildSize += recLen;
+
+  *ppPage = pPage;
+  *ppValBuf = pRec + 2 * sizeof(int32_t) + keyLen;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillAddRow(SHJoinOperatorInfo* pJoin, size_t keyLen, int32_t rowIdx) {
+  SHJoinTableCtx* pBuild = pJoin->pBuild;
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  void*           pPage = NULL;
+
+  SHJoinPartition* pPart = hJoinGetPart(pSpill, hJoinGetPartIdx(pSpill, 0, pBuild->keyData, keyLen));
+  HJ_ERR_RET(hJoinGetSpillRowBuf(pSpill, pPart, pBuild->keyData, keyLen, hJoinGetValBufSize(pBuild, rowIdx), &pPage,
+                                 &pBuild->valData));
+  hJoinCopyValColsDataToBuf(pBuild, rowIdx);
+  hJoinReleaseSpillPage(pSpill->pBuildBuf, pPage);
+
+  pJoin->execInfo.spillBuildRows++;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillKeyHash(SHJoinOperatorInfo* pJoin) {
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  void*           pIte = NULL;
+  int32_t         iter = 0;
+
+  while ((pIte = tSimpleHashIterate(pJoin->pKeyHash, pIte, &iter)) != NULL) {
+    size_t keyLen = 0;
+    char*  pKey = tSimpleHashGetKey(pIte, &keyLen);
+    for (SBufRowInfo* pRow = ((SGroupData*)pIte)->rows; pRow; pRow = pRow->next) {
+      char* pData = NULL;
+      char* pValBuf = NULL;
+      void* pPage = NULL;
+      HJ_ERR_RET(hJoinRetrieveColDataFromRowBufs(pJoin->pRowBufs, pRow, &pData));
+
+      int32_t valLen = hJoinGetRowValLen(pJoin->pBuild, pData);
+      SHJoinPartition* pPart = hJoinGetPart(pSpill, hJoinGetPartIdx(pSpill, 0, pKey, keyLen));
+      HJ_ERR_RET(hJoinGetSpillRowBuf(pSpill, pPart, pKey, keyLen, valLen, &pPage, &pValBuf));
+      if (valLen > 0) {
+        TAOS_MEMCPY(pValBuf, pData, valLen);
+      }
+      hJoinReleaseSpillPage(pSpill->pBuildBuf, pPage);
+
+      pJoin->execInfo.spillBuildRows++;
+    }
+  }
+
+  hJoinResetKeyHash(pJoin);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinAddSpillParts(SHJoinSpillCtx* pSpill, int32_t partNum, int32_t level) {
+  for (int32_t i = 0; i < partNum; ++i) {
+    SHJoinPartition part = {0};
+    part.level = level;
+    part.childIdx = -1;
+    part.pBuildPages = taosArrayInit(8, sizeof(int32_t));
+    part.pProbePages = taosArrayInit(8, sizeof(int32_t));
+    if (NULL == part.pBuildPages || NULL == part.pProbePages || NULL == taosArrayPush(pSpill->pParts, &part)) {
+      taosArrayDestroy(part.pBuildPages);
+      taosArrayDestroy(part.pProbePages);
+      return terrno;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinInitSpill(SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinTableCtx*     pBuild = pJoin->pBuild;
+  const char*         idStr = GET_TASKID(pOperator->pTaskInfo);
+
+  if (!osTempSpaceAvailable()) {
+    qError("%s hash join spill failed since %s, tempDir:%s", idStr, tstrerror(TSDB_CODE_NO_DISKSPACE), tsTempDir);
+    return TSDB_CODE_NO_DISKSPACE;
+  }
+
+  pJoin->pSpill = taosMemoryCalloc(1, sizeof(SHJoinSpillCtx));
+  if (NULL == pJoin->pSpill) {
+    return terrno;
+  }
+
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  int32_t         rowSize = 2 * sizeof(int32_t) + pBuild->valBufSize;
+  for (int32_t i = 0; i < pBuild->keyNum; ++i) {
+    rowSize += pBuild->keyCols[i].bytes;
+  }
+  for (int32_t i = 0; i < pBuild->valNum; ++i) {
+    if (!pBuild->valCols[i].keyCol && pBuild->valCols[i].vardata) {
+      rowSize += pBuild->valCols[i].bytes;
+    }
+  }
+
+  pSpill->hashFp = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
+  pSpill->buildPageSize = TMAX(HJOIN_SPILL_PAGE_SIZE, rowSize + (int32_t)sizeof(int32_t));
+  pSpill->loadedPartIdx = -1;
+  pSpill->pParts = taosArrayInit(HJOIN_PART_NUM + 1, sizeof(SHJoinPartition));
+  if (NULL == pSpill->pParts) {
+    return terrno;
+  }
+  HJ_ERR_RET(hJoinAddSpillParts(pSpill, HJOIN_PART_NUM + 1, 0));
+
+  HJ_ERR_RET(createDiskbasedBuf(&pSpill->pBuildBuf, pSpill->buildPageSize, HJOIN_SPILL_BUF_SIZE, idStr, tsTempDir));
+
+  qDebug("%s hash join build side exceeds %" PRId64 " bytes with %" PRId64 " rows, spill into %d partitions", idStr,
+         hJoinGetBuildMemSize(pJoin), pJoin->execInfo.hashRows, HJOIN_PART_NUM);
+
+  return hJoinSpillKeyHash(pJoin);
+}
+
+static int32_t hJoinLoadSpillPartition(SHJoinOperatorInfo* pJoin, int32_t partIdx) {
+  SHJoinSpillCtx*  pSpill = pJoin->pSpill;
+  SHJoinPartition* pPart = hJoinGetPart(pSpill, partIdx);
+  int32_t          pageNum = taosArrayGetSize(pPart->pBuildPages);
+  int32_t          code = TSDB_CODE_SUCCESS;
+
+  hJoinResetKeyHash(pJoin);
+
+  for (int32_t i = 0; i < pageNum; ++i) {
+    int32_t* pageId = taosArrayGet(pPart->pBuildPages, i);
+    char*    pPage = getBufPage(pSpill->pBuildBuf, *pageId);
+    if (NULL == pPage) {
+      return terrno;
+    }
+
+    int32_t offset = sizeof(int32_t);
+    while (offset < *(int32_t*)pPage) {
+      int32_t keyLen = *(int32_t*)(pPage + offset);
+      int32_t valLen = *(int32_t*)(pPage + offset + sizeof(int32_t));
+      char*   pKey = pPage + offset + 2 * sizeof(int32_t);
+      char*   pValBuf = NULL;
+
+      code = hJoinAddRowToHashImpl(pJoin, tSimpleHashGet(pJoin->pKeyHash, pKey, keyLen), pKey, keyLen, valLen, &pValBuf);
+      if (code) {
+        releaseBufPage(pSpill->pBuildBuf, pPage);
+        return code;
+      }
+      if (valLen > 0) {
+        TAOS_MEMCPY(pValBuf, pKey + keyLen, valLen);
+      }
+
+      offset += 2 * sizeof(int32_t) + keyLen + valLen;
+    }
+
+    releaseBufPage(pSpill->pBuildBuf, pPage);
+  }
+
+  pSpill->loadedPartIdx = partIdx;
+
+  if (hJoinGetPartMemSize(pPart) > pJoin->buildMemLimit) {
+    qWarn("hash join partition %d still exceeds the memory limit at level %d, rows:%" PRId64 ", memSize:%" PRId64,
+          partIdx, pPart->level, pPart->buildRows, hJoinGetPartMemSize(pPart));
+  } else {
+    qDebug("hash join partition %d loaded, rows:%" PRId64 ", probePages:%d", partIdx, pPart->buildRows,
+           (int32_t)taosArrayGetSize(pPart->pProbePages));
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static bool hJoinFilterTimeRange(SSDataBlock* pBlock, STimeWindow* pRange, int32_t primSlot, int32_t* startIdx, int32_t* endIdx) {
   SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, primSlot);
   if (NULL == pCol) {
@@ -888,12 +1188,16 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
     return code;
   }
 
+  if (pJoin->pSpill) {
+    HJ_ERR_RET(hJoinSetValColsData(pBlock, pBuild));
+  }
+
   size_t bufLen = 0;
   for (int32_t i = startIdx; i <= endIdx; ++i) {
     if (hJoinCopyKeyColsDataToBuf(pBuild, i, &bufLen)) {
       continue;
     }
-    code = hJoinAddRowToHash(pJoin, pBlock, bufLen, i);
+    code = pJoin->pSpill ? hJoinSpillAddRow(pJoin, bufLen, i) : hJoinAddRowToHash(pJoin, pBlock, bufLen, i);
     if (code) {
       return code;
     }
@@ -920,9 +1224,14 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
     if (code) {
       return code;
     }
+
+    if (NULL == pJoin->pSpill && hJoinGetBuildMemSize(pJoin) > pJoin->buildMemLimit) {
+      HJ_ERR_RET(hJoinInitSpill(pOperator));
+    }
   }
 
-  if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && tSimpleHashGetSize(pJoin->pKeyHash) <= 0) {
+  int64_t buildRows = pJoin->pSpill ? pJoin->execInfo.spillBuildRows : tSimpleHashGetSize(pJoin->pKeyHash);
+  if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && buildRows <= 0) {
     hJoinSetDone(pOperator);
     *queryDone = true;
   }
@@ -932,11 +1241,418 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t hJoinSpillFlushProbeBlk(SHJoinOperatorInfo* pJoin, SHJoinPartition* pPart) {
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  int32_t         pageId = 0;
+
+  if (NULL == pPart->pProbeBlk || pPart->pProbeBlk->info.rows <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  void* pPage = getNewBufPage(pSpill->pProbeBuf, &pageId);
+  if (NULL == pPage) {
+    return terrno;
+  }
+
+  int32_t code = blockDataToBuf(pPage, pPart->pProbeBlk);
+  hJoinReleaseSpillPage(pSpill->pProbeBuf, pPage);
+  if (code) {
+    return code;
+  }
+  if (NULL == taosArrayPush(pPart->pProbePages, &pageId)) {
+    return terrno;
+  }
+
+  pJoin->execInfo.spillProbeRows += pPart->pProbeBlk->info.rows;
+  blockDataCleanup(pPart->pProbeBlk);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillAppendProbeRows(SHJoinOperatorInfo* pJoin, SHJoinPartition* pPart, SSDataBlock* pBlock, int32_t startIdx, int32_t rows) {
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  int32_t         colNum = taosArrayGetSize(pBlock->pDataBlock);
+
+  if (NULL == pPart->pProbeBlk) {
+    HJ_ERR_RET(createOneDataBlock(pSpill->pProbeBlk, false, &pPart->pProbeBlk));
+    HJ_ERR_RET(blockDataEnsureCapacity(pPart->pProbeBlk, pSpill->probeBlkRows));
+  }
+
+  while (rows > 0) {
+    SSDataBlock* pDst = pPart->pProbeBlk;
+    int32_t      num = TMIN(rows, pSpill->probeBlkRows - pDst->info.rows);
+    for (int32_t i = 0; i < colNum; ++i) {
+      HJ_ERR_RET(colDataAssignNRows(taosArrayGet(pDst->pDataBlock, i), pDst->info.rows, taosArrayGet(pBlock->pDataBlock, i), startIdx, num));
+    }
+
+    pDst->info.rows += num;
+    startIdx += num;
+    rows -= num;
+
+    if (pDst->info.rows >= pSpill->probeBlkRows) {
+      HJ_ERR_RET(hJoinSpillFlushProbeBlk(pJoin, pPart));
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillLoadProbePage(SHJoinSpillCtx* pSpill, int32_t pageId, bool recycle) {
+  void* pPage = getBufPage(pSpill->pProbeBuf, pageId);
+  if (NULL == pPage) {
+    return terrno;
+  }
+
+  int32_t code = blockDataFromBuf(pSpill->pProbeBlk, pPage);
+  if (recycle) {
+    // the rows are moved to sub partitions, the page can be reused by them
+    int32_t code2 = dBufSetBufPageRecycled(pSpill->pProbeBuf, pPage);
+    if (TSDB_CODE_SUCCESS == code) {
+      code = code2;
+    }
+  } else {
+    releaseBufPage(pSpill->pProbeBuf, pPage);
+  }
+  HJ_ERR_RET(code);
+
+  int32_t colNum = taosArrayGetSize(pSpill->pProbeBlk->pDataBlock);
+  for (int32_t i = 0; i < colNum; ++i) {
+    SColumnInfoData* pCol = taosArrayGet(pSpill->pProbeBlk->pDataBlock, i);
+    pCol->hasNull = true;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillEnsureRowBuf(SHJoinSpillCtx* pSpill, int32_t rows) {
+  if (rows <= pSpill->rowBufSize) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  taosMemoryFreeClear(pSpill->pRowPart);
+  taosMemoryFreeClear(pSpill->pRowIdx);
+  pSpill->rowBufSize = 0;
+  pSpill->pRowPart = taosMemoryMalloc(rows * sizeof(int32_t));
+  pSpill->pRowIdx = taosMemoryMalloc(rows * sizeof(int32_t));
+  if (NULL == pSpill->pRowPart || NULL == pSpill->pRowIdx) {
+    return terrno;
+  }
+  pSpill->rowBufSize = rows;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// pRowPart holds the partition of each row relative to partBase, -1 for a dropped row
+static int32_t hJoinSpillScatterProbeRows(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, int32_t partBase) {
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  int32_t         rows = pBlock->info.rows;
+  int32_t         partOffset[HJOIN_PART_NUM + 2] = {0};
+  int32_t         partPos[HJOIN_PART_NUM + 1] = {0};
+
+  for (int32_t i = 0; i < rows; ++i) {
+    if (pSpill->pRowPart[i] >= 0) {
+      partOffset[pSpill->pRowPart[i] + 1]++;
+    }
+  }
+  for (int32_t i = 1; i <= HJOIN_PART_NUM + 1; ++i) {
+    partOffset[i] += partOffset[i - 1];
+  }
+  TAOS_MEMCPY(partPos, partOffset, sizeof(partPos));
+  for (int32_t i = 0; i < rows; ++i) {
+    if (pSpill->pRowPart[i] >= 0) {
+      pSpill->pRowIdx[partPos[pSpill->pRowPart[i]]++] = i;
+    }
+  }
+
+  // copy the rows of each partition in runs of consecutive rows
+  for (int32_t p = 0; p <= HJOIN_PART_NUM; ++p) {
+    for (int32_t i = partOffset[p]; i < partOffset[p + 1];) {
+      int32_t startIdx = pSpill->pRowIdx[i];
+      int32_t num = 1;
+      while (i + num < partOffset[p + 1] && pSpill->pRowIdx[i + num] == startIdx + num) {
+        num++;
+      }
+      HJ_ERR_RET(hJoinSpillAppendProbeRows(pJoin, hJoinGetPart(pSpill, partBase + p), pBlock, startIdx, num));
+      i += num;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillAddProbeBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock) {
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+  SHJoinTableCtx* pProbe = pJoin->pProbe;
+  bool            innerJoin = IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType);
+  int32_t         rows = pBlock->info.rows;
+  TSKEY*          pTs = NULL;
+
+  HJ_ERR_RET(hJoinSpillEnsureRowBuf(pSpill, rows));
+  HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pProbe, 0, rows - 1));
+  HJ_ERR_RET(hJoinSetKeyColsData(pBlock, pProbe));
+  if (pProbe->hasTimeRange) {
+    SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pProbe->primCol->srcSlot);
+    if (NULL == pCol) {
+      qError("hash join can't get prim col, slot:%d, slotNum:%d", pProbe->primCol->srcSlot, (int32_t)taosArrayGetSize(pBlock->pDataBlock));
+      QRY_ERR_RET(TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
+    }
+    pTs = (TSKEY*)pCol->pData;
+  }
+
+  // rows out of the time range or with null keys never match, an inner join drops them and the rows of
+  // empty partitions here, the other joins output them as not matched
+  size_t keyLen = 0;
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t partIdx = innerJoin ? -1 : HJOIN_NMATCH_PART;
+    if (pTs && (pTs[i] < pJoin->tblTimeRange.skey || pTs[i] > pJoin->tblTimeRange.ekey)) {
+      // not matched
+    } else if (!hJoinCopyKeyColsDataToBuf(pProbe, i, &keyLen)) {
+      partIdx = hJoinGetPartIdx(pSpill, 0, pProbe->keyData, keyLen);
+      if (innerJoin && 0 == hJoinGetPart(pSpill, partIdx)->buildRows) {
+        partIdx = -1;
+      }
+    }
+
+    pSpill->pRowPart[i] = partIdx;
+  }
+
+  return hJoinSpillScatterProbeRows(pJoin, pBlock, 0);
+}
+
+static int32_t hJoinSpillFlushParts(SHJoinOperatorInfo* pJoin, int32_t startIdx, int32_t partNum) {
+  SHJoinSpillCtx* pSpill = pJoin->pSpill;
+
+  for (int32_t i = startIdx; i < startIdx + partNum; ++i) {
+    SHJoinPartition* pPart = hJoinGetPart(pSpill, i);
+    HJ_ERR_RET(hJoinSpillFlushProbeBlk(pJoin, pPart));
+    blockDataDestroy(pPart->pProbeBlk);
+    pPart->pProbeBlk = NULL;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSplitSpillBuildRows(SHJoinOperatorInfo* pJoin, int32_t partIdx) {
+  SHJoinSpillCtx*  pSpill = pJoin->pSpill;
+  SHJoinPartition* pPart = hJoinGetPart(pSpill, partIdx);
+  int32_t          childIdx = pPart->childIdx;
+  int32_t          level = pPart->level + 1;
+  int32_t          pageNum = taosArrayGetSize(pPart->pBuildPages);
+
+  for (int32_t i = 0; i < pageNum; ++i) {
+    int32_t* pageId = taosArrayGet(hJoinGetPart(pSpill, partIdx)->pBuildPages, i);
+    char*    pPage = getBufPage(pSpill->pBuildBuf, *pageId);
+    if (NULL == pPage) {
+      return terrno;
+    }
+
+    int32_t offset = sizeof(int32_t);
+    while (offset < *(int32_t*)pPage) {
+      int32_t keyLen = *(int32_t*)(pPage + offset);
+      int32_t valLen = *(int32_t*)(pPage + offset + sizeof(int32_t));
+      char*   pKey = pPage + offset + 2 * sizeof(int32_t);
+      char*   pValBuf = NULL;
+      void*   pChildPage = NULL;
+
+      SHJoinPartition* pChild = hJoinGetPart(pSpill, childIdx + hJoinGetPartIdx(pSpill, level, pKey, keyLen));
+      int32_t          code = hJoinGetSpillRowBuf(pSpill, pChild, pKey, keyLen, valLen, &pChildPage, &pValBuf);
+      if (code) {
+        releaseBufPage(pSpill->pBuildBuf, pPage);
+        return code;
+      }
+      if (valLen > 0) {
+        TAOS_MEMCPY(pValBuf, pKey + keyLen, valLen);
+      }
+      hJoinReleaseSpillPage(pSpill->pBuildBuf, pChildPage);
+
+      offset += 2 * sizeof(int32_t) + keyLen + valLen;
+    }
+
+    HJ_ERR_RET(dBufSetBufPageRecycled(pSpill->pBuildBuf, pPage));
+  }
+
+  pPart = hJoinGetPart(pSpill, partIdx);
+  taosArrayClear(pPart->pBuildPages);
+  pPart->buildRows = 0;
+  pPart->buildSize = 0;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSplitSpillProbeRows(SHJoinOperatorInfo* pJoin, int32_t partIdx) {
+  SHJoinSpillCtx*  pSpill = pJoin->pSpill;
+  SHJoinTableCtx*  pProbe = pJoin->pProbe;
+  SHJoinPartition* pPart = hJoinGetPart(pSpill, partIdx);
+  int32_t          childIdx = pPart->childIdx;
+  int32_t          level = pPart->level + 1;
+  int32_t          pageNum = taosArrayGetSize(pPart->pProbePages);
+  bool             innerJoin = IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType);
+  int64_t          spillProbeRows = pJoin->execInfo.spillProbeRows;
+
+  for (int32_t i = 0; i < pageNum; ++i) {
+    int32_t* pageId = taosArrayGet(hJoinGetPart(pSpill, partIdx)->pProbePages, i);
+    HJ_ERR_RET(hJoinSpillLoadProbePage(pSpill, *pageId, true));
+
+    SSDataBlock* pBlock = pSpill->pProbeBlk;
+    size_t       keyLen = 0;
+    HJ_ERR_RET(hJoinSpillEnsureRowBuf(pSpill, pBlock->info.rows));
+    HJ_ERR_RET(hJoinSetKeyColsData(pBlock, pProbe));
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      // the rows were checked when they were partitioned, none of them has a null key
+      (void)hJoinCopyKeyColsDataToBuf(pProbe, r, &keyLen);
+      int32_t idx = hJoinGetPartIdx(pSpill, level, pProbe->keyData, keyLen);
+      if (innerJoin && 0 == hJoinGetPart(pSpill, childIdx + idx)->buildRows) {
+        idx = -1;
+      }
+      pSpill->pRowPart[r] = idx;
+    }
+
+    HJ_ERR_RET(hJoinSpillScatterProbeRows(pJoin, pBlock, childIdx));
+  }
+
+  taosArrayClear(hJoinGetPart(pSpill, partIdx)->pProbePages);
+  HJ_ERR_RET(hJoinSpillFlushParts(pJoin, childIdx, HJOIN_PART_NUM));
+
+  // the moved rows were counted when they were spilled the first time
+  pJoin->execInfo.spillProbeRows = spillProbeRows;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// move the rows of a partition too large to be loaded into HJOIN_PART_NUM sub partitions appended to pParts,
+// which are visited after all the current ones
+static int32_t hJoinSplitSpillPartition(SHJoinOperatorInfo* pJoin, int32_t partIdx) {
+  SHJoinSpillCtx*  pSpill = pJoin->pSpill;
+  SHJoinPartition* pPart = hJoinGetPart(pSpill, partIdx);
+  int32_t          childIdx = taosArrayGetSize(pSpill->pParts);
+  int32_t          level = pPart->level + 1;
+  int64_t          buildRows = pPart->buildRows;
+  int64_t          memSize = hJoinGetPartMemSize(pPart);
+
+  HJ_ERR_RET(hJoinAddSpillParts(pSpill, HJOIN_PART_NUM, level));
+  hJoinGetPart(pSpill, partIdx)->childIdx = childIdx;
+
+  HJ_ERR_RET(hJoinSplitSpillBuildRows(pJoin, partIdx));
+  HJ_ERR_RET(hJoinSplitSpillProbeRows(pJoin, partIdx));
+
+  pJoin->execInfo.spillPartSplits++;
+  pJoin->execInfo.spillMaxLevel = TMAX(pJoin->execInfo.spillMaxLevel, level);
+
+  qDebug("hash join partition %d split into partitions %d~%d at level %d, rows:%" PRId64 ", memSize:%" PRId64,
+         partIdx, childIdx, childIdx + HJOIN_PART_NUM - 1, level, buildRows, memSize);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillInitProbeBuf(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinSpillCtx*     pSpill = pJoin->pSpill;
+
+  HJ_ERR_RET(createOneDataBlock(pBlock, false, &pSpill->pProbeBlk));
+
+  int32_t metaSize = blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock));
+  int32_t pageSize = TMAX(HJOIN_SPILL_PAGE_SIZE, metaSize + pSpill->pProbeBlk->info.rowSize * 4);
+  HJ_ERR_RET(createDiskbasedBuf(&pSpill->pProbeBuf, pageSize, HJOIN_SPILL_BUF_SIZE, GET_TASKID(pOperator->pTaskInfo), tsTempDir));
+
+  int64_t capacity = (int64_t)blockDataGetCapacityInRow(pSpill->pProbeBlk, pageSize, metaSize);
+  if (capacity <= 0) {
+    return terrno;
+  }
+  pSpill->probeBlkRows = (int32_t)capacity;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinSpillPartitionProbe(SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinSpillCtx*     pSpill = pJoin->pSpill;
+
+  while (true) {
+    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    if (NULL == pBlock) {
+      break;
+    }
+
+    pJoin->execInfo.probeBlkNum++;
+    pJoin->execInfo.probeBlkRows += pBlock->info.rows;
+
+    if (pBlock->info.rows <= 0) {
+      continue;
+    }
+    if (NULL == pSpill->pProbeBuf) {
+      HJ_ERR_RET(hJoinSpillInitProbeBuf(pOperator, pBlock));
+    }
+
+    HJ_ERR_RET(hJoinSpillAddProbeBlock(pJoin, pBlock));
+  }
+
+  HJ_ERR_RET(hJoinSpillFlushParts(pJoin, 0, HJOIN_PART_NUM + 1));
+
+  pSpill->probePartitioned = true;
+
+  qDebug("%s hash join probe side partitioned, probeRows:%" PRId64 ", spillProbeRows:%" PRId64,
+         GET_TASKID(pOperator->pTaskInfo), pJoin->execInfo.probeBlkRows, pJoin->execInfo.spillProbeRows);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t hJoinGetProbeBlock(SOperatorInfo* pOperator, SSDataBlock** ppBlock) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinSpillCtx*     pSpill = pJoin->pSpill;
+
+  *ppBlock = NULL;
+
+  if (NULL == pSpill) {
+    *ppBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    if (*ppBlock) {
+      pJoin->execInfo.probeBlkNum++;
+      pJoin->execInfo.probeBlkRows += (*ppBlock)->info.rows;
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (!pSpill->probePartitioned) {
+    HJ_ERR_RET(hJoinSpillPartitionProbe(pOperator));
+  }
+
+  for (; pSpill->partIdx < taosArrayGetSize(pSpill->pParts); ++pSpill->partIdx, pSpill->pageIdx = 0) {
+    SHJoinPartition* pPart = hJoinGetPart(pSpill, pSpill->partIdx);
+    if (pSpill->pageIdx >= taosArrayGetSize(pPart->pProbePages)) {
+      continue;
+    }
+
+    if (pSpill->loadedPartIdx != pSpill->partIdx) {
+      if (pPart->level < HJOIN_PART_MAX_LEVEL && hJoinGetPartMemSize(pPart) > pJoin->buildMemLimit) {
+        HJ_ERR_RET(hJoinSplitSpillPartition(pJoin, pSpill->partIdx));
+        continue;
+      }
+      HJ_ERR_RET(hJoinLoadSpillPartition(pJoin, pSpill->partIdx));
+    }
+
+    int32_t* pageId = taosArrayGet(pPart->pProbePages, pSpill->pageIdx++);
+    HJ_ERR_RET(hJoinSpillLoadProbePage(pSpill, *pageId, false));
+
+    *ppBlock = pSpill->pProbeBlk;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool hJoinProbeInTimeRange(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, int32_t* startIdx, int32_t* endIdx) {
+  // spilled probe rows were already split by the time range when they were partitioned
+  if (pJoin->pSpill) {
+    return HJOIN_NMATCH_PART != pJoin->pSpill->partIdx;
+  }
+
+  return hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pJoin->pProbe->primCol->srcSlot, startIdx, endIdx);
+}
+
 static int32_t hJoinPrepareStart(struct SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SHJoinTableCtx* pProbe = pJoin->pProbe;
   int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
-  if (pProbe->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pProbe->primCol->srcSlot, &startIdx, &endIdx)) {
+  if (pProbe->hasTimeRange && !hJoinProbeInTimeRange(pJoin, pBlock, &startIdx, &endIdx)) {
     if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType)) {
       pJoin->ctx.probeEndIdx = -1;
       pJoin->ctx.probePostIdx = 0;
@@ -985,6 +1701,7 @@ void hJoinSetDone(struct SOperatorInfo* pOperator) {
 
   SHJoinOperatorInfo* pInfo = pOperator->info;
   hJoinDestroyKeyHash(&pInfo->pKeyHash);
+  hJoinDestroySpill(&pInfo->pSpill);
 
   qDebug("hash Join done");  
 }
@@ -1037,15 +1754,14 @@ static int32_t hJoinMainProcess(struct SOperatorInfo* pOperator, SSDataBlock** p
   }
 
   while (true) {
-    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    SSDataBlock* pBlock = NULL;
+    code = hJoinGetProbeBlock(pOperator, &pBlock);
+    QUERY_CHECK_CODE(code, lino, _end);
     if (NULL == pBlock) {
       hJoinSetDone(pOperator);
       break;
     }
 
-    pJoin->execInfo.probeBlkNum++;
-    pJoin->execInfo.probeBlkRows += pBlock->info.rows;
-
     code = hJoinPrepareStart(pOperator, pBlock);
     QUERY_CHECK_CODE(code, lino, _end);
 
@@ -1081,11 +1797,14 @@ _end:
 
 static void destroyHashJoinOperator(void* param) {
   SHJoinOperatorInfo* pJoinOperator = (SHJoinOperatorInfo*)param;
-  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
+  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64
+         ", spillBuildRows:%" PRId64 ", spillProbeRows:%" PRId64 ", spillPartSplits:%" PRId64 ", spillMaxLevel:%" PRId64, 
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
-         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows, pJoinOperator->execInfo.spillBuildRows,
+         pJoinOperator->execInfo.spillProbeRows, pJoinOperator->execInfo.spillPartSplits, pJoinOperator->execInfo.spillMaxLevel);
 
   hJoinDestroyKeyHash(&pJoinOperator->pKeyHash);
+  hJoinDestroySpill(&pJoinOperator->pSpill);
 
   hJoinFreeTableInfo(&pJoinOperator->tbs[0]);
   hJoinFreeTableInfo(&pJoinOperator->tbs[1]);
@@ -1186,6 +1905,7 @@ int32_t createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t numOfDow
   pInfo->tblTimeRange.ekey = pJoinNode->timeRange.ekey;
   
   pInfo->ctx.limit = pJoinNode->node.pLimit ? ((SLimitNode*)pJoinNode->node.pLimit)->limit : INT64_MAX;
+  pInfo->buildMemLimit = tsQueryHashJoinMemLimitBytes;
 
   setOperatorInfo(pOperator, "HashJoinOperator", QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN, false, OP_NOT_OPENED, pInfo, pTaskInfo);
 
@@ -706,6 +706,7 @@ int32_t getOperatorExplainExecInfo(SOperatorInfo* operatorInfo, SArray* pExecInf
   pExplainInfo->numOfRows = operatorInfo->resultInfo.totalRows;
   pExplainInfo->startupCost = operatorInfo->cost.openCost;
   pExplainInfo->totalCost = operatorInfo->cost.totalCost;
+  pExplainInfo->prof = operatorInfo->prof;
   pExplainInfo->verboseLen = 0;
   pExplainInfo->verboseInfo = NULL;
 
@@ -255,6 +255,34 @@ static int32_t doFilterByBlockSMA(SFilterInfo* pFilterInfo, SColumnDataAgg* pCol
   return filterRangeExecute(pFilterInfo, pColsAgg, numOfCols, numOfRows, keep);
 }
 
+// check if the block SMA shows that no row of the block can beat the worst row kept by the upstream top-k sort
+bool doPruneBlockByTopKBound(const SSortTopKBound* pBound, const SColumnDataAgg* pColsAgg, int32_t numOfRows) {
+  const SColumnDataAgg* pAgg = &pColsAgg[pBound->slotId];
+  if (pAgg->colId == -1 || (pAgg->numOfNull > 0 && pBound->nullFirst)) {
+    return false;
+  }
+
+  // null values are ordered after the bound
+  if (pAgg->numOfNull >= numOfRows) {
+    return true;
+  }
+
+  int64_t best = (pBound->order == TSDB_ORDER_DESC) ? pAgg->max : pAgg->min;
+  int32_t res = 0;
+  if (IS_FLOAT_TYPE(pBound->type)) {
+    double v = *(double*)&best;
+    double b = *(double*)&pBound->val;
+    res = (v < b) ? -1 : ((v > b) ? 1 : 0);
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(pBound->type)) {
+    res = ((uint64_t)best < (uint64_t)pBound->val) ? -1 : (((uint64_t)best > (uint64_t)pBound->val) ? 1 : 0);
+  } else {
+    res = (best < pBound->val) ? -1 : ((best > pBound->val) ? 1 : 0);
+  }
+
+  // rows equal to the bound are kept, since the following sort keys may still decide for them
+  return (pBound->order == TSDB_ORDER_DESC) ? (res < 0) : (res > 0);
+}
+
 static int32_t doLoadBlockSMA(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo,
                               bool* pLoad) {
   SStorageAPI* pAPI = &pTaskInfo->storageAPI;
@@ -366,6 +394,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
            pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
     pCost->filterOutBlocks += 1;
     pCost->totalRows += pBlock->info.rows;
+    pOperator->prof.skipBlocks += 1;
     pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
     return TSDB_CODE_SUCCESS;
   } else if (*status == FUNC_DATA_REQUIRED_NOT_LOAD) {
@@ -374,6 +403,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
            pBlockInfo->id.uid);
     code = doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
     pCost->skipBlocks += 1;
+    pOperator->prof.skipBlocks += 1;
     pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
     return code;
   } else if (*status == FUNC_DATA_REQUIRED_SMA_LOAD) {
@@ -405,8 +435,9 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
   }
 
-  // try to filter data block according to sma info
-  if (pOperator->exprSupp.pFilterInfo != NULL && (!loadSMA)) {
+  // try to filter data block according to sma info, and the bound of the upstream top-k sort
+  bool pruneByTopK = (pTableScanInfo->pTopKBound != NULL && pTableScanInfo->pTopKBound->valid);
+  if ((pOperator->exprSupp.pFilterInfo != NULL || pruneByTopK) && (!loadSMA)) {
     bool success = true;
     code = doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo, &success);
     if (code) {
@@ -425,10 +456,18 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
         QUERY_CHECK_CODE(code, lino, _end);
       }
 
+      if (keep && pruneByTopK &&
+          doPruneBlockByTopKBound(pTableScanInfo->pTopKBound, pBlock->pBlockAgg, pBlockInfo->rows)) {
+        qDebug("%s data block pruned by top-k bound, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+               GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+        keep = false;
+      }
+
       if (!keep) {
         qDebug("%s data block filter out by block SMA, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
                GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
         pCost->filterOutBlocks += 1;
+        pOperator->prof.skipBlocks += 1;
         (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
         taosMemoryFreeClear(pBlock->pBlockAgg);
 
@@ -452,6 +491,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     qDebug("%s data block skipped due to dynamic prune, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
            GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
     pCost->skipBlocks += 1;
+    pOperator->prof.skipBlocks += 1;
     pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
 
     STableScanInfo* p1 = pOperator->info;
@@ -467,11 +507,16 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->loadBlocks += 1;
 
   SSDataBlock* p = NULL;
+  int64_t      st = taosGetTimestampUs();
   code = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, &p, NULL);
+  pOperator->prof.loadTime += (taosGetTimestampUs() - st) / 1000.0;
   if (p == NULL || code != TSDB_CODE_SUCCESS || p != pBlock) {
     return code;
   }
 
+  pOperator->prof.loadBlocks += 1;
+  pOperator->prof.loadBytes += blockDataGetSize(pBlock);
+
   code = doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
   if (code) {
     return code;
@@ -481,12 +526,13 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalRows -= pBlock->info.rows;
 
   if (pOperator->exprSupp.pFilterInfo != NULL) {
+    st = taosGetTimestampUs();
     code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
     QUERY_CHECK_CODE(code, lino, _end);
 
-    int64_t st = taosGetTimestampUs();
-    double  el = (taosGetTimestampUs() - st) / 1000.0;
+    double el = (taosGetTimestampUs() - st) / 1000.0;
     pTableScanInfo->readRecorder.filterTime += el;
+    pOperator->prof.filterTime += el;
 
     if (pBlock->info.rows == 0) {
       pCost->filterOutBlocks += 1;
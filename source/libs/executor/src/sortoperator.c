@@ -41,6 +41,7 @@ typedef struct SSortOperatorInfo {
   uint64_t            maxTupleLength;
   int64_t             maxRows;
   SSortOpGroupIdCalc* pGroupIdCalc;
+  SSortTopKBound      topKBound;
 } SSortOperatorInfo;
 
 static int32_t doSort(SOperatorInfo* pOperator, SSDataBlock** pResBlock);
@@ -355,6 +356,36 @@ void applyScalarFunction(SSDataBlock* pBlock, void* param) {
   }
 }
 
+// share the bound of the pq sort with the table scan below, so that it can skip the blocks that can not enter the
+// result by their SMA. Only a plain numeric column from the scan is supported as the first sort key.
+static void setTopKBoundForScan(SOperatorInfo* pOperator) {
+  SSortOperatorInfo* pInfo = pOperator->info;
+  SOperatorInfo*     pDownstream = pOperator->pDownstream[0];
+  if (pInfo->maxRows <= 0 || pOperator->exprSupp.numOfExprs > 0 ||
+      pDownstream->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return;
+  }
+
+  STableScanInfo*  pScan = pDownstream->info;
+  SBlockOrderInfo* pOrder = taosArrayGet(pInfo->pSortInfo, 0);
+  if (pOrder == NULL) {
+    return;
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pScan->pResBlock->pDataBlock, pOrder->slotId);
+  if (pCol == NULL || !IS_MATHABLE_TYPE(pCol->info.type)) {
+    return;
+  }
+
+  pInfo->topKBound = (SSortTopKBound){.valid = false,
+                                      .nullFirst = pOrder->nullFirst,
+                                      .order = pOrder->order,
+                                      .slotId = pOrder->slotId,
+                                      .type = pCol->info.type};
+  tsortSetTopKBound(pInfo->pSortHandle, &pInfo->topKBound);
+  pScan->base.pTopKBound = &pInfo->topKBound;
+}
+
 int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
   SSortOperatorInfo* pInfo = pOperator->info;
   SExecTaskInfo*     pTaskInfo = pOperator->pTaskInfo;
@@ -375,6 +406,7 @@ int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
   QUERY_CHECK_CODE(code, lino, _end);
 
   tsortSetFetchRawDataFp(pInfo->pSortHandle, loadNextDataBlock, applyScalarFunction, pOperator);
+  setTopKBoundForScan(pOperator);
 
   pSource = taosMemoryCalloc(1, sizeof(SSortSource));
   QUERY_CHECK_NULL(pSource, code, lino, _end, terrno);
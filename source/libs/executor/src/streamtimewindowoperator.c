@@ -494,6 +494,7 @@ void destroyStreamFinalIntervalOperatorInfo(void* param) {
   blockDataDestroy(pInfo->pPullDataRes);
   taosArrayDestroy(pInfo->pDelWins);
   blockDataDestroy(pInfo->pDelRes);
+  taosArrayDestroy(pInfo->pWinRuns);
   blockDataDestroy(pInfo->pMidRetriveRes);
   blockDataDestroy(pInfo->pMidPulloverRes);
   if (pInfo->pUpdatedMap != NULL) {
@@ -1029,8 +1030,174 @@ static int32_t getNextQualifiedFinalWindow(SInterval* pInterval, STimeWindow* pN
   return startPos;
 }
 
-static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock, uint64_t groupId,
-                                       SSHashObj* pUpdatedMap, SSHashObj* pDeletedMap) {
+// aggregate rows [startPos, startPos + forwardRows) of the block into the state row of window pWin
+static int32_t doStreamIntervalAggWindow(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock, uint64_t groupId,
+                                         STimeWindow* pWin, int32_t startPos, int32_t forwardRows,
+                                         SSHashObj* pUpdatedMap, SSHashObj* pDeletedMap) {
+  int32_t                      code = TSDB_CODE_SUCCESS;
+  int32_t                      lino = 0;
+  SStreamIntervalOperatorInfo* pInfo = (SStreamIntervalOperatorInfo*)pOperator->info;
+  SExecTaskInfo*               pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*                   pSup = &pOperator->exprSupp;
+  SRowBuffPos*                 pResPos = NULL;
+  int32_t                      winCode = TSDB_CODE_SUCCESS;
+
+  code = setIntervalOutputBuf(pInfo->pState, pWin, &pResPos, groupId, pSup->pCtx, pSup->numOfExprs,
+                              pSup->rowEntryInfoOffset, &pInfo->aggSup, &pInfo->stateStore, &winCode);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  SResultRow* pResult = (SResultRow*)pResPos->pRowBuff;
+  SWinKey     key = {
+          .ts = pResult->win.skey,
+          .groupId = groupId,
+  };
+
+  if (pInfo->destHasPrimaryKey && winCode == TSDB_CODE_SUCCESS && IS_NORMAL_INTERVAL_OP(pOperator)) {
+    code = tSimpleHashPut(pDeletedMap, &key, sizeof(SWinKey), NULL, 0);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  if (pInfo->twAggSup.calTrigger == STREAM_TRIGGER_AT_ONCE && pUpdatedMap) {
+    code = saveWinResult(&key, pResPos, pUpdatedMap);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  if (pInfo->twAggSup.calTrigger == STREAM_TRIGGER_WINDOW_CLOSE) {
+    pResPos->beUpdated = true;
+    code = tSimpleHashPut(pInfo->aggSup.pResultRowHashTable, &key, sizeof(SWinKey), &pResPos, POINTER_BYTES);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, pWin, 1);
+  code = applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos,
+                                         forwardRows, pSDataBlock->info.rows, pSup->numOfExprs);
+  QUERY_CHECK_CODE(code, lino, _end);
+  key.ts = pWin->skey;
+
+  if (pInfo->delKey.ts > key.ts) {
+    pInfo->delKey = key;
+  }
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s. task:%s", __func__, lino, tstrerror(code), GET_TASKID(pTaskInfo));
+  }
+  return code;
+}
+
+/*
+ * Append-only, in-order input of a tumbling interval needs little of the per-window work of the general path: there
+ * is no sliding calculation range to clip against and the windows are aligned on the interval. A block holds the rows
+ * of one table in one group, so it is cut into window runs in one forward pass over the ts column and every run is
+ * aggregated with a single call over its rows, instead of a binary search for every window. A block whose ts goes back
+ * is found by the same pass and left to the general path before any row is aggregated.
+ */
+static bool isStreamIntervalAppendOnly(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock) {
+  SStreamIntervalOperatorInfo* pInfo = (SStreamIntervalOperatorInfo*)pOperator->info;
+  SInterval*                   pInterval = &pInfo->interval;
+
+  // the semi, mid and final operators keep the pull and child window handling of the general path
+  if (pOperator->operatorType != QUERY_NODE_PHYSICAL_PLAN_STREAM_INTERVAL || pSDataBlock->info.type != STREAM_NORMAL) {
+    return false;
+  }
+
+  if (pInterval->interval != pInterval->sliding || pInterval->intervalUnit == 'n' || pInterval->intervalUnit == 'y') {
+    return false;
+  }
+
+  return true;
+}
+
+static int32_t partitionStreamIntervalRuns(SStreamIntervalOperatorInfo* pInfo, TSKEY* tsCols, int32_t rows,
+                                           STimeWindow* pFirstWin, bool* pInOrder) {
+  int64_t     interval = pInfo->interval.interval;
+  STimeWindow win = *pFirstWin;
+  int32_t     startPos = 0;
+
+  taosArrayClear(pInfo->pWinRuns);
+  *pInOrder = false;
+  if (tsCols[0] < win.skey || tsCols[0] > win.ekey) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  while (startPos < rows) {
+    int32_t endPos = startPos + 1;
+    for (; endPos < rows; ++endPos) {
+      if (tsCols[endPos] < tsCols[endPos - 1]) {
+        return TSDB_CODE_SUCCESS;
+      }
+      if (tsCols[endPos] > win.ekey) {
+        break;
+      }
+    }
+
+    SStreamIntervalRun run = {.win = win, .startPos = startPos, .rows = endPos - startPos};
+    if (NULL == taosArrayPush(pInfo->pWinRuns, &run)) {
+      return terrno;
+    }
+
+    if (endPos >= rows) {
+      break;
+    }
+
+    // jump over the empty windows between two runs directly
+    win.skey += ((tsCols[endPos] - win.skey) / interval) * interval;
+    win.ekey = win.skey + interval - 1;
+    startPos = endPos;
+  }
+
+  *pInOrder = true;
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * The expired check is made once for every window run, the same as the general path does for every window. Besides
+ * dropping the runs of expired windows, it moves the max ts of the table in the update info shared with the stream
+ * scan, which later decides whether disordered rows are updates.
+ */
+static int32_t doStreamIntervalAppendOnlyRuns(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock, uint64_t groupId,
+                                              SSHashObj* pUpdatedMap, SSHashObj* pDeletedMap) {
+  SStreamIntervalOperatorInfo* pInfo = (SStreamIntervalOperatorInfo*)pOperator->info;
+  int32_t                      numOfRuns = taosArrayGetSize(pInfo->pWinRuns);
+  SColumnInfoData*             pPkColDataInfo = NULL;
+
+  if (hasSrcPrimaryKeyCol(&pInfo->basic)) {
+    pPkColDataInfo = taosArrayGet(pSDataBlock->pDataBlock, pInfo->basic.primaryPkIndex);
+  }
+
+  for (int32_t i = 0; i < numOfRuns; ++i) {
+    SStreamIntervalRun* pRun = taosArrayGet(pInfo->pWinRuns, i);
+
+    bool expired = false;
+    if (pInfo->ignoreExpiredData) {
+      void*   pPkVal = NULL;
+      int32_t pkLen = 0;
+      if (pPkColDataInfo != NULL) {
+        pPkVal = colDataGetData(pPkColDataInfo, pRun->startPos);
+        pkLen = colDataGetRowLength(pPkColDataInfo, pRun->startPos);
+      }
+      expired = checkExpiredData(&pInfo->stateStore, pInfo->pUpdateInfo, &pInfo->twAggSup, pSDataBlock->info.id.uid,
+                                 pRun->win.ekey, pPkVal, pkLen);
+    }
+
+    if (expired) {
+      qDebug("===stream===ignore expired data, window end ts:%" PRId64 ", maxts - wartermak:%" PRId64, pRun->win.ekey,
+             pInfo->twAggSup.maxTs - pInfo->twAggSup.waterMark);
+      continue;
+    }
+
+    int32_t code = doStreamIntervalAggWindow(pOperator, pSDataBlock, groupId, &pRun->win, pRun->startPos, pRun->rows,
+                                             pUpdatedMap, pDeletedMap);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pSDataBlock, uint64_t groupId,
+                                SSHashObj* pUpdatedMap, SSHashObj* pDeletedMap) {
   int32_t                      code = TSDB_CODE_SUCCESS;
   int32_t                      lino = 0;
   SStreamIntervalOperatorInfo* pInfo = (SStreamIntervalOperatorInfo*)pOperator->info;
@@ -1038,12 +1205,8 @@ static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pS
 
   SResultRowInfo* pResultRowInfo = &(pInfo->binfo.resultRowInfo);
   SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
-  SExprSupp*      pSup = &pOperator->exprSupp;
-  int32_t         numOfOutput = pSup->numOfExprs;
   int32_t         step = 1;
   TSKEY*          tsCols = NULL;
-  SRowBuffPos*    pResPos = NULL;
-  SResultRow*     pResult = NULL;
   int32_t         forwardRows = 0;
   int32_t         endRowId = pSDataBlock->info.rows - 1;
 
@@ -1078,6 +1241,18 @@ static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pS
   } else {
     nextWin = getActiveTimeWindow(pInfo->aggSup.pResultBuf, pResultRowInfo, ts, &pInfo->interval, TSDB_ORDER_ASC);
   }
+
+  if (isStreamIntervalAppendOnly(pOperator, pSDataBlock)) {
+    bool inOrder = false;
+    code = partitionStreamIntervalRuns(pInfo, tsCols, pSDataBlock->info.rows, &nextWin, &inOrder);
+    QUERY_CHECK_CODE(code, lino, _end);
+    if (inOrder) {
+      code = doStreamIntervalAppendOnlyRuns(pOperator, pSDataBlock, groupId, pUpdatedMap, pDeletedMap);
+      QUERY_CHECK_CODE(code, lino, _end);
+      goto _end;
+    }
+  }
+
   while (1) {
     bool isClosed = isCloseWindow(&nextWin, &pInfo->twAggSup);
     if (hasSrcPrimaryKeyCol(&pInfo->basic) && !IS_FINAL_INTERVAL_OP(pOperator) && pInfo->ignoreExpiredData &&
@@ -1143,13 +1318,6 @@ static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pS
       }
     }
 
-    int32_t winCode = TSDB_CODE_SUCCESS;
-    code = setIntervalOutputBuf(pInfo->pState, &nextWin, &pResPos, groupId, pSup->pCtx, numOfOutput,
-                                pSup->rowEntryInfoOffset, &pInfo->aggSup, &pInfo->stateStore, &winCode);
-    QUERY_CHECK_CODE(code, lino, _end);
-
-    pResult = (SResultRow*)pResPos->pRowBuff;
-
     if (IS_FINAL_INTERVAL_OP(pOperator)) {
       forwardRows = 1;
     } else {
@@ -1157,36 +1325,10 @@ static int32_t doStreamIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pS
                                              NULL, TSDB_ORDER_ASC);
     }
 
-    SWinKey key = {
-        .ts = pResult->win.skey,
-        .groupId = groupId,
-    };
-
-    if (pInfo->destHasPrimaryKey && winCode == TSDB_CODE_SUCCESS && IS_NORMAL_INTERVAL_OP(pOperator)) {
-      code = tSimpleHashPut(pDeletedMap, &key, sizeof(SWinKey), NULL, 0);
-      QUERY_CHECK_CODE(code, lino, _end);
-    }
-
-    if (pInfo->twAggSup.calTrigger == STREAM_TRIGGER_AT_ONCE && pUpdatedMap) {
-      code = saveWinResult(&key, pResPos, pUpdatedMap);
-      QUERY_CHECK_CODE(code, lino, _end);
-    }
-
-    if (pInfo->twAggSup.calTrigger == STREAM_TRIGGER_WINDOW_CLOSE) {
-      pResPos->beUpdated = true;
-      code = tSimpleHashPut(pInfo->aggSup.pResultRowHashTable, &key, sizeof(SWinKey), &pResPos, POINTER_BYTES);
-      QUERY_CHECK_CODE(code, lino, _end);
-    }
-
-    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &nextWin, 1);
-    code = applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos,
-                                           forwardRows, pSDataBlock->info.rows, numOfOutput);
+    code = doStreamIntervalAggWindow(pOperator, pSDataBlock, groupId, &nextWin, startPos, forwardRows, pUpdatedMap,
+                                     pDeletedMap);
     QUERY_CHECK_CODE(code, lino, _end);
-    key.ts = nextWin.skey;
 
-    if (pInfo->delKey.ts > key.ts) {
-      pInfo->delKey = key;
-    }
     int32_t prevEndPos = (forwardRows - 1) * step + startPos;
     if (IS_FINAL_INTERVAL_OP(pOperator)) {
       startPos = getNextQualifiedFinalWindow(&pInfo->interval, &nextWin, &pSDataBlock->info, tsCols, prevEndPos);
@@ -5375,6 +5517,9 @@ int32_t createStreamIntervalOperatorInfo(SOperatorInfo* downstream, SPhysiNode*
   QUERY_CHECK_NULL(pInfo->pDelWins, code, lino, _error, terrno);
   pInfo->delIndex = 0;
 
+  pInfo->pWinRuns = taosArrayInit(4, sizeof(SStreamIntervalRun));
+  QUERY_CHECK_NULL(pInfo->pWinRuns, code, lino, _error, terrno);
+
   code = createSpecialDataBlock(STREAM_DELETE_RESULT, &pInfo->pDelRes);
   QUERY_CHECK_CODE(code, lino, _error);
 
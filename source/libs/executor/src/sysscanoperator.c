@@ -38,18 +38,18 @@ typedef int (*__optSysFilter)(void* a, void* b, int16_t dtype);
 typedef int32_t (*__sys_filte)(void* pMeta, SNode* cond, SArray* result);
 typedef int32_t (*__sys_check)(SNode* cond);
 
-typedef struct SSTabFltArg {
-  void*        pMeta;
-  void*        pVnode;
-  SStorageAPI* pAPI;
-} SSTabFltArg;
-
 typedef struct SSysTableIndex {
   int8_t  init;
   SArray* uids;
   int32_t lastIdx;
 } SSysTableIndex;
 
+typedef struct SSysTableStbInfo {
+  char    name[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE];
+  int32_t numOfCols;
+  bool    isTsmaRes;
+} SSysTableStbInfo;
+
 typedef struct SSysTableScanInfo {
   SRetrieveMetaTableRsp* pRsp;
   SRetrieveTableReq      req;
@@ -65,6 +65,7 @@ typedef struct SSysTableScanInfo {
   SMTbCursor*            pCur;        // cursor for iterate the local table meta store.
   SSysTableIndex*        pIdx;        // idx for local table meta
   SHashObj*              pSchema;
+  SHashObj*              pStbInfo;  // super table info by suid, shared by its child tables
   SColMatchInfo          matchInfo;
   SName                  name;
   SSDataBlock*           pRes;
@@ -275,15 +276,38 @@ int32_t sysFilte__Ttl(void* arg, SNode* pNode, SArray* result) {
 }
 
 int32_t sysFilte__STableName(void* arg, SNode* pNode, SArray* result) {
-  void* pMeta = ((SSTabFltArg*)arg)->pMeta;
+  SSTabFltArg* pArg = arg;
+  SStorageAPI* pAPI = pArg->pAPI;
 
   SOperatorNode* pOper = (SOperatorNode*)pNode;
   SValueNode*    pVal = (SValueNode*)pOper->pRight;
-  bool           reverse = false;
-  bool           equal = false;
-  __optSysFilter func = optSysGetFilterFunc(pOper->opType, &reverse, &equal);
-  if (func == NULL) return -1;
-  return -1;
+  if (pOper->opType != OP_TYPE_EQUAL || varDataLen(pVal->datum.p) >= TSDB_TABLE_NAME_LEN) {
+    return -1;
+  }
+
+  char stbName[TSDB_TABLE_NAME_LEN] = {0};
+  memcpy(stbName, varDataVal(pVal->datum.p), varDataLen(pVal->datum.p));
+
+  // the child tables are listed from the suid index, instead of walking through all tables in this vnode
+  SMetaReader mr = {0};
+  pAPI->metaReaderFn.initReader(&mr, pArg->pVnode, META_READER_LOCK, &pAPI->metaFn);
+  int32_t code = pAPI->metaReaderFn.getTableEntryByName(&mr, stbName);
+  if (code != TSDB_CODE_SUCCESS || mr.me.type != TSDB_SUPER_TABLE || isTsmaResSTb(mr.me.name)) {
+    // no such super table in current vnode, so does any child table of it
+    pAPI->metaReaderFn.clearReader(&mr);
+    return 0;
+  }
+
+  int64_t suid = mr.me.uid;
+  pAPI->metaReaderFn.clearReader(&mr);
+
+  code = pAPI->metaFn.getChildTableList(pArg->pVnode, suid, result);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed to get child tables of suid:0x%" PRIx64 " since %s", __func__, suid, tstrerror(code));
+    return -1;
+  }
+
+  return 0;
 }
 
 int32_t sysFilte__Uid(void* arg, SNode* pNode, SArray* result) {
@@ -382,7 +406,6 @@ static int optSysFilterFuncImpl__NoEqual(void* a, void* b, int16_t dtype) {
   return optSysDoCompare(func, OP_TYPE_NOT_EQUAL, a, b);
 }
 
-static int32_t optSysTabFilte(void* arg, SNode* cond, SArray* result);
 static int32_t optSysTabFilteImpl(void* arg, SNode* cond, SArray* result);
 static int32_t optSysCheckOper(SNode* pOpear);
 static int32_t optSysMergeRslt(SArray* mRslt, SArray* rslt);
@@ -1383,171 +1406,246 @@ _end:
   return code;
 }
 
-static int32_t doSetUserTableMetaInfo(SStoreMetaReader* pMetaReaderFn, SStoreMeta* pMetaFn, void* pVnode,
-                                      SMetaReader* pMReader, int64_t uid, const char* dbname, int32_t vgId,
-                                      SSDataBlock* p, int32_t rowIndex, const char* idStr) {
-  char    n[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE] = {0};
-  int32_t lino = 0;
-  int32_t code = pMetaReaderFn->getTableEntryByUid(pMReader, uid);
-  if (code < 0) {
-    qError("failed to get table meta, uid:%" PRId64 ", code:%s, %s", uid, tstrerror(terrno), idStr);
-    return code;
+static int32_t sysTableGetStbInfo(SStoreMetaReader* pMetaReaderFn, SStoreMeta* pMetaFn, void* pVnode,
+                                  SHashObj** pStbInfo, int64_t suid, SSysTableStbInfo* pInfo) {
+  if (*pStbInfo == NULL) {
+    *pStbInfo = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
+    if (*pStbInfo == NULL) {
+      return terrno;
+    }
   }
 
-  STR_TO_VARSTR(n, pMReader->me.name);
-
-  // table name
-  SColumnInfoData* pColInfoData = taosArrayGet(p->pDataBlock, 0);
-  QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
+  SSysTableStbInfo* pCached = taosHashGet(*pStbInfo, &suid, sizeof(int64_t));
+  if (pCached != NULL) {
+    *pInfo = *pCached;
+    return TSDB_CODE_SUCCESS;
+  }
 
-  code = colDataSetVal(pColInfoData, rowIndex, n, false);
-  QUERY_CHECK_CODE(code, lino, _end);
+  SMetaReader mr = {0};
+  pMetaReaderFn->initReader(&mr, pVnode, META_READER_NOLOCK, pMetaFn);
+  int32_t code = pMetaReaderFn->getTableEntryByUid(&mr, suid);
+  if (code != TSDB_CODE_SUCCESS) {
+    pMetaReaderFn->clearReader(&mr);
+    return code;
+  }
 
-  // database name
-  pColInfoData = taosArrayGet(p->pDataBlock, 1);
-  QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-  code = colDataSetVal(pColInfoData, rowIndex, dbname, false);
-  QUERY_CHECK_CODE(code, lino, _end);
+  STR_TO_VARSTR(pInfo->name, mr.me.name);
+  pInfo->numOfCols = mr.me.stbEntry.schemaRow.nCols;
+  pInfo->isTsmaRes = isTsmaResSTb(mr.me.name);
+  pMetaReaderFn->clearReader(&mr);
 
-  // vgId
-  pColInfoData = taosArrayGet(p->pDataBlock, 6);
-  QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-  code = colDataSetVal(pColInfoData, rowIndex, (char*)&vgId, false);
-  QUERY_CHECK_CODE(code, lino, _end);
+  return taosHashPut(*pStbInfo, &suid, sizeof(int64_t), pInfo, sizeof(SSysTableStbInfo));
+}
 
-  int32_t tableType = pMReader->me.type;
-  if (tableType == TSDB_CHILD_TABLE) {
-    // create time
-    int64_t ts = pMReader->me.ctbEntry.btime;
-    pColInfoData = taosArrayGet(p->pDataBlock, 2);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&ts, false);
-    QUERY_CHECK_CODE(code, lino, _end);
+// rows to build in one round, no more than required by the limit if all rows will be returned
+int32_t sysTableGetBatchRows(const SLimitInfo* pLimitInfo, bool hasFilter, int32_t capacity) {
+  if (hasFilter || pLimitInfo->limit.limit < 0) {
+    return capacity;
+  }
 
-    SMetaReader mr1 = {0};
-    pMetaReaderFn->initReader(&mr1, pVnode, META_READER_NOLOCK, pMetaFn);
+  int64_t remain = pLimitInfo->remainOffset + pLimitInfo->limit.limit - pLimitInfo->numOfOutputRows;
+  return (int32_t)TMAX(1, TMIN(capacity, remain));
+}
 
-    int64_t suid = pMReader->me.ctbEntry.suid;
-    code = pMetaReaderFn->getTableEntryByUid(&mr1, suid);
-    if (code != TSDB_CODE_SUCCESS) {
-      qError("failed to get super table meta, cname:%s, suid:0x%" PRIx64 ", code:%s, %s", pMReader->me.name, suid,
-             tstrerror(code), idStr);
-      pMetaReaderFn->clearReader(&mr1);
-      QUERY_CHECK_CODE(code, lino, _end);
+// a bit for every slot of the meta block the scan outputs, the other slots are not built
+static uint64_t sysTableGetOutputSlots(const SColMatchInfo* pMatchInfo, const SSDataBlock* p) {
+  uint64_t slots = 0;
+  int32_t  numOfCols = TMIN(taosArrayGetSize(p->pDataBlock), 64);
+  for (int32_t i = 0; i < taosArrayGetSize(pMatchInfo->pList); ++i) {
+    SColMatchItem* pItem = taosArrayGet(pMatchInfo->pList, i);
+    for (int32_t j = 0; j < numOfCols; ++j) {
+      SColumnInfoData* pCol = taosArrayGet(p->pDataBlock, j);
+      if (pItem != NULL && pCol != NULL && pCol->info.colId == pItem->colId) {
+        slots |= (1ULL << j);
+        break;
+      }
     }
+  }
+  return slots;
+}
 
-    pColInfoData = taosArrayGet(p->pDataBlock, 3);
-    if (pColInfoData == NULL) {
-      pMetaReaderFn->clearReader(&mr1);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    }
+static FORCE_INLINE bool sysTableNeedSlot(uint64_t slots, int32_t slotId) { return (slots >> slotId) & 1; }
 
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&mr1.me.stbEntry.schemaRow.nCols, false);
-    if (code != 0) {
-      pMetaReaderFn->clearReader(&mr1);
-      QUERY_CHECK_CODE(code, lino, _end);
-    }
+static int32_t sysTableSetTableComment(SColumnInfoData* pColInfoData, int32_t rowIndex, const char* pComment,
+                                       int32_t commentLen) {
+  if (commentLen > 0) {
+    char comment[TSDB_TB_COMMENT_LEN + VARSTR_HEADER_SIZE] = {0};
+    STR_TO_VARSTR(comment, pComment);
+    return colDataSetVal(pColInfoData, rowIndex, comment, false);
+  } else if (commentLen == 0) {
+    char comment[VARSTR_HEADER_SIZE + VARSTR_HEADER_SIZE] = {0};
+    STR_TO_VARSTR(comment, "");
+    return colDataSetVal(pColInfoData, rowIndex, comment, false);
+  }
+  colDataSetNULL(pColInfoData, rowIndex);
+  return TSDB_CODE_SUCCESS;
+}
 
-    // super table name
-    STR_TO_VARSTR(n, mr1.me.name);
-    pColInfoData = taosArrayGet(p->pDataBlock, 4);
-    if (pColInfoData == NULL) {
-      pMetaReaderFn->clearReader(&mr1);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
+/*
+ * Fill row rowIndex of the ins_tables block with a child or normal table entry, only the slots in slots are built. If
+ * pTsmaRes is given, it tells whether the table is a child table of a tsma result super table.
+ */
+static int32_t sysTableSetUserTableRow(SStoreMetaReader* pMetaReaderFn, SStoreMeta* pMetaFn, void* pVnode,
+                                       SHashObj** pStbInfo, SMetaEntry* pEntry, const char* dbname, int32_t vgId,
+                                       uint64_t slots, SSDataBlock* p, int32_t rowIndex, bool* pTsmaRes,
+                                       const char* idStr) {
+  char             n[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE] = {0};
+  int32_t          code = TSDB_CODE_SUCCESS;
+  int32_t          lino = 0;
+  SColumnInfoData* pColInfoData = NULL;
+  int64_t          btime = 0;
+  int32_t          numOfCols = 0;
+  const char*      stbName = NULL;
+  const char*      comment = NULL;
+  int32_t          commentLen = -1;
+  int32_t          ttlDays = 0;
+  SSysTableStbInfo stb = {0};
+
+  if (pTsmaRes != NULL) {
+    *pTsmaRes = false;
+  }
+
+  if (pEntry->type == TSDB_CHILD_TABLE) {
+    if (pTsmaRes != NULL || sysTableNeedSlot(slots, 3) || sysTableNeedSlot(slots, 4)) {
+      code = sysTableGetStbInfo(pMetaReaderFn, pMetaFn, pVnode, pStbInfo, pEntry->ctbEntry.suid, &stb);
+      if (code != TSDB_CODE_SUCCESS) {
+        qError("failed to get super table meta, cname:%s, suid:0x%" PRIx64 ", code:%s, %s", pEntry->name,
+               pEntry->ctbEntry.suid, tstrerror(code), idStr);
+        QUERY_CHECK_CODE(code, lino, _end);
+      }
+      if (pTsmaRes != NULL && stb.isTsmaRes) {
+        *pTsmaRes = true;
+        goto _end;
+      }
     }
 
-    code = colDataSetVal(pColInfoData, rowIndex, n, false);
-    pMetaReaderFn->clearReader(&mr1);
-    QUERY_CHECK_CODE(code, lino, _end);
+    btime = pEntry->ctbEntry.btime;
+    numOfCols = stb.numOfCols;
+    stbName = stb.name;
+    comment = pEntry->ctbEntry.comment;
+    commentLen = pEntry->ctbEntry.commentLen;
+    ttlDays = pEntry->ctbEntry.ttlDays;
+    STR_TO_VARSTR(n, "CHILD_TABLE");
+  } else if (pEntry->type == TSDB_NORMAL_TABLE) {
+    btime = pEntry->ntbEntry.btime;
+    numOfCols = pEntry->ntbEntry.schemaRow.nCols;
+    comment = pEntry->ntbEntry.comment;
+    commentLen = pEntry->ntbEntry.commentLen;
+    ttlDays = pEntry->ntbEntry.ttlDays;
+    STR_TO_VARSTR(n, "NORMAL_TABLE");
+  }
 
-    // table comment
-    pColInfoData = taosArrayGet(p->pDataBlock, 8);
+  // table name
+  if (sysTableNeedSlot(slots, 0)) {
+    char name[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE] = {0};
+    STR_TO_VARSTR(name, pEntry->name);
+    pColInfoData = taosArrayGet(p->pDataBlock, 0);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    if (pMReader->me.ctbEntry.commentLen > 0) {
-      char comment[TSDB_TB_COMMENT_LEN + VARSTR_HEADER_SIZE] = {0};
-      STR_TO_VARSTR(comment, pMReader->me.ctbEntry.comment);
-      code = colDataSetVal(pColInfoData, rowIndex, comment, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-    } else if (pMReader->me.ctbEntry.commentLen == 0) {
-      char comment[VARSTR_HEADER_SIZE + VARSTR_HEADER_SIZE] = {0};
-      STR_TO_VARSTR(comment, "");
-      code = colDataSetVal(pColInfoData, rowIndex, comment, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-    } else {
-      colDataSetNULL(pColInfoData, rowIndex);
-    }
+    code = colDataSetVal(pColInfoData, rowIndex, name, false);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    // uid
-    pColInfoData = taosArrayGet(p->pDataBlock, 5);
+  // database name
+  if (sysTableNeedSlot(slots, 1)) {
+    pColInfoData = taosArrayGet(p->pDataBlock, 1);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pMReader->me.uid, false);
+    code = colDataSetVal(pColInfoData, rowIndex, dbname, false);
     QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    // ttl
-    pColInfoData = taosArrayGet(p->pDataBlock, 7);
+  // vgId
+  if (sysTableNeedSlot(slots, 6)) {
+    pColInfoData = taosArrayGet(p->pDataBlock, 6);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pMReader->me.ctbEntry.ttlDays, false);
+    code = colDataSetVal(pColInfoData, rowIndex, (char*)&vgId, false);
     QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    STR_TO_VARSTR(n, "CHILD_TABLE");
+  if (pEntry->type != TSDB_CHILD_TABLE && pEntry->type != TSDB_NORMAL_TABLE) {
+    goto _end;
+  }
 
-  } else if (tableType == TSDB_NORMAL_TABLE) {
-    // create time
+  // create time
+  if (sysTableNeedSlot(slots, 2)) {
     pColInfoData = taosArrayGet(p->pDataBlock, 2);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pMReader->me.ntbEntry.btime, false);
+    code = colDataSetVal(pColInfoData, rowIndex, (char*)&btime, false);
     QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    // number of columns
+  // number of columns
+  if (sysTableNeedSlot(slots, 3)) {
     pColInfoData = taosArrayGet(p->pDataBlock, 3);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pMReader->me.ntbEntry.schemaRow.nCols, false);
+    code = colDataSetVal(pColInfoData, rowIndex, (char*)&numOfCols, false);
     QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    // super table name
+  // super table name
+  if (sysTableNeedSlot(slots, 4)) {
     pColInfoData = taosArrayGet(p->pDataBlock, 4);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    colDataSetNULL(pColInfoData, rowIndex);
-
-    // table comment
-    pColInfoData = taosArrayGet(p->pDataBlock, 8);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    if (pMReader->me.ntbEntry.commentLen > 0) {
-      char comment[TSDB_TB_COMMENT_LEN + VARSTR_HEADER_SIZE] = {0};
-      STR_TO_VARSTR(comment, pMReader->me.ntbEntry.comment);
-      code = colDataSetVal(pColInfoData, rowIndex, comment, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-    } else if (pMReader->me.ntbEntry.commentLen == 0) {
-      char comment[VARSTR_HEADER_SIZE + VARSTR_HEADER_SIZE] = {0};
-      STR_TO_VARSTR(comment, "");
-      code = colDataSetVal(pColInfoData, rowIndex, comment, false);
+    if (stbName != NULL) {
+      code = colDataSetVal(pColInfoData, rowIndex, stbName, false);
       QUERY_CHECK_CODE(code, lino, _end);
     } else {
       colDataSetNULL(pColInfoData, rowIndex);
     }
+  }
 
-    // uid
+  // uid
+  if (sysTableNeedSlot(slots, 5)) {
     pColInfoData = taosArrayGet(p->pDataBlock, 5);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pMReader->me.uid, false);
+    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pEntry->uid, false);
     QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    // ttl
+  // ttl
+  if (sysTableNeedSlot(slots, 7)) {
     pColInfoData = taosArrayGet(p->pDataBlock, 7);
     QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, rowIndex, (char*)&pMReader->me.ntbEntry.ttlDays, false);
+    code = colDataSetVal(pColInfoData, rowIndex, (char*)&ttlDays, false);
     QUERY_CHECK_CODE(code, lino, _end);
+  }
 
-    STR_TO_VARSTR(n, "NORMAL_TABLE");
-    // impl later
+  // table comment
+  if (sysTableNeedSlot(slots, 8)) {
+    pColInfoData = taosArrayGet(p->pDataBlock, 8);
+    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
+    code = sysTableSetTableComment(pColInfoData, rowIndex, comment, commentLen);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  // table type
+  if (sysTableNeedSlot(slots, 9)) {
+    pColInfoData = taosArrayGet(p->pDataBlock, 9);
+    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
+    code = colDataSetVal(pColInfoData, rowIndex, n, false);
+    QUERY_CHECK_CODE(code, lino, _end);
   }
 
 _end:
-  qError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), idStr);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s, %s", __func__, lino, tstrerror(code), idStr);
+  }
   return code;
 }
 
+static int32_t doSetUserTableMetaInfo(SStoreMetaReader* pMetaReaderFn, SStoreMeta* pMetaFn, void* pVnode,
+                                      SHashObj** pStbInfo, SMetaReader* pMReader, int64_t uid, const char* dbname,
+                                      int32_t vgId, uint64_t slots, SSDataBlock* p, int32_t rowIndex,
+                                      const char* idStr) {
+  int32_t code = pMetaReaderFn->getTableEntryByUid(pMReader, uid);
+  if (code < 0) {
+    qError("failed to get table meta, uid:%" PRId64 ", code:%s, %s", uid, tstrerror(terrno), idStr);
+    return code;
+  }
+
+  return sysTableSetUserTableRow(pMetaReaderFn, pMetaFn, pVnode, pStbInfo, &pMReader->me, dbname, vgId, slots, p,
+                                 rowIndex, NULL, idStr);
+}
+
 static SSDataBlock* sysTableBuildUserTablesByUids(SOperatorInfo* pOperator) {
   int32_t            code = TSDB_CODE_SUCCESS;
   int32_t            lino = 0;
@@ -1578,30 +1676,26 @@ static SSDataBlock* sysTableBuildUserTablesByUids(SOperatorInfo* pOperator) {
   p = buildInfoSchemaTableMetaBlock(TSDB_INS_TABLE_TABLES);
   QUERY_CHECK_NULL(p, code, lino, _end, terrno);
 
-  code = blockDataEnsureCapacity(p, pOperator->resultInfo.capacity);
+  int32_t batchRows = sysTableGetBatchRows(&pInfo->limitInfo, pOperator->exprSupp.pFilterInfo != NULL,
+                                           pOperator->resultInfo.capacity);
+  code = blockDataEnsureCapacity(p, batchRows);
   QUERY_CHECK_CODE(code, lino, _end);
 
-  char    n[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE] = {0};
-  int32_t i = pIdx->lastIdx;
+  uint64_t slots = sysTableGetOutputSlots(&pInfo->matchInfo, p);
+  int32_t  i = pIdx->lastIdx;
   for (; i < taosArrayGetSize(pIdx->uids); i++) {
     tb_uid_t* uid = taosArrayGet(pIdx->uids, i);
     QUERY_CHECK_NULL(uid, code, lino, _end, terrno);
 
     SMetaReader mr = {0};
     pAPI->metaReaderFn.initReader(&mr, pInfo->readHandle.vnode, META_READER_LOCK, &pAPI->metaFn);
-    code = doSetUserTableMetaInfo(&pAPI->metaReaderFn, &pAPI->metaFn, pInfo->readHandle.vnode, &mr, *uid, dbname, vgId,
-                                  p, numOfRows, GET_TASKID(pTaskInfo));
+    code = doSetUserTableMetaInfo(&pAPI->metaReaderFn, &pAPI->metaFn, pInfo->readHandle.vnode, &pInfo->pStbInfo, &mr,
+                                  *uid, dbname, vgId, slots, p, numOfRows, GET_TASKID(pTaskInfo));
 
     pAPI->metaReaderFn.clearReader(&mr);
     QUERY_CHECK_CODE(code, lino, _end);
 
-    SColumnInfoData* pColInfoData = taosArrayGet(p->pDataBlock, 9);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-
-    code = colDataSetVal(pColInfoData, numOfRows, n, false);
-    QUERY_CHECK_CODE(code, lino, _end);
-
-    if (++numOfRows >= pOperator->resultInfo.capacity) {
+    if (++numOfRows >= batchRows) {
       p->info.rows = numOfRows;
       pInfo->pRes->info.rows = numOfRows;
 
@@ -1698,162 +1792,25 @@ static SSDataBlock* sysTableBuildUserTables(SOperatorInfo* pOperator) {
   p = buildInfoSchemaTableMetaBlock(TSDB_INS_TABLE_TABLES);
   QUERY_CHECK_NULL(p, code, lino, _end, terrno);
 
-  code = blockDataEnsureCapacity(p, pOperator->resultInfo.capacity);
+  int32_t batchRows = sysTableGetBatchRows(&pInfo->limitInfo, pOperator->exprSupp.pFilterInfo != NULL,
+                                           pOperator->resultInfo.capacity);
+  code = blockDataEnsureCapacity(p, batchRows);
   QUERY_CHECK_CODE(code, lino, _end);
 
-  char n[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE] = {0};
+  uint64_t slots = sysTableGetOutputSlots(&pInfo->matchInfo, p);
 
   int32_t ret = 0;
   while ((ret = pAPI->metaFn.cursorNext(pInfo->pCur, TSDB_SUPER_TABLE)) == 0) {
-    STR_TO_VARSTR(n, pInfo->pCur->mr.me.name);
-
-    // table name
-    SColumnInfoData* pColInfoData = taosArrayGet(p->pDataBlock, 0);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, numOfRows, n, false);
-    QUERY_CHECK_CODE(code, lino, _end);
-
-    // database name
-    pColInfoData = taosArrayGet(p->pDataBlock, 1);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, numOfRows, dbname, false);
-    QUERY_CHECK_CODE(code, lino, _end);
-
-    // vgId
-    pColInfoData = taosArrayGet(p->pDataBlock, 6);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, numOfRows, (char*)&vgId, false);
+    bool tsmaRes = false;
+    code = sysTableSetUserTableRow(&pAPI->metaReaderFn, &pAPI->metaFn, pInfo->readHandle.vnode, &pInfo->pStbInfo,
+                                   &pInfo->pCur->mr.me, dbname, vgId, slots, p, numOfRows, &tsmaRes,
+                                   GET_TASKID(pTaskInfo));
     QUERY_CHECK_CODE(code, lino, _end);
-
-    int32_t tableType = pInfo->pCur->mr.me.type;
-    if (tableType == TSDB_CHILD_TABLE) {
-      // create time
-      int64_t ts = pInfo->pCur->mr.me.ctbEntry.btime;
-      pColInfoData = taosArrayGet(p->pDataBlock, 2);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&ts, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      SMetaReader mr = {0};
-      pAPI->metaReaderFn.initReader(&mr, pInfo->readHandle.vnode, META_READER_NOLOCK, &pAPI->metaFn);
-
-      uint64_t suid = pInfo->pCur->mr.me.ctbEntry.suid;
-      code = pAPI->metaReaderFn.getTableEntryByUid(&mr, suid);
-      if (code != TSDB_CODE_SUCCESS) {
-        qError("failed to get super table meta, cname:%s, suid:0x%" PRIx64 ", code:%s, %s", pInfo->pCur->mr.me.name,
-               suid, tstrerror(terrno), GET_TASKID(pTaskInfo));
-        pAPI->metaReaderFn.clearReader(&mr);
-        pAPI->metaFn.closeTableMetaCursor(pInfo->pCur);
-        pInfo->pCur = NULL;
-        blockDataDestroy(p);
-        T_LONG_JMP(pTaskInfo->env, terrno);
-      }
-
-      if (isTsmaResSTb(mr.me.name)) {
-        pAPI->metaReaderFn.clearReader(&mr);
-        continue;
-      }
-
-      // number of columns
-      pColInfoData = taosArrayGet(p->pDataBlock, 3);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&mr.me.stbEntry.schemaRow.nCols, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      // super table name
-      STR_TO_VARSTR(n, mr.me.name);
-      pColInfoData = taosArrayGet(p->pDataBlock, 4);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, n, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-      pAPI->metaReaderFn.clearReader(&mr);
-
-      // table comment
-      pColInfoData = taosArrayGet(p->pDataBlock, 8);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      if (pInfo->pCur->mr.me.ctbEntry.commentLen > 0) {
-        char comment[TSDB_TB_COMMENT_LEN + VARSTR_HEADER_SIZE] = {0};
-        STR_TO_VARSTR(comment, pInfo->pCur->mr.me.ctbEntry.comment);
-        code = colDataSetVal(pColInfoData, numOfRows, comment, false);
-        QUERY_CHECK_CODE(code, lino, _end);
-      } else if (pInfo->pCur->mr.me.ctbEntry.commentLen == 0) {
-        char comment[VARSTR_HEADER_SIZE + VARSTR_HEADER_SIZE] = {0};
-        STR_TO_VARSTR(comment, "");
-        code = colDataSetVal(pColInfoData, numOfRows, comment, false);
-        QUERY_CHECK_CODE(code, lino, _end);
-      } else {
-        colDataSetNULL(pColInfoData, numOfRows);
-      }
-
-      // uid
-      pColInfoData = taosArrayGet(p->pDataBlock, 5);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&pInfo->pCur->mr.me.uid, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      // ttl
-      pColInfoData = taosArrayGet(p->pDataBlock, 7);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&pInfo->pCur->mr.me.ctbEntry.ttlDays, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      STR_TO_VARSTR(n, "CHILD_TABLE");
-    } else if (tableType == TSDB_NORMAL_TABLE) {
-      // create time
-      pColInfoData = taosArrayGet(p->pDataBlock, 2);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&pInfo->pCur->mr.me.ntbEntry.btime, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      // number of columns
-      pColInfoData = taosArrayGet(p->pDataBlock, 3);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&pInfo->pCur->mr.me.ntbEntry.schemaRow.nCols, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      // super table name
-      pColInfoData = taosArrayGet(p->pDataBlock, 4);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      colDataSetNULL(pColInfoData, numOfRows);
-
-      // table comment
-      pColInfoData = taosArrayGet(p->pDataBlock, 8);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      if (pInfo->pCur->mr.me.ntbEntry.commentLen > 0) {
-        char comment[TSDB_TB_COMMENT_LEN + VARSTR_HEADER_SIZE] = {0};
-        STR_TO_VARSTR(comment, pInfo->pCur->mr.me.ntbEntry.comment);
-        code = colDataSetVal(pColInfoData, numOfRows, comment, false);
-        QUERY_CHECK_CODE(code, lino, _end);
-      } else if (pInfo->pCur->mr.me.ntbEntry.commentLen == 0) {
-        char comment[VARSTR_HEADER_SIZE + VARSTR_HEADER_SIZE] = {0};
-        STR_TO_VARSTR(comment, "");
-        code = colDataSetVal(pColInfoData, numOfRows, comment, false);
-        QUERY_CHECK_CODE(code, lino, _end);
-      } else {
-        colDataSetNULL(pColInfoData, numOfRows);
-      }
-
-      // uid
-      pColInfoData = taosArrayGet(p->pDataBlock, 5);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&pInfo->pCur->mr.me.uid, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      // ttl
-      pColInfoData = taosArrayGet(p->pDataBlock, 7);
-      QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-      code = colDataSetVal(pColInfoData, numOfRows, (char*)&pInfo->pCur->mr.me.ntbEntry.ttlDays, false);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      STR_TO_VARSTR(n, "NORMAL_TABLE");
+    if (tsmaRes) {
+      continue;
     }
 
-    pColInfoData = taosArrayGet(p->pDataBlock, 9);
-    QUERY_CHECK_NULL(pColInfoData, code, lino, _end, terrno);
-    code = colDataSetVal(pColInfoData, numOfRows, n, false);
-    QUERY_CHECK_CODE(code, lino, _end);
-
-    if (++numOfRows >= pOperator->resultInfo.capacity) {
+    if (++numOfRows >= batchRows) {
       p->info.rows = numOfRows;
       pInfo->pRes->info.rows = numOfRows;
 
@@ -2383,6 +2340,11 @@ void destroySysScanOperator(void* param) {
     pInfo->pSchema = NULL;
   }
 
+  if (pInfo->pStbInfo) {
+    taosHashCleanup(pInfo->pStbInfo);
+    pInfo->pStbInfo = NULL;
+  }
+
   taosArrayDestroy(pInfo->matchInfo.pList);
   taosMemoryFreeClear(pInfo->pUser);
 
@@ -2489,7 +2451,8 @@ static int32_t sysChkFilter__Ttl(SNode* pNode) {
 static int32_t sysChkFilter__STableName(SNode* pNode) {
   SOperatorNode* pOper = (SOperatorNode*)pNode;
   SValueNode*    pVal = (SValueNode*)pOper->pRight;
-  if (!IS_STR_DATA_TYPE(pVal->node.resType.type)) {
+  // the name is looked up by its bytes, the UCS-4 bytes of a nchar value are not the name
+  if (pVal->node.resType.type != TSDB_DATA_TYPE_VARCHAR) {
     return -1;
   }
   return sysChkFilter__Comm(pNode);
@@ -2634,17 +2597,18 @@ static int32_t optSysSpecialColumn(SNode* cond) {
   return 0;
 }
 
-static int32_t optSysTabFilte(void* arg, SNode* cond, SArray* result) {
+// the uid list of these columns is complete, so the tables can be built by the uids
+static bool optSysIsUidListColumn(SNode* cond) {
+  SColumnNode* pCol = (SColumnNode*)((SOperatorNode*)cond)->pLeft;
+  return (0 == strcmp(pCol->colName, "create_time")) || (0 == strcmp(pCol->colName, "stable_name"));
+}
+
+int32_t optSysTabFilte(void* arg, SNode* cond, SArray* result) {
   int ret = TSDB_CODE_FAILED;
   if (nodeType(cond) == QUERY_NODE_OPERATOR) {
     ret = optSysTabFilteImpl(arg, cond, result);
     if (ret == 0) {
-      SOperatorNode* pOper = (SOperatorNode*)cond;
-      SColumnNode*   pCol = (SColumnNode*)pOper->pLeft;
-      if (0 == strcmp(pCol->colName, "create_time")) {
-        return 0;
-      }
-      return -1;
+      return optSysIsUidListColumn(cond) ? 0 : -1;
     }
     return ret;
   }
@@ -2705,7 +2669,8 @@ static int32_t optSysTabFilte(void* arg, SNode* cond, SArray* result) {
     }
   }
 
-  for (int i = 0; i < taosArrayGetSize(mRslt); i++) {
+  int32_t numOfRslt = taosArrayGetSize(mRslt);
+  for (int i = 0; i < numOfRslt; i++) {
     SArray* aRslt = taosArrayGetP(mRslt, i);
     taosArrayDestroy(aRslt);
   }
@@ -2713,13 +2678,11 @@ static int32_t optSysTabFilte(void* arg, SNode* cond, SArray* result) {
   if (hasRslt == false) {
     return -2;
   }
-  if (hasRslt && hasIdx) {
+  if (hasRslt && hasIdx && numOfRslt > 0) {
     cell = pList->pHead;
     for (int i = 0; i < len; i++) {
       if (cell == NULL) break;
-      SOperatorNode* pOper = (SOperatorNode*)cell->pNode;
-      SColumnNode*   pCol = (SColumnNode*)pOper->pLeft;
-      if (0 == strcmp(pCol->colName, "create_time")) {
+      if (nodeType(cell->pNode) == QUERY_NODE_OPERATOR && optSysIsUidListColumn(cell->pNode)) {
         return 0;
       }
       cell = cell->pNext;
@@ -79,41 +79,55 @@ static void setNullRow(SSDataBlock* pBlock, SFillInfo* pFillInfo, int32_t rowInd
   }
 }
 
-static int32_t doSetUserSpecifiedValue(SColumnInfoData* pDst, SVariant* pVar, int32_t rowIndex, int64_t currentKey) {
+static int32_t setNItems(SColumnInfoData* pDst, int32_t rowIndex, const char* pData, bool isNull,
+                         int32_t numOfRows) {
+  if (numOfRows == 1) {
+    return colDataSetVal(pDst, rowIndex, pData, isNull);
+  }
+
+  if (isNull) {
+    colDataSetNNULL(pDst, rowIndex, numOfRows);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return colDataSetNItems(pDst, rowIndex, pData, numOfRows, false);
+}
+
+static int32_t doSetUserSpecifiedValue(SColumnInfoData* pDst, SVariant* pVar, int32_t rowIndex, int32_t numOfRows) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
   bool    isNull = (TSDB_DATA_TYPE_NULL == pVar->nType) ? true : false;
   if (pDst->info.type == TSDB_DATA_TYPE_FLOAT) {
     float v = 0;
     GET_TYPED_DATA(v, float, pVar->nType, &pVar->f);
-    code = colDataSetVal(pDst, rowIndex, (char*)&v, isNull);
+    code = setNItems(pDst, rowIndex, (char*)&v, isNull, numOfRows);
     QUERY_CHECK_CODE(code, lino, _end);
   } else if (pDst->info.type == TSDB_DATA_TYPE_DOUBLE) {
     double v = 0;
     GET_TYPED_DATA(v, double, pVar->nType, &pVar->d);
-    code = colDataSetVal(pDst, rowIndex, (char*)&v, isNull);
+    code = setNItems(pDst, rowIndex, (char*)&v, isNull, numOfRows);
     QUERY_CHECK_CODE(code, lino, _end);
   } else if (IS_SIGNED_NUMERIC_TYPE(pDst->info.type) || pDst->info.type == TSDB_DATA_TYPE_BOOL) {
     int64_t v = 0;
     GET_TYPED_DATA(v, int64_t, pVar->nType, &pVar->i);
-    code = colDataSetVal(pDst, rowIndex, (char*)&v, isNull);
+    code = setNItems(pDst, rowIndex, (char*)&v, isNull, numOfRows);
     QUERY_CHECK_CODE(code, lino, _end);
   } else if (IS_UNSIGNED_NUMERIC_TYPE(pDst->info.type)) {
     uint64_t v = 0;
     GET_TYPED_DATA(v, uint64_t, pVar->nType, &pVar->u);
-    code = colDataSetVal(pDst, rowIndex, (char*)&v, isNull);
+    code = setNItems(pDst, rowIndex, (char*)&v, isNull, numOfRows);
     QUERY_CHECK_CODE(code, lino, _end);
   } else if (pDst->info.type == TSDB_DATA_TYPE_TIMESTAMP) {
     int64_t v = 0;
     GET_TYPED_DATA(v, int64_t, pVar->nType, &pVar->u);
-    code = colDataSetVal(pDst, rowIndex, (const char*)&v, isNull);
+    code = setNItems(pDst, rowIndex, (const char*)&v, isNull, numOfRows);
     QUERY_CHECK_CODE(code, lino, _end);
   } else if (pDst->info.type == TSDB_DATA_TYPE_NCHAR || pDst->info.type == TSDB_DATA_TYPE_VARCHAR ||
              pDst->info.type == TSDB_DATA_TYPE_VARBINARY) {
-    code = colDataSetVal(pDst, rowIndex, pVar->pz, isNull);
+    code = setNItems(pDst, rowIndex, pVar->pz, isNull, numOfRows);
     QUERY_CHECK_CODE(code, lino, _end);
   } else {  // others data
-    colDataSetNULL(pDst, rowIndex);
+    colDataSetNNULL(pDst, rowIndex, numOfRows);
   }
 
 _end:
@@ -255,7 +269,7 @@ static void doFillOneRow(SFillInfo* pFillInfo, SSDataBlock* pBlock, SSDataBlock*
         }
       } else {
         SVariant* pVar = &pFillInfo->pFillCol[i].fillVal;
-        code = doSetUserSpecifiedValue(pDst, pVar, index, pFillInfo->currentKey);
+        code = doSetUserSpecifiedValue(pDst, pVar, index, 1);
         QUERY_CHECK_CODE(code, lino, _end);
       }
     }
@@ -275,6 +289,142 @@ _end:
   }
 }
 
+static bool fillCanGenMultiRows(const SFillInfo* pFillInfo) {
+  const SInterval* pInterval = &pFillInfo->interval;
+  return pInterval->sliding > 0 && !IS_CALENDAR_TIME_DURATION(pInterval->slidingUnit) &&
+         !IS_CALENDAR_TIME_DURATION(pInterval->intervalUnit);
+}
+
+// number of the missing windows from currentKey up to, but not including, ts
+static int32_t getNumOfRowsInGap(const SFillInfo* pFillInfo, int64_t ts, int32_t maxRows) {
+  int64_t sliding = pFillInfo->interval.sliding;
+  int64_t gap = FILL_IS_ASC_FILL(pFillInfo) ? (ts - pFillInfo->currentKey) : (pFillInfo->currentKey - ts);
+  if (gap <= 0) {
+    return 0;
+  }
+
+  return (int32_t)TMIN((gap + sliding - 1) / sliding, maxRows);
+}
+
+// the column based version of fillIfWindowPseudoColumn
+static bool fillWindowPseudoColumnNRows(SFillInfo* pFillInfo, SFillColInfo* pCol, SColumnInfoData* pDst,
+                                        int32_t rowIndex, int32_t numOfRows) {
+  if (!pCol->notFillCol || pCol->pExpr->pExpr->nodeType != QUERY_NODE_COLUMN || pCol->pExpr->base.numOfParams != 1) {
+    return false;
+  }
+
+  SInterval* pInterval = &pFillInfo->interval;
+  int64_t    step = pInterval->sliding * GET_FORWARD_DIRECTION_FACTOR(pFillInfo->order);
+  int64_t*   pKey = (int64_t*)pDst->pData + rowIndex;
+  int16_t    colType = pCol->pExpr->base.pParam[0].pCol->colType;
+
+  if (colType == COLUMN_TYPE_WINDOW_START || colType == COLUMN_TYPE_WINDOW_END) {
+    int64_t key = pFillInfo->currentKey;
+    if (colType == COLUMN_TYPE_WINDOW_END) {
+      key = taosTimeAdd(key, pInterval->interval, pInterval->intervalUnit, pInterval->precision);
+    }
+
+    for (int32_t k = 0; k < numOfRows; ++k) {
+      pKey[k] = key + k * step;
+    }
+    return true;
+  } else if (colType == COLUMN_TYPE_WINDOW_DURATION) {
+    for (int32_t k = 0; k < numOfRows; ++k) {
+      pKey[k] = pInterval->sliding;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+static int32_t setNotFillColumnNRows(SFillInfo* pFillInfo, SColumnInfoData* pDst, int32_t rowIndex, int32_t colIdx,
+                                     int32_t numOfRows) {
+  SFillColInfo* pCol = &pFillInfo->pFillCol[colIdx];
+  if (pCol->fillNull) {
+    colDataSetNNULL(pDst, rowIndex, numOfRows);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SRowVal* p = NULL;
+  if (pFillInfo->type == TSDB_FILL_NEXT) {
+    p = FILL_IS_ASC_FILL(pFillInfo) ? &pFillInfo->next : &pFillInfo->prev;
+  } else {
+    p = FILL_IS_ASC_FILL(pFillInfo) ? &pFillInfo->prev : &pFillInfo->next;
+  }
+
+  SGroupKeys* pKey = taosArrayGet(p->pRowVal, colIdx);
+  if (!pKey) {
+    return terrno;
+  }
+
+  return setNItems(pDst, rowIndex, pKey->pData, pKey->isNull, numOfRows);
+}
+
+/*
+ * Generate numOfRows consecutive filled rows column by column. The value of a filled column is the same in all these
+ * rows, except the window pseudo columns and the linear interpolation, which step by a fixed sliding. Only used when
+ * the sliding is not a calendar duration, see fillCanGenMultiRows.
+ */
+static void doFillNRows(SFillInfo* pFillInfo, SSDataBlock* pBlock, SSDataBlock* pSrcBlock, int64_t ts, bool outOfBound,
+                        int32_t numOfRows) {
+  int32_t    code = TSDB_CODE_SUCCESS;
+  int32_t    lino = 0;
+  int32_t    index = pBlock->info.rows;
+  SInterval* pInterval = &pFillInfo->interval;
+  int64_t    step = pInterval->sliding * GET_FORWARD_DIRECTION_FACTOR(pFillInfo->order);
+
+  for (int32_t i = 0; i < pFillInfo->numOfCols; ++i) {
+    SFillColInfo*    pCol = &pFillInfo->pFillCol[i];
+    SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, GET_DEST_SLOT_ID(pCol));
+    QUERY_CHECK_NULL(pDst, code, lino, _end, terrno);
+
+    if (pFillInfo->type == TSDB_FILL_PREV || pFillInfo->type == TSDB_FILL_NEXT || pCol->notFillCol) {
+      if (!fillWindowPseudoColumnNRows(pFillInfo, pCol, pDst, index, numOfRows)) {
+        code = setNotFillColumnNRows(pFillInfo, pDst, index, i, numOfRows);
+        QUERY_CHECK_CODE(code, lino, _end);
+      }
+    } else if (pFillInfo->type == TSDB_FILL_NULL || pFillInfo->type == TSDB_FILL_NULL_F ||
+               (pFillInfo->type == TSDB_FILL_LINEAR && outOfBound)) {
+      colDataSetNNULL(pDst, index, numOfRows);
+    } else if (pFillInfo->type == TSDB_FILL_LINEAR) {
+      int16_t     type = pDst->info.type;
+      SGroupKeys* pKey = taosArrayGet(pFillInfo->prev.pRowVal, i);
+      QUERY_CHECK_NULL(pKey, code, lino, _end, terrno);
+      if (IS_VAR_DATA_TYPE(type) || type == TSDB_DATA_TYPE_BOOL || pKey->isNull) {
+        colDataSetNNULL(pDst, index, numOfRows);
+        continue;
+      }
+
+      SGroupKeys*      pKey1 = taosArrayGet(pFillInfo->prev.pRowVal, pFillInfo->tsSlotId);
+      SColumnInfoData* pSrcCol = taosArrayGet(pSrcBlock->pDataBlock, GET_DEST_SLOT_ID(pCol));
+      QUERY_CHECK_NULL(pKey1, code, lino, _end, terrno);
+      QUERY_CHECK_NULL(pSrcCol, code, lino, _end, terrno);
+
+      SPoint point1 = {.key = *(int64_t*)pKey1->pData, .val = pKey->pData};
+      SPoint point2 = {.key = ts, .val = colDataGetData(pSrcCol, pFillInfo->index)};
+      char*  pOut = pDst->pData + (int64_t)index * pDst->info.bytes;
+      for (int32_t k = 0; k < numOfRows; ++k, pOut += pDst->info.bytes) {
+        SPoint point = {.key = pFillInfo->currentKey + k * step, .val = pOut};
+        taosGetLinearInterpolationVal(&point, type, &point1, &point2, type);
+      }
+    } else {
+      code = doSetUserSpecifiedValue(pDst, &pCol->fillVal, index, numOfRows);
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+  }
+
+  pFillInfo->currentKey += step * numOfRows;
+  pBlock->info.rows += numOfRows;
+  pFillInfo->numOfCurrent += numOfRows;
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+    T_LONG_JMP(pFillInfo->pTaskInfo->env, code);
+  }
+}
+
 int32_t doSetVal(SColumnInfoData* pDstCol, int32_t rowIndex, const SGroupKeys* pKey) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
@@ -396,6 +546,13 @@ static int32_t fillResultImpl(SFillInfo* pFillInfo, SSDataBlock* pBlock, int32_t
     if (((pFillInfo->currentKey < ts && ascFill) || (pFillInfo->currentKey > ts && !ascFill)) &&
         pFillInfo->numOfCurrent < outputRows) {
       // fill the gap between two input rows
+      if (pFillInfo->fillNRows) {
+        int32_t numOfRows = getNumOfRowsInGap(pFillInfo, ts, outputRows - pFillInfo->numOfCurrent);
+        if (numOfRows > 1) {
+          doFillNRows(pFillInfo, pBlock, pFillInfo->pSrcBlock, ts, false, numOfRows);
+        }
+      }
+
       while (((pFillInfo->currentKey < ts && ascFill) || (pFillInfo->currentKey > ts && !ascFill)) &&
              pFillInfo->numOfCurrent < outputRows) {
         doFillOneRow(pFillInfo, pBlock, pFillInfo->pSrcBlock, ts, false);
@@ -474,7 +631,7 @@ static int32_t fillResultImpl(SFillInfo* pFillInfo, SSDataBlock* pBlock, int32_t
               QUERY_CHECK_CODE(code, lino, _end);
             } else {
               SVariant* pVar = &pFillInfo->pFillCol[i].fillVal;
-              code = doSetUserSpecifiedValue(pDst, pVar, index, pFillInfo->currentKey);
+              code = doSetUserSpecifiedValue(pDst, pVar, index, 1);
               QUERY_CHECK_CODE(code, lino, _end);
             }
           }
@@ -526,6 +683,10 @@ static int32_t appendFilledResult(SFillInfo* pFillInfo, SSDataBlock* pBlock, int
    * real result set. Note that we need to keep the direct previous result rows, to generated the filled data.
    */
   pFillInfo->numOfCurrent = 0;
+  if (pFillInfo->fillNRows && resultCapacity > 1) {
+    doFillNRows(pFillInfo, pBlock, pFillInfo->pSrcBlock, pFillInfo->start, true, (int32_t)resultCapacity);
+  }
+
   while (pFillInfo->numOfCurrent < resultCapacity) {
     doFillOneRow(pFillInfo, pBlock, pFillInfo->pSrcBlock, pFillInfo->start, true);
   }
@@ -584,6 +745,7 @@ int32_t taosCreateFillInfo(TSKEY skey, int32_t numOfFillCols, int32_t numOfNotFi
   pFillInfo->alloc = capacity;
   pFillInfo->id = id;
   pFillInfo->interval = *pInterval;
+  pFillInfo->fillNRows = fillCanGenMultiRows(pFillInfo);
 
   pFillInfo->next.pRowVal = taosArrayInit(pFillInfo->numOfCols, sizeof(SGroupKeys));
   QUERY_CHECK_NULL(pFillInfo->next.pRowVal, code, lino, _end, terrno);
@@ -25,31 +25,6 @@
 #include "tfill.h"
 #include "ttime.h"
 
-typedef struct STimeSliceOperatorInfo {
-  SSDataBlock*         pRes;
-  STimeWindow          win;
-  SInterval            interval;
-  int64_t              current;
-  SArray*              pPrevRow;     // SArray<SGroupValue>
-  SArray*              pNextRow;     // SArray<SGroupValue>
-  SArray*              pLinearInfo;  // SArray<SFillLinearInfo>
-  bool                 isPrevRowSet;
-  bool                 isNextRowSet;
-  int32_t              fillType;      // fill type
-  SColumn              tsCol;         // primary timestamp column
-  SExprSupp            scalarSup;     // scalar calculation
-  struct SFillColInfo* pFillColInfo;  // fill column info
-  SRowKey              prevKey;
-  bool                 prevTsSet;
-  uint64_t             groupId;
-  SArray*              pPrevGroupKeys;
-  SSDataBlock*         pNextGroupRes;
-  SSDataBlock*         pRemainRes;   // save block unfinished processing
-  int32_t              remainIndex;  // the remaining index in the block to be processed
-  bool                 hasPk;
-  SColumn              pkCol;
-} STimeSliceOperatorInfo;
-
 static void destroyTimeSliceOperatorInfo(void* param);
 
 static void doKeepPrevRows(STimeSliceOperatorInfo* pSliceInfo, const SSDataBlock* pBlock, int32_t rowIndex) {
@@ -153,14 +128,22 @@ static void doKeepLinearInfo(STimeSliceOperatorInfo* pSliceInfo, const SSDataBlo
   }
 }
 
-static FORCE_INLINE int32_t timeSliceEnsureBlockCapacity(STimeSliceOperatorInfo* pSliceInfo, SSDataBlock* pBlock) {
-  if (pBlock->info.rows < pBlock->info.capacity) {
+static FORCE_INLINE int32_t timeSliceEnsureBlockCapacity(STimeSliceOperatorInfo* pSliceInfo, SSDataBlock* pBlock,
+                                                         int32_t numOfRows) {
+  int64_t required = (int64_t)pBlock->info.rows + numOfRows;
+  if (required <= pBlock->info.capacity) {
     return TSDB_CODE_SUCCESS;
   }
 
   uint32_t winNum = (pSliceInfo->win.ekey - pSliceInfo->win.skey) / pSliceInfo->interval.interval;
-  uint32_t newRowsNum = pBlock->info.rows + TMIN(winNum / 4 + 1, 1048576);
-  int32_t  code = blockDataEnsureCapacity(pBlock, newRowsNum);
+  int64_t  newRowsNum = pBlock->info.rows + TMIN(winNum / 4 + 1, 1048576);
+  if (newRowsNum < required) {
+    // a gap filled at once may be longer than one step, double the capacity so that long gaps do not copy the block
+    // each time
+    newRowsNum = TMIN(TMAX(required, (int64_t)pBlock->info.capacity * 2), INT32_MAX);
+  }
+
+  int32_t code = blockDataEnsureCapacity(pBlock, newRowsNum);
   if (code != TSDB_CODE_SUCCESS) {
     qError("%s failed at line %d since %s", __func__, __LINE__, tstrerror(code));
     return code;
@@ -277,12 +260,61 @@ static bool checkNullRow(SExprSupp* pExprSup, SSDataBlock* pSrcBlock, int32_t in
   return false;
 }
 
+static bool getFillValue(SVariant* pVar, int8_t type, char* pVal, bool* isNull) {
+  *isNull = (TSDB_DATA_TYPE_NULL == pVar->nType) ? true : false;
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    float v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, float, pVar->nType, &pVar->f);
+    } else {
+      v = taosStr2Float(varDataVal(pVar->pz), NULL);
+    }
+    memcpy(pVal, &v, sizeof(v));
+  } else if (type == TSDB_DATA_TYPE_DOUBLE) {
+    double v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, double, pVar->nType, &pVar->d);
+    } else {
+      v = taosStr2Double(varDataVal(pVar->pz), NULL);
+    }
+    memcpy(pVal, &v, sizeof(v));
+  } else if (IS_SIGNED_NUMERIC_TYPE(type)) {
+    int64_t v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, int64_t, pVar->nType, &pVar->i);
+    } else {
+      v = taosStr2Int64(varDataVal(pVar->pz), NULL, 10);
+    }
+    memcpy(pVal, &v, sizeof(v));
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    uint64_t v = 0;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, uint64_t, pVar->nType, &pVar->u);
+    } else {
+      v = taosStr2UInt64(varDataVal(pVar->pz), NULL, 10);
+    }
+    memcpy(pVal, &v, sizeof(v));
+  } else if (IS_BOOLEAN_TYPE(type)) {
+    bool v = false;
+    if (!IS_VAR_DATA_TYPE(pVar->nType)) {
+      GET_TYPED_DATA(v, bool, pVar->nType, &pVar->i);
+    } else {
+      v = taosStr2Int8(varDataVal(pVar->pz), NULL, 10);
+    }
+    memcpy(pVal, &v, sizeof(v));
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
 static bool genInterpolationResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, SSDataBlock* pResBlock,
                                    SSDataBlock* pSrcBlock, int32_t index, bool beforeTs, SExecTaskInfo* pTaskInfo) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
   int32_t rows = pResBlock->info.rows;
-  code = timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock);
+  code = timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock, 1);
   QUERY_CHECK_CODE(code, lino, _end);
   // todo set the correct primary timestamp column
 
@@ -355,51 +387,10 @@ static bool genInterpolationResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp
       case TSDB_FILL_SET_VALUE:
       case TSDB_FILL_SET_VALUE_F: {
         SVariant* pVar = &pSliceInfo->pFillColInfo[fillColIndex].fillVal;
+        int64_t   v = 0;
+        bool      isNull = false;
 
-        bool isNull = (TSDB_DATA_TYPE_NULL == pVar->nType) ? true : false;
-        if (pDst->info.type == TSDB_DATA_TYPE_FLOAT) {
-          float v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, float, pVar->nType, &pVar->f);
-          } else {
-            v = taosStr2Float(varDataVal(pVar->pz), NULL);
-          }
-          code = colDataSetVal(pDst, rows, (char*)&v, isNull);
-          QUERY_CHECK_CODE(code, lino, _end);
-        } else if (pDst->info.type == TSDB_DATA_TYPE_DOUBLE) {
-          double v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, double, pVar->nType, &pVar->d);
-          } else {
-            v = taosStr2Double(varDataVal(pVar->pz), NULL);
-          }
-          code = colDataSetVal(pDst, rows, (char*)&v, isNull);
-          QUERY_CHECK_CODE(code, lino, _end);
-        } else if (IS_SIGNED_NUMERIC_TYPE(pDst->info.type)) {
-          int64_t v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, int64_t, pVar->nType, &pVar->i);
-          } else {
-            v = taosStr2Int64(varDataVal(pVar->pz), NULL, 10);
-          }
-          code = colDataSetVal(pDst, rows, (char*)&v, isNull);
-          QUERY_CHECK_CODE(code, lino, _end);
-        } else if (IS_UNSIGNED_NUMERIC_TYPE(pDst->info.type)) {
-          uint64_t v = 0;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, uint64_t, pVar->nType, &pVar->u);
-          } else {
-            v = taosStr2UInt64(varDataVal(pVar->pz), NULL, 10);
-          }
-          code = colDataSetVal(pDst, rows, (char*)&v, isNull);
-          QUERY_CHECK_CODE(code, lino, _end);
-        } else if (IS_BOOLEAN_TYPE(pDst->info.type)) {
-          bool v = false;
-          if (!IS_VAR_DATA_TYPE(pVar->nType)) {
-            GET_TYPED_DATA(v, bool, pVar->nType, &pVar->i);
-          } else {
-            v = taosStr2Int8(varDataVal(pVar->pz), NULL, 10);
-          }
+        if (getFillValue(pVar, pDst->info.type, (char*)&v, &isNull)) {
           code = colDataSetVal(pDst, rows, (char*)&v, isNull);
           QUERY_CHECK_CODE(code, lino, _end);
         }
@@ -495,11 +486,185 @@ _end:
   return hasInterp;
 }
 
+static bool canGenInterpInBatch(STimeSliceOperatorInfo* pSliceInfo) {
+  SInterval* pInterval = &pSliceInfo->interval;
+  if (IS_CALENDAR_TIME_DURATION(pInterval->intervalUnit) || pInterval->interval <= 0) {
+    return false;
+  }
+
+  switch (pSliceInfo->fillType) {
+    case TSDB_FILL_NULL:
+    case TSDB_FILL_NULL_F:
+    case TSDB_FILL_SET_VALUE:
+    case TSDB_FILL_SET_VALUE_F:
+    case TSDB_FILL_PREV:
+    case TSDB_FILL_NEXT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static int32_t setNItemsInCol(SColumnInfoData* pDst, int32_t startRow, const char* pData, bool isNull,
+                              int32_t numOfRows) {
+  if (isNull) {
+    colDataSetNNULL(pDst, startRow, numOfRows);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return colDataSetNItems(pDst, startRow, pData, numOfRows, false);
+}
+
+/*
+ * Generate the interpolation results of all the grid points from pSliceInfo->current up to lastKey at once. Every
+ * output column is filled in a single pass, the value of each column is the same for all points except _irowts, since
+ * the prev/next keepers and the fill values do not change within the gap.
+ */
+static void genInterpolationResultBatch(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup,
+                                        SSDataBlock* pResBlock, SSDataBlock* pSrcBlock, int32_t index, int64_t lastKey,
+                                        SExecTaskInfo* pTaskInfo) {
+  int32_t    code = TSDB_CODE_SUCCESS;
+  int32_t    lino = 0;
+  SInterval* pInterval = &pSliceInfo->interval;
+
+  lastKey = TMIN(lastKey, pSliceInfo->win.ekey);
+  if (pSliceInfo->current > lastKey) {
+    return;
+  }
+
+  int32_t rows = pResBlock->info.rows;
+  int64_t numOfPoints = (lastKey - pSliceInfo->current) / pInterval->interval + 1;
+  if (numOfPoints + rows > INT32_MAX) {
+    numOfPoints = INT32_MAX - rows;
+  }
+
+  int32_t num = (int32_t)numOfPoints;
+  code = timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock, num);
+  QUERY_CHECK_CODE(code, lino, _end);
+
+  int32_t fillColIndex = 0;
+  int32_t groupKeyIndex = 0;
+  bool    hasInterp = true;
+  for (int32_t j = 0; j < pExprSup->numOfExprs; ++j) {
+    SExprInfo* pExprInfo = &pExprSup->pExprInfo[j];
+
+    int32_t          dstSlot = pExprInfo->base.resSchema.slotId;
+    SColumnInfoData* pDst = taosArrayGet(pResBlock->pDataBlock, dstSlot);
+
+    if (isIrowtsPseudoColumn(pExprInfo)) {
+      int64_t* pKey = (int64_t*)pDst->pData + rows;
+      for (int32_t k = 0; k < num; ++k) {
+        pKey[k] = pSliceInfo->current + k * pInterval->interval;
+      }
+      continue;
+    } else if (isIsfilledPseudoColumn(pExprInfo)) {
+      bool isFilled = true;
+      code = setNItemsInCol(pDst, rows, (char*)&isFilled, false, num);
+      QUERY_CHECK_CODE(code, lino, _end);
+      continue;
+    } else if (!isInterpFunc(pExprInfo)) {
+      if (isGroupKeyFunc(pExprInfo) || isSelectGroupConstValueFunc(pExprInfo)) {
+        if (pSrcBlock != NULL) {
+          int32_t          srcSlot = pExprInfo->base.pParam[0].pCol->slotId;
+          SColumnInfoData* pSrc = taosArrayGet(pSrcBlock->pDataBlock, srcSlot);
+          bool             isNull = colDataIsNull_s(pSrc, index);
+
+          code = setNItemsInCol(pDst, rows, isNull ? NULL : colDataGetData(pSrc, index), isNull, num);
+          QUERY_CHECK_CODE(code, lino, _end);
+        } else if (!isSelectGroupConstValueFunc(pExprInfo)) {
+          SGroupKeys* pkey = taosArrayGet(pSliceInfo->pPrevGroupKeys, groupKeyIndex);
+          QUERY_CHECK_NULL(pkey, code, lino, _end, terrno);
+          groupKeyIndex++;
+          code = setNItemsInCol(pDst, rows, pkey->pData, pkey->isNull, num);
+          QUERY_CHECK_CODE(code, lino, _end);
+        } else {
+          int32_t     srcSlot = pExprInfo->base.pParam[0].pCol->slotId;
+          SGroupKeys* pkey = taosArrayGet(pSliceInfo->pPrevRow, srcSlot);
+          code = setNItemsInCol(pDst, rows, pkey->pData, pkey->isNull, num);
+          QUERY_CHECK_CODE(code, lino, _end);
+        }
+      }
+      continue;
+    }
+
+    int32_t srcSlot = pExprInfo->base.pParam[0].pCol->slotId;
+    switch (pSliceInfo->fillType) {
+      case TSDB_FILL_NULL:
+      case TSDB_FILL_NULL_F: {
+        colDataSetNNULL(pDst, rows, num);
+        break;
+      }
+
+      case TSDB_FILL_SET_VALUE:
+      case TSDB_FILL_SET_VALUE_F: {
+        SVariant* pVar = &pSliceInfo->pFillColInfo[fillColIndex].fillVal;
+        int64_t   v = 0;
+        bool      isNull = false;
+
+        if (getFillValue(pVar, pDst->info.type, (char*)&v, &isNull)) {
+          code = setNItemsInCol(pDst, rows, (char*)&v, isNull, num);
+          QUERY_CHECK_CODE(code, lino, _end);
+        }
+
+        ++fillColIndex;
+        break;
+      }
+
+      case TSDB_FILL_PREV:
+      case TSDB_FILL_NEXT: {
+        bool   isSet = (pSliceInfo->fillType == TSDB_FILL_PREV) ? pSliceInfo->isPrevRowSet : pSliceInfo->isNextRowSet;
+        SArray* pKeeper = (pSliceInfo->fillType == TSDB_FILL_PREV) ? pSliceInfo->pPrevRow : pSliceInfo->pNextRow;
+        if (!isSet) {
+          hasInterp = false;
+          break;
+        }
+
+        SGroupKeys* pkey = taosArrayGet(pKeeper, srcSlot);
+        code = setNItemsInCol(pDst, rows, pkey->pData, pkey->isNull, num);
+        QUERY_CHECK_CODE(code, lino, _end);
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
+
+  if (hasInterp) {
+    pResBlock->info.rows += num;
+  }
+
+  pSliceInfo->current += num * pInterval->interval;
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+    pTaskInfo->code = code;
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+}
+
+// find the first row in [start, rows) whose timestamp is not less than key
+static int32_t seekRowByTs(SColumnInfoData* pTsCol, int32_t start, int32_t rows, int64_t key) {
+  int64_t* pTs = (int64_t*)pTsCol->pData;
+  int32_t  lo = start, hi = rows;
+  while (lo < hi) {
+    int32_t mid = lo + ((hi - lo) >> 1);
+    if (pTs[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
 static int32_t addCurrentRowToResult(STimeSliceOperatorInfo* pSliceInfo, SExprSupp* pExprSup, SSDataBlock* pResBlock,
                                      SSDataBlock* pSrcBlock, int32_t index) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t lino = 0;
-  code = timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock);
+  code = timeSliceEnsureBlockCapacity(pSliceInfo, pResBlock, 1);
   QUERY_CHECK_CODE(code, lino, _end);
   for (int32_t j = 0; j < pExprSup->numOfExprs; ++j) {
     SExprInfo* pExprInfo = &pExprSup->pExprInfo[j];
@@ -812,10 +977,27 @@ static void doTimesliceImpl(SOperatorInfo* pOperator, STimeSliceOperatorInfo* pS
     pPkCol = taosArrayGet(pBlock->pDataBlock, pSliceInfo->pkCol.slotId);
   }
 
+  // rows before the current grid point only refresh the prev/next keepers, so they can be skipped as a whole by
+  // seeking the last one of them, unless every row is needed for the linear keeper, the null check or the pk check.
+  bool batchInterp = pSliceInfo->batchInterp;
+  bool skipRows = batchInterp && !ignoreNull && pPkCol == NULL;
+
   int32_t i = (pSliceInfo->pRemainRes == NULL) ? 0 : pSliceInfo->remainIndex;
   for (; i < pBlock->info.rows; ++i) {
     int64_t ts = *(int64_t*)colDataGetData(pTsCol, i);
 
+    if (skipRows && ts < pSliceInfo->current && pSliceInfo->prevTsSet) {
+      int32_t last = seekRowByTs(pTsCol, i, pBlock->info.rows, pSliceInfo->current) - 1;
+      while (last > i && ((int64_t*)pTsCol->pData)[last - 1] == ((int64_t*)pTsCol->pData)[last]) {
+        --last;
+      }
+
+      if (last > i) {
+        i = last;
+        ts = *(int64_t*)colDataGetData(pTsCol, i);
+      }
+    }
+
     // check for duplicate timestamps
     if (checkDuplicateTimestamps(pSliceInfo, pTsCol, pPkCol, i, pBlock->info.rows)) {
       continue;
@@ -853,6 +1035,9 @@ static void doTimesliceImpl(SOperatorInfo* pOperator, STimeSliceOperatorInfo* pS
         doKeepNextRows(pSliceInfo, pBlock, i + 1);
         int64_t nextTs = *(int64_t*)colDataGetData(pTsCol, i + 1);
         if (nextTs > pSliceInfo->current) {
+          if (batchInterp) {
+            genInterpolationResultBatch(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, nextTs - 1, pTaskInfo);
+          }
           while (pSliceInfo->current < nextTs && pSliceInfo->current <= pSliceInfo->win.ekey) {
             if (!genInterpolationResult(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, false, pTaskInfo) &&
                 pSliceInfo->fillType == TSDB_FILL_LINEAR) {
@@ -881,6 +1066,9 @@ static void doTimesliceImpl(SOperatorInfo* pOperator, STimeSliceOperatorInfo* pS
       doKeepNextRows(pSliceInfo, pBlock, i);
       doKeepLinearInfo(pSliceInfo, pBlock, i);
 
+      if (batchInterp) {
+        genInterpolationResultBatch(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, ts - 1, pTaskInfo);
+      }
       while (pSliceInfo->current < ts && pSliceInfo->current <= pSliceInfo->win.ekey) {
         if (!genInterpolationResult(pSliceInfo, &pOperator->exprSupp, pResBlock, pBlock, i, true, pTaskInfo) &&
             pSliceInfo->fillType == TSDB_FILL_LINEAR) {
@@ -932,6 +1120,11 @@ static void genInterpAfterDataBlock(STimeSliceOperatorInfo* pSliceInfo, SOperato
     return;
   }
 
+  if (pSliceInfo->batchInterp) {
+    genInterpolationResultBatch(pSliceInfo, &pOperator->exprSupp, pResBlock, NULL, index, pSliceInfo->win.ekey,
+                                pOperator->pTaskInfo);
+  }
+
   while (pSliceInfo->current <= pSliceInfo->win.ekey) {
     (void)genInterpolationResult(pSliceInfo, &pOperator->exprSupp, pResBlock, NULL, index, false, pOperator->pTaskInfo);
     pSliceInfo->current =
@@ -1192,6 +1385,7 @@ int32_t createTimeSliceOperatorInfo(SOperatorInfo* downstream, SPhysiNode* pPhyN
   pInfo->pNextGroupRes = NULL;
   pInfo->pRemainRes = NULL;
   pInfo->remainIndex = 0;
+  pInfo->batchInterp = canGenInterpInBatch(pInfo);
 
   if (pInfo->hasPk) {
     pInfo->prevKey.numOfPKs = 1;
@@ -78,6 +78,7 @@ struct SSortHandle {
   uint32_t      pqSortBufSize;
   bool          forceUsePQSort;
   BoundedQueue* pBoundedQueue;
+  SSortTopKBound* pTopKBound;
   uint32_t      tmpRowIdx;
   int64_t       mergeLimit;
   int64_t       currMergeLimitTs;
@@ -2646,6 +2647,10 @@ void tsortSetForceUsePQSort(SSortHandle* pHandle) {
   pHandle->forceUsePQSort = true;
 }
 
+void tsortSetTopKBound(SSortHandle* pHandle, SSortTopKBound* pBound) {
+  pHandle->pTopKBound = pBound;
+}
+
 static bool tsortIsPQSortApplicable(SSortHandle* pHandle) {
   if (pHandle->type != SORT_SINGLESOURCE_SORT) return false;
   if (tsortIsForceUsePQSort(pHandle)) return true;
@@ -2713,6 +2718,39 @@ static int32_t tupleComparFn(const void* pLeft, const void* pRight, void* param)
   return 0;
 }
 
+static int32_t tsortUpdateTopKBound(SSortHandle* pHandle) {
+  SSortTopKBound* pBound = pHandle->pTopKBound;
+  if (taosBQSize(pHandle->pBoundedQueue) < taosBQMaxSize(pHandle->pBoundedQueue)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the top is the worst row in the queue, anything worse than it is dropped by the push
+  PriorityQueueNode* pNode = taosBQTop(pHandle->pBoundedQueue);
+  void*              pData = NULL;
+  int32_t code = tupleDescGetField(pNode->data, pBound->slotId, blockDataGetNumOfCols(pHandle->pDataBlock), &pData);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  pBound->valid = (pData != NULL);
+  if (!pBound->valid) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (IS_FLOAT_TYPE(pBound->type)) {
+    double v = 0;
+    GET_TYPED_DATA(v, double, pBound->type, pData);
+    pBound->val = *(int64_t*)&v;
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(pBound->type)) {
+    uint64_t v = 0;
+    GET_TYPED_DATA(v, uint64_t, pBound->type, pData);
+    pBound->val = (int64_t)v;
+  } else {
+    GET_TYPED_DATA(pBound->val, int64_t, pBound->type, pData);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
   pHandle->pBoundedQueue = createBoundedQueue(pHandle->pqMaxRows, tsortPQCompFn, destroyTuple, pHandle);
   if (NULL == pHandle->pBoundedQueue) {
@@ -2781,6 +2819,10 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
         }
       }
     }
+
+    if (pHandle->pTopKBound != NULL) {
+      TAOS_CHECK_RETURN(tsortUpdateTopKBound(pHandle));
+    }
   }
 
   return TSDB_CODE_SUCCESS;
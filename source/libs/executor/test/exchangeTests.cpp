@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include <addr_any.h>
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "operator.h"
+#include "query.h"
+#include "querytask.h"
+#include "stub.h"
+#include "tdatablock.h"
+#include "tref.h"
+
+namespace {
+
+// the scripted results of one upstream task, a source is done after its last rsp unless that one is empty
+typedef struct {
+  std::vector<int32_t> rows;
+  int32_t              sent;
+} SExTestSource;
+
+std::vector<SExTestSource> gExTestSources;
+
+int32_t exTestValue(uint64_t taskId, int32_t rspIdx, int32_t row) { return taskId * 1000 + rspIdx * 100 + row; }
+
+// a fetch rsp in network byte order with a single uncompressed block of one INT column
+SRetrieveTableRsp* exTestBuildRsp(uint64_t taskId, int32_t rspIdx, int32_t rows, bool completed, int32_t* pLen) {
+  SSDataBlock* pBlock = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+  SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 1);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &col), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, TMAX(rows, 1)), TSDB_CODE_SUCCESS);
+
+  SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t val = exTestValue(taskId, rspIdx, i);
+    EXPECT_EQ(colDataSetVal(pCol, i, (const char*)&val, false), TSDB_CODE_SUCCESS);
+  }
+  pBlock->info.rows = rows;
+
+  int32_t            dataLen = blockGetEncodeSize(pBlock);
+  SRetrieveTableRsp* pRsp =
+      (SRetrieveTableRsp*)taosMemoryCalloc(1, sizeof(SRetrieveTableRsp) + PAYLOAD_PREFIX_LEN + dataLen);
+  int32_t            len = 0;
+  if (rows > 0) {
+    len = blockEncode(pBlock, pRsp->data + PAYLOAD_PREFIX_LEN, 1);
+    EXPECT_GT(len, 0);
+    int32_t prefix[2] = {len, len};
+    memcpy(pRsp->data, prefix, sizeof(prefix));
+    len += PAYLOAD_PREFIX_LEN;
+  }
+
+  pRsp->completed = completed;
+  pRsp->numOfBlocks = htonl(rows > 0 ? 1 : 0);
+  pRsp->numOfRows = htobe64(rows);
+  pRsp->numOfCols = htonl(1);
+  pRsp->compLen = htonl(len);
+  pRsp->payloadLen = htonl(len);
+  *pLen = sizeof(SRetrieveTableRsp) + len;
+
+  blockDataDestroy(pBlock);
+  return pRsp;
+}
+
+// answer the fetch at once with the next scripted rsp of the source, the task id of the req is the source
+int32_t exTestSendMsg(void* pTransporter, SEpSet* epSet, int64_t* pTransporterId, SMsgSendInfo* pInfo) {
+  SResFetchReq req = {0};
+  EXPECT_EQ(tDeserializeSResFetchReq(pInfo->msgInfo.pData, pInfo->msgInfo.len, &req), TSDB_CODE_SUCCESS);
+  EXPECT_GT(req.taskId, 0);
+  EXPECT_LE(req.taskId, gExTestSources.size());
+
+  SExTestSource* pSource = &gExTestSources[req.taskId - 1];
+  int32_t        rspIdx = pSource->sent++;
+  int32_t        rows = rspIdx < pSource->rows.size() ? pSource->rows[rspIdx] : 0;
+  bool           completed = (rspIdx + 1 >= pSource->rows.size()) && rows > 0;
+
+  SDataBuf buf = {0};
+  int32_t  len = 0;
+  buf.pData = exTestBuildRsp(req.taskId, rspIdx, rows, completed, &len);
+  buf.len = len;
+  *pTransporterId = 1;
+
+  int32_t code = (*pInfo->fp)(pInfo->param, &buf, TSDB_CODE_SUCCESS);
+  destroySendMsgInfo(pInfo);
+  return code;
+}
+
+int32_t exTestFreeConn(void* pTransporter, int64_t pid) { return TSDB_CODE_SUCCESS; }
+
+void exTestReplaceTransport() {
+  static Stub stub;
+  stub.set(asyncSendMsgToServer, exTestSendMsg);
+  stub.set(asyncFreeConnById, exTestFreeConn);
+  {
+#ifdef WINDOWS
+    AddrAny                       any;
+    std::map<std::string, void *> result;
+    any.get_func_addr("asyncSendMsgToServer", result);
+    for (const auto &f : result) {
+      stub.set(f.second, exTestSendMsg);
+    }
+#endif
+#ifdef LINUX
+    AddrAny                       any("libqcom.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^asyncSendMsgToServer$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, exTestSendMsg);
+    }
+#endif
+  }
+}
+
+SExchangePhysiNode* exTestCreatePhysiNode(int32_t numOfSources) {
+  SExchangePhysiNode* pNode = NULL;
+  SDataBlockDescNode* pDesc = NULL;
+  SSlotDescNode*      pSlot = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_EXCHANGE, (SNode**)&pNode), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_DATABLOCK_DESC, (SNode**)&pDesc), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_SLOT_DESC, (SNode**)&pSlot), TSDB_CODE_SUCCESS);
+  pSlot->slotId = 0;
+  pSlot->output = true;
+  pSlot->dataType.type = TSDB_DATA_TYPE_INT;
+  pSlot->dataType.bytes = sizeof(int32_t);
+  EXPECT_EQ(nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot), TSDB_CODE_SUCCESS);
+  pDesc->totalRowSize = sizeof(int32_t);
+  pDesc->outputRowSize = sizeof(int32_t);
+  pNode->node.pOutputDataBlockDesc = pDesc;
+  pNode->seqRecvData = true;
+
+  for (int32_t i = 0; i < numOfSources; ++i) {
+    SDownstreamSourceNode* pSource = NULL;
+    EXPECT_EQ(nodesMakeNode(QUERY_NODE_DOWNSTREAM_SOURCE, (SNode**)&pSource), TSDB_CODE_SUCCESS);
+    pSource->addr.nodeId = 2 + i;
+    pSource->taskId = 1 + i;
+    pSource->schedId = 1;
+    pSource->fetchMsgType = TDMT_SCH_FETCH;
+    EXPECT_EQ(nodesListMakeStrictAppend(&pNode->pSrcEndPoints, (SNode*)pSource), TSDB_CODE_SUCCESS);
+  }
+  return pNode;
+}
+
+// drive a sequential exchange block by block, recording the rows and first value of each block and the fetches sent
+// to each source after every call
+void exTestRunSeqExchange(const std::vector<std::vector<int32_t>>& sources, std::vector<int32_t>* pBlocks,
+                          std::vector<std::vector<int32_t>>* pSentAfter) {
+  exTestReplaceTransport();
+  if (exchangeObjRefPool < 0) {
+    exchangeObjRefPool = taosOpenRef(1024, doDestroyExchangeOperatorInfo);
+  }
+
+  gExTestSources.clear();
+  for (const auto& rows : sources) {
+    SExTestSource source = {rows, 0};
+    gExTestSources.push_back(source);
+  }
+
+  SStorageAPI    storageAPI = {0};
+  SExecTaskInfo* pTask = NULL;
+  ASSERT_EQ(doCreateTask(1, 1, 1, OPTR_EXEC_MODEL_BATCH, &storageAPI, &pTask), TSDB_CODE_SUCCESS);
+
+  SExchangePhysiNode* pNode = exTestCreatePhysiNode(sources.size());
+  SOperatorInfo*      pOperator = NULL;
+  ASSERT_EQ(createExchangeOperatorInfo(NULL, pNode, pTask, &pOperator), TSDB_CODE_SUCCESS);
+  pTask->pRoot = pOperator;
+
+  while (1) {
+    SSDataBlock* pBlock = NULL;
+    ASSERT_EQ(pOperator->fpSet.getNextFn(pOperator, &pBlock), TSDB_CODE_SUCCESS);
+
+    std::vector<int32_t> sent;
+    for (const auto& source : gExTestSources) {
+      sent.push_back(source.sent);
+    }
+    pSentAfter->push_back(sent);
+    if (NULL == pBlock) {
+      break;
+    }
+
+    // the values tell which source and which rsp the block comes from
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    int32_t          first = *(int32_t*)colDataGetData(pCol, 0);
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      ASSERT_FALSE(colDataIsNull_s(pCol, i));
+      ASSERT_EQ(*(int32_t*)colDataGetData(pCol, i), first + i);
+    }
+    pBlocks->push_back(pBlock->info.rows);
+    pBlocks->push_back(first);
+  }
+
+  doDestroyTask(pTask);
+  nodesDestroyNode((SNode*)pNode);
+}
+
+}  // namespace
+
+TEST(exchangeTest, seqLoadPrefetchOneSource) {
+  std::vector<int32_t>              blocks;
+  std::vector<std::vector<int32_t>> sentAfter;
+  exTestRunSeqExchange({{10, 20, 30}}, &blocks, &sentAfter);
+
+  // the fetch of the next rsp goes out with every block but the last one, and none is sent twice
+  std::vector<int32_t> expBlocks = {10, exTestValue(1, 0, 0), 20, exTestValue(1, 1, 0), 30, exTestValue(1, 2, 0)};
+  EXPECT_EQ(blocks, expBlocks);
+  std::vector<std::vector<int32_t>> expSent = {{2}, {3}, {3}, {3}};
+  EXPECT_EQ(sentAfter, expSent);
+}
+
+TEST(exchangeTest, seqLoadPrefetchEmptyRsp) {
+  std::vector<int32_t>              blocks;
+  std::vector<std::vector<int32_t>> sentAfter;
+  exTestRunSeqExchange({{5, 0}, {7}}, &blocks, &sentAfter);
+
+  // the prefetched empty rsp ends the first source, the second one is fetched only after it
+  std::vector<int32_t> expBlocks = {5, exTestValue(1, 0, 0), 7, exTestValue(2, 0, 0)};
+  EXPECT_EQ(blocks, expBlocks);
+  std::vector<std::vector<int32_t>> expSent = {{2, 0}, {2, 1}, {2, 1}};
+  EXPECT_EQ(sentAfter, expSent);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "tdatablock.h"
+#include "tfill.h"
+
+namespace {
+
+// _wstart, two filled columns, a not filled column and _wend
+const int32_t fillTestNumOfCols = 5;
+const int8_t  fillTestTypes[fillTestNumOfCols] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_DOUBLE,
+                                                  TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_TIMESTAMP};
+const int16_t fillTestColTypes[fillTestNumOfCols] = {COLUMN_TYPE_WINDOW_START, COLUMN_TYPE_COLUMN, COLUMN_TYPE_COLUMN,
+                                                     COLUMN_TYPE_COLUMN, COLUMN_TYPE_WINDOW_END};
+const int64_t fillTestInterval = 10;
+
+typedef struct {
+  int64_t ts;
+  int32_t val;
+  bool    isNull;
+} SFillTestRow;
+
+SSDataBlock* fillTestCreateBlock(int32_t capacity) {
+  SSDataBlock* pBlock = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+  for (int32_t i = 0; i < fillTestNumOfCols; ++i) {
+    SColumnInfoData col = createColumnInfoData(fillTestTypes[i], tDataTypes[fillTestTypes[i]].bytes, i + 1);
+    EXPECT_EQ(blockDataAppendColInfo(pBlock, &col), TSDB_CODE_SUCCESS);
+  }
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, capacity), TSDB_CODE_SUCCESS);
+  return pBlock;
+}
+
+// the input rows are the results of the windows, in the fill order
+SSDataBlock* fillTestCreateSrcBlock(const std::vector<SFillTestRow>& rows) {
+  SSDataBlock* pBlock = fillTestCreateBlock(rows.size());
+  for (int32_t i = 0; i < rows.size(); ++i) {
+    int64_t ts = rows[i].ts;
+    int64_t wend = ts + fillTestInterval;
+    int64_t tag = 77;
+    double  d = rows[i].val * 1.5;
+
+    EXPECT_EQ(colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&ts, false),
+              TSDB_CODE_SUCCESS);
+    for (int32_t c = 1; c <= 2; ++c) {
+      SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, c);
+      if (rows[i].isNull) {
+        colDataSetNULL(pCol, i);
+      } else {
+        EXPECT_EQ(colDataSetVal(pCol, i, (c == 1) ? (const char*)&rows[i].val : (const char*)&d, false),
+                  TSDB_CODE_SUCCESS);
+      }
+    }
+    EXPECT_EQ(colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 3), i, (const char*)&tag, false),
+              TSDB_CODE_SUCCESS);
+    EXPECT_EQ(colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 4), i, (const char*)&wend, false),
+              TSDB_CODE_SUCCESS);
+  }
+  pBlock->info.rows = rows.size();
+  return pBlock;
+}
+
+void fillTestInitExpr(SExprInfo* pExpr, int32_t slotId) {
+  memset(pExpr, 0, sizeof(SExprInfo));
+  pExpr->pExpr = (tExprNode*)taosMemoryCalloc(1, sizeof(tExprNode));
+  pExpr->pExpr->nodeType = QUERY_NODE_COLUMN;
+  pExpr->base.resSchema.type = fillTestTypes[slotId];
+  pExpr->base.resSchema.bytes = tDataTypes[fillTestTypes[slotId]].bytes;
+  pExpr->base.resSchema.slotId = slotId;
+  pExpr->base.numOfParams = 1;
+  pExpr->base.pParam = (SFunctParam*)taosMemoryCalloc(1, sizeof(SFunctParam));
+  pExpr->base.pParam[0].type = FUNC_PARAM_TYPE_COLUMN;
+  pExpr->base.pParam[0].pCol = (SColumn*)taosMemoryCalloc(1, sizeof(SColumn));
+  pExpr->base.pParam[0].pCol->slotId = slotId;
+  pExpr->base.pParam[0].pCol->colType = fillTestColTypes[slotId];
+}
+
+void fillTestDestroyExprs(SExprInfo* pExprs, int32_t num) {
+  for (int32_t i = 0; i < num; ++i) {
+    taosMemoryFree(pExprs[i].base.pParam[0].pCol);
+    taosMemoryFree(pExprs[i].base.pParam);
+    taosMemoryFree(pExprs[i].pExpr);
+  }
+}
+
+void fillTestCollect(SSDataBlock* pBlock, std::vector<std::vector<char>>* pRes) {
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    std::vector<char> row;
+    for (int32_t c = 0; c < fillTestNumOfCols; ++c) {
+      SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, c);
+      bool             isNull = colDataIsNull_s(pCol, i);
+      row.push_back(isNull ? 1 : 0);
+      if (!isNull) {
+        const char* p = colDataGetData(pCol, i);
+        row.insert(row.end(), p, p + pCol->info.bytes);
+      }
+    }
+    pRes->push_back(row);
+  }
+}
+
+// fill the windows from start to end around the rows, the output blocks hold at most capacity rows
+std::vector<std::vector<char>> fillTestRun(int32_t fillType, int32_t order, const std::vector<SFillTestRow>& rows,
+                                           int64_t start, int64_t end, int32_t capacity, bool nRows) {
+  SExprInfo fillExprs[2], notFillExprs[3];
+  fillTestInitExpr(&fillExprs[0], 1);
+  fillTestInitExpr(&fillExprs[1], 2);
+  fillTestInitExpr(&notFillExprs[0], 0);
+  fillTestInitExpr(&notFillExprs[1], 3);
+  fillTestInitExpr(&notFillExprs[2], 4);
+
+  SFillColInfo* pFillCol = createFillColInfo(fillExprs, 2, notFillExprs, 3, NULL, 0, NULL);
+  EXPECT_NE(pFillCol, nullptr);
+  for (int32_t i = 0; i < 2; ++i) {
+    pFillCol[i].fillVal.nType = TSDB_DATA_TYPE_BIGINT;
+    pFillCol[i].fillVal.i = -7;
+  }
+
+  SInterval interval = {0};
+  interval.interval = fillTestInterval;
+  interval.sliding = fillTestInterval;
+  interval.intervalUnit = 'a';
+  interval.slidingUnit = 'a';
+  interval.precision = TSDB_TIME_PRECISION_MILLI;
+
+  SFillInfo* pFillInfo = NULL;
+  EXPECT_EQ(taosCreateFillInfo(start, 2, 3, 0, capacity, &interval, fillType, pFillCol, 0, order, "fillTest", NULL,
+                               &pFillInfo),
+            TSDB_CODE_SUCCESS);
+  EXPECT_TRUE(pFillInfo->fillNRows);
+  pFillInfo->fillNRows = nRows;
+
+  std::vector<std::vector<char>> res;
+  SSDataBlock*                   pSrc = fillTestCreateSrcBlock(rows);
+  SSDataBlock*                   pOut = fillTestCreateBlock(capacity);
+
+  // the windows up to the last row, then the ones after it up to the end
+  taosFillSetStartInfo(pFillInfo, rows.size(), rows.back().ts);
+  taosFillSetInputDataBlock(pFillInfo, pSrc);
+  for (int32_t round = 0; round < 2; ++round) {
+    while (taosFillHasMoreResults(pFillInfo)) {
+      blockDataCleanup(pOut);
+      EXPECT_EQ(taosFillResultDataBlock(pFillInfo, pOut, capacity), TSDB_CODE_SUCCESS);
+      EXPECT_LE(pOut->info.rows, capacity);
+      if (pOut->info.rows == 0) {
+        break;
+      }
+      fillTestCollect(pOut, &res);
+    }
+    taosFillSetStartInfo(pFillInfo, 0, end);
+  }
+
+  blockDataDestroy(pSrc);
+  blockDataDestroy(pOut);
+  taosDestroyFillInfo(pFillInfo);
+  fillTestDestroyExprs(fillExprs, 2);
+  fillTestDestroyExprs(notFillExprs, 3);
+  return res;
+}
+
+// window results with gaps of various length, some of them null
+std::vector<SFillTestRow> fillTestCreateRows(int32_t order) {
+  std::vector<SFillTestRow> rows;
+  int64_t                   gaps[] = {1, 1, 2, 5, 1, 13, 3, 40, 1, 7};
+  int64_t                   ts = 0;
+  for (int32_t i = 0; i < sizeof(gaps) / sizeof(gaps[0]); ++i) {
+    SFillTestRow row = {ts, i + 1, i % 4 == 2};
+    rows.push_back(row);
+    ts += gaps[i] * fillTestInterval;
+  }
+  if (order == TSDB_ORDER_DESC) {
+    std::reverse(rows.begin(), rows.end());
+  }
+  return rows;
+}
+
+// the runs filled column by column must give the rows filled one by one
+void fillTestCompare(int32_t fillType) {
+  int32_t orders[] = {TSDB_ORDER_ASC, TSDB_ORDER_DESC};
+  int32_t capacities[] = {4096, 7, 1};
+  for (int32_t order : orders) {
+    std::vector<SFillTestRow> rows = fillTestCreateRows(order);
+    int64_t                   first = -5 * fillTestInterval;
+    int64_t                   last = rows.front().ts + rows.back().ts + 9 * fillTestInterval;
+    int64_t                   start = (order == TSDB_ORDER_ASC) ? first : last;
+    int64_t                   end = (order == TSDB_ORDER_ASC) ? last : first;
+
+    for (int32_t capacity : capacities) {
+      std::vector<std::vector<char>> expect = fillTestRun(fillType, order, rows, start, end, capacity, false);
+      std::vector<std::vector<char>> res = fillTestRun(fillType, order, rows, start, end, capacity, true);
+      EXPECT_EQ(expect.size(), (last - first) / fillTestInterval + 1);
+      EXPECT_TRUE(res == expect) << "fill type:" << fillType << " order:" << order << " capacity:" << capacity;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(fillTest, fillNRowsPrev) { fillTestCompare(TSDB_FILL_PREV); }
+
+TEST(fillTest, fillNRowsNext) { fillTestCompare(TSDB_FILL_NEXT); }
+
+TEST(fillTest, fillNRowsNull) {
+  fillTestCompare(TSDB_FILL_NULL);
+  fillTestCompare(TSDB_FILL_NULL_F);
+}
+
+TEST(fillTest, fillNRowsValue) {
+  fillTestCompare(TSDB_FILL_SET_VALUE);
+  fillTestCompare(TSDB_FILL_SET_VALUE_F);
+}
+
+TEST(fillTest, fillNRowsLinear) { fillTestCompare(TSDB_FILL_LINEAR); }
+
+#pragma GCC diagnostic pop
@@ -14,7 +14,9 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -41,6 +43,8 @@
 #include "tvariant.h"
 #include "stub.h"
 #include "querytask.h"
+#include "hashjoin.h"
+#include "tglobal.h"
 
 
 namespace {
@@ -2521,11 +2525,14 @@ SSDataBlock* getDummyInputBlock(struct SOperatorInfo* pOperator, int32_t idx) {
 void joinTestReplaceRetrieveFp() {
   static Stub stub;
   stub.set(getNextBlockFromDownstreamRemain, getDummyInputBlock);
+  // the hash join reads its downstreams without the remain flag
+  stub.set(getNextBlockFromDownstream, getDummyInputBlock);
   {
 #ifdef WINDOWS
     AddrAny                       any;
     std::map<std::string, void *> result;
     any.get_func_addr("getNextBlockFromDownstreamRemain", result);
+    any.get_func_addr("getNextBlockFromDownstream", result);
     for (const auto &f : result) {
       stub.set(f.second, getDummyInputBlock);
     }
@@ -2534,6 +2541,7 @@ void joinTestReplaceRetrieveFp() {
     AddrAny                       any("libexecutor.so");
     std::map<std::string, void *> result;
     any.get_global_func_addr_dynsym("^getNextBlockFromDownstreamRemain$", result);
+    any.get_global_func_addr_dynsym("^getNextBlockFromDownstream$", result);
     for (const auto &f : result) {
       stub.set(f.second, getDummyInputBlock);
     }
@@ -2989,6 +2997,223 @@ void handleCaseEnd() {
   jtCtx.rightFinMatchNum = 0;
 }
 
+typedef std::vector<int64_t> SHJoinTestRow;  // [isNull, value] of each column
+
+typedef struct {
+  int64_t spillBuildRows;
+  int64_t spillPartSplits;
+  int64_t spillMaxLevel;
+} SHJoinTestSpillInfo;
+
+// blocks of all the input columns with unique ts, keys in [0, keyRange) and one null key out of 10 rows
+void createHJoinTestBlkList(SArray* pList, int32_t blkId, int32_t totalRows, int32_t blkRows, int32_t keyRange,
+                            std::vector<SHJoinTestRow>* pRows) {
+  for (int32_t r = 0; r < totalRows;) {
+    int32_t      rows = TMIN(blkRows, totalRows - r);
+    SSDataBlock* pBlk = createDummyBlock(blkId);
+    assert(0 == blockDataEnsureCapacity(pBlk, rows));
+    for (int32_t i = 0; i < rows; ++i, ++r) {
+      SHJoinTestRow row;
+      int64_t       ts = jtCtx.curTs + r;
+      int32_t       v1 = r;
+      int32_t       v2 = taosRand() % 1000;
+      int64_t       key = taosRand() % keyRange;
+      bool          v2Null = (0 == taosRand() % 7);
+      bool          keyNull = (0 == taosRand() % 10);
+
+      assert(0 == colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, 0), i, (char*)&ts, false));
+      assert(0 == colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, 1), i, (char*)&v1, false));
+      assert(0 == colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, 2), i, (char*)&v2, v2Null));
+      assert(0 == colDataSetVal((SColumnInfoData*)taosArrayGet(pBlk->pDataBlock, JT_KEY_SOLT_ID), i, (char*)&key, keyNull));
+
+      int64_t vals[MAX_SLOT_NUM] = {ts, v1, v2, key};
+      bool    nulls[MAX_SLOT_NUM] = {false, false, v2Null, keyNull};
+      for (int32_t c = 0; c < MAX_SLOT_NUM; ++c) {
+        row.push_back(nulls[c]);
+        row.push_back(nulls[c] ? 0 : vals[c]);
+      }
+      pRows->push_back(row);
+    }
+    pBlk->info.rows = rows;
+    assert(NULL != taosArrayPush(pList, &pBlk));
+  }
+  jtCtx.curTs += totalRows;
+}
+
+// all the columns of both tables are output, joined on the key column
+SHashJoinPhysiNode* createDummyHashJoinPhysiNode(EJoinType joinType) {
+  SHashJoinPhysiNode* p = NULL;
+  assert(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN, (SNode**)&p));
+  p->joinType = joinType;
+  p->subType = (JOIN_TYPE_INNER == joinType) ? JOIN_STYPE_NONE : JOIN_STYPE_OUTER;
+  p->leftPrimSlotId = JT_PRIM_TS_SLOT_ID;
+  p->rightPrimSlotId = JT_PRIM_TS_SLOT_ID;
+  p->timeRangeTarget = 0;
+
+  for (int32_t blkId = LEFT_BLK_ID; blkId <= RIGHT_BLK_ID; ++blkId) {
+    SColumnNode* pKey = NULL;
+    assert(0 == nodesMakeNode(QUERY_NODE_COLUMN, (SNode**)&pKey));
+    pKey->dataBlockId = blkId;
+    pKey->slotId = JT_KEY_SOLT_ID;
+    pKey->node.resType.type = jtInputColType[JT_KEY_SOLT_ID];
+    pKey->node.resType.bytes = tDataTypes[pKey->node.resType.type].bytes;
+    assert(0 == nodesListMakeStrictAppend((LEFT_BLK_ID == blkId) ? &p->pOnLeft : &p->pOnRight, (SNode*)pKey));
+  }
+
+  SDataBlockDescNode* pDesc = NULL;
+  assert(0 == nodesMakeNode(QUERY_NODE_DATABLOCK_DESC, (SNode**)&pDesc));
+  pDesc->dataBlockId = RES_BLK_ID;
+  for (int32_t i = 0; i < MAX_SLOT_NUM * 2; ++i) {
+    int32_t      type = jtInputColType[i % MAX_SLOT_NUM];
+    STargetNode* pTarget = NULL;
+    SColumnNode* pCol = NULL;
+    assert(0 == nodesMakeNode(QUERY_NODE_TARGET, (SNode**)&pTarget));
+    assert(0 == nodesMakeNode(QUERY_NODE_COLUMN, (SNode**)&pCol));
+    pCol->dataBlockId = (i < MAX_SLOT_NUM) ? LEFT_BLK_ID : RIGHT_BLK_ID;
+    pCol->slotId = i % MAX_SLOT_NUM;
+    pCol->node.resType.type = type;
+    pCol->node.resType.bytes = tDataTypes[type].bytes;
+    pTarget->dataBlockId = RES_BLK_ID;
+    pTarget->slotId = i;
+    pTarget->pExpr = (SNode*)pCol;
+    assert(0 == nodesListMakeStrictAppend(&p->pTargets, (SNode*)pTarget));
+
+    SSlotDescNode* pSlot = NULL;
+    assert(0 == nodesMakeNode(QUERY_NODE_SLOT_DESC, (SNode**)&pSlot));
+    pSlot->slotId = i;
+    pSlot->dataType.type = type;
+    pSlot->dataType.bytes = tDataTypes[type].bytes;
+    pDesc->totalRowSize += pSlot->dataType.bytes;
+    assert(0 == nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot));
+  }
+  pDesc->outputRowSize = pDesc->totalRowSize;
+  p->node.pOutputDataBlockDesc = pDesc;
+
+  return p;
+}
+
+void appendHJoinTestResRows(SSDataBlock* pBlock, std::vector<SHJoinTestRow>* pRes) {
+  for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+    SHJoinTestRow row;
+    for (int32_t c = 0; c < MAX_SLOT_NUM * 2; ++c) {
+      SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, c);
+      bool             isNull = colDataIsNull_s(pCol, r);
+      int64_t          val = 0;
+      if (!isNull) {
+        val = (TSDB_DATA_TYPE_INT == pCol->info.type) ? *(int32_t*)colDataGetData(pCol, r)
+                                                      : *(int64_t*)colDataGetData(pCol, r);
+      }
+      row.push_back(isNull);
+      row.push_back(val);
+    }
+    pRes->push_back(row);
+  }
+}
+
+// the nested loop join of the input rows
+std::vector<SHJoinTestRow> getHJoinTestExpectRes(EJoinType joinType, const std::vector<SHJoinTestRow>& leftRows,
+                                                 const std::vector<SHJoinTestRow>& rightRows) {
+  std::vector<SHJoinTestRow> res;
+  int32_t                    keyIdx = JT_KEY_SOLT_ID * 2;
+  for (const auto& l : leftRows) {
+    bool matched = false;
+    for (const auto& r : rightRows) {
+      if (l[keyIdx] || r[keyIdx] || l[keyIdx + 1] != r[keyIdx + 1]) {
+        continue;
+      }
+      SHJoinTestRow row(l);
+      row.insert(row.end(), r.begin(), r.end());
+      res.push_back(row);
+      matched = true;
+    }
+    if (!matched && JOIN_TYPE_LEFT == joinType) {
+      SHJoinTestRow row(l);
+      for (int32_t c = 0; c < MAX_SLOT_NUM; ++c) {
+        row.push_back(true);
+        row.push_back(0);
+      }
+      res.push_back(row);
+    }
+  }
+
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+std::vector<SHJoinTestRow> runHashJoinTest(EJoinType joinType, int64_t memLimit, SExecTaskInfo* pTask,
+                                           SHJoinTestSpillInfo* pSpillInfo) {
+  int64_t                    oldMemLimit = tsQueryHashJoinMemLimitBytes;
+  SHashJoinPhysiNode*        pNode = createDummyHashJoinPhysiNode(joinType);
+  SOperatorInfo*             pDownstreams[2];
+  SOperatorInfo*             pJoinOp = NULL;
+  std::vector<SHJoinTestRow> res;
+
+  jtCtx.leftBlkReadIdx = 0;
+  jtCtx.rightBlkReadIdx = 0;
+  tsQueryHashJoinMemLimitBytes = memLimit;
+  createDummyDownstreamOperators(2, pDownstreams);
+  int32_t code = createHashJoinOperatorInfo(pDownstreams, 2, pNode, pTask, &pJoinOp);
+  tsQueryHashJoinMemLimitBytes = oldMemLimit;
+  EXPECT_EQ(code, TSDB_CODE_SUCCESS);
+  if (NULL == pJoinOp) {
+    nodesDestroyNode((SNode*)pNode);
+    return res;
+  }
+
+  while (true) {
+    SSDataBlock* pBlock = NULL;
+    EXPECT_EQ(pJoinOp->fpSet.getNextFn(pJoinOp, &pBlock), TSDB_CODE_SUCCESS);
+    if (NULL == pBlock) {
+      break;
+    }
+    appendHJoinTestResRows(pBlock, &res);
+  }
+
+  SHJoinOperatorInfo* pJoin = (SHJoinOperatorInfo*)pJoinOp->info;
+  pSpillInfo->spillBuildRows = pJoin->execInfo.spillBuildRows;
+  pSpillInfo->spillPartSplits = pJoin->execInfo.spillPartSplits;
+  pSpillInfo->spillMaxLevel = pJoin->execInfo.spillMaxLevel;
+
+  destroyOperator(pJoinOp);
+  nodesDestroyNode((SNode*)pNode);
+
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+// run the join in memory and with the build side spilled, both against the nested loop join
+void checkHashJoinSpill(EJoinType joinType, int32_t leftRows, int32_t rightRows, int32_t keyRange, int64_t memLimit,
+                        SHJoinTestSpillInfo* pSpillInfo) {
+  std::vector<SHJoinTestRow> leftInput, rightInput;
+  SExecTaskInfo*             pTask = createDummyTaskInfo("hashJoinSpillTest");
+  SHJoinTestSpillInfo        memInfo = {0};
+
+  createHJoinTestBlkList(jtCtx.leftBlkList, LEFT_BLK_ID, leftRows, 100, keyRange, &leftInput);
+  createHJoinTestBlkList(jtCtx.rightBlkList, RIGHT_BLK_ID, rightRows, 100, keyRange, &rightInput);
+
+  std::vector<SHJoinTestRow> expect = getHJoinTestExpectRes(joinType, leftInput, rightInput);
+  std::vector<SHJoinTestRow> memRes = runHashJoinTest(joinType, tsQueryHashJoinMemLimitBytes, pTask, &memInfo);
+  std::vector<SHJoinTestRow> spillRes = runHashJoinTest(joinType, memLimit, pTask, pSpillInfo);
+
+  EXPECT_EQ(memInfo.spillBuildRows, 0);
+  EXPECT_GT(pSpillInfo->spillBuildRows, 0);
+  EXPECT_EQ(memRes.size(), expect.size());
+  EXPECT_TRUE(memRes == expect);
+  EXPECT_EQ(spillRes.size(), memRes.size());
+  EXPECT_TRUE(spillRes == memRes);
+
+  handleTestDone();
+  taosMemoryFree(pTask);
+}
+
+void initHashJoinSpillTest() {
+  if (0 == tsTempDir[0]) {
+    tstrncpy(tsTempDir, TD_TMP_DIR_PATH, PATH_MAX);
+  }
+  ASSERT_EQ(taosMulMkDir(tsTempDir), 0);
+  ASSERT_EQ(osUpdate(), 0);
+}
+
 }  // namespace
 
 #if 1
@@ -3766,7 +3991,42 @@ TEST(leftWinJoin, noCondProjectionTest) {
 
 #endif
 
+TEST(hashJoinSpill, innerJoinTest) {
+  SHJoinTestSpillInfo info = {0};
+  initHashJoinSpillTest();
+
+  // every partition fits the limit once the build side is spilled
+  checkHashJoinSpill(JOIN_TYPE_INNER, 3000, 2000, 300, 1048576, &info);
+  EXPECT_EQ(info.spillPartSplits, 0);
 
+  // the partitions are too large for the limit and split again
+  checkHashJoinSpill(JOIN_TYPE_INNER, 3000, 2000, 300, 1024, &info);
+  EXPECT_GT(info.spillPartSplits, 0);
+}
+
+TEST(hashJoinSpill, leftOuterJoinTest) {
+  SHJoinTestSpillInfo info = {0};
+  initHashJoinSpillTest();
+
+  // the null key rows of the probe side are output as not matched
+  checkHashJoinSpill(JOIN_TYPE_LEFT, 3000, 2000, 300, 1048576, &info);
+  EXPECT_EQ(info.spillPartSplits, 0);
+
+  checkHashJoinSpill(JOIN_TYPE_LEFT, 3000, 2000, 300, 1024, &info);
+  EXPECT_GT(info.spillPartSplits, 0);
+}
+
+TEST(hashJoinSpill, skewedKeyTest) {
+  SHJoinTestSpillInfo info = {0};
+  initHashJoinSpillTest();
+
+  // a key can't be split, its partition goes down to the last level and is loaded anyway
+  checkHashJoinSpill(JOIN_TYPE_INNER, 200, 400, 2, 1024, &info);
+  EXPECT_EQ(info.spillMaxLevel, HJOIN_PART_MAX_LEVEL);
+
+  checkHashJoinSpill(JOIN_TYPE_LEFT, 200, 400, 2, 1024, &info);
+  EXPECT_EQ(info.spillMaxLevel, HJOIN_PART_MAX_LEVEL);
+}
 
 int main(int argc, char** argv) {
   taosSeedRand(taosGetTimestampSec());
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "tdatablock.h"
+#include "tsort.h"
+
+namespace {
+
+const int32_t topKTestNullVal = -1;
+const int32_t topKTestRows = 64;
+
+// a row is (val, id), a null val is topKTestNullVal, id is unique over all the blocks
+typedef std::pair<int32_t, int32_t> STopKTestRow;
+typedef int32_t (*topk_test_val_fn_t)(int32_t blockIdx, int32_t rowIdx);
+
+// the blocks a table scan returns and the SMA of each one, the pruned blocks are counted instead of returned
+typedef struct {
+  std::vector<SSDataBlock*>   blocks;
+  std::vector<SColumnDataAgg> aggs;  // two per block, of the val and the id column
+  int32_t                     next;
+  SSortTopKBound*             pBound;
+  int32_t                     skipped;
+} STopKTestSource;
+
+void topKTestCreateBlocks(STopKTestSource* pSource, int32_t numOfBlocks, topk_test_val_fn_t fp) {
+  for (int32_t b = 0; b < numOfBlocks; ++b) {
+    SSDataBlock* pBlock = NULL;
+    ASSERT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+    for (int16_t c = 0; c < 2; ++c) {
+      SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), c + 1);
+      ASSERT_EQ(blockDataAppendColInfo(pBlock, &col), TSDB_CODE_SUCCESS);
+    }
+    ASSERT_EQ(blockDataEnsureCapacity(pBlock, topKTestRows), TSDB_CODE_SUCCESS);
+
+    SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pId = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnDataAgg   agg[2];
+    memset(agg, 0, sizeof(agg));
+    agg[0].colId = 1;
+    agg[0].min = INT32_MAX;
+    agg[0].max = INT32_MIN;
+    agg[1].colId = 2;
+    for (int32_t i = 0; i < topKTestRows; ++i) {
+      int32_t val = fp(b, i);
+      int32_t id = b * topKTestRows + i;
+      if (val == topKTestNullVal) {
+        colDataSetNULL(pVal, i);
+        agg[0].numOfNull += 1;
+      } else {
+        ASSERT_EQ(colDataSetVal(pVal, i, (const char*)&val, false), TSDB_CODE_SUCCESS);
+        agg[0].min = TMIN(agg[0].min, val);
+        agg[0].max = TMAX(agg[0].max, val);
+        agg[0].sum += val;
+      }
+      ASSERT_EQ(colDataSetVal(pId, i, (const char*)&id, false), TSDB_CODE_SUCCESS);
+    }
+    agg[1].min = b * topKTestRows;
+    agg[1].max = (b + 1) * topKTestRows - 1;
+    pBlock->info.rows = topKTestRows;
+
+    pSource->blocks.push_back(pBlock);
+    pSource->aggs.push_back(agg[0]);
+    pSource->aggs.push_back(agg[1]);
+  }
+}
+
+// the table scan side: skip the blocks whose SMA can not beat the bound kept by the sort
+int32_t topKTestFetch(void* param, SSDataBlock** ppBlock) {
+  STopKTestSource* pSource = (STopKTestSource*)param;
+  *ppBlock = NULL;
+  while (pSource->next < pSource->blocks.size()) {
+    int32_t idx = pSource->next++;
+    if (pSource->pBound != NULL && pSource->pBound->valid &&
+        doPruneBlockByTopKBound(pSource->pBound, &pSource->aggs[idx * 2], pSource->blocks[idx]->info.rows)) {
+      pSource->skipped += 1;
+      continue;
+    }
+    *ppBlock = pSource->blocks[idx];
+    break;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// ORDER BY val, id LIMIT k through the pq sort, with or without the bound shared with the scan
+std::vector<STopKTestRow> runTopKSort(int32_t numOfBlocks, topk_test_val_fn_t fp, int32_t order, bool nullFirst,
+                                      int32_t k, bool prune, int32_t* pSkipped) {
+  std::vector<STopKTestRow> res;
+  STopKTestSource           source;
+  source.next = 0;
+  source.pBound = NULL;
+  source.skipped = 0;
+  topKTestCreateBlocks(&source, numOfBlocks, fp);
+
+  SArray*         pOrderInfo = taosArrayInit(2, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo orderInfo = {0};
+  orderInfo.nullFirst = nullFirst;
+  orderInfo.order = order;
+  for (int32_t i = 0; i < 2; ++i) {
+    orderInfo.slotId = i;
+    EXPECT_NE(taosArrayPush(pOrderInfo, &orderInfo), nullptr);
+  }
+
+  SSortHandle* pHandle = NULL;
+  EXPECT_EQ(tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, -1, -1, NULL, "topKTest", k,
+                                  2 * sizeof(int32_t), 1024 * 1024, &pHandle),
+            TSDB_CODE_SUCCESS);
+  tsortSetForceUsePQSort(pHandle);
+  tsortSetFetchRawDataFp(pHandle, topKTestFetch, NULL, NULL);
+
+  // as setTopKBoundForScan does for a sort on a numeric column read from a table scan
+  SSortTopKBound bound = {0};
+  bound.valid = false;
+  bound.nullFirst = nullFirst;
+  bound.order = order;
+  bound.slotId = 0;
+  bound.type = TSDB_DATA_TYPE_INT;
+  if (prune) {
+    tsortSetTopKBound(pHandle, &bound);
+    source.pBound = &bound;
+  }
+
+  SSortSource* pSortSource = (SSortSource*)taosMemoryCalloc(1, sizeof(SSortSource));
+  pSortSource->param = &source;
+  pSortSource->onlyRef = true;
+  EXPECT_EQ(tsortAddSource(pHandle, pSortSource), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(tsortOpen(pHandle), TSDB_CODE_SUCCESS);
+
+  while (1) {
+    STupleHandle* pTuple = NULL;
+    EXPECT_EQ(tsortNextTuple(pHandle, &pTuple), TSDB_CODE_SUCCESS);
+    if (pTuple == NULL) {
+      break;
+    }
+
+    void* pVal = NULL;
+    void* pId = NULL;
+    tsortGetValue(pTuple, 1, &pId);
+    if (tsortIsNullVal(pTuple, 0)) {
+      res.push_back(STopKTestRow(topKTestNullVal, *(int32_t*)pId));
+    } else {
+      tsortGetValue(pTuple, 0, &pVal);
+      res.push_back(STopKTestRow(*(int32_t*)pVal, *(int32_t*)pId));
+    }
+  }
+
+  tsortDestroySortHandle(pHandle);
+  taosArrayDestroy(pOrderInfo);
+  for (SSDataBlock* pBlock : source.blocks) {
+    blockDataDestroy(pBlock);
+  }
+  *pSkipped = source.skipped;
+  return res;
+}
+
+// the first k rows of a full sort of all the rows
+std::vector<STopKTestRow> getTopKExpectRes(int32_t numOfBlocks, topk_test_val_fn_t fp, int32_t order, bool nullFirst,
+                                           int32_t k) {
+  std::vector<STopKTestRow> rows;
+  for (int32_t b = 0; b < numOfBlocks; ++b) {
+    for (int32_t i = 0; i < topKTestRows; ++i) {
+      rows.push_back(STopKTestRow(fp(b, i), b * topKTestRows + i));
+    }
+  }
+
+  std::sort(rows.begin(), rows.end(), [order, nullFirst](const STopKTestRow& l, const STopKTestRow& r) {
+    bool lNull = (l.first == topKTestNullVal);
+    bool rNull = (r.first == topKTestNullVal);
+    if (lNull != rNull) {
+      return lNull ? nullFirst : !nullFirst;
+    }
+    if (!lNull && l.first != r.first) {
+      return (order == TSDB_ORDER_ASC) ? (l.first < r.first) : (l.first > r.first);
+    }
+    return (order == TSDB_ORDER_ASC) ? (l.second < r.second) : (l.second > r.second);
+  });
+  rows.resize(TMIN(k, rows.size()));
+  return rows;
+}
+
+int32_t checkTopKSort(int32_t numOfBlocks, topk_test_val_fn_t fp, int32_t order, bool nullFirst, int32_t k) {
+  int32_t                   skipped = 0;
+  int32_t                   noPruneSkipped = 0;
+  std::vector<STopKTestRow> expect = getTopKExpectRes(numOfBlocks, fp, order, nullFirst, k);
+
+  EXPECT_EQ(runTopKSort(numOfBlocks, fp, order, nullFirst, k, false, &noPruneSkipped), expect);
+  EXPECT_EQ(noPruneSkipped, 0);
+  EXPECT_EQ(runTopKSort(numOfBlocks, fp, order, nullFirst, k, true, &skipped), expect);
+  return skipped;
+}
+
+// each block holds 13 values repeated, overlapping the next block, and every 7th row is null
+int32_t ascBlockVal(int32_t blockIdx, int32_t rowIdx) {
+  return (rowIdx % 7 == 0) ? topKTestNullVal : blockIdx * 10 + rowIdx % 13;
+}
+
+int32_t descBlockVal(int32_t blockIdx, int32_t rowIdx) {
+  return (rowIdx % 7 == 0) ? topKTestNullVal : (8 - blockIdx) * 10 + rowIdx % 13;
+}
+
+// nulls only in the even blocks, and the 4th block is all null
+int32_t sparseNullBlockVal(int32_t blockIdx, int32_t rowIdx) {
+  if (blockIdx == 3 || (blockIdx % 2 == 0 && rowIdx % 7 == 0)) {
+    return topKTestNullVal;
+  }
+  return blockIdx * 10 + rowIdx % 13;
+}
+
+// the first block is all null, the others have no null
+int32_t nullHeadBlockVal(int32_t blockIdx, int32_t rowIdx) {
+  return (blockIdx == 0) ? topKTestNullVal : blockIdx * 10 + rowIdx % 13;
+}
+
+// the same few values in every block, only ties with the bound
+int32_t tieBlockVal(int32_t blockIdx, int32_t rowIdx) { return rowIdx % 3; }
+
+}  // namespace
+
+TEST(sortTopKTest, ascLimitNullsLast) {
+  EXPECT_GT(checkTopKSort(8, ascBlockVal, TSDB_ORDER_ASC, false, 20), 0);
+  EXPECT_GT(checkTopKSort(8, ascBlockVal, TSDB_ORDER_ASC, false, 1), 0);
+  // the limit is larger than the first block, so the bound is only known after the second one
+  EXPECT_GT(checkTopKSort(8, ascBlockVal, TSDB_ORDER_ASC, false, 100), 0);
+}
+
+TEST(sortTopKTest, descLimitNullsLast) {
+  EXPECT_GT(checkTopKSort(8, descBlockVal, TSDB_ORDER_DESC, false, 20), 0);
+  EXPECT_GT(checkTopKSort(8, descBlockVal, TSDB_ORDER_DESC, false, 100), 0);
+
+  // the best rows come last, nothing can be skipped
+  EXPECT_EQ(checkTopKSort(8, ascBlockVal, TSDB_ORDER_DESC, false, 20), 0);
+}
+
+TEST(sortTopKTest, nullsFirst) {
+  // a block with nulls may always enter the result, only the blocks without nulls are skipped
+  EXPECT_GT(checkTopKSort(8, sparseNullBlockVal, TSDB_ORDER_ASC, true, 20), 0);
+  EXPECT_EQ(checkTopKSort(8, ascBlockVal, TSDB_ORDER_ASC, true, 20), 0);
+
+  // while the kept rows are all null no bound is set
+  EXPECT_EQ(checkTopKSort(8, nullHeadBlockVal, TSDB_ORDER_ASC, true, 20), 0);
+  EXPECT_GT(checkTopKSort(8, nullHeadBlockVal, TSDB_ORDER_ASC, false, 20), 0);
+
+  // an all null block is skipped when nulls go last
+  EXPECT_GT(checkTopKSort(8, sparseNullBlockVal, TSDB_ORDER_ASC, false, 20), 0);
+}
+
+TEST(sortTopKTest, tiesWithBound) {
+  // every block has rows equal to the bound, they are decided by the id and no block is skipped
+  EXPECT_EQ(checkTopKSort(8, tieBlockVal, TSDB_ORDER_ASC, false, 10), 0);
+  EXPECT_EQ(checkTopKSort(8, tieBlockVal, TSDB_ORDER_DESC, false, 10), 0);
+}
+
+#pragma GCC diagnostic pop
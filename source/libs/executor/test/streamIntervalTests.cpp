@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executor.h"
+#include "executorInt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "streamexecutorInt.h"
+#include "tdatablock.h"
+#include "tdef.h"
+
+namespace {
+
+// the fake update info: a table is incremental as long as its ts never goes back
+std::map<uint64_t, TSKEY> gTableMaxTs;
+std::vector<TSKEY>        gCheckedTs;
+
+bool fakeIsIncrementalTimeStamp(SUpdateInfo* pInfo, uint64_t tableId, TSKEY ts, void* pPkVal, int32_t len) {
+  gCheckedTs.push_back(ts);
+  auto it = gTableMaxTs.find(tableId);
+  bool isInc = (it == gTableMaxTs.end() || ts >= it->second);
+  if (isInc) {
+    gTableMaxTs[tableId] = ts;
+  }
+  return isInc;
+}
+
+// the fake stream state: one row buffer for every window of every group
+const int32_t intervalTestRowSize = sizeof(SResultRow) + sizeof(SResultRowEntryInfo) + 2 * sizeof(int64_t);
+std::map<std::pair<uint64_t, TSKEY>, SRowBuffPos*> gWinBuffs;
+
+int32_t fakeStateAddIfNotExist(SStreamState* pState, const SWinKey* key, void** pVal, int32_t* pVLen,
+                               int32_t* pWinCode) {
+  SRowBuffPos*& pPos = gWinBuffs[std::make_pair(key->groupId, key->ts)];
+  *pWinCode = TSDB_CODE_SUCCESS;
+  if (pPos == NULL) {
+    pPos = (SRowBuffPos*)taosMemoryCalloc(1, sizeof(SRowBuffPos));
+    pPos->pRowBuff = taosMemoryCalloc(1, intervalTestRowSize);
+    *pWinCode = TSDB_CODE_FAILED;
+  }
+  *pVal = pPos;
+  *pVLen = intervalTestRowSize;
+  return TSDB_CODE_SUCCESS;
+}
+
+void resetFakeStore() {
+  gTableMaxTs.clear();
+  gCheckedTs.clear();
+  for (auto& w : gWinBuffs) {
+    taosMemoryFree(w.second->pRowBuff);
+    taosMemoryFree(w.second);
+  }
+  gWinBuffs.clear();
+}
+
+// the fake aggregate: the sum and the count of the int column
+int32_t fakeSumInit(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResInfo) {
+  memset(GET_ROWCELL_INTERBUF(pResInfo), 0, 2 * sizeof(int64_t));
+  pResInfo->initialized = true;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t fakeSumProcess(SqlFunctionCtx* pCtx) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  int64_t*              pBuf = (int64_t*)GET_ROWCELL_INTERBUF(GET_RES_INFO(pCtx));
+  for (int32_t i = pInput->startRowIndex; i < pInput->startRowIndex + pInput->numOfRows; ++i) {
+    pBuf[0] += *(int32_t*)colDataGetData(pInput->pData[0], i);
+    pBuf[1] += 1;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+typedef struct {
+  uint64_t groupId;
+  TSKEY    skey;
+  TSKEY    ekey;
+  int64_t  sum;
+  int64_t  count;
+} SIntervalTestWin;
+
+typedef struct {
+  SOperatorInfo               op;
+  SStreamIntervalOperatorInfo info;
+  SExecTaskInfo*              pTaskInfo;
+  SqlFunctionCtx              ctx;
+  SColumnInfoData*            pInputCols[1];
+  int32_t                     rowEntryInfoOffset[1];
+} SIntervalTestOperator;
+
+void initIntervalOperator(SIntervalTestOperator* pOp, uint16_t type, int64_t interval, int64_t waterMark, TSKEY maxTs,
+                          bool ignoreExpiredData) {
+  memset(pOp, 0, sizeof(*pOp));
+  SStreamIntervalOperatorInfo* pInfo = &pOp->info;
+  pInfo->interval.interval = interval;
+  pInfo->interval.sliding = interval;
+  pInfo->interval.intervalUnit = 'a';
+  pInfo->interval.slidingUnit = 'a';
+  pInfo->interval.precision = TSDB_TIME_PRECISION_MILLI;
+  pInfo->twAggSup.waterMark = waterMark;
+  pInfo->twAggSup.maxTs = maxTs;
+  pInfo->twAggSup.calTrigger = STREAM_TRIGGER_AT_ONCE;
+  pInfo->ignoreExpiredData = ignoreExpiredData;
+  pInfo->basic.primaryPkIndex = -1;
+  pInfo->primaryTsIndex = 0;
+  pInfo->delKey.ts = INT64_MAX;
+  pInfo->aggSup.resultRowSize = intervalTestRowSize;
+  pInfo->stateStore.isIncrementalTimeStamp = fakeIsIncrementalTimeStamp;
+  pInfo->stateStore.streamStateAddIfNotExist = fakeStateAddIfNotExist;
+  initResultRowInfo(&pInfo->binfo.resultRowInfo);
+
+  STimeWindow w = {0};
+  EXPECT_EQ(initExecTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &w), TSDB_CODE_SUCCESS);
+  pInfo->pWinRuns = taosArrayInit(4, sizeof(SStreamIntervalRun));
+  pInfo->pUpdatedMap = tSimpleHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+
+  pOp->ctx.functionId = 1;
+  pOp->ctx.fpSet.init = fakeSumInit;
+  pOp->ctx.fpSet.process = fakeSumProcess;
+  pOp->ctx.input.numOfInputCols = 1;
+  pOp->ctx.input.pData = pOp->pInputCols;
+
+  pOp->pTaskInfo = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  pOp->op.operatorType = type;
+  pOp->op.info = pInfo;
+  pOp->op.pTaskInfo = pOp->pTaskInfo;
+  pOp->op.exprSupp.numOfExprs = 1;
+  pOp->op.exprSupp.pCtx = &pOp->ctx;
+  pOp->op.exprSupp.rowEntryInfoOffset = pOp->rowEntryInfoOffset;
+}
+
+void destroyIntervalOperator(SIntervalTestOperator* pOp) {
+  colDataDestroy(&pOp->info.twAggSup.timeWindowData);
+  taosArrayDestroy(pOp->info.pWinRuns);
+  tSimpleHashCleanup(pOp->info.pUpdatedMap);
+  taosMemoryFree(pOp->pTaskInfo);
+}
+
+SSDataBlock* createIntervalBlock(uint64_t uid, uint64_t groupId, const std::vector<TSKEY>& ts) {
+  SSDataBlock* pBlock = NULL;
+  int32_t      code = createDataBlock(&pBlock);
+  EXPECT_EQ(code, TSDB_CODE_SUCCESS);
+
+  SColumnInfoData tsCol = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(TSKEY), 1);
+  SColumnInfoData valCol = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &tsCol), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &valCol), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, ts.size()), TSDB_CODE_SUCCESS);
+
+  SColumnInfoData* pTsCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pValCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = 0; i < ts.size(); ++i) {
+    int32_t val = i + 1;
+    EXPECT_EQ(colDataSetVal(pTsCol, i, (const char*)&ts[i], false), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(colDataSetVal(pValCol, i, (const char*)&val, false), TSDB_CODE_SUCCESS);
+  }
+
+  pBlock->info.rows = ts.size();
+  pBlock->info.id.uid = uid;
+  pBlock->info.id.groupId = groupId;
+  pBlock->info.type = STREAM_NORMAL;
+  pBlock->info.window.skey = *std::min_element(ts.begin(), ts.end());
+  pBlock->info.window.ekey = *std::max_element(ts.begin(), ts.end());
+  return pBlock;
+}
+
+typedef struct {
+  uint64_t           uid;
+  uint64_t           groupId;
+  std::vector<TSKEY> ts;
+} SIntervalTestBlock;
+
+typedef struct {
+  std::vector<SIntervalTestWin>           wins;
+  std::vector<std::pair<uint64_t, TSKEY>> updated;
+  std::vector<TSKEY>                      checked;
+  std::map<uint64_t, TSKEY>               maxTs;
+  TSKEY                                   delKey;
+  int32_t                                 numOfRuns;  // the window runs cut by the append-only path
+} SIntervalTestResult;
+
+// feed the blocks through doStreamIntervalAggImpl of an operator of the given type and collect the window states
+SIntervalTestResult runIntervalOperator(uint16_t type, int64_t interval, int64_t waterMark, TSKEY maxTs,
+                                        bool ignoreExpiredData, const std::vector<SIntervalTestBlock>& blocks) {
+  SIntervalTestOperator op;
+  SIntervalTestResult   res;
+  res.numOfRuns = 0;
+  resetFakeStore();
+  initIntervalOperator(&op, type, interval, waterMark, maxTs, ignoreExpiredData);
+
+  for (auto& b : blocks) {
+    SSDataBlock* pBlock = createIntervalBlock(b.uid, b.groupId, b.ts);
+    op.pInputCols[0] = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    op.ctx.input.totalRows = pBlock->info.rows;
+    EXPECT_EQ(doStreamIntervalAggImpl(&op.op, pBlock, b.groupId, op.info.pUpdatedMap, NULL), TSDB_CODE_SUCCESS);
+    res.numOfRuns += taosArrayGetSize(op.info.pWinRuns);
+    blockDataDestroy(pBlock);
+  }
+
+  for (auto& w : gWinBuffs) {
+    SResultRow* pRow = (SResultRow*)w.second->pRowBuff;
+    int64_t*    pBuf = (int64_t*)GET_ROWCELL_INTERBUF(getResultEntryInfo(pRow, 0, op.rowEntryInfoOffset));
+    res.wins.push_back({w.first.first, pRow->win.skey, pRow->win.ekey, pBuf[0], pBuf[1]});
+  }
+
+  void*   pIte = NULL;
+  int32_t iter = 0;
+  while ((pIte = tSimpleHashIterate(op.info.pUpdatedMap, pIte, &iter)) != NULL) {
+    SWinKey* pKey = (SWinKey*)tSimpleHashGetKey(pIte, NULL);
+    res.updated.push_back(std::make_pair(pKey->groupId, pKey->ts));
+  }
+  std::sort(res.updated.begin(), res.updated.end());
+
+  res.checked = gCheckedTs;
+  res.maxTs = gTableMaxTs;
+  res.delKey = op.info.delKey.ts;
+  destroyIntervalOperator(&op);
+  resetFakeStore();
+  return res;
+}
+
+/*
+ * The semi interval operator of the same tumbling window always takes the general path, and without a primary key in
+ * the destination it does the same per window work as the interval operator. So the two must leave the same window
+ * states, the same updated windows and the same expired checks behind.
+ */
+void compareIntervalPaths(int64_t interval, int64_t waterMark, TSKEY maxTs, bool ignoreExpiredData,
+                          const std::vector<SIntervalTestBlock>& blocks, bool appendOnly = true) {
+  SIntervalTestResult general = runIntervalOperator(QUERY_NODE_PHYSICAL_PLAN_STREAM_SEMI_INTERVAL, interval, waterMark,
+                                                    maxTs, ignoreExpiredData, blocks);
+  SIntervalTestResult fast =
+      runIntervalOperator(QUERY_NODE_PHYSICAL_PLAN_STREAM_INTERVAL, interval, waterMark, maxTs, ignoreExpiredData, blocks);
+
+  ASSERT_EQ(general.wins.size(), fast.wins.size());
+  for (int32_t i = 0; i < general.wins.size(); ++i) {
+    EXPECT_EQ(general.wins[i].groupId, fast.wins[i].groupId);
+    EXPECT_EQ(general.wins[i].skey, fast.wins[i].skey);
+    EXPECT_EQ(general.wins[i].ekey, fast.wins[i].ekey);
+    EXPECT_EQ(general.wins[i].sum, fast.wins[i].sum);
+    EXPECT_EQ(general.wins[i].count, fast.wins[i].count);
+  }
+  EXPECT_EQ(general.updated, fast.updated);
+  EXPECT_EQ(general.checked, fast.checked);
+  EXPECT_EQ(general.maxTs, fast.maxTs);
+  EXPECT_EQ(general.delKey, fast.delKey);
+  EXPECT_EQ(general.numOfRuns, 0);
+  EXPECT_EQ(fast.numOfRuns > 0, appendOnly);
+}
+
+}  // namespace
+
+TEST(streamIntervalTest, appendOnlyDenseRuns) {
+  std::vector<TSKEY> ts;
+  for (TSKEY t = 1000; t < 1500; t += 3) {
+    ts.push_back(t);
+  }
+  compareIntervalPaths(10, 0, INT64_MIN, false, {{1, 1, ts}});
+  compareIntervalPaths(10, 0, INT64_MIN, true, {{1, 1, ts}});
+}
+
+TEST(streamIntervalTest, appendOnlyGapsAndBoundaries) {
+  // rows on the window edges and gaps of many empty windows between the runs
+  std::vector<TSKEY> ts = {1000, 1009, 1010, 1019, 1020, 1500, 1501, 1599, 1600, 9999, 10000, 10001};
+  compareIntervalPaths(10, 0, INT64_MIN, true, {{1, 1, ts}});
+  compareIntervalPaths(100, 0, INT64_MIN, true, {{1, 1, ts}});
+  compareIntervalPaths(1000, 0, INT64_MIN, true, {{1, 1, ts}});
+}
+
+TEST(streamIntervalTest, appendOnlyExpiredRuns) {
+  std::vector<TSKEY> first = {2000, 2001, 2050, 2100, 2190};
+  std::vector<TSKEY> late = {1000, 1005, 1500, 1990, 2000, 2150, 2200, 2300};
+  std::vector<TSKEY> other = {1000, 1100, 2300};
+
+  // the late block of table 1 goes back in time: its windows before maxTs - watermark are dropped by both paths
+  compareIntervalPaths(10, 100, 2200, true, {{1, 1, first}, {1, 1, late}, {2, 1, other}});
+  compareIntervalPaths(100, 500, 2200, true, {{1, 1, first}, {1, 1, late}, {2, 1, other}});
+  compareIntervalPaths(10, 100, 2200, false, {{1, 1, first}, {1, 1, late}, {2, 1, other}});
+}
+
+TEST(streamIntervalTest, appendOnlyGroups) {
+  // two tables of two groups write into the same windows, the window states are kept apart by group
+  std::vector<TSKEY> ts = {1000, 1001, 1010, 1025, 1100};
+  compareIntervalPaths(10, 0, INT64_MIN, true, {{1, 1, ts}, {2, 2, ts}, {3, 1, {1100, 1101, 1200}}});
+}
+
+TEST(streamIntervalTest, appendOnlyDisorderFallsBack) {
+  // a block whose ts goes back is left to the general path before any run is aggregated
+  compareIntervalPaths(10, 0, INT64_MIN, false, {{1, 1, {1000, 1003, 1001, 1020, 1040}}}, false);
+  compareIntervalPaths(10, 0, INT64_MIN, true, {{1, 1, {1000, 1005, 1002, 1007}}}, false);
+}
+
+TEST(streamIntervalTest, appendOnlySingleRow) {
+  compareIntervalPaths(10, 0, INT64_MIN, true, {{1, 1, {1234}}});
+  compareIntervalPaths(10, 0, 5000, true, {{1, 1, {1234}}, {1, 1, {1234}}});
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "querynodes.h"
+
+namespace {
+
+typedef struct {
+  int64_t uid;
+  char*   name;
+  int8_t  type;
+  int64_t suid;
+  int64_t ctime;
+} SSysTestTable;
+
+// the tables of the vnode, the child tables of st1 and st2 are created one by one
+std::vector<SSysTestTable> sysTestTables;
+
+void sysTestInitTables() {
+  sysTestTables.clear();
+  SSysTestTable st1 = {100, "st1", TSDB_SUPER_TABLE, 0, 0};
+  SSysTestTable st2 = {200, "st2", TSDB_SUPER_TABLE, 0, 0};
+  SSysTestTable nt = {300, "nt", TSDB_NORMAL_TABLE, 0, 5};
+  sysTestTables.push_back(st1);
+  sysTestTables.push_back(st2);
+  sysTestTables.push_back(nt);
+  for (int32_t i = 0; i < 20; ++i) {
+    SSysTestTable ct = {1000 + i, "ct", TSDB_CHILD_TABLE, (i % 2 == 0) ? 100 : 200, 10 * i};
+    sysTestTables.push_back(ct);
+  }
+}
+
+void sysTestInitReader(SMetaReader* pReader, void* pVnode, int32_t flags, SStoreMeta* pAPI) {
+  memset(pReader, 0, sizeof(SMetaReader));
+  pReader->pMeta = pVnode;
+  pReader->flags = flags;
+  pReader->pAPI = pAPI;
+}
+
+void sysTestClearReader(SMetaReader* pReader) { memset(&pReader->me, 0, sizeof(pReader->me)); }
+
+int32_t sysTestGetTableEntryByName(SMetaReader* pReader, const char* name) {
+  for (int32_t i = 0; i < sysTestTables.size(); ++i) {
+    if (sysTestTables[i].type != TSDB_CHILD_TABLE && strcmp(sysTestTables[i].name, name) == 0) {
+      pReader->me.uid = sysTestTables[i].uid;
+      pReader->me.type = sysTestTables[i].type;
+      pReader->me.name = sysTestTables[i].name;
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+  return TSDB_CODE_PAR_TABLE_NOT_EXIST;
+}
+
+int32_t sysTestGetChildTableList(void* pVnode, int64_t suid, SArray* list) {
+  for (int32_t i = 0; i < sysTestTables.size(); ++i) {
+    if (sysTestTables[i].type == TSDB_CHILD_TABLE && sysTestTables[i].suid == suid) {
+      if (taosArrayPush(list, &sysTestTables[i].uid) == NULL) {
+        return terrno;
+      }
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// the create time index, walked through instead of seeked
+int32_t sysTestFilterCreateTime(void* pVnode, SMetaFltParam* param, SArray* pUids) {
+  for (int32_t i = 0; i < sysTestTables.size(); ++i) {
+    if (sysTestTables[i].type == TSDB_SUPER_TABLE) {
+      continue;
+    }
+    if (param->filterFunc(&sysTestTables[i].ctime, param->val, param->type) == 0) {
+      if (taosArrayPush(pUids, &sysTestTables[i].uid) == NULL) {
+        return terrno;
+      }
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+void sysTestInitAPI(SStorageAPI* pAPI) {
+  memset(pAPI, 0, sizeof(SStorageAPI));
+  pAPI->metaReaderFn.initReader = sysTestInitReader;
+  pAPI->metaReaderFn.clearReader = sysTestClearReader;
+  pAPI->metaReaderFn.getTableEntryByName = sysTestGetTableEntryByName;
+  pAPI->metaFn.getChildTableList = sysTestGetChildTableList;
+  pAPI->metaFilter.metaFilterCreateTime = sysTestFilterCreateTime;
+}
+
+SNode* sysTestMakeCond(const char* colName, EOperatorType opType, SNode* pValue) {
+  SOperatorNode* pOper = NULL;
+  SColumnNode*   pCol = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_OPERATOR, (SNode**)&pOper), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_COLUMN, (SNode**)&pCol), TSDB_CODE_SUCCESS);
+  tstrncpy(pCol->colName, colName, TSDB_COL_NAME_LEN);
+  pOper->opType = opType;
+  pOper->pLeft = (SNode*)pCol;
+  pOper->pRight = pValue;
+  return (SNode*)pOper;
+}
+
+SNode* sysTestMakeStrCond(const char* colName, const char* val, int8_t type = TSDB_DATA_TYPE_VARCHAR) {
+  SValueNode* pVal = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_VALUE, (SNode**)&pVal), TSDB_CODE_SUCCESS);
+  pVal->node.resType.type = type;
+  pVal->node.resType.bytes = strlen(val) + VARSTR_HEADER_SIZE;
+  pVal->datum.p = (char*)taosMemoryCalloc(1, strlen(val) + VARSTR_HEADER_SIZE + 1);
+  STR_TO_VARSTR(pVal->datum.p, val);
+  return sysTestMakeCond(colName, OP_TYPE_EQUAL, (SNode*)pVal);
+}
+
+SNode* sysTestMakeTsCond(const char* colName, EOperatorType opType, int64_t val) {
+  SValueNode* pVal = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_VALUE, (SNode**)&pVal), TSDB_CODE_SUCCESS);
+  pVal->node.resType.type = TSDB_DATA_TYPE_TIMESTAMP;
+  pVal->node.resType.bytes = sizeof(int64_t);
+  pVal->datum.i = val;
+  return sysTestMakeCond(colName, opType, (SNode*)pVal);
+}
+
+SNode* sysTestMakeAnd(SNode* pLeft, SNode* pRight) {
+  SLogicConditionNode* pCond = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_LOGIC_CONDITION, (SNode**)&pCond), TSDB_CODE_SUCCESS);
+  pCond->condType = LOGIC_COND_TYPE_AND;
+  EXPECT_EQ(nodesListMakeStrictAppend(&pCond->pParameterList, pLeft), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesListMakeStrictAppend(&pCond->pParameterList, pRight), TSDB_CODE_SUCCESS);
+  return (SNode*)pCond;
+}
+
+// the uids listed for the condition, the condition is destroyed
+int32_t sysTestFilter(SNode* pCond, std::vector<int64_t>* pUids) {
+  SStorageAPI api;
+  sysTestInitAPI(&api);
+  SSTabFltArg arg = {0};
+  arg.pAPI = &api;
+
+  SArray* pResult = taosArrayInit(16, sizeof(int64_t));
+  int32_t ret = optSysTabFilte(&arg, pCond, pResult);
+  for (int32_t i = 0; i < taosArrayGetSize(pResult); ++i) {
+    pUids->push_back(*(int64_t*)taosArrayGet(pResult, i));
+  }
+  std::sort(pUids->begin(), pUids->end());
+
+  taosArrayDestroy(pResult);
+  nodesDestroyNode(pCond);
+  return ret;
+}
+
+std::vector<int64_t> sysTestExpect(int64_t suid, int64_t minCtime) {
+  std::vector<int64_t> uids;
+  for (int32_t i = 0; i < sysTestTables.size(); ++i) {
+    if (sysTestTables[i].type == TSDB_CHILD_TABLE && (suid == 0 || sysTestTables[i].suid == suid) &&
+        sysTestTables[i].ctime > minCtime) {
+      uids.push_back(sysTestTables[i].uid);
+    }
+  }
+  std::sort(uids.begin(), uids.end());
+  return uids;
+}
+
+SLimitInfo sysTestLimit(int64_t limit, int64_t offset, int64_t numOfOutputRows) {
+  SLimitInfo info = {0};
+  info.limit.limit = limit;
+  info.limit.offset = offset;
+  info.remainOffset = offset;
+  info.numOfOutputRows = numOfOutputRows;
+  return info;
+}
+
+}  // namespace
+
+TEST(sysScanTest, stableName) {
+  sysTestInitTables();
+
+  std::vector<int64_t> uids;
+  EXPECT_EQ(sysTestFilter(sysTestMakeStrCond("stable_name", "st1"), &uids), 0);
+  EXPECT_EQ(uids, sysTestExpect(100, -1));
+
+  uids.clear();
+  EXPECT_EQ(sysTestFilter(sysTestMakeStrCond("stable_name", "st2"), &uids), 0);
+  EXPECT_EQ(uids, sysTestExpect(200, -1));
+}
+
+TEST(sysScanTest, missingStableName) {
+  sysTestInitTables();
+
+  // a complete but empty uid list, rather than a scan of all tables
+  std::vector<int64_t> uids;
+  EXPECT_EQ(sysTestFilter(sysTestMakeStrCond("stable_name", "st3"), &uids), 0);
+  EXPECT_TRUE(uids.empty());
+
+  // a normal table is no super table either
+  EXPECT_EQ(sysTestFilter(sysTestMakeStrCond("stable_name", "nt"), &uids), 0);
+  EXPECT_TRUE(uids.empty());
+
+  EXPECT_EQ(sysTestFilter(sysTestMakeAnd(sysTestMakeStrCond("stable_name", "st3"),
+                                         sysTestMakeTsCond("create_time", OP_TYPE_GREATER_THAN, 50)),
+                          &uids),
+            0);
+  EXPECT_TRUE(uids.empty());
+}
+
+TEST(sysScanTest, ncharStableName) {
+  sysTestInitTables();
+
+  // not pushed down, the residual filter compares the nchar value
+  std::vector<int64_t> uids;
+  EXPECT_EQ(sysTestFilter(sysTestMakeStrCond("stable_name", "st1", TSDB_DATA_TYPE_NCHAR), &uids), -1);
+  EXPECT_TRUE(uids.empty());
+
+  EXPECT_EQ(sysTestFilter(sysTestMakeAnd(sysTestMakeStrCond("stable_name", "st1", TSDB_DATA_TYPE_NCHAR),
+                                         sysTestMakeTsCond("create_time", OP_TYPE_GREATER_THAN, 50)),
+                          &uids),
+            0);
+  EXPECT_EQ(uids, sysTestExpect(0, 50));
+}
+
+TEST(sysScanTest, stableNameAndCreateTime) {
+  sysTestInitTables();
+
+  std::vector<int64_t> uids;
+  EXPECT_EQ(sysTestFilter(sysTestMakeAnd(sysTestMakeStrCond("stable_name", "st1"),
+                                         sysTestMakeTsCond("create_time", OP_TYPE_GREATER_THAN, 50)),
+                          &uids),
+            0);
+  EXPECT_EQ(uids, sysTestExpect(100, 50));
+
+  uids.clear();
+  EXPECT_EQ(sysTestFilter(sysTestMakeAnd(sysTestMakeTsCond("create_time", OP_TYPE_GREATER_THAN, 120),
+                                         sysTestMakeStrCond("stable_name", "st2")),
+                          &uids),
+            0);
+  EXPECT_EQ(uids, sysTestExpect(200, 120));
+
+  // a condition without index is left to the residual filter
+  uids.clear();
+  EXPECT_EQ(sysTestFilter(sysTestMakeAnd(sysTestMakeStrCond("stable_name", "st2"),
+                                         sysTestMakeStrCond("table_name", "ct")),
+                          &uids),
+            0);
+  EXPECT_EQ(uids, sysTestExpect(200, -1));
+}
+
+TEST(sysScanTest, batchRows) {
+  int32_t capacity = 4096;
+
+  // no limit, or a residual filter that may drop any of the rows
+  SLimitInfo info = sysTestLimit(-1, 0, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), capacity);
+  info = sysTestLimit(10, 0, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, true, capacity), capacity);
+  info = sysTestLimit(10, 20, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, true, capacity), capacity);
+
+  // the rows skipped by the offset are built as well
+  info = sysTestLimit(10, 0, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), 10);
+  info = sysTestLimit(10, 20, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), 30);
+  info = sysTestLimit(10, 20, 0);
+  info.remainOffset = 5;
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), 15);
+  info = sysTestLimit(10, 20, 4);
+  info.remainOffset = 0;
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), 6);
+
+  // never more than the capacity, and at least one row
+  info = sysTestLimit(100000, 10, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), capacity);
+  info = sysTestLimit(10, 0, 10);
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), 1);
+  info = sysTestLimit(0, 0, 0);
+  EXPECT_EQ(sysTableGetBatchRows(&info, false, capacity), 1);
+}
+
+#pragma GCC diagnostic pop
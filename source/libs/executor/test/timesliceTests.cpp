@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+typedef struct {
+  int64_t ts;
+  int32_t val;
+  bool    isNull;
+} STsTestRow;
+
+bool operator==(const STsTestRow& l, const STsTestRow& r) {
+  return l.ts == r.ts && l.isNull == r.isNull && (l.isNull || l.val == r.val);
+}
+
+std::ostream& operator<<(std::ostream& os, const STsTestRow& r) {
+  return os << "{" << r.ts << "," << (r.isNull ? std::string("null") : std::to_string(r.val)) << "}";
+}
+
+std::vector<SSDataBlock*> gTsTestBlocks;
+int32_t                   gTsTestBlockIdx = 0;
+
+int32_t tsTestGetNextBlock(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  *ppRes = (gTsTestBlockIdx < gTsTestBlocks.size()) ? gTsTestBlocks[gTsTestBlockIdx++] : NULL;
+  return TSDB_CODE_SUCCESS;
+}
+
+SSDataBlock* tsTestCreateBlock(const std::vector<STsTestRow>& rows, int32_t start, int32_t end) {
+  SSDataBlock* pBlock = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+  SColumnInfoData tsCol = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  SColumnInfoData valCol = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &tsCol), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &valCol), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, end - start), TSDB_CODE_SUCCESS);
+
+  SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = start; i < end; ++i) {
+    EXPECT_EQ(colDataSetVal(pTs, i - start, (const char*)&rows[i].ts, false), TSDB_CODE_SUCCESS);
+    if (rows[i].isNull) {
+      colDataSetNULL(pVal, i - start);
+    } else {
+      EXPECT_EQ(colDataSetVal(pVal, i - start, (const char*)&rows[i].val, false), TSDB_CODE_SUCCESS);
+    }
+  }
+  pBlock->info.rows = end - start;
+  return pBlock;
+}
+
+// split the rows into blocks ending after the given rows
+void tsTestSetBlocks(const std::vector<STsTestRow>& rows, const std::vector<int32_t>& ends) {
+  int32_t start = 0;
+  for (int32_t end : ends) {
+    gTsTestBlocks.push_back(tsTestCreateBlock(rows, start, end));
+    start = end;
+  }
+  if (start < rows.size()) {
+    gTsTestBlocks.push_back(tsTestCreateBlock(rows, start, rows.size()));
+  }
+}
+
+void tsTestClearBlocks() {
+  for (SSDataBlock* pBlock : gTsTestBlocks) {
+    blockDataDestroy(pBlock);
+  }
+  gTsTestBlocks.clear();
+  gTsTestBlockIdx = 0;
+}
+
+SColumnNode* tsTestCreateColumn(int16_t slotId, int8_t type) {
+  SColumnNode* pCol = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_COLUMN, (SNode**)&pCol), TSDB_CODE_SUCCESS);
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = tDataTypes[type].bytes;
+  return pCol;
+}
+
+STargetNode* tsTestCreateFuncTarget(int16_t slotId, const char* name, int8_t type, SNode* pParam) {
+  SFunctionNode* pFunc = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_FUNCTION, (SNode**)&pFunc), TSDB_CODE_SUCCESS);
+  tstrncpy(pFunc->functionName, name, sizeof(pFunc->functionName));
+  pFunc->funcId = fmGetFuncId(name);
+  pFunc->funcType = (0 == strcmp(name, "interp")) ? FUNCTION_TYPE_INTERP : FUNCTION_TYPE_IROWTS;
+  pFunc->node.resType.type = type;
+  pFunc->node.resType.bytes = tDataTypes[type].bytes;
+  if (pParam != NULL) {
+    EXPECT_EQ(nodesListMakeStrictAppend(&pFunc->pParameterList, pParam), TSDB_CODE_SUCCESS);
+  }
+
+  STargetNode* pTarget = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_TARGET, (SNode**)&pTarget), TSDB_CODE_SUCCESS);
+  pTarget->slotId = slotId;
+  pTarget->pExpr = (SNode*)pFunc;
+  return pTarget;
+}
+
+// select _irowts, interp(val) range(skey, ekey) every(interval) fill(mode)
+SInterpFuncPhysiNode* tsTestCreatePhysiNode(EFillMode mode, int64_t skey, int64_t ekey, int64_t interval) {
+  SInterpFuncPhysiNode* pNode = NULL;
+  SDataBlockDescNode*   pDesc = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_INTERP_FUNC, (SNode**)&pNode), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_DATABLOCK_DESC, (SNode**)&pDesc), TSDB_CODE_SUCCESS);
+  for (int16_t i = 0; i < 2; ++i) {
+    SSlotDescNode* pSlot = NULL;
+    EXPECT_EQ(nodesMakeNode(QUERY_NODE_SLOT_DESC, (SNode**)&pSlot), TSDB_CODE_SUCCESS);
+    pSlot->slotId = i;
+    pSlot->output = true;
+    pSlot->dataType.type = (0 == i) ? TSDB_DATA_TYPE_TIMESTAMP : TSDB_DATA_TYPE_INT;
+    pSlot->dataType.bytes = tDataTypes[pSlot->dataType.type].bytes;
+    EXPECT_EQ(nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot), TSDB_CODE_SUCCESS);
+  }
+  pNode->node.pOutputDataBlockDesc = pDesc;
+
+  EXPECT_EQ(nodesListMakeStrictAppend(
+                &pNode->pFuncs, (SNode*)tsTestCreateFuncTarget(0, "_irowts", TSDB_DATA_TYPE_TIMESTAMP, NULL)),
+            TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesListMakeStrictAppend(&pNode->pFuncs,
+                                      (SNode*)tsTestCreateFuncTarget(1, "interp", TSDB_DATA_TYPE_INT,
+                                                                     (SNode*)tsTestCreateColumn(1, TSDB_DATA_TYPE_INT))),
+            TSDB_CODE_SUCCESS);
+  pNode->pTimeSeries = (SNode*)tsTestCreateColumn(0, TSDB_DATA_TYPE_TIMESTAMP);
+
+  if (mode == FILL_MODE_VALUE || mode == FILL_MODE_VALUE_F) {
+    SNodeListNode* pValues = NULL;
+    SValueNode*    pVal = NULL;
+    EXPECT_EQ(nodesMakeNode(QUERY_NODE_NODE_LIST, (SNode**)&pValues), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(nodesMakeNode(QUERY_NODE_VALUE, (SNode**)&pVal), TSDB_CODE_SUCCESS);
+    pVal->node.resType.type = TSDB_DATA_TYPE_BIGINT;
+    pVal->node.resType.bytes = sizeof(int64_t);
+    pVal->datum.i = -999;
+    EXPECT_EQ(nodesListMakeStrictAppend(&pValues->pNodeList, (SNode*)pVal), TSDB_CODE_SUCCESS);
+    pNode->pFillValues = (SNode*)pValues;
+  }
+
+  pNode->fillMode = mode;
+  pNode->timeRange.skey = skey;
+  pNode->timeRange.ekey = ekey;
+  pNode->interval = interval;
+  return pNode;
+}
+
+// run the interp query over the blocks set before, generating the gaps at once or point by point
+std::vector<STsTestRow> tsTestRun(EFillMode mode, int64_t skey, int64_t ekey, int64_t interval, bool batch) {
+  std::vector<STsTestRow> res;
+  gTsTestBlockIdx = 0;
+
+  SStorageAPI    storageAPI = {0};
+  SExecTaskInfo* pTask = NULL;
+  EXPECT_EQ(doCreateTask(1, 1, 1, OPTR_EXEC_MODEL_BATCH, &storageAPI, &pTask), TSDB_CODE_SUCCESS);
+
+  SOperatorInfo* pDownstream = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pDownstream->fpSet.getNextFn = tsTestGetNextBlock;
+
+  SInterpFuncPhysiNode* pNode = tsTestCreatePhysiNode(mode, skey, ekey, interval);
+  SOperatorInfo*        pOperator = NULL;
+  EXPECT_EQ(createTimeSliceOperatorInfo(pDownstream, (SPhysiNode*)pNode, pTask, &pOperator), TSDB_CODE_SUCCESS);
+  pTask->pRoot = pOperator;
+
+  STimeSliceOperatorInfo* pInfo = (STimeSliceOperatorInfo*)pOperator->info;
+  EXPECT_TRUE(pInfo->batchInterp);
+  pInfo->batchInterp = batch;
+
+  while (1) {
+    SSDataBlock* pBlock = NULL;
+    EXPECT_EQ(pOperator->fpSet.getNextFn(pOperator, &pBlock), TSDB_CODE_SUCCESS);
+    if (NULL == pBlock) {
+      break;
+    }
+
+    SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      STsTestRow row = {*(int64_t*)colDataGetData(pTs, i), 0, colDataIsNull_s(pVal, i)};
+      if (!row.isNull) {
+        row.val = *(int32_t*)colDataGetData(pVal, i);
+      }
+      res.push_back(row);
+    }
+  }
+
+  doDestroyTask(pTask);
+  nodesDestroyNode((SNode*)pNode);
+  return res;
+}
+
+// the gaps generated at once must give the results of the point by point generation
+void tsTestCompare(int64_t skey, int64_t ekey, int64_t interval) {
+  EFillMode modes[] = {FILL_MODE_PREV, FILL_MODE_NEXT, FILL_MODE_NULL, FILL_MODE_NULL_F, FILL_MODE_VALUE,
+                       FILL_MODE_VALUE_F};
+  for (EFillMode mode : modes) {
+    std::vector<STsTestRow> expect = tsTestRun(mode, skey, ekey, interval, false);
+    std::vector<STsTestRow> res = tsTestRun(mode, skey, ekey, interval, true);
+    EXPECT_FALSE(expect.empty());
+    EXPECT_EQ(res, expect) << "fill mode:" << mode;
+
+    // every grid point of the range has a result unless there is no row to fill it with
+    if (mode != FILL_MODE_PREV && mode != FILL_MODE_NEXT) {
+      EXPECT_EQ(res.size(), (ekey - skey) / interval + 1);
+    }
+  }
+}
+
+// rows at and between the grid points, with gaps of various length and duplicated timestamps
+std::vector<STsTestRow> tsTestCreateRows(int64_t start, int64_t end, int32_t* pDupIndex) {
+  std::vector<STsTestRow> rows;
+  int64_t                 steps[] = {3, 7, 10, 10, 25, 60, 130};
+  int64_t                 ts = start;
+  *pDupIndex = -1;
+  for (int32_t i = 0; ts <= end; ++i) {
+    STsTestRow row = {ts, i, i % 7 == 3};
+    rows.push_back(row);
+    if (i % 9 == 4) {
+      // a duplicated timestamp with another value, only the first row counts
+      row.val = -i;
+      rows.push_back(row);
+      if (*pDupIndex < 0 && i > 10) {
+        *pDupIndex = rows.size() - 1;
+      }
+    }
+    ts += steps[taosRand() % (sizeof(steps) / sizeof(steps[0]))];
+  }
+  return rows;
+}
+
+}  // namespace
+
+TEST(timesliceTest, fillGapsOneBlock) {
+  int32_t                 dupIndex = 0;
+  std::vector<STsTestRow> rows = tsTestCreateRows(-35, 1100, &dupIndex);
+  tsTestSetBlocks(rows, {});
+  tsTestCompare(0, 1000, 10);
+  tsTestClearBlocks();
+}
+
+TEST(timesliceTest, fillGapsBlockBoundaries) {
+  int32_t                 dupIndex = 0;
+  std::vector<STsTestRow> rows = tsTestCreateRows(-35, 1100, &dupIndex);
+  ASSERT_GT(dupIndex, 0);
+
+  // blocks of one row, a block boundary between duplicated timestamps and blocks of random size
+  std::vector<int32_t> ends = {1, 2, 3, dupIndex};
+  for (int32_t end = dupIndex + 1; end < rows.size(); end += 1 + taosRand() % 20) {
+    ends.push_back(end);
+  }
+  tsTestSetBlocks(rows, ends);
+  tsTestCompare(0, 1000, 10);
+  tsTestClearBlocks();
+}
+
+TEST(timesliceTest, fillGapsBeyondCapacity) {
+  // a single gap of more grid points than the result block holds, filled up to the end of the range
+  std::vector<STsTestRow> rows = {{-5, 1, false}, {0, 2, false}, {3, 3, true}, {20000, 4, false}, {20000, 5, false}};
+  tsTestSetBlocks(rows, {2, 3});
+  tsTestCompare(0, 50000, 1);
+  tsTestClearBlocks();
+}
+
+#pragma GCC diagnostic pop
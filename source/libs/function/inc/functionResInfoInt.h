@@ -28,11 +28,15 @@ extern "C" {
 
 #define USE_ARRAYLIST
 
-#define HLL_BUCKET_BITS 14  // The bits of the bucket
-#define HLL_DATA_BITS   (64 - HLL_BUCKET_BITS)
-#define HLL_BUCKETS     (1 << HLL_BUCKET_BITS)
-#define HLL_BUCKET_MASK (HLL_BUCKETS - 1)
-#define HLL_ALPHA_INF   0.721347520444481703680  // constant for 0.5/ln(2)
+#define HLL_BUCKET_BITS        14  // The bits of the bucket
+#define HLL_DATA_BITS          (64 - HLL_BUCKET_BITS)
+#define HLL_BUCKETS            (1 << HLL_BUCKET_BITS)
+#define HLL_BUCKET_MASK        (HLL_BUCKETS - 1)
+#define HLL_ALPHA_INF          0.721347520444481703680  // constant for 0.5/ln(2)
+#define HLL_SPARSE_MAX_ENTRIES (HLL_BUCKETS >> 3)       // sparse partial result is at most half of the dense one
+#define HLL_SPARSE_TAG         0x01534C48               // "HLS" and the version 1 of the sparse partial result
+
+#define PERCENTILE_MAX_PIVOTS 32
 
 typedef struct SSumRes {
   union {
@@ -120,6 +124,16 @@ typedef struct SHLLFuncInfo {
   uint8_t  buckets[HLL_BUCKETS];
 } SHLLInfo;
 
+// the partial result of a group with few non-empty buckets, told apart from SHLLInfo by its length and checked by
+// its tag, so that an unknown encoding is rejected instead of being merged as buckets
+typedef struct SHLLSparseInfo {
+  uint32_t tag;  // HLL_SPARSE_TAG
+  uint32_t numOfEntries;
+  uint64_t result;
+  uint64_t totalCount;
+  uint32_t entries[];  // (bucket index << 8) | bucket value, in ascending order of the bucket index
+} SHLLSparseInfo;
+
 typedef struct SGroupKeyInfo {
   bool hasResult;
   bool isNull;
@@ -206,6 +220,10 @@ typedef struct tMemBucket {
   SDiskbasedBuf     *pBuffer;
   __perc_hash_func_t hashFunc;
   SHashObj          *groupPagesMap;  // disk page map for different groups;
+  double            *pValues;        // all values kept in memory if they fit, no slot or disk page is used then
+  int32_t            capacity;
+  int32_t            numOfPivots;
+  int32_t            pivots[PERCENTILE_MAX_PIVOTS];  // positions already holding their sorted value in pValues
 } tMemBucket;
 
 typedef struct SPercentileInfo {
@@ -25,8 +25,12 @@ extern "C" {
 
 struct tMemBucket;
 
-int32_t tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, double maxval, bool hasWindowOrGroup,
-                         struct tMemBucket **pBucket);
+/**
+ * @param numOfElems the expected number of values, they are kept in memory and selected directly if they fit in the
+ *                   memory that the disk based buffer of the buckets would take
+ */
+int32_t tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, double maxval, int64_t numOfElems,
+                         bool hasWindowOrGroup, struct tMemBucket **pBucket);
 
 void tMemBucketDestroy(struct tMemBucket **pBucket);
 
@@ -34,8 +38,12 @@ int32_t tMemBucketPut(struct tMemBucket *pBucket, const void *data, size_t size)
 
 int32_t getPercentile(struct tMemBucket *pMemBucket, double percent, double *result);
 
-#endif  // TDENGINE_TPERCENTILE_H
+int32_t selectKthValue(double *v, int32_t lo, int32_t hi, int32_t k);
+
+int32_t selectKthValueInMem(struct tMemBucket *pMemBucket, int32_t k, double *result);
 
 #ifdef __cplusplus
 }
 #endif
+
+#endif  // TDENGINE_TPERCENTILE_H
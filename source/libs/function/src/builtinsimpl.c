@@ -1805,7 +1805,8 @@ int32_t percentileFunction(SqlFunctionCtx* pCtx) {
       pResInfo->complete = true;
       return TSDB_CODE_SUCCESS;
     } else {
-      code = tMemBucketCreate(pCol->info.bytes, type, pInfo->minval, pInfo->maxval, pCtx->hasWindowOrGroup, &pInfo->pMemBucket);
+      code = tMemBucketCreate(pCol->info.bytes, type, pInfo->minval, pInfo->maxval, pInfo->numOfElems,
+                              pCtx->hasWindowOrGroup, &pInfo->pMemBucket);
       if (TSDB_CODE_SUCCESS != code) {
         return code;
       }
@@ -4803,19 +4804,21 @@ bool getHLLFuncEnv(SFunctionNode* UNUSED_PARAM(pFunc), SFuncExecEnv* pEnv) {
   return true;
 }
 
-static uint8_t hllCountNum(void* data, int32_t bytes, int32_t* buk) {
-  uint64_t hash = MurmurHash3_64(data, bytes);
-  int32_t  index = hash & HLL_BUCKET_MASK;
-  hash >>= HLL_BUCKET_BITS;
-  hash |= ((uint64_t)1 << HLL_DATA_BITS);
-  uint64_t bit = 1;
-  uint8_t  count = 1;
-  while ((hash & bit) == 0) {
-    count++;
-    bit <<= 1;
+#define HLL_HASH_BATCH 256
+
+static FORCE_INLINE void hllUpdateBucket(uint8_t* buckets, uint64_t hash) {
+  int32_t index = hash & HLL_BUCKET_MASK;
+  // the position of the lowest set bit in the remaining bits, starting from 1
+  uint8_t count = (uint8_t)BUILDIN_CTZL((hash >> HLL_BUCKET_BITS) | ((uint64_t)1 << HLL_DATA_BITS)) + 1;
+  if (count > buckets[index]) {
+    buckets[index] = count;
+  }
+}
+
+static void hllUpdateBuckets(uint8_t* buckets, const uint64_t* pHash, int32_t num) {
+  for (int32_t i = 0; i < num; ++i) {
+    hllUpdateBucket(buckets, pHash[i]);
   }
-  *buk = index;
-  return count;
 }
 
 static void hllBucketHisto(uint8_t* buckets, int32_t* bucketHisto) {
@@ -4903,6 +4906,25 @@ int32_t hllFunction(SqlFunctionCtx* pCtx) {
     goto _hll_over;
   }
 
+  // hash a batch of rows first and then update the buckets, so that the hash loop does not wait on the random
+  // accesses of the buckets
+  uint64_t hash[HLL_HASH_BATCH];
+  int32_t  num = 0;
+
+  if (!pCol->hasNull && !IS_VAR_DATA_TYPE(type)) {
+    const char* pData = pCol->pData + (size_t)start * bytes;
+    for (int32_t i = 0; i < numOfRows; i += HLL_HASH_BATCH) {
+      num = TMIN(HLL_HASH_BATCH, numOfRows - i);
+      for (int32_t j = 0; j < num; ++j) {
+        hash[j] = MurmurHash3_64(pData + (size_t)(i + j) * bytes, bytes);
+      }
+      hllUpdateBuckets(pInfo->buckets, hash, num);
+    }
+
+    numOfElems = numOfRows;
+    goto _hll_over;
+  }
+
   for (int32_t i = start; i < numOfRows + start; ++i) {
     if (pCol->hasNull && colDataIsNull_s(pCol, i)) {
       continue;
@@ -4916,14 +4938,15 @@ int32_t hllFunction(SqlFunctionCtx* pCtx) {
       data = varDataVal(data);
     }
 
-    int32_t index = 0;
-    uint8_t count = hllCountNum(data, bytes, &index);
-    uint8_t oldcount = pInfo->buckets[index];
-    if (count > oldcount) {
-      pInfo->buckets[index] = count;
+    hash[num++] = MurmurHash3_64(data, bytes);
+    if (num == HLL_HASH_BATCH) {
+      hllUpdateBuckets(pInfo->buckets, hash, num);
+      num = 0;
     }
   }
 
+  hllUpdateBuckets(pInfo->buckets, hash, num);
+
 _hll_over:
   pInfo->totalCount += numOfElems;
 
@@ -4937,14 +4960,74 @@ _hll_over:
 }
 
 static void hllTransferInfo(SHLLInfo* pInput, SHLLInfo* pOutput) {
-  for (int32_t k = 0; k < HLL_BUCKETS; ++k) {
-    if (pOutput->buckets[k] < pInput->buckets[k]) {
-      pOutput->buckets[k] = pInput->buckets[k];
+  if (!(tsAVX2Supported && tsSIMDEnable) ||
+      u8VectorMaxAVX2(pOutput->buckets, pInput->buckets, HLL_BUCKETS) != TSDB_CODE_SUCCESS) {
+    for (int32_t k = 0; k < HLL_BUCKETS; ++k) {
+      if (pOutput->buckets[k] < pInput->buckets[k]) {
+        pOutput->buckets[k] = pInput->buckets[k];
+      }
     }
   }
   pOutput->totalCount += pInput->totalCount;
 }
 
+// the input is not aligned, it is the payload of a var data column
+static int32_t hllTransferSparseInfo(const char* pInput, int32_t len, SHLLInfo* pOutput) {
+  SHLLSparseInfo header = {0};
+  if (len < (int32_t)sizeof(SHLLSparseInfo)) {
+    return TSDB_CODE_FUNC_FUNTION_PARA_VALUE;
+  }
+
+  (void)memcpy(&header, pInput, sizeof(SHLLSparseInfo));
+  if (header.tag != HLL_SPARSE_TAG || header.numOfEntries > HLL_SPARSE_MAX_ENTRIES ||
+      len != (int32_t)(sizeof(SHLLSparseInfo) + header.numOfEntries * sizeof(uint32_t))) {
+    return TSDB_CODE_FUNC_FUNTION_PARA_VALUE;
+  }
+
+  const char* pEntries = pInput + sizeof(SHLLSparseInfo);
+  for (int32_t k = 0; k < header.numOfEntries; ++k) {
+    uint32_t entry = 0;
+    (void)memcpy(&entry, pEntries + k * sizeof(uint32_t), sizeof(uint32_t));
+
+    int32_t index = (entry >> 8) & HLL_BUCKET_MASK;
+    uint8_t count = entry & 0xFF;
+    if (pOutput->buckets[index] < count) {
+      pOutput->buckets[index] = count;
+    }
+  }
+  pOutput->totalCount += header.totalCount;
+  return TSDB_CODE_SUCCESS;
+}
+
+// encode the non-empty buckets only, return the encoded length, or -1 if there are too many of them
+static int32_t hllEncodeSparseInfo(const SHLLInfo* pInfo, SHLLSparseInfo* pSparse) {
+  int32_t num = 0;
+
+  for (int32_t j = 0; j < HLL_BUCKETS >> 3; ++j) {
+    uint64_t word = 0;
+    (void)memcpy(&word, pInfo->buckets + (j << 3), sizeof(uint64_t));
+    if (word == 0) {
+      continue;
+    }
+
+    for (int32_t k = j << 3; k < (j + 1) << 3; ++k) {
+      if (pInfo->buckets[k] == 0) {
+        continue;
+      }
+      if (num >= HLL_SPARSE_MAX_ENTRIES) {
+        return -1;
+      }
+      pSparse->entries[num++] = ((uint32_t)k << 8) | pInfo->buckets[k];
+    }
+  }
+
+  pSparse->tag = HLL_SPARSE_TAG;
+  pSparse->numOfEntries = num;
+  pSparse->result = pInfo->result;
+  pSparse->totalCount = pInfo->totalCount;
+  return (int32_t)(sizeof(SHLLSparseInfo) + num * sizeof(uint32_t));
+}
+
 int32_t hllFunctionMerge(SqlFunctionCtx* pCtx) {
   SInputColumnInfoData* pInput = &pCtx->input;
   SColumnInfoData*      pCol = pInput->pData[0];
@@ -4964,9 +5047,16 @@ int32_t hllFunctionMerge(SqlFunctionCtx* pCtx) {
 
   for (int32_t i = start; i < start + pInput->numOfRows; ++i) {
     if (colDataIsNull_s(pCol, i)) continue;
-    char*     data = colDataGetData(pCol, i);
-    SHLLInfo* pInputInfo = (SHLLInfo*)varDataVal(data);
-    hllTransferInfo(pInputInfo, pInfo);
+    char*   data = colDataGetData(pCol, i);
+    int32_t len = varDataLen(data);
+    if (len == getHLLInfoSize()) {
+      hllTransferInfo((SHLLInfo*)varDataVal(data), pInfo);
+    } else {
+      int32_t code = hllTransferSparseInfo(varDataVal(data), len, pInfo);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    }
   }
 
   if (pInfo->totalCount == 0 && !tsCountAlwaysReturnValue) {
@@ -4999,8 +5089,18 @@ int32_t hllPartialFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
   if (NULL == res) {
     return terrno;
   }
-  (void)memcpy(varDataVal(res), pInfo, resultBytes);
-  varDataSetLen(res, resultBytes);
+
+  // most groups of a high cardinality partition see a few values only, ship their non-empty buckets only. The payload
+  // of the var data is not aligned, so the entries are encoded aside and copied.
+  uint64_t sparse[(sizeof(SHLLSparseInfo) + HLL_SPARSE_MAX_ENTRIES * sizeof(uint32_t)) / sizeof(uint64_t)];
+  int32_t  len = hllEncodeSparseInfo(pInfo, (SHLLSparseInfo*)sparse);
+  if (len < 0) {
+    (void)memcpy(varDataVal(res), pInfo, resultBytes);
+    len = resultBytes;
+  } else {
+    (void)memcpy(varDataVal(res), sparse, len);
+  }
+  varDataSetLen(res, len);
 
   int32_t          slotId = pCtx->pExpr->base.resSchema.slotId;
   int32_t          code = TSDB_CODE_SUCCESS;
@@ -225,3 +225,27 @@ int32_t doubleVectorCmpAVX2(const double* pData, int32_t numOfRows, bool isMinFu
   return TSDB_CODE_OPS_NOT_SUPPORT;
 #endif
 }
+
+// element-wise max of two uint8 arrays, the result is kept in pDst
+int32_t u8VectorMaxAVX2(uint8_t* pDst, const uint8_t* pSrc, int32_t num) {
+#ifdef __AVX2__
+  const int32_t width = 256 >> 3u;
+
+  int32_t i = 0;
+  for (; i + width <= num; i += width) {
+    __m256i a = _mm256_lddqu_si256((const __m256i*)(pDst + i));
+    __m256i b = _mm256_lddqu_si256((const __m256i*)(pSrc + i));
+    _mm256_storeu_si256((__m256i*)(pDst + i), _mm256_max_epu8(a, b));
+  }
+
+  for (; i < num; ++i) {
+    if (pDst[i] < pSrc[i]) {
+      pDst[i] = pSrc[i];
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+#else
+  uError("unable run %s without avx2 instructions", __func__);
+  return TSDB_CODE_OPS_NOT_SUPPORT;
+#endif
+}
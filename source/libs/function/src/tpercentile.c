@@ -114,6 +114,11 @@ int32_t findOnlyResult(tMemBucket *pMemBucket, double *result) {
   }
   terrno = 0;
 
+  if (pMemBucket->pValues != NULL) {
+    *result = pMemBucket->pValues[0];
+    return TSDB_CODE_SUCCESS;
+  }
+
   for (int32_t i = 0; i < pMemBucket->numOfSlots; ++i) {
     tMemBucketSlot *pSlot = &pMemBucket->pSlots[i];
     if (pSlot->info.size == 0) {
@@ -266,8 +271,8 @@ static void resetSlotInfo(tMemBucket *pBucket) {
   }
 }
 
-int32_t tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, double maxval, bool hasWindowOrGroup,
-                         tMemBucket **pBucket) {
+int32_t tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, double maxval, int64_t numOfElems,
+                         bool hasWindowOrGroup, tMemBucket **pBucket) {
   *pBucket = (tMemBucket *)taosMemoryCalloc(1, sizeof(tMemBucket));
   if (*pBucket == NULL) {
     return terrno;
@@ -299,6 +304,18 @@ int32_t tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, dou
     return TSDB_CODE_FUNC_INVALID_VALUE_RANGE;
   }
 
+  // no more memory than the page cache of the disk based buffer is used to keep all values
+  int64_t memLimit = (int64_t)(*pBucket)->bufPageSize * DEFAULT_NUM_OF_SLOT * 4;
+  if (numOfElems > 0 && numOfElems * (int64_t)sizeof(double) <= memLimit) {
+    (*pBucket)->pValues = taosMemoryMalloc(numOfElems * sizeof(double));
+    if ((*pBucket)->pValues == NULL) {
+      tMemBucketDestroy(pBucket);
+      return terrno;
+    }
+    (*pBucket)->capacity = (int32_t)numOfElems;
+    return TSDB_CODE_SUCCESS;
+  }
+
   (*pBucket)->elemPerPage = ((*pBucket)->bufPageSize - sizeof(SFilePage)) / (*pBucket)->bytes;
   (*pBucket)->comparFn = getKeyComparFunc((*pBucket)->type, TSDB_ORDER_ASC);
 
@@ -346,6 +363,7 @@ void tMemBucketDestroy(tMemBucket **pBucket) {
   }
 
   destroyDiskbasedBuf((*pBucket)->pBuffer);
+  taosMemoryFreeClear((*pBucket)->pValues);
   taosMemoryFreeClear((*pBucket)->pSlots);
   taosHashCleanup((*pBucket)->groupPagesMap);
   taosMemoryFreeClear(*pBucket);
@@ -392,10 +410,39 @@ int32_t tMemBucketUpdateBoundingBox(MinMaxEntry *r, const char *data, int32_t da
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t tMemBucketPutInMem(tMemBucket *pBucket, const void *data, size_t size) {
+  if (pBucket->total + size > pBucket->capacity) {
+    int64_t capacity = TMAX((int64_t)pBucket->capacity * 2, (int64_t)(pBucket->total + size));
+    if (capacity > INT32_MAX) {
+      return TSDB_CODE_OUT_OF_RANGE;
+    }
+
+    double *p = taosMemoryRealloc(pBucket->pValues, capacity * sizeof(double));
+    if (p == NULL) {
+      return terrno;
+    }
+    pBucket->pValues = p;
+    pBucket->capacity = (int32_t)capacity;
+  }
+
+  double *pDst = pBucket->pValues + pBucket->total;
+  for (int32_t i = 0; i < size; ++i) {
+    GET_TYPED_DATA(pDst[i], double, pBucket->type, (char *)data + i * pBucket->bytes);
+  }
+
+  pBucket->total += size;
+  pBucket->numOfPivots = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
 /*
  * in memory bucket, we only accept data array list
  */
 int32_t tMemBucketPut(tMemBucket *pBucket, const void *data, size_t size) {
+  if (pBucket->pValues != NULL) {
+    return tMemBucketPutInMem(pBucket, data, size);
+  }
+
   int32_t count = 0;
   int32_t bytes = pBucket->bytes;
   int32_t code = TSDB_CODE_SUCCESS;
@@ -512,7 +559,123 @@ static double getIdenticalDataVal(tMemBucket *pMemBucket, int32_t slotIndex) {
   return finalResult;
 }
 
+static int32_t compareDoubleValExt(const void *pLeft, const void *pRight, const void *param) {
+  return compareDoubleVal(pLeft, pRight);
+}
+
+static FORCE_INLINE void swapDoubleVal(double *a, double *b) {
+  double t = *a;
+  *a = *b;
+  *b = t;
+}
+
+/*
+ * Move the k-th smallest value of v[lo, hi) to v[k], with all values before it not greater and all values after it
+ * not smaller. Quick select with a median of three pivot, the range is sorted instead once the partition goes on for
+ * too many rounds, which bounds the worst case.
+ */
+int32_t selectKthValue(double *v, int32_t lo, int32_t hi, int32_t k) {
+  int32_t depth = 0;
+  for (int32_t n = hi - lo; n > 0; n >>= 1) {
+    depth += 2;
+  }
+
+  while (hi - lo > 16) {
+    if (depth-- == 0) {
+      return taosqsort(v + lo, hi - lo, sizeof(double), NULL, compareDoubleValExt);
+    }
+
+    int32_t mid = lo + ((hi - lo) >> 1);
+    if (v[mid] < v[lo]) swapDoubleVal(&v[mid], &v[lo]);
+    if (v[hi - 1] < v[lo]) swapDoubleVal(&v[hi - 1], &v[lo]);
+    if (v[hi - 1] < v[mid]) swapDoubleVal(&v[hi - 1], &v[mid]);
+
+    double  pivot = v[mid];
+    int32_t i = lo, j = hi - 1;
+    while (i <= j) {
+      while (v[i] < pivot) i++;
+      while (v[j] > pivot) j--;
+      if (i <= j) {
+        swapDoubleVal(&v[i], &v[j]);
+        i++;
+        j--;
+      }
+    }
+
+    // v[lo, j] <= pivot, v[i, hi) >= pivot, and the values in between equal to the pivot
+    if (k <= j) {
+      hi = j + 1;
+    } else if (k >= i) {
+      lo = i;
+    } else {
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  for (int32_t i = lo + 1; i < hi; ++i) {
+    double  t = v[i];
+    int32_t j = i - 1;
+    for (; j >= lo && v[j] > t; --j) {
+      v[j + 1] = v[j];
+    }
+    v[j + 1] = t;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// select within the range bounded by the nearest pivots left by the former selections, so that the percentiles
+// requested by one query partition the values once in total rather than once each
+int32_t selectKthValueInMem(tMemBucket *pMemBucket, int32_t k, double *result) {
+  int32_t lo = 0, hi = pMemBucket->total;
+  for (int32_t i = 0; i < pMemBucket->numOfPivots; ++i) {
+    int32_t p = pMemBucket->pivots[i];
+    if (p == k) {
+      *result = pMemBucket->pValues[k];
+      return TSDB_CODE_SUCCESS;
+    } else if (p < k) {
+      lo = TMAX(lo, p + 1);
+    } else {
+      hi = TMIN(hi, p);
+    }
+  }
+
+  int32_t code = selectKthValue(pMemBucket->pValues, lo, hi, k);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  if (pMemBucket->numOfPivots < PERCENTILE_MAX_PIVOTS) {
+    pMemBucket->pivots[pMemBucket->numOfPivots++] = k;
+  }
+  *result = pMemBucket->pValues[k];
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t getPercentileInMem(tMemBucket *pMemBucket, int32_t count, double fraction, double *result) {
+  double  td = 0, nd = 0;
+  int32_t code = selectKthValueInMem(pMemBucket, count, &td);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  if (fraction > 0 && count + 1 < pMemBucket->total) {
+    code = selectKthValueInMem(pMemBucket, count + 1, &nd);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  } else {
+    nd = td;
+  }
+
+  *result = (1 - fraction) * td + fraction * nd;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction, double *result) {
+  if (pMemBucket->pValues != NULL) {
+    return getPercentileInMem(pMemBucket, count, fraction, result);
+  }
+
   int32_t num = 0;
 
   for (int32_t i = 0; i < pMemBucket->numOfSlots; ++i) {
@@ -585,7 +748,7 @@ int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction
         // try next round
         tMemBucket *tmpBucket = NULL;
         int32_t code = tMemBucketCreate(pMemBucket->bytes, pMemBucket->type, pSlot->range.dMinVal, pSlot->range.dMaxVal,
-                                            false, &tmpBucket);
+                                        pSlot->info.size, false, &tmpBucket);
         if (TSDB_CODE_SUCCESS != code) {
           tMemBucketDestroy(&tmpBucket);
           return code;
@@ -1211,6 +1211,8 @@ int32_t udfdOpenClientRpc() {
   rpcInit.parent = &global;
   rpcInit.rfp = udfdRpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressAlg = tsCompressMsgAlg;
+  rpcInit.compressLevel = tsCompressMsgLevel;
 
   int32_t connLimitNum = tsNumOfRpcSessions / (tsNumOfRpcThreads * 3);
   connLimitNum = TMAX(connLimitNum, 10);
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "builtinsimpl.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+// the function ctx of one group, the interbuf of the result row follows the entry info
+typedef struct {
+  SqlFunctionCtx ctx;
+  SExprInfo      expr;
+  char*          pRow;
+} SHllTestCtx;
+
+void hllTestInitCtx(SHllTestCtx* p) {
+  memset(&p->ctx, 0, sizeof(p->ctx));
+  memset(&p->expr, 0, sizeof(p->expr));
+  p->pRow = (char*)taosMemoryCalloc(1, sizeof(SResultRowEntryInfo) + getHLLInfoSize());
+  p->ctx.resultInfo = (SResultRowEntryInfo*)p->pRow;
+  p->ctx.pExpr = &p->expr;
+  p->expr.base.resSchema.slotId = 0;
+}
+
+SHLLInfo* hllTestGetInfo(SHllTestCtx* p) { return (SHLLInfo*)GET_ROWCELL_INTERBUF(p->ctx.resultInfo); }
+
+SColumnInfoData* hllTestCreateIntCol(int32_t startVal, int32_t rows, bool withNull) {
+  SColumnInfoData* pCol = (SColumnInfoData*)taosMemoryCalloc(1, sizeof(SColumnInfoData));
+  *pCol = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+  EXPECT_EQ(colInfoDataEnsureCapacity(pCol, rows, true), TSDB_CODE_SUCCESS);
+  for (int32_t i = 0; i < rows; ++i) {
+    int64_t val = startVal + i;
+    if (withNull && i % 10 == 0) {
+      colDataSetNULL(pCol, i);
+    } else {
+      EXPECT_EQ(colDataSetVal(pCol, i, (const char*)&val, false), TSDB_CODE_SUCCESS);
+    }
+  }
+  return pCol;
+}
+
+void hllTestDestroyCol(SColumnInfoData* pCol) {
+  colDataDestroy(pCol);
+  taosMemoryFree(pCol);
+}
+
+void hllTestFeed(SHllTestCtx* p, SColumnInfoData* pCol, int32_t rows) {
+  p->ctx.input.pData = &pCol;
+  p->ctx.input.startRowIndex = 0;
+  p->ctx.input.numOfRows = rows;
+  p->ctx.input.totalRows = rows;
+  ASSERT_EQ(hllFunction(&p->ctx), TSDB_CODE_SUCCESS);
+}
+
+SSDataBlock* hllTestCreateStateBlock(int32_t rows) {
+  SSDataBlock* pBlock = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+  SColumnInfoData col =
+      createColumnInfoData(TSDB_DATA_TYPE_BINARY, getHLLInfoSize() + VARSTR_HEADER_SIZE, 1);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &col), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, rows), TSDB_CODE_SUCCESS);
+  return pBlock;
+}
+
+// append the partial state of the group to the block, return its length
+int32_t hllTestPartialFinalize(SHllTestCtx* p, SSDataBlock* pBlock) {
+  EXPECT_EQ(hllPartialFinalize(&p->ctx, pBlock), TSDB_CODE_SUCCESS);
+  SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  int32_t          len = varDataLen(colDataGetData(pCol, pBlock->info.rows));
+  pBlock->info.rows += 1;
+  return len;
+}
+
+int32_t hllTestMerge(SHllTestCtx* p, SSDataBlock* pBlock) {
+  SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  p->ctx.input.pData = &pCol;
+  p->ctx.input.startRowIndex = 0;
+  p->ctx.input.numOfRows = pBlock->info.rows;
+  p->ctx.input.totalRows = pBlock->info.rows;
+  return hllFunctionMerge(&p->ctx);
+}
+
+void hllTestCheckSame(SHLLInfo* pExpect, SHLLInfo* pInfo) {
+  EXPECT_EQ(pInfo->totalCount, pExpect->totalCount);
+  EXPECT_EQ(memcmp(pInfo->buckets, pExpect->buckets, HLL_BUCKETS), 0);
+}
+
+// the states of the groups are shipped and merged, the merged buckets must be those of a single group of all rows
+void hllTestRoundTrip(const std::vector<std::pair<int32_t, int32_t>>& groups, const std::vector<bool>& expectSparse) {
+  SHllTestCtx  all, merged;
+  SSDataBlock* pBlock = hllTestCreateStateBlock(groups.size());
+  hllTestInitCtx(&all);
+  hllTestInitCtx(&merged);
+
+  for (int32_t i = 0; i < groups.size(); ++i) {
+    SHllTestCtx      group;
+    SColumnInfoData* pCol = hllTestCreateIntCol(groups[i].first, groups[i].second, i % 2 == 1);
+    hllTestInitCtx(&group);
+    hllTestFeed(&group, pCol, groups[i].second);
+    hllTestFeed(&all, pCol, groups[i].second);
+
+    int32_t len = hllTestPartialFinalize(&group, pBlock);
+    if (expectSparse[i]) {
+      EXPECT_LT(len, getHLLInfoSize());
+      SColumnInfoData* pStateCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+      uint32_t         tag = 0;
+      memcpy(&tag, varDataVal(colDataGetData(pStateCol, i)), sizeof(tag));
+      EXPECT_EQ(tag, HLL_SPARSE_TAG);
+    } else {
+      EXPECT_EQ(len, getHLLInfoSize());
+    }
+
+    hllTestDestroyCol(pCol);
+    taosMemoryFree(group.pRow);
+  }
+
+  ASSERT_EQ(hllTestMerge(&merged, pBlock), TSDB_CODE_SUCCESS);
+  hllTestCheckSame(hllTestGetInfo(&all), hllTestGetInfo(&merged));
+
+  blockDataDestroy(pBlock);
+  taosMemoryFree(all.pRow);
+  taosMemoryFree(merged.pRow);
+}
+
+}  // namespace
+
+TEST(hllTest, sparseRoundTrip) {
+  hllTestRoundTrip({{0, 100}}, {true});
+  hllTestRoundTrip({{0, 1}, {1000, 1000}, {5000, 10}}, {true, true, true});
+}
+
+TEST(hllTest, denseRoundTrip) { hllTestRoundTrip({{0, 100000}}, {false}); }
+
+TEST(hllTest, sparseDenseMerge) {
+  // dense and sparse states of overlapping value ranges merged into one group
+  hllTestRoundTrip({{0, 50}, {0, 100000}, {99990, 20}, {200000, 100000}}, {true, false, true, false});
+}
+
+TEST(hllTest, rejectUnknownState) {
+  SHllTestCtx  group, merged;
+  SSDataBlock* pBlock = hllTestCreateStateBlock(1);
+  hllTestInitCtx(&group);
+  hllTestInitCtx(&merged);
+
+  SColumnInfoData* pCol = hllTestCreateIntCol(0, 10, false);
+  hllTestFeed(&group, pCol, 10);
+  int32_t len = hllTestPartialFinalize(&group, pBlock);
+  ASSERT_LT(len, getHLLInfoSize());
+
+  // a state of another encoding version
+  SColumnInfoData* pStateCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  char*            pState = varDataVal(colDataGetData(pStateCol, 0));
+  uint32_t         tag = HLL_SPARSE_TAG + 1;
+  memcpy(pState, &tag, sizeof(tag));
+  EXPECT_EQ(hllTestMerge(&merged, pBlock), TSDB_CODE_FUNC_FUNTION_PARA_VALUE);
+
+  // a state whose length does not match its entries
+  tag = HLL_SPARSE_TAG;
+  memcpy(pState, &tag, sizeof(tag));
+  varDataSetLen(colDataGetData(pStateCol, 0), len - sizeof(uint32_t));
+  EXPECT_EQ(hllTestMerge(&merged, pBlock), TSDB_CODE_FUNC_FUNTION_PARA_VALUE);
+
+  varDataSetLen(colDataGetData(pStateCol, 0), len);
+  EXPECT_EQ(hllTestMerge(&merged, pBlock), TSDB_CODE_SUCCESS);
+  hllTestCheckSame(hllTestGetInfo(&group), hllTestGetInfo(&merged));
+
+  hllTestDestroyCol(pCol);
+  blockDataDestroy(pBlock);
+  taosMemoryFree(group.pRow);
+  taosMemoryFree(merged.pRow);
+}
+
+TEST(hllTest, avx2BucketMax) {
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  (void)taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+  if (!avx2) {
+    return;
+  }
+
+  // lengths with and without a tail shorter than one vector
+  int32_t lens[] = {HLL_BUCKETS, 32, 31, 1000 + 7};
+  for (int32_t len : lens) {
+    std::vector<uint8_t> dst(len), src(len), expect(len);
+    for (int32_t i = 0; i < len; ++i) {
+      dst[i] = taosRand() % 64;
+      src[i] = (i % 5 == 0) ? 0 : taosRand() % 64;
+      expect[i] = TMAX(dst[i], src[i]);
+    }
+    ASSERT_EQ(u8VectorMaxAVX2(dst.data(), src.data(), len), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(dst, expect);
+  }
+
+  // dense states merged by the AVX2 max and by the scalar loop
+  char oldAVX2 = tsAVX2Supported;
+  char oldSIMD = tsSIMDEnable;
+  SHLLInfo* pInfo[2] = {0};
+  SHllTestCtx merged[2];
+  for (int32_t i = 0; i < 2; ++i) {
+    tsAVX2Supported = avx2;
+    tsSIMDEnable = (i == 0);
+
+    SSDataBlock* pBlock = hllTestCreateStateBlock(2);
+    for (int32_t g = 0; g < 2; ++g) {
+      SHllTestCtx      group;
+      SColumnInfoData* pCol = hllTestCreateIntCol(g * 50000, 100000, false);
+      hllTestInitCtx(&group);
+      hllTestFeed(&group, pCol, 100000);
+      EXPECT_EQ(hllTestPartialFinalize(&group, pBlock), getHLLInfoSize());
+      hllTestDestroyCol(pCol);
+      taosMemoryFree(group.pRow);
+    }
+
+    hllTestInitCtx(&merged[i]);
+    ASSERT_EQ(hllTestMerge(&merged[i], pBlock), TSDB_CODE_SUCCESS);
+    pInfo[i] = hllTestGetInfo(&merged[i]);
+    blockDataDestroy(pBlock);
+  }
+  hllTestCheckSame(pInfo[1], pInfo[0]);
+
+  tsAVX2Supported = oldAVX2;
+  tsSIMDEnable = oldSIMD;
+  taosMemoryFree(merged[0].pRow);
+  taosMemoryFree(merged[1].pRow);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "tpercentile.h"
+
+namespace {
+
+// values of the given number of distinct keys, so that small key counts give many duplicates
+std::vector<double> pctTestValues(int32_t num, int32_t keys, double base) {
+  std::vector<double> v(num);
+  for (int32_t i = 0; i < num; ++i) {
+    v[i] = base + (double)(taosRand() % keys);
+  }
+  return v;
+}
+
+std::vector<double> pctTestSorted(std::vector<double> v) {
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+double pctTestReference(const std::vector<double>& sorted, double percent) {
+  double  percentVal = (percent * (sorted.size() - 1)) / 100.0;
+  int32_t idx = (int32_t)percentVal;
+  double  fraction = percentVal - idx;
+  double  next = (idx + 1 < sorted.size()) ? sorted[idx + 1] : sorted[idx];
+  return (1 - fraction) * sorted[idx] + fraction * next;
+}
+
+// the k-th value is in place and the range is partitioned around it
+void pctTestCheckSelect(std::vector<double> v, int32_t k) {
+  std::vector<double> sorted = pctTestSorted(v);
+  ASSERT_EQ(selectKthValue(v.data(), 0, v.size(), k), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(v[k], sorted[k]);
+  for (int32_t i = 0; i < k; ++i) {
+    ASSERT_LE(v[i], v[k]);
+  }
+  for (int32_t i = k + 1; i < v.size(); ++i) {
+    ASSERT_GE(v[i], v[k]);
+  }
+  EXPECT_EQ(pctTestSorted(v), sorted);
+}
+
+void pctTestInitTempDir() {
+  if (0 == tsTempDir[0]) {
+    tstrncpy(tsTempDir, TD_TMP_DIR_PATH, PATH_MAX);
+  }
+  ASSERT_EQ(taosMulMkDir(tsTempDir), 0);
+  ASSERT_EQ(osUpdate(), 0);
+}
+
+// a bucket of the values, numOfElems of zero keeps them in the slots of the disk based buffer
+tMemBucket* pctTestCreateBucket(const std::vector<double>& v, int64_t numOfElems) {
+  tMemBucket* pBucket = NULL;
+  double      minVal = *std::min_element(v.begin(), v.end());
+  double      maxVal = *std::max_element(v.begin(), v.end());
+  EXPECT_EQ(tMemBucketCreate(sizeof(double), TSDB_DATA_TYPE_DOUBLE, minVal, maxVal, numOfElems, false, &pBucket),
+            TSDB_CODE_SUCCESS);
+  return pBucket;
+}
+
+void pctTestPut(tMemBucket* pBucket, const std::vector<double>& v, int32_t batch) {
+  for (int32_t i = 0; i < v.size(); i += batch) {
+    int32_t size = TMIN(batch, (int32_t)v.size() - i);
+    ASSERT_EQ(tMemBucketPut(pBucket, v.data() + i, size), TSDB_CODE_SUCCESS);
+  }
+}
+
+void pctTestCheckPercentiles(tMemBucket* pBucket, const std::vector<double>& v) {
+  std::vector<double> sorted = pctTestSorted(v);
+  double              percents[] = {50, 0, 100, 99.9, 0.1, 25, 75, 33.3, 66.6, 90, 10, 50};
+  for (double percent : percents) {
+    double result = 0;
+    ASSERT_EQ(getPercentile(pBucket, percent, &result), TSDB_CODE_SUCCESS);
+    EXPECT_DOUBLE_EQ(result, pctTestReference(sorted, percent)) << "percent:" << percent;
+  }
+}
+
+}  // namespace
+
+TEST(percentileTest, selectKthValue) {
+  int32_t sizes[] = {1, 2, 16, 17, 100, 5000};
+  int32_t keys[] = {1, 2, 10, 1000000};
+  for (int32_t size : sizes) {
+    for (int32_t key : keys) {
+      std::vector<double> v = pctTestValues(size, key, -500);
+      int32_t             ks[] = {0, size / 3, size / 2, size - 1};
+      for (int32_t k : ks) {
+        pctTestCheckSelect(v, k);
+      }
+    }
+  }
+
+  // sorted, reversed and all equal input, which drive a plain quick select into its worst case
+  std::vector<double> ordered(10000);
+  for (int32_t i = 0; i < ordered.size(); ++i) {
+    ordered[i] = i;
+  }
+  pctTestCheckSelect(ordered, 4321);
+  std::reverse(ordered.begin(), ordered.end());
+  pctTestCheckSelect(ordered, 4321);
+  pctTestCheckSelect(std::vector<double>(10000, 7.5), 4321);
+}
+
+TEST(percentileTest, selectKthValueInMem) {
+  std::vector<double> v = pctTestValues(20000, 100, 0);
+  std::vector<double> sorted = pctTestSorted(v);
+  tMemBucket*         pBucket = pctTestCreateBucket(v, v.size());
+  ASSERT_NE(pBucket->pValues, nullptr);
+  pctTestPut(pBucket, v, 4096);
+
+  // every selection is bounded by the pivots of the former ones and must still see the sorted value
+  int32_t ks[] = {10000, 5000, 15000, 10001, 9999, 0, 19999, 5000, 12345};
+  for (int32_t k : ks) {
+    double result = 0;
+    ASSERT_EQ(selectKthValueInMem(pBucket, k, &result), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(result, sorted[k]) << "k:" << k;
+  }
+  EXPECT_LE(pBucket->numOfPivots, PERCENTILE_MAX_PIVOTS);
+  EXPECT_EQ(pctTestSorted(std::vector<double>(pBucket->pValues, pBucket->pValues + pBucket->total)), sorted);
+
+  // more selections than kept pivots
+  for (int32_t k = 0; k < v.size(); k += 331) {
+    double result = 0;
+    ASSERT_EQ(selectKthValueInMem(pBucket, k, &result), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(result, sorted[k]) << "k:" << k;
+  }
+  tMemBucketDestroy(&pBucket);
+}
+
+TEST(percentileTest, inMemPercentile) {
+  // the expected number of values is only a hint, the values grow past it
+  std::vector<double> v = pctTestValues(30000, 1000, -100);
+  tMemBucket*         pBucket = pctTestCreateBucket(v, 1000);
+  ASSERT_NE(pBucket->pValues, nullptr);
+  pctTestPut(pBucket, v, 777);
+  pctTestCheckPercentiles(pBucket, v);
+  tMemBucketDestroy(&pBucket);
+
+  std::vector<double> equal(3000, 42);
+  pBucket = pctTestCreateBucket(equal, equal.size());
+  pctTestPut(pBucket, equal, 1000);
+  pctTestCheckPercentiles(pBucket, equal);
+  tMemBucketDestroy(&pBucket);
+}
+
+TEST(percentileTest, rebucketInMem) {
+  pctTestInitTempDir();
+
+  // most values in the first slot of the disk buckets, a slot over the capacity is bucketed again in memory
+  std::vector<double> v = pctTestValues(5000, 50, 0);
+  std::vector<double> wide = pctTestValues(500, 1000000, 0);
+  v.insert(v.end(), wide.begin(), wide.end());
+
+  tMemBucket* pBucket = pctTestCreateBucket(v, 0);
+  ASSERT_EQ(pBucket->pValues, nullptr);
+  pBucket->maxCapacity = 256;
+  pctTestPut(pBucket, v, 1024);
+  EXPECT_GT(pBucket->pSlots[0].info.size, pBucket->maxCapacity);
+  pctTestCheckPercentiles(pBucket, v);
+  tMemBucketDestroy(&pBucket);
+}
+
+#pragma GCC diagnostic pop
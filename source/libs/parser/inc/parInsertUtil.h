@@ -48,6 +48,8 @@ int32_t insInitBoundColsInfo(int32_t numOfBound, SBoundColInfo *pInfo);
 void    insResetBoundColsInfo(SBoundColInfo *pInfo);
 int32_t insInitColValues(STableMeta *pTableMeta, SArray *aColValues);
 void    insCheckTableDataOrder(STableDataCxt *pTableCxt, SRowKey *rowKey);
+int32_t insParseCsvFile(SParseContext *pComCxt, SVnodeModifyOpStmt *pStmt, STableDataCxt *pTableCxt, char *pMsg,
+                        int32_t msgLen, int32_t *pNumOfRows);
 int32_t insGetTableDataCxt(SHashObj *pHash, void *id, int32_t idLen, STableMeta *pTableMeta,
                            SVCreateTbReq **pCreateTbReq, STableDataCxt **pTableCxt, bool colMode, bool ignoreColVals);
 int32_t initTableColSubmitData(STableDataCxt *pTableCxt);
@@ -18,6 +18,7 @@
 #include "parToken.h"
 #include "scalar.h"
 #include "tglobal.h"
+#include "tsched.h"
 #include "ttime.h"
 
 typedef struct SInsertParseContext {
@@ -2144,64 +2145,406 @@ static int32_t parseValuesClause(SInsertParseContext* pCxt, SVnodeModifyOpStmt*
   return code;
 }
 
-static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
-                            int32_t* pNumOfRows) {
+#define CSV_PARSE_TASK_LINES     16384
+#define CSV_PARSE_MIN_TASK_LINES 2048
+#define CSV_PARSE_CHUNK_SIZE     (64 * 1024 * 1024)
+#define CSV_PARSE_MAX_TASKS      64
+#define CSV_PARSE_QUEUE_SIZE     (CSV_PARSE_MAX_TASKS * 4)
+
+// all INSERT ... FILE requests of the process share one bounded pool of parse threads, created on first use and
+// created again if used after qCleanupCsvParsePool
+static void* csvParsePool = NULL;
+
+typedef struct SCsvChunk {
+  char*   pBuf;
+  int64_t len;
+  int64_t cap;
+  SArray* pLineOffset;  // SArray<int64_t>, every line is '\0' terminated in pBuf
+} SCsvChunk;
+
+typedef struct SCsvParseTask {
+  SInsertParseContext* pCxt;      // private context, only pComCxt is shared
+  STableDataCxt        tableCxt;  // shares meta, schema and bound columns with the target table
+  SSubmitTbData        data;
+  SCsvChunk*           pChunk;
+  int32_t              startLine;
+  int32_t              endLine;
+  bool                 firstLine;  // the first line of the task may be the header of the file
+  int32_t              numOfRows;
+  int32_t              code;
+  tsem_t               done;
+  bool                 semInited;
+} SCsvParseTask;
+
+static void destroyCsvParsePool(void* pPool) {
+  taosCleanUpScheduler(pPool);
+  taosMemoryFree(pPool);
+}
+
+static void* getCsvParsePool() {
+  void* pPool = atomic_load_ptr(&csvParsePool);
+  if (NULL != pPool) {
+    return pPool;
+  }
+
+  // the calling thread always parses a part of the chunk itself
+  int32_t numOfThreads = TMAX(TMIN(tsNumOfCsvParseThreads, CSV_PARSE_MAX_TASKS) - 1, 1);
+  pPool = taosInitScheduler(CSV_PARSE_QUEUE_SIZE, numOfThreads, "csvParse", NULL);
+  if (NULL == pPool) {
+    parserError("failed to init csv parse pool since %s, parse in place", tstrerror(terrno));
+    return NULL;
+  }
+
+  // another request created the pool at the same time, use that one
+  void* pOld = atomic_val_compare_exchange_ptr(&csvParsePool, NULL, pPool);
+  if (NULL != pOld) {
+    destroyCsvParsePool(pPool);
+    return pOld;
+  }
+  return pPool;
+}
+
+void qCleanupCsvParsePool() {
+  void* pPool = atomic_exchange_ptr(&csvParsePool, NULL);
+  if (NULL != pPool) {
+    destroyCsvParsePool(pPool);
+  }
+}
+
+// Rows of a normal table or subtable only depend on the bound columns, so they can be parsed apart from each other.
+// Rows of a super table resolve their child table through the catalog and stay on the calling thread, and geometry
+// values are built with a thread local geos context.
+static bool canParseCsvInParallel(SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt) {
+  if (tsNumOfCsvParseThreads <= 1 || pStmt->stbSyntax) {
+    return false;
+  }
+
+  STableDataCxt* pTableCxt = rowsDataCxt.pTableDataCxt;
+  if (NULL == pTableCxt || NULL == pTableCxt->pData || NULL == pTableCxt->pData->aRowP) {
+    return false;
+  }
+
+  SBoundColInfo* pCols = &pTableCxt->boundColsInfo;
+  SSchema*       pSchemas = getTableColumnSchema(pTableCxt->pMeta);
+  for (int32_t i = 0; i < pCols->numOfBound; ++i) {
+    if (TSDB_DATA_TYPE_GEOMETRY == pSchemas[pCols->pColIndex[i]].type) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int32_t appendCsvLine(SCsvChunk* pChunk, const char* pLine, int64_t len) {
+  if (pChunk->len + len + 1 > pChunk->cap) {
+    int64_t cap = TMAX(pChunk->cap * 2, pChunk->len + len + 1);
+    char*   pBuf = taosMemoryRealloc(pChunk->pBuf, cap);
+    if (NULL == pBuf) {
+      return terrno;
+    }
+    pChunk->pBuf = pBuf;
+    pChunk->cap = cap;
+  }
+
+  if (NULL == taosArrayPush(pChunk->pLineOffset, &pChunk->len)) {
+    return terrno;
+  }
+  (void)memcpy(pChunk->pBuf + pChunk->len, pLine, len);
+  pChunk->pBuf[pChunk->len + len] = '\0';
+  pChunk->len += len + 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+// Read at most maxLines non-empty lines into the chunk. The file position always stays at a line boundary, so a batch
+// cut by maxInsertBatchRows resumes at the next line like the serial path does.
+static int32_t readCsvChunk(SVnodeModifyOpStmt* pStmt, SCsvChunk* pChunk, int32_t maxLines, char** ppLine,
+                            bool* pFirstLine, bool* pHasHeader, bool* pEof) {
   int32_t code = TSDB_CODE_SUCCESS;
-  (*pNumOfRows) = 0;
-  char*   pLine = NULL;
   int64_t readLen = 0;
-  bool    firstLine = (pStmt->fileProcessing == false);
-  pStmt->fileProcessing = false;
-  while (TSDB_CODE_SUCCESS == code && (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
+
+  pChunk->len = 0;
+  taosArrayClear(pChunk->pLineOffset);
+  *pHasHeader = false;
+
+  while (taosArrayGetSize(pChunk->pLineOffset) < maxLines && pChunk->len < CSV_PARSE_CHUNK_SIZE) {
+    readLen = taosGetLineFile(pStmt->fp, ppLine);
+    if (-1 == readLen) {
+      *pEof = true;
+      break;
+    }
+
+    char* pLine = *ppLine;
     if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
       pLine[--readLen] = '\0';
     }
 
     if (readLen == 0) {
-      firstLine = false;
+      *pFirstLine = false;
       continue;
     }
 
-    bool gotRow = false;
-    if (TSDB_CODE_SUCCESS == code) {
-      SToken token;
-      (void)strtolower(pLine, pLine);
-      const char* pRow = pLine;
-      if (!pStmt->stbSyntax) {
-        code = parseOneRow(pCxt, (const char**)&pRow, rowsDataCxt.pTableDataCxt, &gotRow, &token);
-      } else {
-        STableDataCxt* pTableDataCxt = NULL;
-        code =
-            parseOneStbRow(pCxt, pStmt, (const char**)&pRow, rowsDataCxt.pStbRowsCxt, &gotRow, &token, &pTableDataCxt);
-        if (code == TSDB_CODE_SUCCESS) {
-          SStbRowsDataContext* pStbRowsCxt = rowsDataCxt.pStbRowsCxt;
-          void*                pData = pTableDataCxt;
-          code = taosHashPut(pStmt->pTableCxtHashObj, &pStbRowsCxt->pCtbMeta->uid, sizeof(pStbRowsCxt->pCtbMeta->uid), &pData,
-                      POINTER_BYTES);
-          if (TSDB_CODE_SUCCESS != code) {
-            break;
-          }
-        }
-      }
-      if (code && firstLine) {
-        firstLine = false;
-        code = 0;
+    code = appendCsvLine(pChunk, pLine, readLen);
+    if (TSDB_CODE_SUCCESS != code) {
+      break;
+    }
+    if (*pFirstLine) {
+      *pHasHeader = true;
+      *pFirstLine = false;
+    }
+  }
+  return code;
+}
+
+static void destroyCsvParseTaskRows(SCsvParseTask* pTask) {
+  for (int32_t i = 0; i < taosArrayGetSize(pTask->data.aRowP); ++i) {
+    tRowDestroy(*(SRow**)taosArrayGet(pTask->data.aRowP, i));
+  }
+  taosArrayClear(pTask->data.aRowP);
+}
+
+static void destroyCsvParseTask(SCsvParseTask* pTask) {
+  if (pTask->data.aRowP) {
+    destroyCsvParseTaskRows(pTask);
+    taosArrayDestroy(pTask->data.aRowP);
+  }
+  if (pTask->semInited) {
+    (void)tsem_destroy(&pTask->done);
+  }
+  taosArrayDestroy(pTask->tableCxt.pValues);
+  taosMemoryFree(pTask->pCxt);
+}
+
+static int32_t initCsvParseTask(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, SCsvParseTask* pTask) {
+  pTask->pCxt = taosMemoryCalloc(1, sizeof(SInsertParseContext) + pCxt->msg.len);
+  if (NULL == pTask->pCxt) {
+    return terrno;
+  }
+  pTask->pCxt->pComCxt = pCxt->pComCxt;
+  pTask->pCxt->msg.buf = (char*)(pTask->pCxt + 1);
+  pTask->pCxt->msg.len = pCxt->msg.len;
+
+  if (tsem_init(&pTask->done, 0, 0) != 0) {
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+  pTask->semInited = true;
+
+  pTask->tableCxt = *pTableCxt;
+  pTask->tableCxt.pData = &pTask->data;
+  pTask->tableCxt.pValues = taosArrayInit(pTableCxt->pMeta->tableInfo.numOfColumns, sizeof(SColVal));
+  if (NULL == pTask->tableCxt.pValues) {
+    return terrno;
+  }
+  int32_t code = insInitColValues(pTableCxt->pMeta, pTask->tableCxt.pValues);
+  if (TSDB_CODE_SUCCESS == code) {
+    pTask->data.aRowP = taosArrayInit(CSV_PARSE_TASK_LINES, POINTER_BYTES);
+    if (NULL == pTask->data.aRowP) {
+      code = terrno;
+    }
+  }
+  return code;
+}
+
+static void doParseCsvTask(SCsvParseTask* pTask) {
+  pTask->numOfRows = 0;
+  pTask->code = TSDB_CODE_SUCCESS;
+  pTask->tableCxt.lastKey = (SRowKey){0};
+  pTask->tableCxt.ordered = true;
+
+  for (int32_t i = pTask->startLine; i < pTask->endLine; ++i) {
+    char*       pLine = pTask->pChunk->pBuf + *(int64_t*)taosArrayGet(pTask->pChunk->pLineOffset, i);
+    const char* pRow = pLine;
+    SToken      token;
+    bool        gotRow = false;
+
+    (void)strtolower(pLine, pLine);
+    int32_t code = parseOneRow(pTask->pCxt, &pRow, &pTask->tableCxt, &gotRow, &token);
+    if (TSDB_CODE_SUCCESS != code) {
+      if (pTask->firstLine && i == pTask->startLine) {
         continue;
       }
+      pTask->code = code;
+      break;
+    }
+    if (gotRow) {
+      pTask->numOfRows++;
     }
+  }
+}
 
-    if (TSDB_CODE_SUCCESS == code && gotRow) {
-      (*pNumOfRows)++;
+static void csvParseTaskFp(SSchedMsg* pMsg) {
+  SCsvParseTask* pTask = pMsg->ahandle;
+  doParseCsvTask(pTask);
+  (void)tsem_post(&pTask->done);
+}
+
+// Split the chunk among the tasks, the calling thread takes the first part and the rest go to the shared pool. The rows
+// are appended to the table in file order, so the order check and the submit data are the same as with the serial path.
+static int32_t parseCsvChunk(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, SCsvChunk* pChunk, bool hasHeader,
+                             SCsvParseTask* pTasks, int32_t maxTasks, int32_t* pNumOfRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t numOfLines = taosArrayGetSize(pChunk->pLineOffset);
+  int32_t numOfTasks = TMAX(TMIN(maxTasks, numOfLines / CSV_PARSE_MIN_TASK_LINES), 1);
+  int32_t linesPerTask = (numOfLines + numOfTasks - 1) / numOfTasks;
+  bool    scheduled[CSV_PARSE_MAX_TASKS] = {0};
+  void*   pPool = (numOfTasks > 1) ? getCsvParsePool() : NULL;
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    pTasks[i].pChunk = pChunk;
+    pTasks[i].startLine = TMIN(i * linesPerTask, numOfLines);
+    pTasks[i].endLine = TMIN(pTasks[i].startLine + linesPerTask, numOfLines);
+    pTasks[i].firstLine = (0 == i) && hasHeader;
+  }
+
+  for (int32_t i = 1; i < numOfTasks && NULL != pPool; ++i) {
+    SSchedMsg msg = {.fp = csvParseTaskFp, .ahandle = &pTasks[i]};
+    if (taosScheduleTask(pPool, &msg) == 0) {
+      scheduled[i] = true;
+    } else {
+      parserWarn("0x%" PRIx64 " failed to schedule csv parse task since %s, parse it in place",
+                 pCxt->pComCxt->requestId, tstrerror(terrno));
+    }
+  }
+  doParseCsvTask(&pTasks[0]);
+  for (int32_t i = 1; i < numOfTasks; ++i) {
+    if (scheduled[i]) {
+      (void)tsem_wait(&pTasks[i].done);
+    } else {
+      doParseCsvTask(&pTasks[i]);
+    }
+  }
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    SCsvParseTask* pTask = &pTasks[i];
+    if (TSDB_CODE_SUCCESS == code && TSDB_CODE_SUCCESS != pTask->code) {
+      code = pTask->code;
+      tstrncpy(pCxt->msg.buf, pTask->pCxt->msg.buf, pCxt->msg.len);
+    }
+    if (TSDB_CODE_SUCCESS != code) {
+      destroyCsvParseTaskRows(pTask);
+      continue;
+    }
+
+    int32_t numOfRows = taosArrayGetSize(pTask->data.aRowP);
+    if (NULL == taosArrayAddBatch(pTableCxt->pData->aRowP, TARRAY_DATA(pTask->data.aRowP), numOfRows)) {
+      code = terrno;
+      destroyCsvParseTaskRows(pTask);
+      continue;
+    }
+    for (int32_t j = 0; j < numOfRows; ++j) {
+      SRowKey key;
+      tRowGetKey(*(SRow**)taosArrayGet(pTask->data.aRowP, j), &key);
+      insCheckTableDataOrder(pTableCxt, &key);
     }
+    taosArrayClear(pTask->data.aRowP);
+    (*pNumOfRows) += pTask->numOfRows;
+  }
+  return code;
+}
+
+static int32_t parseCsvFileInParallel(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, STableDataCxt* pTableCxt,
+                                      bool firstLine, int32_t* pNumOfRows) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int32_t        maxTasks = TMIN(tsNumOfCsvParseThreads, CSV_PARSE_MAX_TASKS);
+  SCsvParseTask* pTasks = taosMemoryCalloc(maxTasks, sizeof(SCsvParseTask));
+  SCsvChunk      chunk = {0};
+  char*          pLine = NULL;
+  bool           eof = false;
+
+  if (NULL == pTasks) {
+    return terrno;
+  }
+  chunk.pLineOffset = taosArrayInit(CSV_PARSE_TASK_LINES * maxTasks, sizeof(int64_t));
+  if (NULL == chunk.pLineOffset) {
+    code = terrno;
+  }
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < maxTasks; ++i) {
+    code = initCsvParseTask(pCxt, pTableCxt, &pTasks[i]);
+  }
 
+  while (TSDB_CODE_SUCCESS == code && !eof) {
+    bool    hasHeader = false;
+    int32_t maxLines = TMIN(CSV_PARSE_TASK_LINES * maxTasks, tsMaxInsertBatchRows - (*pNumOfRows));
+    code = readCsvChunk(pStmt, &chunk, maxLines, &pLine, &firstLine, &hasHeader, &eof);
+    if (TSDB_CODE_SUCCESS == code && taosArrayGetSize(chunk.pLineOffset) > 0) {
+      code = parseCsvChunk(pCxt, pTableCxt, &chunk, hasHeader, pTasks, maxTasks, pNumOfRows);
+    }
     if (TSDB_CODE_SUCCESS == code && (*pNumOfRows) >= tsMaxInsertBatchRows) {
       pStmt->fileProcessing = true;
       break;
     }
+  }
 
-    firstLine = false;
+  for (int32_t i = 0; i < maxTasks; ++i) {
+    destroyCsvParseTask(&pTasks[i]);
   }
+  taosMemoryFree(pTasks);
+  taosArrayDestroy(chunk.pLineOffset);
+  taosMemoryFree(chunk.pBuf);
   taosMemoryFree(pLine);
+  return code;
+}
+
+static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
+                            int32_t* pNumOfRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  (*pNumOfRows) = 0;
+  char*   pLine = NULL;
+  int64_t readLen = 0;
+  bool    firstLine = (pStmt->fileProcessing == false);
+  pStmt->fileProcessing = false;
+  if (canParseCsvInParallel(pStmt, rowsDataCxt)) {
+    code = parseCsvFileInParallel(pCxt, pStmt, rowsDataCxt.pTableDataCxt, firstLine, pNumOfRows);
+  } else {
+    while (TSDB_CODE_SUCCESS == code && (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
+      if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
+        pLine[--readLen] = '\0';
+      }
+
+      if (readLen == 0) {
+        firstLine = false;
+        continue;
+      }
+
+      bool gotRow = false;
+      if (TSDB_CODE_SUCCESS == code) {
+        SToken token;
+        (void)strtolower(pLine, pLine);
+        const char* pRow = pLine;
+        if (!pStmt->stbSyntax) {
+          code = parseOneRow(pCxt, (const char**)&pRow, rowsDataCxt.pTableDataCxt, &gotRow, &token);
+        } else {
+          STableDataCxt* pTableDataCxt = NULL;
+          code =
+              parseOneStbRow(pCxt, pStmt, (const char**)&pRow, rowsDataCxt.pStbRowsCxt, &gotRow, &token, &pTableDataCxt);
+          if (code == TSDB_CODE_SUCCESS) {
+            SStbRowsDataContext* pStbRowsCxt = rowsDataCxt.pStbRowsCxt;
+            void*                pData = pTableDataCxt;
+            code = taosHashPut(pStmt->pTableCxtHashObj, &pStbRowsCxt->pCtbMeta->uid, sizeof(pStbRowsCxt->pCtbMeta->uid), &pData,
+                        POINTER_BYTES);
+            if (TSDB_CODE_SUCCESS != code) {
+              break;
+            }
+          }
+        }
+        if (code && firstLine) {
+          firstLine = false;
+          code = 0;
+          continue;
+        }
+      }
+
+      if (TSDB_CODE_SUCCESS == code && gotRow) {
+        (*pNumOfRows)++;
+      }
+
+      if (TSDB_CODE_SUCCESS == code && (*pNumOfRows) >= tsMaxInsertBatchRows) {
+        pStmt->fileProcessing = true;
+        break;
+      }
+
+      firstLine = false;
+    }
+    taosMemoryFree(pLine);
+  }
 
   parserDebug("0x%" PRIx64 " %d rows have been parsed", pCxt->pComCxt->requestId, *pNumOfRows);
 
@@ -2212,6 +2555,13 @@ static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt
   return code;
 }
 
+int32_t insParseCsvFile(SParseContext* pComCxt, SVnodeModifyOpStmt* pStmt, STableDataCxt* pTableCxt, char* pMsg,
+                        int32_t msgLen, int32_t* pNumOfRows) {
+  SInsertParseContext context = {.pComCxt = pComCxt, .msg = {.buf = pMsg, .len = msgLen}};
+  SRowsDataContext    rowsDataCxt = {.pTableDataCxt = pTableCxt};
+  return parseCsvFile(&context, pStmt, rowsDataCxt, pNumOfRows);
+}
+
 static int32_t parseDataFromFileImpl(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt,
                                      SRowsDataContext rowsDataCxt) {
   // init only for file
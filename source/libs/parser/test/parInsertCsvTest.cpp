@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "parInsertUtil.h"
+#include "tglobal.h"
+
+using namespace std;
+
+namespace {
+
+const char* csvTestFile = "/tmp/parInsertCsvTest.csv";
+
+void writeCsvFile(bool withHeader, int32_t numOfLines) {
+  TdFilePtr pFile = taosOpenFile(csvTestFile, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+
+  string content;
+  if (withHeader) {
+    content += "ts,c1\n";
+  }
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    content += to_string(1700000000000LL + i) + "," + to_string(i) + "\n";
+  }
+  ASSERT_EQ(taosWriteFile(pFile, content.c_str(), content.size()), (int64_t)content.size());
+  (void)taosCloseFile(&pFile);
+}
+
+STableMeta* createCsvTableMeta() {
+  STableMeta* pMeta = (STableMeta*)taosMemoryCalloc(1, sizeof(STableMeta) + 2 * sizeof(SSchema));
+  pMeta->uid = 1;
+  pMeta->vgId = 2;
+  pMeta->tableType = TSDB_NORMAL_TABLE;
+  pMeta->sversion = 1;
+  pMeta->tableInfo.precision = TSDB_TIME_PRECISION_MILLI;
+  pMeta->tableInfo.numOfColumns = 2;
+  pMeta->tableInfo.rowSize = sizeof(int64_t) + sizeof(int32_t);
+
+  pMeta->schema[0].type = TSDB_DATA_TYPE_TIMESTAMP;
+  pMeta->schema[0].colId = PRIMARYKEY_TIMESTAMP_COL_ID;
+  pMeta->schema[0].bytes = sizeof(int64_t);
+  strcpy(pMeta->schema[0].name, "ts");
+  pMeta->schema[1].type = TSDB_DATA_TYPE_INT;
+  pMeta->schema[1].colId = PRIMARYKEY_TIMESTAMP_COL_ID + 1;
+  pMeta->schema[1].bytes = sizeof(int32_t);
+  strcpy(pMeta->schema[1].name, "c1");
+  return pMeta;
+}
+
+// parse the whole file batch by batch, as the client does, and return the c1 values of each batch
+vector<vector<int32_t>> parseCsvBatches(int32_t numOfThreads, int32_t maxBatchRows) {
+  int32_t oldThreads = tsNumOfCsvParseThreads;
+  int32_t oldBatchRows = tsMaxInsertBatchRows;
+  tsNumOfCsvParseThreads = numOfThreads;
+  tsMaxInsertBatchRows = maxBatchRows;
+
+  vector<vector<int32_t>> batches;
+  STableMeta*             pMeta = createCsvTableMeta();
+  SHashObj* pHash = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
+  STableDataCxt*          pTableCxt = NULL;
+  EXPECT_EQ(insGetTableDataCxt(pHash, &pMeta->uid, sizeof(pMeta->uid), pMeta, NULL, &pTableCxt, false, false),
+            TSDB_CODE_SUCCESS);
+
+  SParseContext      cxt = {0};
+  SVnodeModifyOpStmt stmt;
+  char               msg[128] = {0};
+  memset(&stmt, 0, sizeof(stmt));
+  cxt.requestId = 1;
+  stmt.fp = taosOpenFile(csvTestFile, TD_FILE_READ | TD_FILE_STREAM);
+  EXPECT_NE(stmt.fp, nullptr);
+
+  do {
+    int32_t numOfRows = 0;
+    int32_t code = insParseCsvFile(&cxt, &stmt, pTableCxt, msg, sizeof(msg), &numOfRows);
+    EXPECT_EQ(code, TSDB_CODE_SUCCESS) << msg;
+    if (TSDB_CODE_SUCCESS != code) {
+      break;
+    }
+
+    SArray* aRowP = pTableCxt->pData->aRowP;
+    EXPECT_EQ(numOfRows, taosArrayGetSize(aRowP));
+    vector<int32_t> batch;
+    for (int32_t i = 0; i < taosArrayGetSize(aRowP); ++i) {
+      SRow*   pRow = *(SRow**)taosArrayGet(aRowP, i);
+      SColVal colVal = {0};
+      EXPECT_EQ(tRowGet(pRow, pTableCxt->pSchema, 1, &colVal), TSDB_CODE_SUCCESS);
+      batch.push_back(*(int32_t*)&colVal.value.val);
+      tRowDestroy(pRow);
+    }
+    taosArrayClear(aRowP);
+    batches.push_back(batch);
+    stmt.totalRowsNum += numOfRows;
+  } while (stmt.fileProcessing);
+
+  (void)taosCloseFile(&stmt.fp);
+  insDestroyTableDataCxtHashMap(pHash);
+  taosMemoryFree(pMeta);
+  tsNumOfCsvParseThreads = oldThreads;
+  tsMaxInsertBatchRows = oldBatchRows;
+  return batches;
+}
+
+void checkCsvBatches(const vector<vector<int32_t>>& batches, int32_t numOfLines, int32_t maxBatchRows) {
+  int32_t expect = 0;
+  for (int32_t i = 0; i < batches.size(); ++i) {
+    if (i + 1 < batches.size()) {
+      EXPECT_EQ(batches[i].size(), maxBatchRows);
+    }
+    for (int32_t val : batches[i]) {
+      ASSERT_EQ(val, expect++);
+    }
+  }
+  EXPECT_EQ(expect, numOfLines);
+}
+
+}  // namespace
+
+TEST(parInsertCsvTest, headerSkip) {
+  writeCsvFile(true, 10000);
+  vector<vector<int32_t>> parallel = parseCsvBatches(4, 1000000);
+  checkCsvBatches(parallel, 10000, 1000000);
+  EXPECT_EQ(parallel, parseCsvBatches(1, 1000000));
+
+  // without a header the first line is a row and is kept
+  writeCsvFile(false, 10000);
+  parallel = parseCsvBatches(4, 1000000);
+  checkCsvBatches(parallel, 10000, 1000000);
+  EXPECT_EQ(parallel, parseCsvBatches(1, 1000000));
+}
+
+TEST(parInsertCsvTest, rowOrderAcrossChunks) {
+  // more lines than one chunk of 4 tasks holds, each chunk is split among the pool and the caller
+  writeCsvFile(true, 100000);
+  vector<vector<int32_t>> parallel = parseCsvBatches(4, 1000000);
+  ASSERT_EQ(parallel.size(), 1);
+  checkCsvBatches(parallel, 100000, 1000000);
+  EXPECT_EQ(parallel, parseCsvBatches(1, 1000000));
+}
+
+TEST(parInsertCsvTest, batchCutAtChunkBoundary) {
+  writeCsvFile(false, 150000);
+
+  // a batch of exactly one chunk, the next call resumes at the first line of the next chunk
+  vector<vector<int32_t>> parallel = parseCsvBatches(4, 65536);
+  ASSERT_EQ(parallel.size(), 3);
+  checkCsvBatches(parallel, 150000, 65536);
+  EXPECT_EQ(parallel, parseCsvBatches(1, 65536));
+
+  // a batch that ends inside the second chunk
+  parallel = parseCsvBatches(4, 70000);
+  ASSERT_EQ(parallel.size(), 3);
+  checkCsvBatches(parallel, 150000, 70000);
+  EXPECT_EQ(parallel, parseCsvBatches(1, 70000));
+
+  // the header of the file takes a line of the first chunk but not a row of the batch
+  writeCsvFile(true, 150000);
+  parallel = parseCsvBatches(4, 65536);
+  checkCsvBatches(parallel, 150000, 65536);
+  EXPECT_EQ(parallel, parseCsvBatches(1, 65536));
+}
+
+TEST(parInsertCsvTest, poolAfterCleanup) {
+  writeCsvFile(true, 100000);
+  vector<vector<int32_t>> parallel = parseCsvBatches(4, 1000000);
+  checkCsvBatches(parallel, 100000, 1000000);
+
+  // the pool released by taos_cleanup is created again by the next parallel parse
+  qCleanupCsvParsePool();
+  EXPECT_EQ(parallel, parseCsvBatches(4, 1000000));
+  qCleanupCsvParsePool();
+  qCleanupCsvParsePool();
+  EXPECT_EQ(parallel, parseCsvBatches(4, 1000000));
+  qCleanupCsvParsePool();
+}
@@ -36,6 +36,7 @@ extern "C" {
 #define QW_DEFAULT_HEARTBEAT_MSEC   5000
 #define QW_SCH_TIMEOUT_MSEC         180000
 #define QW_MIN_RES_ROWS             16384
+#define QW_RECENT_WAIT_WEIGHT       8
 
 enum {
   QW_PHASE_PRE_QUERY = 1,
@@ -160,6 +161,7 @@ typedef struct SQWSchStatus {
 typedef struct SQWTimeInQ {
   uint64_t num;
   uint64_t total;
+  int64_t  recent;  // moving average of the latest waits, reported to schedulers by hb
 } SQWTimeInQ;
 
 typedef struct SQWMsgStat {
@@ -421,6 +423,7 @@ int32_t qwOpenRef(void);
 void    qwSetHbParam(int64_t refId, SQWHbParam **pParam);
 int32_t qwUpdateTimeInQueue(SQWorker *mgmt, int64_t ts, EQueueType type);
 int64_t qwGetTimeInQueue(SQWorker *mgmt, EQueueType type);
+void    qwFillHbRspLoad(SQWorker *mgmt, SSchedulerHbRsp *rsp);
 void    qwClearExpiredSch(SQWorker *mgmt, SArray *pExpiredSch);
 int32_t qwAcquireScheduler(SQWorker *mgmt, uint64_t sId, int32_t rwType, SQWSchStatus **sch);
 void    qwFreeTaskCtx(SQWTaskCtx *ctx);
@@ -434,6 +437,7 @@ void    qwDbgSimulateRedirect(SQWMsg *qwMsg, SQWTaskCtx *ctx, bool *rsped);
 void    qwDbgSimulateSleep(void);
 void    qwDbgSimulateDead(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *rsped);
 int32_t qwSendExplainResponse(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+int32_t qwGetQueryResInPlaceFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SRetrieveTableRsp **ppRsp, SOutputData *pOutput);
 
 #ifdef __cplusplus
 }
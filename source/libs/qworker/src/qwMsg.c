@@ -43,10 +43,11 @@ void qwBuildFetchRsp(void *msg, SOutputData *input, int32_t len, int32_t rawData
   rsp->numOfBlocks = htonl(input->numOfBlocks);
 }
 
-void qwFreeFetchRsp(void *msg) {
+void qwFreeFetchRsp(void *msg, SArray *pIov) {
   if (msg) {
     rpcFreeCont(msg);
   }
+  rpcFreeIov(pIov);
 }
 
 int32_t qwBuildAndSendErrorRsp(int32_t rspType, SRpcHandleInfo *pConn, int32_t code) {
@@ -162,9 +163,11 @@ int32_t qwBuildAndSendHbRsp(SRpcHandleInfo *pConn, SSchedulerHbRsp *pStatus, int
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t qwBuildAndSendFetchRsp(int32_t rspType, SRpcHandleInfo *pConn, SRetrieveTableRsp *pRsp, int32_t dataLength,
-                               int32_t code) {
+int32_t qwBuildAndSendFetchRsp(int32_t rspType, SRpcHandleInfo *pConn, SRetrieveTableRsp *pRsp, SArray *pIov,
+                               int32_t dataLength, int32_t code) {
   if (NULL == pRsp) {
+    rpcFreeIov(pIov);
+    pIov = NULL;
     pRsp = (SRetrieveTableRsp *)rpcMallocCont(sizeof(SRetrieveTableRsp));
     if (NULL == pRsp) {
       QW_RET(terrno);
@@ -176,9 +179,10 @@ int32_t qwBuildAndSendFetchRsp(int32_t rspType, SRpcHandleInfo *pConn, SRetrieve
   SRpcMsg rpcRsp = {
       .msgType = rspType,
       .pCont = pRsp,
-      .contLen = sizeof(*pRsp) + dataLength,
+      .contLen = sizeof(*pRsp) + dataLength - rpcMsgIovLen(pIov),
       .code = code,
       .info = *pConn,
+      .pIov = pIov,
   };
 
   rpcRsp.info.compressed = pRsp->compressed;
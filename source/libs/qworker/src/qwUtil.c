@@ -323,6 +323,30 @@ static void freeExplainExecItem(void *param) {
   taosMemoryFree(pInfo->verboseInfo);
 }
 
+static void qwLogExplainProfInfo(QW_FPARAMS_DEF, SArray *execInfoList) {
+  SExplainProfInfo prof = {0};
+  int32_t          num = taosArrayGetSize(execInfoList);
+  for (int32_t i = 0; i < num; ++i) {
+    SExplainProfInfo *p = &((SExplainExecInfo *)taosArrayGet(execInfoList, i))->prof;
+    prof.inputRows += p->inputRows;
+    prof.inputBlocks += p->inputBlocks;
+    prof.loadBlocks += p->loadBlocks;
+    prof.skipBlocks += p->skipBlocks;
+    prof.loadBytes += p->loadBytes;
+    prof.loadTime += p->loadTime;
+    prof.filterTime += p->filterTime;
+    prof.aggTime += p->aggTime;
+    prof.hashProbes += p->hashProbes;
+    prof.hashMatchRows += p->hashMatchRows;
+  }
+
+  QW_TASK_DLOG("explain profile, operators:%d, inputRows:%" PRIu64 ", inputBlocks:%" PRIu64 ", loadBlocks:%" PRIu64
+               ", skipBlocks:%" PRIu64 ", loadBytes:%" PRIu64 ", loadTime:%.2fms, filterTime:%.2fms, aggTime:%.2fms"
+               ", hashProbes:%" PRIu64 ", hashMatchRows:%" PRIu64,
+               num, prof.inputRows, prof.inputBlocks, prof.loadBlocks, prof.skipBlocks, prof.loadBytes, prof.loadTime,
+               prof.filterTime, prof.aggTime, prof.hashProbes, prof.hashMatchRows);
+}
+
 
 int32_t qwSendExplainResponse(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
   int32_t code = TSDB_CODE_SUCCESS;
@@ -336,6 +360,7 @@ int32_t qwSendExplainResponse(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
   }
   
   QW_ERR_JRET(qGetExplainExecInfo(taskHandle, execInfoList));
+  qwLogExplainProfInfo(QW_FPARAMS(), execInfoList);
   
   if (ctx->localExec) {
     SExplainLocalRsp localRsp = {0};
@@ -646,21 +671,26 @@ int32_t qwUpdateTimeInQueue(SQWorker *mgmt, int64_t ts, EQueueType type) {
     return TSDB_CODE_SUCCESS;
   }
 
-  int64_t duration = taosGetTimestampUs() - ts;
+  int64_t     duration = taosGetTimestampUs() - ts;
+  SQWTimeInQ *pStat = NULL;
   switch (type) {
     case QUERY_QUEUE:
-      ++mgmt->stat.msgStat.waitTime[0].num;
-      mgmt->stat.msgStat.waitTime[0].total += duration;
+      pStat = &mgmt->stat.msgStat.waitTime[0];
       break;
     case FETCH_QUEUE:
-      ++mgmt->stat.msgStat.waitTime[1].num;
-      mgmt->stat.msgStat.waitTime[1].total += duration;
+      pStat = &mgmt->stat.msgStat.waitTime[1];
       break;
     default:
       qError("unsupported queue type %d", type);
       return TSDB_CODE_APP_ERROR;
   }
 
+  ++pStat->num;
+  pStat->total += duration;
+
+  int64_t recent = atomic_load_64(&pStat->recent);
+  atomic_store_64(&pStat->recent, recent + (duration - recent) / QW_RECENT_WAIT_WEIGHT);
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -681,6 +711,13 @@ int64_t qwGetTimeInQueue(SQWorker *mgmt, EQueueType type) {
   return -1;
 }
 
+void qwFillHbRspLoad(SQWorker *mgmt, SSchedulerHbRsp *rsp) {
+  if (mgmt->msgCb.qsizeFp) {
+    rsp->queryInQueue = (*mgmt->msgCb.qsizeFp)(mgmt->msgCb.mgmt, mgmt->nodeId, QUERY_QUEUE);
+  }
+  rsp->queryWaitUs = atomic_load_64(&mgmt->stat.msgStat.waitTime[0].recent);
+}
+
 void qwClearExpiredSch(SQWorker *mgmt, SArray *pExpiredSch) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t num = taosArrayGetSize(pExpiredSch);
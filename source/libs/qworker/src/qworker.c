@@ -264,6 +264,7 @@ int32_t qwGenerateSchHbRsp(SQWorker *mgmt, SQWSchStatus *sch, SQWHbInfo *hbInfo)
   
   hbInfo->connInfo = sch->hbConnInfo;
   hbInfo->rsp.epId = sch->hbEpId;
+  qwFillHbRspLoad(mgmt, &hbInfo->rsp);
 
   QW_LOCK(QW_READ, &sch->tasksLock);
 
@@ -307,8 +308,65 @@ int32_t qwGenerateSchHbRsp(SQWorker *mgmt, SQWSchStatus *sch, SQWHbInfo *hbInfo)
   return code;
 }
 
+static void qwFreeSinkBuf(void *param) { taosMemoryFree(param); }
+
+static int32_t qwGetQueryResRefFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int64_t len, SArray **ppIov,
+                                        SOutputData *pOutput) {
+  void   *pBuf = NULL;
+  int32_t code = dsGetDataBlockRef(ctx->sinkHandle, pOutput, &pBuf);
+  if (code) {
+    return code;
+  }
+
+  if (NULL == *ppIov) {
+    *ppIov = taosArrayInit(4, sizeof(SRpcIov));
+    if (NULL == *ppIov) {
+      taosMemoryFree(pBuf);
+      QW_RET(terrno);
+    }
+  }
+
+  SRpcIov iov = {.base = pOutput->pData - PAYLOAD_PREFIX_LEN,
+                 .len = len + PAYLOAD_PREFIX_LEN,
+                 .param = pBuf,
+                 .freeFp = qwFreeSinkBuf};
+  if (NULL == taosArrayPush(*ppIov, &iov)) {
+    taosMemoryFree(pBuf);
+    QW_RET(terrno);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// the sink leaves room for a rsp head in front of every block it hands over, so a local fetch rsp is the block itself
+int32_t qwGetQueryResInPlaceFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SRetrieveTableRsp **ppRsp, SOutputData *pOutput) {
+  void   *pBuf = NULL;
+  int32_t code = dsGetDataBlockRef(ctx->sinkHandle, pOutput, &pBuf);
+  if (code) {
+    return code;
+  }
+
+  SRetrieveTableRsp *pRsp = (SRetrieveTableRsp *)pBuf;
+  if (NULL == pRsp || pRsp->data != pOutput->pData - PAYLOAD_PREFIX_LEN) {
+    QW_TASK_ELOG("invalid block buf %p from sink, data:%p", pBuf, pOutput->pData);
+    taosMemoryFree(pBuf);
+    QW_ERR_RET(TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
+  }
+
+  // the head overlaps the entry fields of the block, which are already copied into pOutput
+  TAOS_MEMSET(pRsp, 0, offsetof(SRetrieveTableRsp, data));
+  *ppRsp = pRsp;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * When ppIov is not NULL, the blocks are handed over from the sink by reference and the rsp only holds the head,
+ * the block list is sent after it by rpc without being copied into the rsp.
+ * A local fetch takes the first block by reference as the rsp and returns it alone.
+ */
 int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen, int32_t *pRawDataLen, void **rspMsg,
-                              SOutputData *pOutput) {
+                              SArray **ppIov, SOutputData *pOutput) {
   int64_t            len = 0;
   int64_t            rawLen = 0;
   SRetrieveTableRsp *pRsp = NULL;
@@ -368,19 +426,47 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
     *dataLen += len + PAYLOAD_PREFIX_LEN;
     *pRawDataLen += rawLen + PAYLOAD_PREFIX_LEN;
 
-    QW_ERR_JRET(qwMallocFetchRsp(!ctx->localExec, *dataLen, &pRsp));
+    if (NULL != ppIov) {
+      QW_ERR_JRET(qwMallocFetchRsp(!ctx->localExec, 0, &pRsp));
 
-    // set the serialize start position
-    output.pData = pRsp->data + *dataLen - (len + PAYLOAD_PREFIX_LEN);
+      code = qwGetQueryResRefFromSink(QW_FPARAMS(), ctx, len, ppIov, &output);
+      if (TSDB_CODE_OPS_NOT_SUPPORT == code && NULL == *ppIov) {
+        QW_TASK_DLOG_E("sink does not support fetch by ref, copy data instead");
+        ppIov = NULL;
+      } else if (code) {
+        QW_TASK_ELOG("dsGetDataBlockRef failed, code:%x - %s", code, tstrerror(code));
+        QW_ERR_JRET(code);
+      }
+    }
 
-    ((int32_t *)output.pData)[0] = len;
-    ((int32_t *)output.pData)[1] = rawLen;
-    output.pData += sizeof(int32_t) * 2;
+    bool inPlace = false;
+    if (NULL == ppIov && ctx->localExec && NULL == pRsp) {
+      code = qwGetQueryResInPlaceFromSink(QW_FPARAMS(), ctx, &pRsp, &output);
+      if (TSDB_CODE_OPS_NOT_SUPPORT == code) {
+        QW_TASK_DLOG_E("sink does not support fetch by ref, copy data into local rsp instead");
+      } else if (code) {
+        QW_TASK_ELOG("get block in place failed, code:%x - %s", code, tstrerror(code));
+        QW_ERR_JRET(code);
+      } else {
+        inPlace = true;
+      }
+    }
 
-    code = dsGetDataBlock(ctx->sinkHandle, &output);
-    if (code) {
-      QW_TASK_ELOG("dsGetDataBlock failed, code:%x - %s", code, tstrerror(code));
-      QW_ERR_JRET(code);
+    if (NULL == ppIov && !inPlace) {
+      QW_ERR_JRET(qwMallocFetchRsp(!ctx->localExec, *dataLen, &pRsp));
+
+      // set the serialize start position
+      output.pData = pRsp->data + *dataLen - (len + PAYLOAD_PREFIX_LEN);
+
+      ((int32_t *)output.pData)[0] = len;
+      ((int32_t *)output.pData)[1] = rawLen;
+      output.pData += sizeof(int32_t) * 2;
+
+      code = dsGetDataBlock(ctx->sinkHandle, &output);
+      if (code) {
+        QW_TASK_ELOG("dsGetDataBlock failed, code:%x - %s", code, tstrerror(code));
+        QW_ERR_JRET(code);
+      }
     }
 
     pOutput->queryEnd = output.queryEnd;
@@ -409,6 +495,11 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
       break;
     }
 
+    if (inPlace) {
+      QW_TASK_DLOG("task fetched block in place, rows %" PRId64, pOutput->numOfRows);
+      break;
+    }
+
     if (pOutput->numOfRows >= QW_MIN_RES_ROWS) {
       QW_TASK_DLOG("task fetched blocks %d rows %" PRId64 " reaches the min rows", pOutput->numOfBlocks,
                    pOutput->numOfRows);
@@ -468,16 +559,19 @@ int32_t qwQuickRspFetchReq(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SQWMsg *qwMsg, int32
   if (QUERY_RSP_POLICY_QUICK == tsQueryRspPolicy && ctx != NULL) {
     if (QW_EVENT_RECEIVED(ctx, QW_EVENT_FETCH)) {
       void       *rsp = NULL;
+      SArray     *pIov = NULL;
       int32_t     dataLen = 0;
       int32_t     rawLen = 0;
       SOutputData sOutput = {0};
       if (TSDB_CODE_SUCCESS == code) {
-        code = qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawLen, &rsp, &sOutput);
+        code = qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawLen, &rsp, ctx->localExec ? NULL : &pIov,
+                                     &sOutput);
       }
 
       if (code) {
-        qwFreeFetchRsp(rsp);
+        qwFreeFetchRsp(rsp, pIov);
         rsp = NULL;
+        pIov = NULL;
         dataLen = 0;
       }
 
@@ -497,7 +591,7 @@ int32_t qwQuickRspFetchReq(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SQWMsg *qwMsg, int32
       qwMsg->connInfo = ctx->dataConnInfo;
       QW_SET_EVENT_PROCESSED(ctx, QW_EVENT_FETCH);
 
-      QW_ERR_RET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp, dataLen, code));
+      QW_ERR_RET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp, pIov, dataLen, code));
       rsp = NULL;
 
       QW_TASK_DLOG("fetch rsp send, handle:%p, code:%x - %s, dataLen:%d", qwMsg->connInfo.handle, code, tstrerror(code),
@@ -829,6 +923,7 @@ int32_t qwProcessCQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
   int32_t       code = 0;
   SQWPhaseInput input = {0};
   void         *rsp = NULL;
+  SArray       *pIov = NULL;
   int32_t       dataLen = 0;
   int32_t       rawLen = 0;
   bool          queryStop = false;
@@ -850,7 +945,8 @@ int32_t qwProcessCQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
 
     if (QW_EVENT_RECEIVED(ctx, QW_EVENT_FETCH)) {
       SOutputData sOutput = {0};
-      QW_ERR_JRET(qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawLen, &rsp, &sOutput));
+      QW_ERR_JRET(
+          qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawLen, &rsp, ctx->localExec ? NULL : &pIov, &sOutput));
 
       if ((!sOutput.queryEnd) && (DS_BUF_LOW == sOutput.bufStatus || DS_BUF_EMPTY == sOutput.bufStatus)) {
         QW_TASK_DLOG("task not end and buf is %s, need to continue query", qwBufStatusStr(sOutput.bufStatus));
@@ -870,8 +966,10 @@ int32_t qwProcessCQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
         qwMsg->connInfo = ctx->dataConnInfo;
         QW_SET_EVENT_PROCESSED(ctx, QW_EVENT_FETCH);
 
-        QW_ERR_JRET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp, dataLen, code));
+        code = qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp, pIov, dataLen, code);
         rsp = NULL;
+        pIov = NULL;
+        QW_ERR_JRET(code);
 
         QW_TASK_DLOG("fetch rsp send, handle:%p, code:%x - %s, dataLen:%d", qwMsg->connInfo.handle, code,
                      tstrerror(code), dataLen);
@@ -886,14 +984,15 @@ int32_t qwProcessCQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
       break;
     }
 
-    qwFreeFetchRsp(rsp);
+    qwFreeFetchRsp(rsp, pIov);
     rsp = NULL;
+    pIov = NULL;
 
     if (code && QW_EVENT_RECEIVED(ctx, QW_EVENT_FETCH)) {
       QW_SET_EVENT_PROCESSED(ctx, QW_EVENT_FETCH);
 
       qwMsg->connInfo = ctx->dataConnInfo;
-      code = qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, NULL, 0, code);
+      code = qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, NULL, NULL, 0, code);
       if (TSDB_CODE_SUCCESS != code) {
         QW_TASK_ELOG("fetch rsp send fail, handle:%p, code:%x - %s, dataLen:%d", qwMsg->connInfo.handle, code, tstrerror(code),
                      0);
@@ -929,6 +1028,7 @@ int32_t qwProcessFetch(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
   bool          locked = false;
   SQWTaskCtx   *ctx = NULL;
   void         *rsp = NULL;
+  SArray       *pIov = NULL;
   SQWPhaseInput input = {0};
 
   QW_ERR_JRET(qwHandlePrePhaseEvents(QW_FPARAMS(), QW_PHASE_PRE_FETCH, &input, NULL));
@@ -944,7 +1044,8 @@ int32_t qwProcessFetch(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
   }
 
   SOutputData sOutput = {0};
-  QW_ERR_JRET(qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawDataLen, &rsp, &sOutput));
+  QW_ERR_JRET(
+      qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawDataLen, &rsp, ctx->localExec ? NULL : &pIov, &sOutput));
 
   if (NULL == rsp) {
     QW_SET_EVENT_RECEIVED(ctx, QW_EVENT_FETCH);
@@ -986,8 +1087,9 @@ _return:
   code = qwHandlePostPhaseEvents(QW_FPARAMS(), QW_PHASE_POST_FETCH, &input, NULL);
 
   if (code) {
-    qwFreeFetchRsp(rsp);
+    qwFreeFetchRsp(rsp, pIov);
     rsp = NULL;
+    pIov = NULL;
     dataLen = 0;
   }
 
@@ -999,7 +1101,7 @@ _return:
     }
 
     if (!rsped) {
-      code = qwBuildAndSendFetchRsp(qwMsg->msgType + 1, &qwMsg->connInfo, rsp, dataLen, code);
+      code = qwBuildAndSendFetchRsp(qwMsg->msgType + 1, &qwMsg->connInfo, rsp, pIov, dataLen, code);
       if (TSDB_CODE_SUCCESS != code) {
         QW_TASK_ELOG("fetch rsp send fail, msgType:%s, handle:%p, code:%x - %s, dataLen:%d", TMSG_INFO(qwMsg->msgType + 1),
                      qwMsg->connInfo.handle, code, tstrerror(code), dataLen);
@@ -1008,8 +1110,9 @@ _return:
                      qwMsg->connInfo.handle, code, tstrerror(code), dataLen);
       }
     } else {
-      qwFreeFetchRsp(rsp);
+      qwFreeFetchRsp(rsp, pIov);
       rsp = NULL;
+      pIov = NULL;
     }
   } else {
     // qwQuickRspFetchReq(QW_FPARAMS(), ctx, qwMsg, code);
@@ -1156,6 +1259,7 @@ int32_t qwProcessHb(SQWorker *mgmt, SQWMsg *qwMsg, SSchedulerHbReq *req) {
 _return:
 
   (void)memcpy(&rsp.epId, &req->epId, sizeof(req->epId));
+  qwFillHbRspLoad(mgmt, &rsp);
   code = qwBuildAndSendHbRsp(&qwMsg->connInfo, &rsp, code);
 
   if (code) {
@@ -1559,7 +1663,7 @@ int32_t qWorkerProcessLocalFetch(void *pMgmt, uint64_t sId, uint64_t qId, uint64
   SOutputData sOutput = {0};
 
   while (true) {
-    QW_ERR_JRET(qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawLen, &rsp, &sOutput));
+    QW_ERR_JRET(qwGetQueryResFromSink(QW_FPARAMS(), ctx, &dataLen, &rawLen, &rsp, NULL, &sOutput));
 
     if (NULL == rsp) {
       QW_ERR_JRET(qwExecTask(QW_FPARAMS(), ctx, &queryStop));
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "dataSinkMgt.h"
+#include "qwInt.h"
+#include "tcompression.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+const int32_t qwtFetchRows = 1000;
+
+SSDataBlock* qwtCreateFetchBlock(int32_t rows, int64_t startTs) {
+  SSDataBlock* pBlock = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+
+  SColumnInfoData tsCol = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  SColumnInfoData valCol = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &tsCol), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &valCol), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, rows), TSDB_CODE_SUCCESS);
+
+  SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = 0; i < rows; ++i) {
+    int64_t ts = startTs + i;
+    int32_t val = i % 7;
+    EXPECT_EQ(colDataSetVal(pTs, i, (const char*)&ts, false), TSDB_CODE_SUCCESS);
+    if (0 == i % 5) {
+      colDataSetNULL(pVal, i);
+    } else {
+      EXPECT_EQ(colDataSetVal(pVal, i, (const char*)&val, false), TSDB_CODE_SUCCESS);
+    }
+  }
+  pBlock->info.rows = rows;
+  return pBlock;
+}
+
+SDataSinkNode* qwtCreateDispatchNode() {
+  SDataSinkNode*      pSink = NULL;
+  SDataBlockDescNode* pDesc = NULL;
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_DISPATCH, (SNode**)&pSink), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(nodesMakeNode(QUERY_NODE_DATABLOCK_DESC, (SNode**)&pDesc), TSDB_CODE_SUCCESS);
+  pDesc->precision = TSDB_TIME_PRECISION_MILLI;
+  for (int16_t i = 0; i < 2; ++i) {
+    SSlotDescNode* pSlot = NULL;
+    EXPECT_EQ(nodesMakeNode(QUERY_NODE_SLOT_DESC, (SNode**)&pSlot), TSDB_CODE_SUCCESS);
+    pSlot->slotId = i;
+    pSlot->output = true;
+    pSlot->dataType.type = (0 == i) ? TSDB_DATA_TYPE_TIMESTAMP : TSDB_DATA_TYPE_INT;
+    pSlot->dataType.bytes = tDataTypes[pSlot->dataType.type].bytes;
+    EXPECT_EQ(nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot), TSDB_CODE_SUCCESS);
+  }
+  pSink->pInputDataBlockDesc = pDesc;
+  return pSink;
+}
+
+// decode a block of a fetch rsp, the payload may be compressed
+SSDataBlock* qwtDecodeFetchBlock(const char* pPayload, bool compressed) {
+  int32_t dataLen = 0;
+  int32_t rawLen = 0;
+  memcpy(&dataLen, pPayload, sizeof(int32_t));
+  memcpy(&rawLen, pPayload + sizeof(int32_t), sizeof(int32_t));
+  pPayload += PAYLOAD_PREFIX_LEN;
+
+  char* pRaw = (char*)taosMemoryMalloc(rawLen);
+  if (compressed) {
+    EXPECT_EQ(tsDecompressString((void*)pPayload, dataLen, 1, pRaw, rawLen, ONE_STAGE_COMP, NULL, 0), rawLen);
+  } else {
+    EXPECT_EQ(dataLen, rawLen);
+    memcpy(pRaw, pPayload, rawLen);
+  }
+
+  SSDataBlock* pBlock = NULL;
+  const char*  pEnd = NULL;
+  EXPECT_EQ(createDataBlock(&pBlock), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(blockDecode(pBlock, pRaw, &pEnd), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(pEnd - pRaw, rawLen);
+  taosMemoryFree(pRaw);
+  return pBlock;
+}
+
+void qwtCompareFetchBlock(SSDataBlock* pExpect, SSDataBlock* pBlock) {
+  ASSERT_EQ(pBlock->info.rows, pExpect->info.rows);
+  ASSERT_EQ(taosArrayGetSize(pBlock->pDataBlock), taosArrayGetSize(pExpect->pDataBlock));
+  for (int32_t c = 0; c < taosArrayGetSize(pExpect->pDataBlock); ++c) {
+    SColumnInfoData* pExpCol = (SColumnInfoData*)taosArrayGet(pExpect->pDataBlock, c);
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, c);
+    for (int32_t i = 0; i < pExpect->info.rows; ++i) {
+      ASSERT_EQ(colDataIsNull_s(pCol, i), colDataIsNull_s(pExpCol, i));
+      if (!colDataIsNull_s(pExpCol, i)) {
+        ASSERT_EQ(memcmp(colDataGetData(pCol, i), colDataGetData(pExpCol, i), pExpCol->info.bytes), 0);
+      }
+    }
+  }
+}
+
+void qwtFetchInPlace(bool compress) {
+  int32_t         oldCompressMsgSize = tsCompressMsgSize;
+  SDataSinkMgtCfg cfg = {0};
+  void*           pManager = NULL;
+  DataSinkHandle  sinkHandle = NULL;
+  SDataSinkNode*  pSink = qwtCreateDispatchNode();
+
+  tsCompressMsgSize = compress ? 1 : -1;
+  cfg.compress = compress;
+  cfg.maxDataBlockNum = 500;
+  cfg.maxDataBlockNumPerQuery = 50;
+  ASSERT_EQ(dsDataSinkMgtInit(&cfg, NULL, &pManager), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(dsCreateDataSinker(pManager, pSink, &sinkHandle, NULL, "qwFetchTest"), TSDB_CODE_SUCCESS);
+
+  SSDataBlock* pBlocks[2] = {qwtCreateFetchBlock(qwtFetchRows, 1000), qwtCreateFetchBlock(qwtFetchRows / 2, 5000)};
+  for (int32_t i = 0; i < 2; ++i) {
+    SInputData input = {0};
+    bool       cont = false;
+    input.pData = pBlocks[i];
+    ASSERT_EQ(dsPutDataBlock(sinkHandle, &input, &cont), TSDB_CODE_SUCCESS);
+  }
+  dsEndPut(sinkHandle, 0);
+
+  SQWTaskCtx ctx;
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.sinkHandle = sinkHandle;
+
+  // the first block is handed over in place, the rsp is the sink buffer itself
+  int64_t len = 0;
+  int64_t rawLen = 0;
+  bool    queryEnd = false;
+  dsGetDataLength(sinkHandle, &len, &rawLen, &queryEnd);
+  ASSERT_GT(len, 0);
+
+  SRetrieveTableRsp* pRsp = NULL;
+  SOutputData        output = {0};
+  ASSERT_EQ(qwGetQueryResInPlaceFromSink(NULL, 0, 1, 2, 0, 0, &ctx, &pRsp, &output), TSDB_CODE_SUCCESS);
+  ASSERT_NE(pRsp, nullptr);
+  EXPECT_EQ(output.numOfRows, qwtFetchRows);
+  EXPECT_EQ(output.numOfCols, 2);
+  EXPECT_EQ(output.compressed, compress ? 1 : 0);
+  EXPECT_EQ(output.pData, pRsp->data + PAYLOAD_PREFIX_LEN);
+
+  char zero[sizeof(SRetrieveTableRsp)] = {0};
+  EXPECT_EQ(memcmp(pRsp, zero, offsetof(SRetrieveTableRsp, data)), 0);
+
+  int32_t prefix[2] = {0};
+  memcpy(prefix, pRsp->data, sizeof(prefix));
+  EXPECT_EQ(prefix[0], len);
+  EXPECT_EQ(prefix[1], rawLen);
+  if (compress) {
+    EXPECT_LT(prefix[0], prefix[1]);
+  }
+
+  SSDataBlock* pDecoded = qwtDecodeFetchBlock(pRsp->data, compress);
+  qwtCompareFetchBlock(pBlocks[0], pDecoded);
+  blockDataDestroy(pDecoded);
+  taosMemoryFree(pRsp);
+
+  // the second block is copied out by the regular path and decodes the same way
+  dsGetDataLength(sinkHandle, &len, &rawLen, &queryEnd);
+  ASSERT_GT(len, 0);
+  char* pCopy = (char*)taosMemoryCalloc(1, len + PAYLOAD_PREFIX_LEN);
+  int32_t copyPrefix[2] = {(int32_t)len, (int32_t)rawLen};
+  memcpy(pCopy, copyPrefix, sizeof(copyPrefix));
+  memset(&output, 0, sizeof(output));
+  output.pData = pCopy + PAYLOAD_PREFIX_LEN;
+  ASSERT_EQ(dsGetDataBlock(sinkHandle, &output), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(output.numOfRows, qwtFetchRows / 2);
+
+  pDecoded = qwtDecodeFetchBlock(pCopy, compress);
+  qwtCompareFetchBlock(pBlocks[1], pDecoded);
+  blockDataDestroy(pDecoded);
+  taosMemoryFree(pCopy);
+
+  // nothing is left in the sink
+  dsGetDataLength(sinkHandle, &len, &rawLen, &queryEnd);
+  EXPECT_EQ(len, 0);
+  EXPECT_TRUE(queryEnd);
+
+  blockDataDestroy(pBlocks[0]);
+  blockDataDestroy(pBlocks[1]);
+  dsDestroyDataSinker(sinkHandle);
+  nodesDestroyNode((SNode*)pSink);
+  tsCompressMsgSize = oldCompressMsgSize;
+}
+
+}  // namespace
+
+TEST(qwFetchTest, inPlaceRspFromSink) { qwtFetchInPlace(false); }
+
+TEST(qwFetchTest, inPlaceCompressedRspFromSink) { qwtFetchInPlace(true); }
+
+#pragma GCC diagnostic pop
@@ -63,6 +63,9 @@ typedef enum {
 #define SCH_MIN_AYSNC_EXEC_NUM        3
 #define SCH_DEFAULT_RETRY_TOTAL_ROUND 3
 #define SCH_DEFAULT_TASK_CAPACITY_NUM 1000     
+#define SCH_NODE_LOAD_EXPIRE_MSEC     30000
+#define SCH_NODE_QUEUED_TASK_COST_US  1000
+#define SCH_NODE_BUSY_QUEUE_NUM       8
 
 typedef struct SSchDebug {
   bool lockEnable;
@@ -82,6 +85,12 @@ typedef struct SSchHbTrans {
   SSchTrans trans;
 } SSchHbTrans;
 
+typedef struct SSchNodeLoad {
+  int32_t queryInQueue;
+  int64_t queryWaitUs;
+  int64_t updateTs;
+} SSchNodeLoad;
+
 typedef struct SSchApiStat {
 #if defined(WINDOWS) || defined(_TD_DARWIN_64)
   size_t avoidCompilationErrors;
@@ -152,6 +161,7 @@ typedef struct SSchedulerMgmt {
   void         *timer;
   SRWLatch      hbLock;
   SHashObj     *hbConnections;
+  SHashObj     *nodeLoad;  // key: SQueryNodeEpId, value: SSchNodeLoad
   void         *queryMgmt;
 } SSchedulerMgmt;
 
@@ -592,6 +602,9 @@ void     schFreeJobImpl(void *job);
 int32_t  schMakeHbRpcCtx(SSchJob *pJob, SSchTask *pTask, SRpcCtx *pCtx);
 int32_t  schEnsureHbConnection(SSchJob *pJob, SSchTask *pTask);
 int32_t  schUpdateHbConnection(SQueryNodeEpId *epId, SSchTrans *trans);
+void     schUpdateNodeLoad(SQueryNodeEpId *epId, int32_t queryInQueue, int64_t queryWaitUs);
+int32_t  schGetNodeLoad(SQueryNodeAddr *addr, SSchNodeLoad *pLoad);
+int64_t  schGetNodeTableQuota(SQueryNodeAddr *addr);
 int32_t  schHandleHbCallback(void *param, SDataBuf *pMsg, int32_t code);
 void     schFreeRpcCtx(SRpcCtx *pCtx);
 int32_t  schGetCallbackFp(int32_t msgType, __async_send_cb_fn_t *fp);
@@ -647,6 +660,7 @@ void     schGetTaskFromList(SHashObj *pTaskList, uint64_t taskId, SSchTask **pTa
 int32_t  schValidateSubplan(SSchJob *pJob, SSubplan* pSubplan, int32_t level, int32_t idx, int32_t taskNum);
 int32_t  schInitTask(SSchJob *pJob, SSchTask *pTask, SSubplan *pPlan, SSchLevel *pLevel);
 int32_t  schSwitchTaskCandidateAddr(SSchJob *pJob, SSchTask *pTask);
+void     schSetTaskLeastLoadedCandidate(SSchJob *pJob, SSchTask *pTask);
 void     schDirectPostJobRes(SSchedulerReq *pReq, int32_t errCode);
 int32_t  schHandleJobFailure(SSchJob *pJob, int32_t errCode);
 int32_t  schHandleJobDrop(SSchJob *pJob, int32_t errCode);
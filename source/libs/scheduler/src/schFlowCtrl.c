@@ -148,7 +148,7 @@ int32_t schCheckIncTaskFlowQuota(SSchJob *pJob, SSchTask *pTask, bool *enough) {
 
     int64_t sum = pTask->plan->execNodeStat.tableNum + ctrl->tableNumSum;
 
-    if (sum <= schMgmt.cfg.maxNodeTableNum) {
+    if (sum <= schGetNodeTableQuota(&pTask->plan->execNode)) {
       ctrl->tableNumSum = sum;
       ++ctrl->execTaskNum;
 
@@ -224,7 +224,8 @@ int32_t schLaunchTasksInFlowCtrlListImpl(SSchJob *pJob, SSchFlowControl *ctrl) {
     }
     SEp *ep = SCH_GET_CUR_EP(&pTask->plan->execNode);
 
-    if (pTask->plan->execNodeStat.tableNum > remainNum && ctrl->execTaskNum > 0) {
+    int64_t nodeRemainNum = TMIN(remainNum, schGetNodeTableQuota(&pTask->plan->execNode) - ctrl->tableNumSum);
+    if (pTask->plan->execNodeStat.tableNum > nodeRemainNum && ctrl->execTaskNum > 0) {
       SCH_TASK_DLOG("task NOT to launch, fqdn:%s, port:%d, tableNum:%d, remainNum:%" PRId64 ", remainExecTaskNum:%d", ep->fqdn,
                     ep->port, pTask->plan->execNodeStat.tableNum, ctrl->tableNumSum, ctrl->execTaskNum);
 
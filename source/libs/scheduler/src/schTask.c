@@ -807,6 +807,37 @@ int32_t schSetAddrsFromNodeList(SSchJob *pJob, SSchTask *pTask) {
   return TSDB_CODE_SUCCESS;
 }
 
+// start from the candidate with the least queued work reported by hb, nodes without a recent report count as idle
+void schSetTaskLeastLoadedCandidate(SSchJob *pJob, SSchTask *pTask) {
+  int32_t candidateNum = taosArrayGetSize(pTask->candidateAddrs);
+  int32_t startIdx = taosRand() % candidateNum;
+  int64_t minCost = INT64_MAX;
+
+  pTask->candidateIdx = startIdx;
+
+  for (int32_t i = 0; i < candidateNum; ++i) {
+    int32_t         idx = (startIdx + i) % candidateNum;
+    SQueryNodeAddr *addr = taosArrayGet(pTask->candidateAddrs, idx);
+    SSchNodeLoad    load = {0};
+    if (NULL == addr || schGetNodeLoad(addr, &load)) {
+      load.queryInQueue = 0;
+      load.queryWaitUs = 0;
+    }
+
+    int64_t cost = load.queryWaitUs + (int64_t)load.queryInQueue * SCH_NODE_QUEUED_TASK_COST_US;
+    if (cost < minCost) {
+      minCost = cost;
+      pTask->candidateIdx = idx;
+    }
+
+    if (0 == cost) {
+      break;
+    }
+  }
+
+  SCH_TASK_DLOG("choose candidate %d/%d, cost:%" PRId64, pTask->candidateIdx, candidateNum, minCost);
+}
+
 int32_t schSetTaskCandidateAddrs(SSchJob *pJob, SSchTask *pTask) {
   if (NULL != pTask->candidateAddrs) {
     return TSDB_CODE_SUCCESS;
@@ -836,7 +867,7 @@ int32_t schSetTaskCandidateAddrs(SSchJob *pJob, SSchTask *pTask) {
 
   SCH_ERR_RET(schSetAddrsFromNodeList(pJob, pTask));
 
-  pTask->candidateIdx = taosRand() % taosArrayGetSize(pTask->candidateAddrs);
+  schSetTaskLeastLoadedCandidate(pJob, pTask);
 
   /*
     for (int32_t i = 0; i < job->dataSrcEps.numOfEps && addNum < SCH_MAX_CANDIDATE_EP_NUM; ++i) {
@@ -282,6 +282,69 @@ int32_t schUpdateHbConnection(SQueryNodeEpId *epId, SSchTrans *trans) {
   return TSDB_CODE_SUCCESS;
 }
 
+void schUpdateNodeLoad(SQueryNodeEpId *epId, int32_t queryInQueue, int64_t queryWaitUs) {
+  SSchNodeLoad load = {.queryInQueue = queryInQueue, .queryWaitUs = queryWaitUs, .updateTs = taosGetTimestampMs()};
+
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  SCH_LOCK(SCH_READ, &schMgmt.hbLock);
+  if (schMgmt.nodeLoad) {
+    code = taosHashPut(schMgmt.nodeLoad, epId, sizeof(SQueryNodeEpId), &load, sizeof(load));
+  }
+  SCH_UNLOCK(SCH_READ, &schMgmt.hbLock);
+
+  if (code) {
+    qWarn("update node load failed, nodeId:%d, fqdn:%s, port:%d, error:%s", epId->nodeId, epId->ep.fqdn, epId->ep.port,
+          tstrerror(code));
+    return;
+  }
+
+  qTrace("node load updated, nodeId:%d, fqdn:%s, port:%d, queryInQueue:%d, queryWaitUs:%" PRId64, epId->nodeId,
+         epId->ep.fqdn, epId->ep.port, queryInQueue, queryWaitUs);
+}
+
+// the load reported by the last hb of the node that addr currently points to, TSDB_CODE_NOT_FOUND if unknown or expired
+int32_t schGetNodeLoad(SQueryNodeAddr *addr, SSchNodeLoad *pLoad) {
+  SQueryNodeEpId epId = {0};
+  SEp           *pEp = SCH_GET_CUR_EP(addr);
+
+  epId.nodeId = addr->nodeId;
+  TAOS_STRCPY(epId.ep.fqdn, pEp->fqdn);
+  epId.ep.port = pEp->port;
+
+  SSchNodeLoad *pNodeLoad = NULL;
+
+  SCH_LOCK(SCH_READ, &schMgmt.hbLock);
+  if (schMgmt.nodeLoad) {
+    pNodeLoad = taosHashAcquire(schMgmt.nodeLoad, &epId, sizeof(epId));
+    if (pNodeLoad) {
+      *pLoad = *pNodeLoad;
+      taosHashRelease(schMgmt.nodeLoad, pNodeLoad);
+    }
+  }
+  SCH_UNLOCK(SCH_READ, &schMgmt.hbLock);
+
+  if (NULL == pNodeLoad) {
+    return TSDB_CODE_NOT_FOUND;
+  }
+
+  if (taosGetTimestampMs() - pLoad->updateTs > SCH_NODE_LOAD_EXPIRE_MSEC) {
+    return TSDB_CODE_NOT_FOUND;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// shrink the per node table quota of flow control as the node's query queue builds up
+int64_t schGetNodeTableQuota(SQueryNodeAddr *addr) {
+  SSchNodeLoad load = {0};
+  if (schGetNodeLoad(addr, &load) || load.queryInQueue < SCH_NODE_BUSY_QUEUE_NUM) {
+    return schMgmt.cfg.maxNodeTableNum;
+  }
+
+  return TMAX(schMgmt.cfg.maxNodeTableNum / (1 + load.queryInQueue / SCH_NODE_BUSY_QUEUE_NUM), 1);
+}
+
 void schCloseJobRef(void) {
   if (!atomic_load_8((int8_t *)&schMgmt.exit)) {
     return;
@@ -50,6 +50,12 @@ int32_t schedulerInit() {
     SCH_ERR_RET(terrno);
   }
 
+  schMgmt.nodeLoad = taosHashInit(100, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_ENTRY_LOCK);
+  if (NULL == schMgmt.nodeLoad) {
+    qError("taosHashInit node load failed");
+    SCH_ERR_RET(terrno);
+  }
+
   schMgmt.timer = taosTmrInit(0, 0, 0, "scheduler");
   if (NULL == schMgmt.timer) {
     qError("init timer failed, error:%s", tstrerror(terrno));
@@ -219,6 +225,9 @@ void schedulerDestroy(void) {
     taosHashCleanup(schMgmt.hbConnections);
     schMgmt.hbConnections = NULL;
   }
+
+  taosHashCleanup(schMgmt.nodeLoad);
+  schMgmt.nodeLoad = NULL;
   SCH_UNLOCK(SCH_WRITE, &schMgmt.hbLock);
 
   qWorkerDestroy(&schMgmt.queryMgmt);
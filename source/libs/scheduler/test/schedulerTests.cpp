@@ -1295,6 +1295,49 @@ TEST(otherTest, otherCase) {
   ASSERT_EQ(strcmp(schGetOpStr((SCH_OP_TYPE)100), "UNKNOWN"), 0);
 }
 
+TEST(otherTest, nodeLoadCase) {
+  bool localHash = (NULL == schMgmt.nodeLoad);
+  if (localHash) {
+    schMgmt.nodeLoad = taosHashInit(10, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_ENTRY_LOCK);
+    ASSERT_NE(schMgmt.nodeLoad, nullptr);
+  }
+
+  int64_t maxNodeTableNum = schMgmt.cfg.maxNodeTableNum;
+  schMgmt.cfg.maxNodeTableNum = 1000;
+
+  SQueryNodeAddr addr = {0};
+  addr.nodeId = 2;
+  addr.epSet.numOfEps = 1;
+  TAOS_STRCPY(addr.epSet.eps[0].fqdn, "localhost");
+  addr.epSet.eps[0].port = 6030;
+
+  SSchNodeLoad load = {0};
+  ASSERT_EQ(schGetNodeLoad(&addr, &load), TSDB_CODE_NOT_FOUND);
+  ASSERT_EQ(schGetNodeTableQuota(&addr), 1000);
+
+  SQueryNodeEpId epId = {0};
+  epId.nodeId = 2;
+  TAOS_STRCPY(epId.ep.fqdn, "localhost");
+  epId.ep.port = 6030;
+
+  schUpdateNodeLoad(&epId, SCH_NODE_BUSY_QUEUE_NUM * 3, 5000);
+  ASSERT_EQ(schGetNodeLoad(&addr, &load), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(load.queryInQueue, SCH_NODE_BUSY_QUEUE_NUM * 3);
+  ASSERT_EQ(load.queryWaitUs, 5000);
+  ASSERT_EQ(schGetNodeTableQuota(&addr), 250);
+
+  schUpdateNodeLoad(&epId, 0, 0);
+  ASSERT_EQ(schGetNodeTableQuota(&addr), 1000);
+
+  schMgmt.cfg.maxNodeTableNum = maxNodeTableNum;
+  if (localHash) {
+    taosHashCleanup(schMgmt.nodeLoad);
+    schMgmt.nodeLoad = NULL;
+  } else {
+    (void)taosHashRemove(schMgmt.nodeLoad, &epId, sizeof(epId));
+  }
+}
+
 int main(int argc, char **argv) {
   schtInitLogFile();
   if (rpcInit()) {
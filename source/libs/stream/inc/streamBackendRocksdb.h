@@ -237,6 +237,9 @@ char*   streamDefaultIterVal_rocksdb(void* iter, int32_t* len);
 int     streamStateGetCfIdx(SStreamState* pState, const char* funcName);
 void*   streamStateCreateBatch();
 int32_t streamStateGetBatchSize(void* pBatch);
+int64_t streamStateGetBatchDataSize(void* pBatch);
+int32_t streamStateEncodeKey(int32_t cfIdx, void* key, char* buf);
+int32_t streamStateCompareEncodedKey(int32_t cfIdx, const char* pKey1, int32_t len1, const char* pKey2, int32_t len2);
 void    streamStateClearBatch(void* pBatch);
 void    streamStateDestroyBatch(void* pBatch);
 int32_t streamStatePutBatch(SStreamState* pState, const char* cfName, rocksdb_writebatch_t* pBatch, void* key,
@@ -244,6 +247,8 @@ int32_t streamStatePutBatch(SStreamState* pState, const char* cfName, rocksdb_wr
 
 int32_t streamStatePutBatchOptimize(SStreamState* pState, int32_t cfIdx, rocksdb_writebatch_t* pBatch, void* key,
                                     void* val, int32_t vlen, int64_t ttl, void* tmpBuf);
+int32_t streamStatePutBatchEncoded(SStreamState* pState, int32_t cfIdx, rocksdb_writebatch_t* pBatch, const char* pKey,
+                                   int32_t klen, void* val, int32_t vlen, int64_t ttl, void* tmpBuf);
 
 int32_t streamStatePutBatch_rocksdb(SStreamState* pState, void* pBatch);
 int32_t streamBackendTriggerChkp(void* pMeta, char* dst);
@@ -4479,6 +4479,19 @@ int32_t streamStateGetBatchSize(void* pBatch) {
   return rocksdb_writebatch_count(pBatch);
 }
 
+int64_t streamStateGetBatchDataSize(void* pBatch) {
+  size_t size = 0;
+  if (pBatch == NULL) return 0;
+  TAOS_UNUSED(rocksdb_writebatch_data((rocksdb_writebatch_t*)pBatch, &size));
+  return (int64_t)size;
+}
+
+int32_t streamStateEncodeKey(int32_t cfIdx, void* key, char* buf) { return ginitDict[cfIdx].enFunc(key, buf); }
+
+int32_t streamStateCompareEncodedKey(int32_t cfIdx, const char* pKey1, int32_t len1, const char* pKey2, int32_t len2) {
+  return ginitDict[cfIdx].cmpKey(NULL, pKey1, (size_t)len1, pKey2, (size_t)len2);
+}
+
 void    streamStateClearBatch(void* pBatch) { rocksdb_writebatch_clear((rocksdb_writebatch_t*)pBatch); }
 void    streamStateDestroyBatch(void* pBatch) { rocksdb_writebatch_destroy((rocksdb_writebatch_t*)pBatch); }
 int32_t streamStatePutBatch(SStreamState* pState, const char* cfKeyName, rocksdb_writebatch_t* pBatch, void* key,
@@ -4513,8 +4526,14 @@ int32_t streamStatePutBatch(SStreamState* pState, const char* cfKeyName, rocksdb
 
 int32_t streamStatePutBatchOptimize(SStreamState* pState, int32_t cfIdx, rocksdb_writebatch_t* pBatch, void* key,
                                     void* val, int32_t vlen, int64_t ttl, void* tmpBuf) {
-  int32_t code = 0;
   char    buf[128] = {0};
+  int32_t klen = ginitDict[cfIdx].enFunc((void*)key, buf);
+  return streamStatePutBatchEncoded(pState, cfIdx, pBatch, buf, klen, val, vlen, ttl, tmpBuf);
+}
+
+int32_t streamStatePutBatchEncoded(SStreamState* pState, int32_t cfIdx, rocksdb_writebatch_t* pBatch, const char* pKey,
+                                   int32_t klen, void* val, int32_t vlen, int64_t ttl, void* tmpBuf) {
+  int32_t code = 0;
 
   char*  dst = NULL;
   size_t size = 0;
@@ -4527,7 +4546,6 @@ int32_t streamStatePutBatchOptimize(SStreamState* pState, int32_t cfIdx, rocksdb
       return code;
     }
   }
-  int32_t klen = ginitDict[cfIdx].enFunc((void*)key, buf);
   char*   ttlV = tmpBuf;
   int32_t ttlVLen = ginitDict[cfIdx].enValueFunc(dst, size, ttl, &ttlV);
 
@@ -4536,19 +4554,17 @@ int32_t streamStatePutBatchOptimize(SStreamState* pState, int32_t cfIdx, rocksdb
   TAOS_UNUSED(atomic_add_fetch_64(&wrapper->dataWritten, 1));
 
   rocksdb_column_family_handle_t* pCf = wrapper->pCf[ginitDict[cfIdx].idx];
-  rocksdb_writebatch_put_cf((rocksdb_writebatch_t*)pBatch, pCf, buf, (size_t)klen, ttlV, (size_t)ttlVLen);
+  rocksdb_writebatch_put_cf((rocksdb_writebatch_t*)pBatch, pCf, pKey, (size_t)klen, ttlV, (size_t)ttlVLen);
 
-  taosMemoryFree(dst);
+  if (dst != val) {
+    taosMemoryFree(dst);
+  }
 
   if (tmpBuf == NULL) {
     taosMemoryFree(ttlV);
   }
 
-  {
-    char tbuf[256] = {0};
-    TAOS_UNUSED(ginitDict[cfIdx].toStrFunc((void*)key, tbuf));
-    stTrace("streamState str: %s succ to write to %s_%s", tbuf, wrapper->idstr, ginitDict[cfIdx].key);
-  }
+  stTrace("streamState succ to write %d bytes to %s_%s", ttlVLen, wrapper->idstr, ginitDict[cfIdx].key);
   return 0;
 }
 int32_t streamStatePutBatch_rocksdb(SStreamState* pState, void* pBatch) {
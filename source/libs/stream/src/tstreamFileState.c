@@ -26,6 +26,7 @@
 #define FLUSH_NUM                      4
 #define DEFAULT_MAX_STREAM_BUFFER_SIZE (128 * 1024 * 1024)
 #define MIN_NUM_OF_ROW_BUFF            10240
+#define STREAM_FLUSH_BATCH_SIZE        (16 * 1024 * 1024)
 #define MIN_NUM_OF_RECOVER_ROW_BUFF    128
 
 #define TASK_KEY               "streamFileState"
@@ -685,16 +686,30 @@ SStreamSnapshot* getSnapshot(SStreamFileState* pFileState) {
   return pFileState->usedBuffs;
 }
 
+typedef struct SFlushKey {
+  SRowBuffPos* pPos;
+  int32_t      cfIdx;
+  int32_t      len;
+  char         key[];
+} SFlushKey;
+
+static int32_t flushKeyComp(const void* pLeft, const void* pRight) {
+  SFlushKey* pKey1 = *(SFlushKey**)pLeft;
+  SFlushKey* pKey2 = *(SFlushKey**)pRight;
+  return streamStateCompareEncodedKey(pKey1->cfIdx, pKey1->key, pKey1->len, pKey2->key, pKey2->len);
+}
+
 void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState) {
   int32_t   code = TSDB_CODE_SUCCESS;
   int32_t   lino = 0;
   SListIter iter = {0};
   tdListInitIter(pSnapshot, &iter, TD_LIST_FORWARD);
 
-  const int32_t BATCH_LIMIT = 256;
-
   int64_t    st = taosGetTimestampMs();
   SListNode* pNode = NULL;
+  SArray*    pKeys = NULL;
+  void*      batch = NULL;
+  int32_t    numOfWrites = 0;
 
   int idx = streamStateGetCfIdx(pFileState->pFileStore, pFileState->cfName);
 
@@ -705,13 +720,16 @@ void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, boo
     QUERY_CHECK_CODE(code, lino, _end);
   }
 
-  void* batch = streamStateCreateBatch();
+  batch = streamStateCreateBatch();
   if (!batch) {
     code = TSDB_CODE_OUT_OF_MEMORY;
     QUERY_CHECK_CODE(code, lino, _end);
   }
 
-  while ((pNode = tdListNext(&iter)) != NULL && code == TSDB_CODE_SUCCESS) {
+  pKeys = taosArrayInit(TMAX(listNEles(pSnapshot), 1), POINTER_BYTES);
+  QUERY_CHECK_NULL(pKeys, code, lino, _end, terrno);
+
+  while ((pNode = tdListNext(&iter)) != NULL) {
     SRowBuffPos* pPos = *(SRowBuffPos**)pNode->data;
     if (pPos->beFlushed || !pPos->pRowBuff) {
       continue;
@@ -719,39 +737,55 @@ void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, boo
     pPos->beFlushed = true;
     pFileState->flushMark = TMAX(pFileState->flushMark, pFileState->getTs(pPos->pKey));
 
+    void* pSKey = pFileState->stateBuffCreateStateKeyFn(pPos, ((SStreamState*)pFileState->pFileStore)->number);
+    QUERY_CHECK_NULL(pSKey, code, lino, _end, terrno);
+
+    char    keyBuf[128] = {0};
+    int32_t klen = streamStateEncodeKey(idx, pSKey, keyBuf);
+    taosMemoryFreeClear(pSKey);
+
+    SFlushKey* pKey = taosMemoryMalloc(sizeof(SFlushKey) + klen);
+    QUERY_CHECK_NULL(pKey, code, lino, _end, terrno);
+    pKey->pPos = pPos;
+    pKey->cfIdx = idx;
+    pKey->len = klen;
+    memcpy(pKey->key, keyBuf, klen);
+    if (taosArrayPush(pKeys, &pKey) == NULL) {
+      taosMemoryFree(pKey);
+      code = terrno;
+      QUERY_CHECK_CODE(code, lino, _end);
+    }
+  }
+
+  // the dirty rows leave the buffer in lru order, hand them to rocksdb as one sorted run instead, so that the memtable
+  // inserts are sequential and the flushed sst does not overlap with every other one.
+  taosArraySort(pKeys, flushKeyComp);
+
+  int32_t numOfElems = taosArrayGetSize(pKeys);
+  for (int32_t i = 0; i < numOfElems; i++) {
+    SFlushKey*   pKey = taosArrayGetP(pKeys, i);
+    SRowBuffPos* pPos = pKey->pPos;
+
     qDebug("===stream===flushed start:%" PRId64, pFileState->getTs(pPos->pKey));
-    if (streamStateGetBatchSize(batch) >= BATCH_LIMIT) {
+    if (streamStateGetBatchDataSize(batch) >= STREAM_FLUSH_BATCH_SIZE) {
       code = streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
       streamStateClearBatch(batch);
       QUERY_CHECK_CODE(code, lino, _end);
+      numOfWrites++;
     }
 
-    void* pSKey = pFileState->stateBuffCreateStateKeyFn(pPos, ((SStreamState*)pFileState->pFileStore)->number);
-    QUERY_CHECK_NULL(pSKey, code, lino, _end, terrno);
-
-    code = streamStatePutBatchOptimize(pFileState->pFileStore, idx, batch, pSKey, pPos->pRowBuff, pFileState->rowSize,
-                                       0, buf);
-    taosMemoryFreeClear(pSKey);
+    code = streamStatePutBatchEncoded(pFileState->pFileStore, idx, batch, pKey->key, pKey->len, pPos->pRowBuff,
+                                      pFileState->rowSize, 0, buf);
     QUERY_CHECK_CODE(code, lino, _end);
-    // todo handle failure
     memset(buf, 0, len);
   }
   taosMemoryFreeClear(buf);
 
-  int32_t numOfElems = streamStateGetBatchSize(batch);
-  if (numOfElems > 0) {
-    code = streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
-    QUERY_CHECK_CODE(code, lino, _end);
-  } else {
+  if (numOfElems == 0) {
     goto _end;
   }
 
-  streamStateClearBatch(batch);
-
-  int64_t elapsed = taosGetTimestampMs() - st;
-  qDebug("%s flush to disk in batch model completed, rows:%d, batch size:%d, elapsed time:%" PRId64 "ms",
-         pFileState->id, numOfElems, BATCH_LIMIT, elapsed);
-
+  // the flush mark goes out in the same write with the rows it covers
   if (flushState) {
     void*   valBuf = NULL;
     int32_t len = 0;
@@ -762,16 +796,22 @@ void flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, boo
     code = streamStatePutBatch(pFileState->pFileStore, "default", batch, STREAM_STATE_INFO_NAME, valBuf, len, 0);
     taosMemoryFree(valBuf);
     QUERY_CHECK_CODE(code, lino, _end);
-
-    code = streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
-    QUERY_CHECK_CODE(code, lino, _end);
   }
 
+  code = streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
+  QUERY_CHECK_CODE(code, lino, _end);
+  numOfWrites++;
+
+  int64_t elapsed = taosGetTimestampMs() - st;
+  qDebug("%s flush to disk in batch model completed, rows:%d, writes:%d, elapsed time:%" PRId64 "ms", pFileState->id,
+         numOfElems, numOfWrites, elapsed);
+
 _end:
   if (code != TSDB_CODE_SUCCESS) {
     qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
   }
   taosMemoryFree(buf);
+  taosArrayDestroyP(pKeys, taosMemoryFree);
   streamStateDestroyBatch(batch);
 }
 
@@ -491,6 +491,134 @@ TEST_F(BackendEnv, oldBackendInit) {
   taosRemoveDir(path);
 }
 
+// key of the flush mark in the default column family, see tstreamFileState.c
+#define STREAM_STATE_INFO_NAME "StreamStateCheckPoint"
+
+TSKEY flushTestGetTs(void *pKey) { return ((SWinKey *)pKey)->ts; }
+
+void flushTestFillRow(char *pRow, int32_t rowSize, const SWinKey *pKey) {
+  for (int32_t i = 0; i < rowSize; i++) {
+    pRow[i] = (char)(pKey->groupId * 31 + pKey->ts + i);
+  }
+}
+
+// the flush before the sorted write batch: rows in lru order, a rocksdb write every 256 puts and the flush mark after
+void flushTestLegacyFlush(SStreamState *pState, const std::vector<SWinKey> &keys, int32_t rowSize) {
+  int32_t idx = streamStateGetCfIdx(pState, "state");
+  void   *pBatch = streamStateCreateBatch();
+  char   *pRow = (char *)taosMemoryCalloc(1, rowSize);
+  TSKEY   flushMark = INT64_MIN;
+  ASSERT_TRUE(pBatch != NULL && pRow != NULL);
+
+  for (int32_t i = 0; i < keys.size(); i++) {
+    if (streamStateGetBatchSize(pBatch) >= 256) {
+      ASSERT_EQ(streamStatePutBatch_rocksdb(pState, pBatch), 0);
+      streamStateClearBatch(pBatch);
+    }
+    SStateKey key = {.key = keys[i], .opNum = pState->number};
+    flushTestFillRow(pRow, rowSize, &keys[i]);
+    ASSERT_EQ(streamStatePutBatchOptimize(pState, idx, (rocksdb_writebatch_t *)pBatch, &key, pRow, rowSize, 0, NULL), 0);
+    flushMark = TMAX(flushMark, keys[i].ts);
+  }
+  ASSERT_EQ(streamStatePutBatch_rocksdb(pState, pBatch), 0);
+  streamStateClearBatch(pBatch);
+
+  char  markBuf[sizeof(TSKEY)] = {0};
+  void *pMark = markBuf;
+  TAOS_UNUSED(taosEncodeFixedI64(&pMark, flushMark));
+  ASSERT_EQ(streamStatePutBatch(pState, "default", (rocksdb_writebatch_t *)pBatch, (void *)STREAM_STATE_INFO_NAME,
+                                markBuf, sizeof(TSKEY), 0),
+            0);
+  ASSERT_EQ(streamStatePutBatch_rocksdb(pState, pBatch), 0);
+
+  taosMemoryFree(pRow);
+  streamStateDestroyBatch(pBatch);
+}
+
+TEST_F(BackendEnv, flushSortedBatch) {
+  streamMetaInit();
+  const char   *newPath = "/tmp/backend_flush_new";
+  const char   *oldPath = "/tmp/backend_flush_old";
+  SStreamState *pNew = stateCreate(newPath);
+  SStreamState *pOld = stateCreate(oldPath);
+  ASSERT_TRUE(pNew != NULL && pOld != NULL);
+
+  // rows large enough for the flush to be cut into several size-bounded writes, put in an order unrelated to the keys
+  const int32_t        rowSize = 40 * 1024;
+  const int32_t        numOfRows = 1000;
+  std::vector<SWinKey> keys;
+  for (int32_t i = 0; i < numOfRows; i++) {
+    SWinKey key = {0};
+    key.groupId = (uint64_t)((i * 7919) % 13);
+    key.ts = 1700000000000 + ((int64_t)i * 104729) % 100003;
+    keys.push_back(key);
+  }
+
+  SStreamFileState *pFileState = NULL;
+  int32_t code = streamFileStateInit((int64_t)rowSize * numOfRows * 2, sizeof(SWinKey), rowSize, 0, flushTestGetTs,
+                                     pNew, INT64_MAX, "flushSortedBatch", 0, STREAM_STATE_BUFF_HASH, &pFileState);
+  ASSERT_EQ(code, 0);
+
+  for (int32_t i = 0; i < numOfRows; i++) {
+    SRowBuffPos *pPos = NULL;
+    int32_t      vLen = 0;
+    int32_t      winCode = 0;
+    ASSERT_EQ(getRowBuff(pFileState, &keys[i], sizeof(SWinKey), (void **)&pPos, &vLen, &winCode), 0);
+    ASSERT_EQ(vLen, rowSize);
+    flushTestFillRow((char *)pPos->pRowBuff, rowSize, &keys[i]);
+  }
+  flushSnapshot(pFileState, getSnapshot(pFileState), true);
+  streamFileStateDestroy(pFileState);
+
+  flushTestLegacyFlush(pOld, keys, rowSize);
+
+  char *pExpect = (char *)taosMemoryCalloc(1, rowSize);
+  ASSERT_TRUE(pExpect != NULL);
+  TSKEY maxTs = INT64_MIN;
+  for (int32_t i = 0; i < numOfRows; i++) {
+    void   *pNewVal = NULL;
+    void   *pOldVal = NULL;
+    int32_t newLen = 0;
+    int32_t oldLen = 0;
+    ASSERT_EQ(streamStateGet_rocksdb(pNew, &keys[i], &pNewVal, &newLen), 0);
+    ASSERT_EQ(streamStateGet_rocksdb(pOld, &keys[i], &pOldVal, &oldLen), 0);
+    flushTestFillRow(pExpect, rowSize, &keys[i]);
+    ASSERT_EQ(newLen, rowSize);
+    ASSERT_EQ(oldLen, rowSize);
+    ASSERT_EQ(memcmp(pNewVal, pExpect, rowSize), 0);
+    ASSERT_EQ(memcmp(pNewVal, pOldVal, rowSize), 0);
+    taosMemoryFree(pNewVal);
+    taosMemoryFree(pOldVal);
+    maxTs = TMAX(maxTs, keys[i].ts);
+  }
+  taosMemoryFree(pExpect);
+
+  // both flushes leave the same flush mark behind, the one a reopened file state starts from
+  void   *pNewMark = NULL;
+  void   *pOldMark = NULL;
+  int32_t newMarkLen = 0;
+  int32_t oldMarkLen = 0;
+  ASSERT_EQ(streamDefaultGet_rocksdb(pNew, STREAM_STATE_INFO_NAME, &pNewMark, &newMarkLen), 0);
+  ASSERT_EQ(streamDefaultGet_rocksdb(pOld, STREAM_STATE_INFO_NAME, &pOldMark, &oldMarkLen), 0);
+  ASSERT_EQ(newMarkLen, sizeof(TSKEY));
+  ASSERT_EQ(oldMarkLen, sizeof(TSKEY));
+  ASSERT_EQ(memcmp(pNewMark, pOldMark, sizeof(TSKEY)), 0);
+  taosMemoryFree(pNewMark);
+  taosMemoryFree(pOldMark);
+
+  code = streamFileStateInit((int64_t)rowSize * 16, sizeof(SWinKey), rowSize, 0, flushTestGetTs, pNew, INT64_MAX,
+                             "flushSortedBatch", 0, STREAM_STATE_BUFF_HASH, &pFileState);
+  ASSERT_EQ(code, 0);
+  ASSERT_TRUE(isFlushedState(pFileState, maxTs, 0));
+  ASSERT_FALSE(isFlushedState(pFileState, maxTs + 1, 0));
+  streamFileStateDestroy(pFileState);
+
+  streamStateClose(pNew, true);
+  streamStateClose(pOld, true);
+  taosRemoveDir(newPath);
+  taosRemoveDir(oldPath);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
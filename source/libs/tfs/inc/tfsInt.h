@@ -40,7 +40,16 @@ typedef struct {
   int32_t   id;
   int8_t    disable;  // disable create new file
   char     *path;
+  int32_t   pathLen;
   SDiskSize size;
+  // placement statistics, guarded by the tier lock
+  int32_t curWeight;    // smooth weighted round-robin state
+  int64_t allocNum;     // # of files placed on the disk
+  int64_t hotAllocNum;  // # of hot files placed on the disk
+  int64_t writeBytes;   // bytes synced to the disk
+  int64_t writeCost;    // EWMA of sync cost, us per MB, 0 if not measured yet
+  int64_t recentBytes;  // bytes synced recently, halved every TFS_LOAD_HALF_LIFE_MS
+  int64_t recentTs;     // ms of the last decay of recentBytes
 } STfsDisk;
 
 typedef struct {
@@ -82,7 +91,8 @@ int32_t tfsInitTier(STfsTier *pTier, int32_t level);
 void    tfsDestroyTier(STfsTier *pTier);
 int32_t tfsMountDiskToTier(STfsTier *pTier, SDiskCfg *pCfg, STfsDisk **ppDisk);
 void    tfsUpdateTierSize(STfsTier *pTier);
-int32_t tfsAllocDiskOnTier(STfsTier *pTier);
+int32_t tfsAllocDiskOnTier(STfsTier *pTier, ETfsFileTemp temp);
+void    tfsRecordDiskWrite(STfsTier *pTier, STfsDisk *pDisk, int64_t bytes, int64_t costUs);
 void    tfsPosNextId(STfsTier *pTier);
 
 #define tfsLockTier(pTier)   taosThreadSpinLock(&(pTier)->lock)
@@ -97,6 +107,9 @@ void    tfsPosNextId(STfsTier *pTier);
 
 #define TMPNAME_LEN (TSDB_FILENAME_LEN * 2 + 32)
 
+#define TFS_LOAD_HALF_LIFE_MS 10000
+#define TFS_HOT_COST_SLACK    25  // percent above the fastest disk still taken as fast
+
 #ifdef __cplusplus
 }
 #endif
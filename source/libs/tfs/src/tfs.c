@@ -154,6 +154,10 @@ int32_t tfsGetDisksAtLevel(STfs *pTfs, int32_t level) {
 int32_t tfsGetLevel(STfs *pTfs) { return pTfs->nlevel; }
 
 int32_t tfsAllocDisk(STfs *pTfs, int32_t expLevel, SDiskID *pDiskId) {
+  return tfsAllocDiskByTemp(pTfs, expLevel, TFS_FILE_WARM, pDiskId);
+}
+
+int32_t tfsAllocDiskByTemp(STfs *pTfs, int32_t expLevel, ETfsFileTemp temp, SDiskID *pDiskId) {
   pDiskId->level = expLevel;
   pDiskId->id = -1;
 
@@ -166,7 +170,7 @@ int32_t tfsAllocDisk(STfs *pTfs, int32_t expLevel, SDiskID *pDiskId) {
   }
 
   while (pDiskId->level >= 0) {
-    pDiskId->id = tfsAllocDiskOnTier(&pTfs->tiers[pDiskId->level]);
+    pDiskId->id = tfsAllocDiskOnTier(&pTfs->tiers[pDiskId->level], temp);
     if (pDiskId->id < 0) {
       pDiskId->level--;
       continue;
@@ -178,6 +182,23 @@ int32_t tfsAllocDisk(STfs *pTfs, int32_t expLevel, SDiskID *pDiskId) {
   TAOS_RETURN(TSDB_CODE_FS_NO_VALID_DISK);
 }
 
+void tfsRecordWrite(STfs *pTfs, const char *path, int64_t bytes, int64_t costUs) {
+  if (pTfs == NULL || path == NULL || bytes <= 0) return;
+
+  for (int32_t level = 0; level < pTfs->nlevel; level++) {
+    STfsTier *pTier = TFS_TIER_AT(pTfs, level);
+    for (int32_t id = 0; id < pTier->ndisk; id++) {
+      STfsDisk *pDisk = pTier->disks[id];
+      if (pDisk == NULL || strncmp(path, pDisk->path, pDisk->pathLen) != 0) continue;
+      char sep = path[pDisk->pathLen];
+      if (sep != '/' && sep != '\\' && sep != '\0') continue;
+
+      tfsRecordDiskWrite(pTier, pDisk, bytes, costUs);
+      return;
+    }
+  }
+}
+
 const char *tfsGetPrimaryPath(STfs *pTfs) { return TFS_PRIMARY_DISK(pTfs)->path; }
 
 const char *tfsGetDiskPath(STfs *pTfs, SDiskID diskId) { return TFS_DISK_AT(pTfs, diskId)->path; }
@@ -706,6 +727,12 @@ int32_t tfsGetMonitorInfo(STfs *pTfs, SMonDiskInfo *pInfo) {
       SMonDiskDesc dinfo = {0};
       dinfo.size = pDisk->size;
       dinfo.level = pDisk->level;
+      TAOS_UNUSED(tfsLockTier(pTier));
+      dinfo.allocNum = pDisk->allocNum;
+      dinfo.hotAllocNum = pDisk->hotAllocNum;
+      dinfo.writeBytes = pDisk->writeBytes;
+      dinfo.writeCost = pDisk->writeCost;
+      TAOS_UNUSED(tfsUnLockTier(pTier));
       tstrncpy(dinfo.name, pDisk->path, sizeof(dinfo.name));
       if (taosArrayPush(pInfo->datadirs, &dinfo) == NULL) {
         TAOS_UNUSED(tfsUnLock(pTfs));
@@ -29,6 +29,7 @@ int32_t tfsNewDisk(int32_t level, int32_t id, int8_t disable, const char *path,
     TAOS_CHECK_GOTO(terrno, &lino, _exit);
   }
 
+  pDisk->pathLen = (int32_t)strlen(pDisk->path);
   pDisk->level = level;
   pDisk->id = id;
   pDisk->disable = disable;
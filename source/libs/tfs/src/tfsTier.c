@@ -107,8 +107,30 @@ void tfsUpdateTierSize(STfsTier *pTier) {
   TAOS_UNUSED(tfsUnLockTier(pTier));
 }
 
-// Round-Robin to allocate disk on a tier
-int32_t tfsAllocDiskOnTier(STfsTier *pTier) {
+static void tfsDecayDiskLoad(STfsDisk *pDisk, int64_t now) {
+  int64_t elapsed = now - pDisk->recentTs;
+  if (elapsed < TFS_LOAD_HALF_LIFE_MS) return;
+
+  int64_t halves = elapsed / TFS_LOAD_HALF_LIFE_MS;
+  pDisk->recentBytes = (halves >= 63) ? 0 : (pDisk->recentBytes >> halves);
+  pDisk->recentTs = now;
+}
+
+// Weight of a disk in [1, 100]. Free space and write cost count twice as much as the recent load, so a busy disk
+// still takes files when it is clearly the roomiest or fastest one. Free space is counted in 5% steps, the jitter
+// between disks sharing one device would break the rotation otherwise.
+static int32_t tfsDiskWeight(const STfsDisk *pDisk, int64_t maxAvail, int64_t minCost, int64_t maxRecent) {
+  int64_t freeW = (maxAvail > 0) ? ((pDisk->size.avail * 20 + maxAvail / 2) / maxAvail * 5) : 100;
+  int64_t speedW = (pDisk->writeCost > 0 && minCost > 0) ? (minCost * 100 / pDisk->writeCost) : 100;
+  int64_t idleW = (maxRecent > 0) ? (100 - pDisk->recentBytes * 50 / maxRecent) : 100;
+  int64_t weight = (freeW * 2 + speedW * 2 + idleW) / 5;
+  return (int32_t)TMAX(weight, 1);
+}
+
+// Smooth weighted round-robin to allocate disk on a tier. Each usable disk is weighted by its free space, observed
+// sync cost and recent write volume; disks with equal weights are visited round-robin like before. Hot files are
+// only placed on the disks whose cost is within TFS_HOT_COST_SLACK percent of the fastest measured disk.
+int32_t tfsAllocDiskOnTier(STfsTier *pTier, ETfsFileTemp temp) {
   TAOS_UNUSED(tfsLockTier(pTier));
 
   if (pTier->ndisk <= 0 || pTier->nAvailDisks <= 0) {
@@ -116,10 +138,14 @@ int32_t tfsAllocDiskOnTier(STfsTier *pTier) {
     TAOS_RETURN(TSDB_CODE_FS_NO_VALID_DISK);
   }
 
-  int32_t retId = -1;
-  int64_t avail = 0;
-  for (int32_t id = 0; id < TFS_MAX_DISKS_PER_TIER; ++id) {
-#if 1  // round-robin
+  int64_t   now = taosGetTimestampMs();
+  STfsDisk *candidates[TFS_MAX_DISKS_PER_TIER];
+  int32_t   nCandidate = 0;
+  int64_t   maxAvail = 0;
+  int64_t   minCost = 0;
+  int64_t   maxRecent = 0;
+
+  for (int32_t id = 0; id < pTier->ndisk; ++id) {
     int32_t   diskId = (pTier->nextid + id) % pTier->ndisk;
     STfsDisk *pDisk = pTier->disks[diskId];
 
@@ -137,31 +163,73 @@ int32_t tfsAllocDiskOnTier(STfsTier *pTier) {
       continue;
     }
 
-    retId = diskId;
-    terrno = 0;
-    pTier->nextid = (diskId + 1) % pTier->ndisk;
-    break;
-#else  // select the disk with the most available space
-    STfsDisk *pDisk = pTier->disks[id];
-    if (pDisk == NULL) continue;
+    tfsDecayDiskLoad(pDisk, now);
+    maxAvail = TMAX(maxAvail, pDisk->size.avail);
+    maxRecent = TMAX(maxRecent, pDisk->recentBytes);
+    if (pDisk->writeCost > 0 && (minCost == 0 || pDisk->writeCost < minCost)) {
+      minCost = pDisk->writeCost;
+    }
+    candidates[nCandidate++] = pDisk;
+  }
+
+  if (nCandidate == 0) {
+    TAOS_UNUSED(tfsUnLockTier(pTier));
+    TAOS_RETURN(TSDB_CODE_FS_NO_VALID_DISK);
+  }
 
-    if (pDisk->size.avail < tsMinDiskFreeSize) continue;
+  if (temp == TFS_FILE_HOT && minCost > 0) {
+    int64_t maxHotCost = minCost + minCost * TFS_HOT_COST_SLACK / 100;
+    int32_t nHot = 0;
+    for (int32_t i = 0; i < nCandidate; ++i) {
+      // disks not measured yet stay eligible so that they get a chance to be measured
+      if (candidates[i]->writeCost <= maxHotCost) {
+        candidates[nHot++] = candidates[i];
+      }
+    }
+    nCandidate = nHot;
+  }
+
+  STfsDisk *pSelected = NULL;
+  int32_t   totalWeight = 0;
+  for (int32_t i = 0; i < nCandidate; ++i) {
+    STfsDisk *pDisk = candidates[i];
+    int32_t   weight = tfsDiskWeight(pDisk, maxAvail, minCost, maxRecent);
 
-    if (pDisk->size.avail > avail) {
-      avail = pDisk->size.avail;
-      retId = id;
-      terrno = 0;
+    pDisk->curWeight += weight;
+    totalWeight += weight;
+    if (pSelected == NULL || pDisk->curWeight > pSelected->curWeight) {
+      pSelected = pDisk;
     }
-#endif
   }
 
+  pSelected->curWeight -= totalWeight;
+  pSelected->allocNum++;
+  if (temp == TFS_FILE_HOT) pSelected->hotAllocNum++;
+  pTier->nextid = (pSelected->id + 1) % pTier->ndisk;
+  terrno = 0;
+
+  int32_t retId = pSelected->id;
   TAOS_UNUSED(tfsUnLockTier(pTier));
-  if (retId < 0) {
-    TAOS_RETURN(TSDB_CODE_FS_NO_VALID_DISK);
-  }
+
+  fTrace("disk %s is allocated, level:%d id:%d temp:%d cost:%" PRId64 "us/MB recent:%" PRId64, pSelected->path,
+         pSelected->level, retId, temp, pSelected->writeCost, pSelected->recentBytes);
   return retId;
 }
 
+void tfsRecordDiskWrite(STfsTier *pTier, STfsDisk *pDisk, int64_t bytes, int64_t costUs) {
+  if (bytes <= 0 || costUs < 0) return;
+
+  // small syncs are dominated by the fixed flush cost, normalize them as 1MB writes
+  int64_t sample = costUs * 1048576 / TMAX(bytes, 1048576);
+
+  TAOS_UNUSED(tfsLockTier(pTier));
+  tfsDecayDiskLoad(pDisk, taosGetTimestampMs());
+  pDisk->writeCost = (pDisk->writeCost == 0) ? TMAX(sample, 1) : TMAX((pDisk->writeCost * 7 + sample) / 8, 1);
+  pDisk->writeBytes += bytes;
+  pDisk->recentBytes += bytes;
+  TAOS_UNUSED(tfsUnLockTier(pTier));
+}
+
 void tfsPosNextId(STfsTier *pTier) {
   int32_t nextid = 0;
 
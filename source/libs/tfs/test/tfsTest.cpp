@@ -744,3 +744,88 @@ TEST_F(TfsTest, 05_MultiDisk) {
 
   tfsClose(pTfs);
 }
+
+TEST_F(TfsTest, 06_AllocDiskByTemp) {
+  int32_t code = 0;
+
+#ifdef _TD_DARWIN_64
+  const char *root00 = "/private" TD_TMP_DIR_PATH "tfsTest00";
+  const char *root01 = "/private" TD_TMP_DIR_PATH "tfsTest01";
+#else
+  const char *root00 = TD_TMP_DIR_PATH "tfsTest00";
+  const char *root01 = TD_TMP_DIR_PATH "tfsTest01";
+#endif
+
+  SDiskCfg dCfg[2] = {0};
+  tstrncpy(dCfg[0].dir, root00, TSDB_FILENAME_LEN);
+  dCfg[0].level = 0;
+  dCfg[0].primary = 1;
+  dCfg[0].disable = 0;
+  tstrncpy(dCfg[1].dir, root01, TSDB_FILENAME_LEN);
+  dCfg[1].level = 0;
+  dCfg[1].primary = 0;
+  dCfg[1].disable = 0;
+
+  taosRemoveDir(root00);
+  taosRemoveDir(root01);
+  taosMkDir(root00);
+  taosMkDir(root01);
+
+  STfs *pTfs = NULL;
+  (void)tfsOpen(dCfg, 2, &pTfs);
+  ASSERT_NE(pTfs, nullptr);
+
+  // without any write feedback both temperatures rotate over the disks
+  SDiskID did = {0};
+  int32_t count[2] = {0};
+  for (int32_t i = 0; i < 8; i++) {
+    code = tfsAllocDiskByTemp(pTfs, 0, (i % 2) ? TFS_FILE_HOT : TFS_FILE_WARM, &did);
+    EXPECT_EQ(code, 0);
+    EXPECT_EQ(did.level, 0);
+    count[did.id]++;
+  }
+  EXPECT_EQ(count[0], 4);
+  EXPECT_EQ(count[1], 4);
+
+  // disk 1 syncs 100 times slower than disk 0
+  char fname[TSDB_FILENAME_LEN] = {0};
+  snprintf(fname, TSDB_FILENAME_LEN, "%s%sf0", root00, TD_DIRSEP);
+  tfsRecordWrite(pTfs, fname, 4 * 1024 * 1024, 4 * 1000);
+  snprintf(fname, TSDB_FILENAME_LEN, "%s%sf1", root01, TD_DIRSEP);
+  tfsRecordWrite(pTfs, fname, 4 * 1024 * 1024, 4 * 100000);
+
+  // a path only sharing the prefix of a disk is not counted
+  snprintf(fname, TSDB_FILENAME_LEN, "%s0%sf", root00, TD_DIRSEP);
+  tfsRecordWrite(pTfs, fname, 4 * 1024 * 1024, 1);
+
+  for (int32_t i = 0; i < 16; i++) {
+    code = tfsAllocDiskByTemp(pTfs, 0, TFS_FILE_HOT, &did);
+    EXPECT_EQ(code, 0);
+    EXPECT_EQ(did.id, 0);
+  }
+
+  count[0] = count[1] = 0;
+  for (int32_t i = 0; i < 64; i++) {
+    code = tfsAllocDisk(pTfs, 0, &did);
+    EXPECT_EQ(code, 0);
+    count[did.id]++;
+  }
+  EXPECT_GT(count[0], count[1]);
+  EXPECT_GT(count[1], 0);
+
+  SMonDiskInfo info = {0};
+  code = tfsGetMonitorInfo(pTfs, &info);
+  EXPECT_EQ(code, 0);
+  ASSERT_EQ(taosArrayGetSize(info.datadirs), 2);
+
+  SMonDiskDesc *pDesc0 = (SMonDiskDesc *)taosArrayGet(info.datadirs, 0);
+  SMonDiskDesc *pDesc1 = (SMonDiskDesc *)taosArrayGet(info.datadirs, 1);
+  EXPECT_EQ(pDesc0->allocNum + pDesc1->allocNum, 8 + 16 + 64);
+  EXPECT_EQ(pDesc0->hotAllocNum + pDesc1->hotAllocNum, 4 + 16);
+  EXPECT_EQ(pDesc0->writeBytes, 4 * 1024 * 1024);
+  EXPECT_EQ(pDesc1->writeBytes, 4 * 1024 * 1024);
+  EXPECT_LT(pDesc0->writeCost, pDesc1->writeCost);
+  taosArrayDestroy(info.datadirs);
+
+  tfsClose(pTfs);
+}
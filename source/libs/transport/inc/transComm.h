@@ -147,10 +147,10 @@ typedef struct {
 #define TRANS_VER 2
 typedef struct {
   char version : 4;       // RPC version
-  char comp : 2;          // compression algorithm, 0:no compression 1:lz4
+  uint8_t comp : 2;       // compression algorithm, 0:no compression 1:lz4 2:zstd
   char noResp : 2;        // noResp bits, 0: resp, 1: resp
   char withUserInfo : 2;  // 0: sent user info or not
-  char secured : 2;
+  uint8_t compAccept : 2;  // codecs accepted by sender besides lz4, bit0: zstd, 0 for old versions
   char spi : 2;
   char hasEpSet : 2;  // contain epset or not, 0(default): no epset, 1: contain epset
 
@@ -171,6 +171,32 @@ typedef struct {
   int32_t contLen;
 } STransCompMsg;
 
+#define TRANS_COMP_NONE 0
+#define TRANS_COMP_LZ4  1
+#define TRANS_COMP_ZSTD 2
+#define TRANS_COMP_MAX  3
+
+#define TRANS_COMP_ACCEPT_ZSTD 0x1
+
+// zstd of tcompression falls back to lz4 on these platforms, so it is neither sent nor accepted
+#if defined(WINDOWS) || defined(_TD_DARWIN_64)
+#define TRANS_COMP_ACCEPT 0
+#else
+#define TRANS_COMP_ACCEPT TRANS_COMP_ACCEPT_ZSTD
+#endif
+
+/*
+ * per conn compression state, the codec of each msg is picked from the observed compression ratio and cost of
+ * each codec, and the observed link bandwidth, see transCompChoose
+ */
+typedef struct {
+  int8_t  peerAccept;  // codecs accepted by peer, learned from the received msg head
+  int32_t numOfMsg;    // compressible msgs sent, used to probe codecs periodically
+  double  linkBw;      // bytes per us, ewma, 0 if not known yet
+  double  ratio[TRANS_COMP_MAX];  // compressed len / raw len, ewma, 0 if not known yet
+  double  cost[TRANS_COMP_MAX];   // us per raw byte, ewma
+} STransCompCtx;
+
 typedef struct {
   uint32_t timeStamp;
   uint8_t  auth[TSDB_AUTH_LEN];
@@ -450,9 +476,16 @@ void    transCleanup();
 void    transPrintEpSet(SEpSet* pEpSet);
 
 void    transFreeMsg(void* msg);
-int32_t transCompressMsg(char* msg, int32_t len);
+int32_t transCompressMsg(char* msg, int32_t len, int8_t codec, int8_t level);
 int32_t transDecompressMsg(char** msg, int32_t* len);
 
+void    transCompCtxOnRecv(STransCompCtx* pCtx, STransMsgHead* pHead);
+void    transCompCtxUpdateLink(STransCompCtx* pCtx, int64_t len, int64_t us);
+int8_t  transCompChoose(STransCompCtx* pCtx, STrans* pInst, int32_t len);
+int32_t transCompressMsgWithCtx(STransCompCtx* pCtx, STrans* pInst, tmsg_t msgType, char* msg, int32_t len);
+void    transCompStatUpdate(tmsg_t msgType, int8_t codec, int64_t rawLen, int64_t len, int64_t us);
+int32_t transGetCompStat(tmsg_t msgType, SRpcCompStat* pStat);
+
 int32_t transOpenRefMgt(int size, void (*func)(void*));
 void    transCloseRefMgt(int32_t refMgt);
 int64_t transAddExHandle(int32_t refMgt, void* p);
@@ -502,6 +535,8 @@ typedef struct {
   queue      q;     // queue for reqs
   uv_write_t wreq;
   void*      arg;
+  int64_t    st;   // write start time, us
+  int64_t    len;  // bytes written
 } SWReqsWrapper;
 
 int32_t     initWQ(queue* wq);
@@ -48,6 +48,8 @@ typedef struct {
   char     user[TSDB_UNI_LEN];  // meter ID
   int32_t  compatibilityVer;
   int32_t  compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t   compressAlg;   // RPC_COMP_AUTO, RPC_COMP_LZ4, RPC_COMP_ZSTD
+  int8_t   compressLevel;  // zstd level
   int8_t   encryption;    // encrypt or not
 
   int32_t retryMinInterval;  // retry init interval
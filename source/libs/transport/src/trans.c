@@ -53,6 +53,8 @@ void* rpcOpen(const SRpcInit* pInit) {
   if (pRpc->compressSize < 0) {
     pRpc->compressSize = -1;
   }
+  pRpc->compressAlg = pInit->compressAlg;
+  pRpc->compressLevel = pInit->compressLevel;
 
   pRpc->encryption = pInit->encryption;
   pRpc->compatibilityVer = pInit->compatibilityVer;
@@ -186,6 +188,42 @@ void* rpcReallocCont(void* ptr, int64_t contLen) {
   return st + TRANS_MSG_OVERHEAD;
 }
 
+int32_t rpcMsgAppendIov(SRpcMsg* pMsg, void* base, int32_t len, void* param, RpcIovFreeFp freeFp) {
+  if (pMsg->pIov == NULL) {
+    pMsg->pIov = taosArrayInit(4, sizeof(SRpcIov));
+    if (pMsg->pIov == NULL) {
+      return terrno;
+    }
+  }
+
+  SRpcIov iov = {.base = base, .len = len, .param = param, .freeFp = freeFp};
+  if (taosArrayPush(pMsg->pIov, &iov) == NULL) {
+    return terrno;
+  }
+  return 0;
+}
+
+int32_t rpcMsgIovLen(const SArray* pIov) {
+  int32_t len = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pIov); i++) {
+    SRpcIov* pItem = taosArrayGet(pIov, i);
+    len += pItem->len;
+  }
+  return len;
+}
+
+void rpcFreeIov(SArray* pIov) {
+  if (pIov == NULL) return;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pIov); i++) {
+    SRpcIov* pItem = taosArrayGet(pIov, i);
+    if (pItem->freeFp != NULL) {
+      pItem->freeFp(pItem->param);
+    }
+  }
+  taosArrayDestroy(pIov);
+}
+
 int32_t rpcSendRequest(void* pInit, const SEpSet* pEpSet, SRpcMsg* pMsg, int64_t* pRid) {
   return transSendRequest(pInit, pEpSet, pMsg, NULL);
 }
@@ -230,6 +268,8 @@ int32_t rpcSetIpWhite(void* thandle, void* arg) { return transSetIpWhiteList(tha
 int32_t rpcAllocHandle(int64_t* refId) { return transAllocHandle(refId); }
 
 int32_t rpcUtilSIpRangeToStr(SIpV4Range* pRange, char* buf) { return transUtilSIpRangeToStr(pRange, buf); }
+
+int32_t rpcGetCompStat(tmsg_t msgType, SRpcCompStat* pStat) { return transGetCompStat(msgType, pStat); }
 int32_t rpcUtilSWhiteListToStr(SIpWhiteList* pWhiteList, char** ppBuf) {
   return transUtilSWhiteListToStr(pWhiteList, ppBuf);
 }
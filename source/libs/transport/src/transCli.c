@@ -113,6 +113,7 @@ typedef struct SCliConn {
   queue  batchSendq;
   int8_t inThreadSendq;
 
+  STransCompCtx compCtx;
 } SCliConn;
 
 typedef struct {
@@ -663,6 +664,7 @@ void cliHandleResp(SCliConn* conn) {
     return;
   }
 
+  transCompCtxOnRecv(&conn->compCtx, pHead);
   if ((code = transDecompressMsg((char**)&pHead, &msgLen)) < 0) {
     tDebug("%s conn %p recv invalid packet, failed to decompress", CONN_GET_INST_LABEL(conn), conn);
     // TODO: notify cb
@@ -1314,6 +1316,10 @@ static void cliBatchSendCb(uv_write_t* req, int status) {
   SCliThrd* pThrd = conn->hostThrd;
   STrans*   pInst = pThrd->pInst;
 
+  if (status == 0) {
+    transCompCtxUpdateLink(&conn->compCtx, wrapper->len, taosGetTimestampUs() - wrapper->st);
+  }
+
   while (!QUEUE_IS_EMPTY(&wrapper->node)) {
     queue*   h = QUEUE_HEAD(&wrapper->node);
     SCliReq* pReq = QUEUE_DATA(h, SCliReq, sendQ);
@@ -1462,6 +1468,7 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
       pHead->magicNum = htonl(TRANS_MAGIC_NUM);
       pHead->version = TRANS_VER;
       pHead->compatibilityVer = htonl(pInst->compatibilityVer);
+      pHead->compAccept = TRANS_COMP_ACCEPT;
     }
     pHead->timestamp = taosHton64(pCliMsg->st);
     pHead->seqNum = taosHton64(pConn->seq);
@@ -1469,7 +1476,8 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
 
     if (pHead->comp == 0) {
       if (pInst->compressSize != -1 && pInst->compressSize < contLen) {
-        msgLen = transCompressMsg(content, contLen) + sizeof(STransMsgHead);
+        msgLen = transCompressMsgWithCtx(&pConn->compCtx, pInst, pReq->msgType, content, contLen) +
+                 sizeof(STransMsgHead);
         pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
       }
     } else {
@@ -1514,6 +1522,9 @@ int32_t cliBatchSend(SCliConn* pConn, int8_t direct) {
   QUEUE_MOVE(&reqToSend, &pWreq->node);
   tDebug("%s conn %p start to send msg, batch size:%d, len:%d", CONN_GET_INST_LABEL(pConn), pConn, j, totalLen);
 
+  pWreq->st = taosGetTimestampUs();
+  pWreq->len = totalLen;
+
   int32_t ret = uv_write(req, (uv_stream_t*)pConn->stream, wb, j, cliBatchSendCb);
   if (ret != 0) {
     tError("%s conn %p failed to send msg since %s", CONN_GET_INST_LABEL(pConn), pConn, uv_err_name(ret));
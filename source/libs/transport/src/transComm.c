@@ -14,6 +14,7 @@
  */
 
 #include "transComm.h"
+#include "tcompression.h"
 
 #define BUFFER_CAP 8 * 1024
 
@@ -26,19 +27,52 @@ static int32_t transSyncMsgMgt;
 
 void transDestroySyncMsg(void* msg);
 
-int32_t transCompressMsg(char* msg, int32_t len) {
+#define TRANS_COMP_EWMA(old, val)   ((old) == 0 ? (val) : (old)*0.875 + (val)*0.125)
+#define TRANS_COMP_PROBE_INTERVAL   64           // probe one of the codecs every N msgs to refresh its stat
+#define TRANS_COMP_BW_MIN_LEN       (64 * 1024)  // smaller writes finish in the socket buffer, tell nothing of the link
+#define TRANS_COMP_DEFAULT_ZSTD_LVL 3
+
+static SRpcCompStat transCompStat[TDMT_MAX] = {0};
+
+static int32_t transCompressLz4(const char* src, int32_t len, char* dst, int32_t cap) {
+  return LZ4_compress_default(src, dst, len, cap);
+}
+
+static FORCE_INLINE uint32_t transZstdCmprAlg(int8_t level) {
+  uint32_t cmprAlg = 0;
+  SET_COMPRESS(L1_DISABLED, L2_ZSTD, level > 0 ? level : TRANS_COMP_DEFAULT_ZSTD_LVL, cmprAlg);
+  return cmprAlg;
+}
+
+// the zstd block of tcompression starts with a flag byte, a raw copy is never shorter than the input
+static int32_t transCompressZstd(char* src, int32_t len, char* dst, int32_t cap, int8_t level) {
+  return tsCompressString2(src, len, 0, dst, cap, transZstdCmprAlg(level), NULL, 0);
+}
+
+static int32_t transDecompressZstd(char* src, int32_t len, char* dst, int32_t cap) {
+  return tsDecompressString2(src, len, 0, dst, cap, transZstdCmprAlg(0), NULL, 0);
+}
+
+int32_t transCompressMsg(char* msg, int32_t len, int8_t codec, int8_t level) {
   int32_t        ret = 0;
   int            compHdr = sizeof(STransCompMsg);
   STransMsgHead* pHead = transHeadFromCont(msg);
 
-  char* buf = taosMemoryMalloc(len + compHdr + 8);  // 8 extra bytes
+  if (codec == TRANS_COMP_NONE) {
+    pHead->comp = 0;
+    return len;
+  }
+
+  int32_t cap = len + compHdr;
+  char*   buf = taosMemoryMalloc(cap + 8);  // 8 extra bytes
   if (buf == NULL) {
     tWarn("failed to allocate memory for rpc msg compression, contLen:%d", len);
     ret = len;
     return ret;
   }
 
-  int32_t clen = LZ4_compress_default(msg, buf, len, len + compHdr);
+  int32_t clen = codec == TRANS_COMP_ZSTD ? transCompressZstd(msg, len, buf, cap, level)
+                                          : transCompressLz4(msg, len, buf, cap);
   /*
    * only the compressed size is less than the value of contLen - overhead, the compression is applied
    * The first four bytes is set to 0, the second four bytes are utilized to keep the original length of message
@@ -49,9 +83,9 @@ int32_t transCompressMsg(char* msg, int32_t len) {
     pComp->contLen = htonl(len);
     memcpy(msg + compHdr, buf, clen);
 
-    tDebug("compress rpc msg, before:%d, after:%d", len, clen);
+    tDebug("compress rpc msg, codec:%d, before:%d, after:%d", codec, len, clen);
     ret = clen + compHdr;
-    pHead->comp = 1;
+    pHead->comp = codec;
   } else {
     ret = len;
     pHead->comp = 0;
@@ -75,8 +109,13 @@ int32_t transDecompressMsg(char** msg, int32_t* len) {
   }
 
   STransMsgHead* pNewHead = (STransMsgHead*)buf;
-  int32_t        decompLen = LZ4_decompress_safe(pCont + sizeof(STransCompMsg), (char*)pNewHead->content,
-                                                 tlen - sizeof(STransMsgHead) - sizeof(STransCompMsg), oriLen);
+  int32_t        srcLen = tlen - sizeof(STransMsgHead) - sizeof(STransCompMsg);
+  int32_t        decompLen = -1;
+  if (pHead->comp == TRANS_COMP_LZ4) {
+    decompLen = LZ4_decompress_safe(pCont + sizeof(STransCompMsg), (char*)pNewHead->content, srcLen, oriLen);
+  } else if (pHead->comp == TRANS_COMP_ZSTD && (TRANS_COMP_ACCEPT & TRANS_COMP_ACCEPT_ZSTD)) {
+    decompLen = transDecompressZstd(pCont + sizeof(STransCompMsg), srcLen, (char*)pNewHead->content, oriLen);
+  }
   memcpy((char*)pNewHead, (char*)pHead, sizeof(STransMsgHead));
 
   *len = oriLen + sizeof(STransMsgHead);
@@ -90,6 +129,109 @@ int32_t transDecompressMsg(char** msg, int32_t* len) {
   return 0;
 }
 
+void transCompCtxOnRecv(STransCompCtx* pCtx, STransMsgHead* pHead) { pCtx->peerAccept = pHead->compAccept; }
+
+void transCompCtxUpdateLink(STransCompCtx* pCtx, int64_t len, int64_t us) {
+  // the write cb is only called after the data has been handed to the kernel, for a small write that is at once
+  if (len < TRANS_COMP_BW_MIN_LEN || us <= 0) {
+    return;
+  }
+  pCtx->linkBw = TRANS_COMP_EWMA(pCtx->linkBw, (double)len / us);
+}
+
+/*
+ * gain of a codec is the transfer time it saves minus the time it costs, in us. The link bandwidth is unknown until
+ * some large msgs have been sent, lz4 is used until then as before.
+ */
+static double transCompGain(STransCompCtx* pCtx, int8_t codec, int32_t len) {
+  if (pCtx->linkBw <= 0) {
+    return codec == TRANS_COMP_LZ4 ? 1 : 0;
+  }
+  return len * (1 - pCtx->ratio[codec]) / pCtx->linkBw - len * pCtx->cost[codec];
+}
+
+int8_t transCompChoose(STransCompCtx* pCtx, STrans* pInst, int32_t len) {
+  if (pInst->compressSize == -1 || pInst->compressSize >= len) {
+    return TRANS_COMP_NONE;
+  }
+
+  bool zstd = (pCtx->peerAccept & TRANS_COMP_ACCEPT & TRANS_COMP_ACCEPT_ZSTD) != 0;
+  if (pInst->compressAlg == RPC_COMP_LZ4) {
+    return TRANS_COMP_LZ4;
+  } else if (pInst->compressAlg == RPC_COMP_ZSTD) {
+    return zstd ? TRANS_COMP_ZSTD : TRANS_COMP_LZ4;
+  }
+
+  int8_t  maxCodec = zstd ? TRANS_COMP_ZSTD : TRANS_COMP_LZ4;
+  int32_t n = pCtx->numOfMsg++;
+  if (n % TRANS_COMP_PROBE_INTERVAL == 0) {
+    return TRANS_COMP_LZ4 + (n / TRANS_COMP_PROBE_INTERVAL) % maxCodec;
+  }
+
+  int8_t codec = TRANS_COMP_NONE;
+  double best = 0;
+  for (int8_t c = TRANS_COMP_LZ4; c <= maxCodec; ++c) {
+    if (pCtx->ratio[c] == 0) {
+      return c;  // not probed yet
+    }
+    double gain = transCompGain(pCtx, c, len);
+    if (gain > best) {
+      best = gain;
+      codec = c;
+    }
+  }
+  return codec;
+}
+
+int32_t transCompressMsgWithCtx(STransCompCtx* pCtx, STrans* pInst, tmsg_t msgType, char* msg, int32_t len) {
+  int8_t codec = transCompChoose(pCtx, pInst, len);
+  if (codec == TRANS_COMP_NONE) {
+    transHeadFromCont(msg)->comp = 0;
+    if (pInst->compressSize != -1 && pInst->compressSize < len) {
+      transCompStatUpdate(msgType, codec, len, len, 0);
+    }
+    return len;
+  }
+
+  int64_t st = taosGetTimestampUs();
+  int32_t clen = transCompressMsg(msg, len, codec, pInst->compressLevel);
+  int64_t us = taosGetTimestampUs() - st;
+
+  // a msg not compressed is counted at ratio 1, so that a codec not working for this conn is not picked again
+  pCtx->ratio[codec] = TRANS_COMP_EWMA(pCtx->ratio[codec], (double)clen / len);
+  pCtx->cost[codec] = TRANS_COMP_EWMA(pCtx->cost[codec], (double)us / len);
+
+  transCompStatUpdate(msgType, transHeadFromCont(msg)->comp, len, clen, us);
+  return clen;
+}
+
+void transCompStatUpdate(tmsg_t msgType, int8_t codec, int64_t rawLen, int64_t len, int64_t us) {
+  if (!tmsgIsValid(msgType)) {
+    return;
+  }
+  SRpcCompStat* pStat = &transCompStat[TMSG_INDEX(msgType)];
+  (void)atomic_add_fetch_64(&pStat->numOfMsg[codec], 1);
+  (void)atomic_add_fetch_64(&pStat->rawBytes, rawLen);
+  if (codec != TRANS_COMP_NONE) {
+    (void)atomic_add_fetch_64(&pStat->compBytes, len);
+  }
+  (void)atomic_add_fetch_64(&pStat->compUs, us);
+}
+
+int32_t transGetCompStat(tmsg_t msgType, SRpcCompStat* pStat) {
+  if (!tmsgIsValid(msgType)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+  SRpcCompStat* pSrc = &transCompStat[TMSG_INDEX(msgType)];
+  for (int32_t i = 0; i < TRANS_COMP_MAX; ++i) {
+    pStat->numOfMsg[i] = atomic_load_64(&pSrc->numOfMsg[i]);
+  }
+  pStat->rawBytes = atomic_load_64(&pSrc->rawBytes);
+  pStat->compBytes = atomic_load_64(&pSrc->compBytes);
+  pStat->compUs = atomic_load_64(&pSrc->compUs);
+  return 0;
+}
+
 void transFreeMsg(void* msg) {
   if (msg == NULL) {
     return;
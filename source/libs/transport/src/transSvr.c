@@ -64,6 +64,8 @@ typedef struct SSvrConn {
   uv_buf_t* buf;
   int32_t   bufSize;
   queue     wq;  // uv_write_t queue
+
+  STransCompCtx compCtx;
 } SSvrConn;
 
 typedef struct SSvrRespMsg {
@@ -161,7 +163,7 @@ static void uvFreeCb(uv_handle_t* handle);
 
 static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg);
 
-static int32_t uvPrepareSendData(SSvrRespMsg* msg, uv_buf_t* wb);
+static int32_t uvPrepareSendData(SSvrRespMsg* msg, uv_buf_t* wb, int32_t* bufNum);
 static void    uvStartSendResp(SSvrRespMsg* msg);
 
 static void uvNotifyLinkBrokenToApp(SSvrConn* conn);
@@ -527,6 +529,7 @@ static bool uvHandleReq(SSvrConn* pConn) {
     tError("%s conn %p read invalid packet", transLabel(pInst), pConn);
     return false;
   }
+  transCompCtxOnRecv(&pConn->compCtx, pHead);
   if (transDecompressMsg((char**)&pHead, &msgLen) < 0) {
     tError("%s conn %p recv invalid packet, failed to decompress", transLabel(pInst), pConn);
     taosMemoryFree(pHead);
@@ -677,6 +680,10 @@ void uvOnSendCb(uv_write_t* req, int status) {
   SWReqsWrapper* wrapper = req->data;
   SSvrConn*      conn = wrapper->arg;
 
+  if (status == 0) {
+    transCompCtxUpdateLink(&conn->compCtx, wrapper->len, taosGetTimestampUs() - wrapper->st);
+  }
+
   queue src;
   QUEUE_INIT(&src);
   QUEUE_MOVE(&wrapper->node, &src);
@@ -727,7 +734,7 @@ static void uvOnPipeWriteCb(uv_write_t* req, int status) {
   taosMemoryFree(req);
 }
 
-static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
+static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb, int32_t* bufNum) {
   SSvrConn*  pConn = smsg->pConn;
   STransMsg* pMsg = &smsg->msg;
   if (pMsg->pCont == 0) {
@@ -746,6 +753,7 @@ static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
   pHead->seqNum = taosHton64(pMsg->info.seqNum);
   pHead->qid = taosHton64(pMsg->info.qId);
   pHead->withUserInfo = pConn->userInited == 0 ? 1 : 0;
+  pHead->compAccept = TRANS_COMP_ACCEPT;
 
   // handle invalid drop_task resp, TD-20098
   // if (pConn->inType == TDMT_SCH_DROP_TASK && pMsg->code == TSDB_CODE_VND_INVALID_VGROUP_ID) {
@@ -757,24 +765,34 @@ static int32_t uvPrepareSendData(SSvrRespMsg* smsg, uv_buf_t* wb) {
   // pHead->msgType = pMsg->msgType;
   // pHead->release = smsg->type == Release ? 1 : 0;
   pHead->code = htonl(pMsg->code);
-  pHead->msgLen = htonl(pMsg->contLen + sizeof(STransMsgHead));
 
   char*   msg = (char*)pHead;
   int32_t len = transMsgLenFromCont(pMsg->contLen);
+  int32_t iovNum = (int32_t)taosArrayGetSize(pMsg->pIov);
+  int32_t iovLen = rpcMsgIovLen(pMsg->pIov);
+  pHead->msgLen = htonl(len + iovLen);
 
+  // scatter-gather payload is written as it is, compression would need a contiguous copy
   STrans* pInst = pConn->pInst;
-  if (pMsg->info.compressed == 0 && pConn->clientIp != pConn->serverIp && pInst->compressSize != -1 &&
-      pInst->compressSize < pMsg->contLen) {
-    len = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+  if (iovNum == 0 && pMsg->info.compressed == 0 && pConn->clientIp != pConn->serverIp) {
+    len = transCompressMsgWithCtx(&pConn->compCtx, pInst, pHead->msgType, pMsg->pCont, pMsg->contLen) +
+          sizeof(STransMsgHead);
     pHead->msgLen = (int32_t)htonl((uint32_t)len);
   }
 
   STraceId* trace = &pMsg->info.traceId;
-  tGDebug("%s conn %p %s is sent to %s, local info:%s, len:%d, seqNum:%" PRId64 ", sid:%" PRId64 "", transLabel(pInst),
-          pConn, TMSG_INFO(pHead->msgType), pConn->dst, pConn->src, len, pMsg->info.seqNum, pMsg->info.qId);
-
-  wb->base = (char*)pHead;
-  wb->len = len;
+  tGDebug("%s conn %p %s is sent to %s, local info:%s, len:%d, iov:%d, seqNum:%" PRId64 ", sid:%" PRId64 "",
+          transLabel(pInst), pConn, TMSG_INFO(pHead->msgType), pConn->dst, pConn->src, len + iovLen, iovNum,
+          pMsg->info.seqNum, pMsg->info.qId);
+
+  wb[0].base = (char*)pHead;
+  wb[0].len = len;
+  for (int32_t i = 0; i < iovNum; i++) {
+    SRpcIov* pIov = taosArrayGet(pMsg->pIov, i);
+    wb[i + 1].base = pIov->base;
+    wb[i + 1].len = pIov->len;
+  }
+  *bufNum = iovNum + 1;
   return 0;
 }
 static int32_t uvBuildToSendData(SSvrConn* pConn, uv_buf_t** ppBuf, int32_t* bufNum, queue* toSendQ) {
@@ -785,30 +803,33 @@ static int32_t uvBuildToSendData(SSvrConn* pConn, uv_buf_t** ppBuf, int32_t* buf
     return 0;
   }
 
-  if (pConn->bufSize < size) {
-    pConn->buf = taosMemoryRealloc(pConn->buf, size * sizeof(uv_buf_t));
-    if (pConn->buf == NULL) {
-      return terrno;
-    }
-    pConn->bufSize = size;
-  }
-  uv_buf_t* pWb = pConn->buf;
-
   int32_t count = 0;
 
   while (transQueueSize(&pConn->resps) > 0) {
     queue*       el = transQueuePop(&pConn->resps);
     SSvrRespMsg* pMsg = QUEUE_DATA(el, SSvrRespMsg, q);
-    uv_buf_t     wb;
-    code = uvPrepareSendData(pMsg, &wb);
+
+    int32_t need = count + 1 + (int32_t)taosArrayGetSize(pMsg->msg.pIov) + transQueueSize(&pConn->resps);
+    if (pConn->bufSize < need) {
+      uv_buf_t* buf = taosMemoryRealloc(pConn->buf, need * sizeof(uv_buf_t));
+      if (buf == NULL) {
+        transQueuePush(&pConn->resps, el);
+        return terrno;
+      }
+      pConn->buf = buf;
+      pConn->bufSize = need;
+    }
+
+    int32_t num = 0;
+    code = uvPrepareSendData(pMsg, pConn->buf + count, &num);
     if (code != 0) {
       return code;
     }
-    pWb[count] = wb;
     pMsg->sent = 1;
     QUEUE_PUSH(toSendQ, &pMsg->q);
-    count++;
+    count += num;
   }
+  uv_buf_t* pWb = pConn->buf;
 
   if (count == 0) {
     return 0;
@@ -854,6 +875,12 @@ static FORCE_INLINE void uvStartSendRespImpl(SSvrRespMsg* smsg) {
 
   transRefSrvHandle(pConn);
 
+  pWreq->st = taosGetTimestampUs();
+  pWreq->len = 0;
+  for (int32_t i = 0; i < bufNum; i++) {
+    pWreq->len += pBuf[i].len;
+  }
+
   int32_t ret = uv_write(req, (uv_stream_t*)pConn->pTcp, pBuf, bufNum, uvOnSendCb);
   if (ret != 0) {
     tError("conn %p failed to write data since %s", pConn, uv_err_name(ret));
@@ -907,6 +934,7 @@ static FORCE_INLINE void destroySmsg(SSvrRespMsg* smsg) {
     return;
   }
   transFreeMsg(smsg->msg.pCont);
+  rpcFreeIov(smsg->msg.pIov);
   taosMemoryFree(smsg);
 }
 static FORCE_INLINE void destroySmsgWrapper(void* smsg, void* param) { destroySmsg((SSvrRespMsg*)smsg); }
@@ -1911,6 +1939,7 @@ int32_t transSendResponse(const STransMsg* msg) {
 
   if (msg->info.noResp) {
     rpcFreeCont(msg->pCont);
+    rpcFreeIov(msg->pIov);
     tTrace("no need send resp");
     return 0;
   }
@@ -1918,6 +1947,7 @@ int32_t transSendResponse(const STransMsg* msg) {
 
   if (exh == NULL) {
     rpcFreeCont(msg->pCont);
+    rpcFreeIov(msg->pIov);
     return 0;
   }
   int64_t refId = msg->info.refId;
@@ -1955,11 +1985,13 @@ int32_t transSendResponse(const STransMsg* msg) {
 _return1:
   tDebug("handle %p failed to send resp", exh);
   rpcFreeCont(msg->pCont);
+  rpcFreeIov(msg->pIov);
   transReleaseExHandle(msg->info.refIdMgt, refId);
   return code;
 _return2:
   tDebug("handle %p failed to send resp", exh);
   rpcFreeCont(msg->pCont);
+  rpcFreeIov(msg->pIov);
   return code;
 }
 int32_t transRegisterMsg(const STransMsg* msg) {
@@ -211,6 +211,36 @@ static void processRegisterFailure(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet)
   rpcMsg.code = 0;
   rpcSendResponse(&rpcMsg);
 }
+
+static const int32_t iovHeadLen = 16;
+static const int32_t iovNum = 3;
+static const int32_t iovSegLen = 4096;
+static int32_t       iovFreed = 0;
+
+static void freeIovSeg(void *param) {
+  taosMemoryFree(param);
+  (void)atomic_add_fetch_32(&iovFreed, 1);
+}
+
+static void processIovReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  SRpcMsg rpcMsg = {0};
+  rpcMsg.pCont = rpcMallocCont(iovHeadLen);
+  memset(rpcMsg.pCont, 'h', iovHeadLen);
+  rpcMsg.contLen = iovHeadLen;
+  rpcMsg.info = pMsg->info;
+  rpcMsg.code = 0;
+  for (int32_t i = 0; i < iovNum; ++i) {
+    char *pSeg = (char *)taosMemoryMalloc(iovSegLen);
+    memset(pSeg, 'a' + i, iovSegLen);
+    if (rpcMsgAppendIov(&rpcMsg, pSeg, iovSegLen, pSeg, freeIovSeg) != 0) {
+      taosMemoryFree(pSeg);
+      break;
+    }
+  }
+  rpcFreeCont(pMsg->pCont);
+  rpcSendResponse(&rpcMsg);
+}
+
 // client process;
 static void processResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
   Client *client = (Client *)parent;
@@ -516,3 +546,35 @@ TEST_F(TransEnv, noResp) {
 
   // no resp
 }
+TEST_F(TransEnv, srvSendIovRsp) {
+  tr->SetSrvContinueSend(processIovReq);
+  for (int i = 0; i < 5; i++) {
+    atomic_store_32(&iovFreed, 0);
+
+    SRpcMsg req = {0}, resp = {0};
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(10);
+    req.contLen = 10;
+    tr->cliSendAndRecv(&req, &resp);
+    ASSERT_EQ(resp.code, 0);
+    ASSERT_EQ(resp.contLen, iovHeadLen + iovNum * iovSegLen);
+
+    char *pCont = (char *)resp.pCont;
+    for (int32_t j = 0; j < iovHeadLen; ++j) {
+      ASSERT_EQ(pCont[j], 'h');
+    }
+    for (int32_t s = 0; s < iovNum; ++s) {
+      char *pSeg = pCont + iovHeadLen + s * iovSegLen;
+      for (int32_t j = 0; j < iovSegLen; ++j) {
+        ASSERT_EQ(pSeg[j], 'a' + s);
+      }
+    }
+    rpcFreeCont(resp.pCont);
+
+    // segments are released by the server once the write completes
+    for (int32_t w = 0; w < 100 && atomic_load_32(&iovFreed) < iovNum; ++w) {
+      taosMsleep(10);
+    }
+    EXPECT_EQ(atomic_load_32(&iovFreed), iovNum);
+  }
+}
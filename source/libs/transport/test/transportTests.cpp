@@ -232,4 +232,101 @@ int32_t cloneVal(void *src, void **dst) {
 //  skey = (char *)transCtxDumpVal(ctx, 2);
 //  EXPECT_EQ(0, strcmp(skey, val.c_str()));
 //}
+static char *compMsgInit(int32_t len) {
+  char *pCont = (char *)rpcMallocCont(len);
+  for (int32_t i = 0; i < len; ++i) {
+    pCont[i] = 'a' + (i / 64) % 8;
+  }
+  return pCont;
+}
+
+static void compRoundTrip(int8_t codec) {
+  int32_t len = 64 * 1024;
+  char   *pCont = compMsgInit(len);
+  char   *pExpect = compMsgInit(len);
+
+  int32_t clen = transCompressMsg(pCont, len, codec, 3);
+  ASSERT_LT(clen, len);
+
+  STransMsgHead *pHead = transHeadFromCont(pCont);
+  ASSERT_EQ(pHead->comp, codec);
+
+  char   *msg = (char *)pHead;
+  int32_t msgLen = transMsgLenFromCont(clen);
+  ASSERT_EQ(transDecompressMsg(&msg, &msgLen), 0);
+  ASSERT_EQ(msgLen, transMsgLenFromCont(len));
+  ASSERT_EQ(memcmp(transContFromHead(msg), pExpect, len), 0);
+
+  taosMemoryFree(msg);
+  rpcFreeCont(pExpect);
+}
+
+TEST(TransCompTest, lz4RoundTrip) { compRoundTrip(TRANS_COMP_LZ4); }
+
+#if !defined(WINDOWS) && !defined(_TD_DARWIN_64)
+TEST(TransCompTest, zstdRoundTrip) { compRoundTrip(TRANS_COMP_ZSTD); }
+#endif
+
+TEST(TransCompTest, incompressibleKeptRaw) {
+  int32_t len = 4096;
+  char   *pCont = (char *)rpcMallocCont(len);
+  for (int32_t i = 0; i < len; ++i) {
+    pCont[i] = (char)taosRand();
+  }
+
+  EXPECT_EQ(transCompressMsg(pCont, len, TRANS_COMP_ZSTD, 3), len);
+  EXPECT_EQ(transHeadFromCont(pCont)->comp, TRANS_COMP_NONE);
+  rpcFreeCont(pCont);
+}
+
+TEST(TransCompTest, chooseCodec) {
+  STrans inst = {0};
+  inst.compressSize = 1024;
+
+  STransCompCtx ctx = {0};
+  inst.compressAlg = RPC_COMP_LZ4;
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 512), TRANS_COMP_NONE);
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_LZ4);
+
+  // zstd only goes to peers announcing it
+  inst.compressAlg = RPC_COMP_ZSTD;
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_LZ4);
+
+  STransMsgHead head = {0};
+  head.compAccept = TRANS_COMP_ACCEPT;
+  transCompCtxOnRecv(&ctx, &head);
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_ACCEPT ? TRANS_COMP_ZSTD : TRANS_COMP_LZ4);
+
+  inst.compressSize = -1;
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_NONE);
+}
+
+TEST(TransCompTest, chooseCodecAuto) {
+  STrans inst = {0};
+  inst.compressSize = 0;
+  inst.compressAlg = RPC_COMP_AUTO;
+
+  STransCompCtx ctx = {0};
+  ctx.peerAccept = TRANS_COMP_ACCEPT;
+  ctx.numOfMsg = 1;  // skip the probe of the first msg
+
+  // no link bandwidth seen yet, codecs are probed first
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_LZ4);
+
+  // a fast link where compression saves less than it costs
+  ctx.linkBw = 1000;
+  for (int8_t c = TRANS_COMP_LZ4; c < TRANS_COMP_MAX; ++c) {
+    ctx.ratio[c] = 0.9;
+    ctx.cost[c] = 0.01;
+  }
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_NONE);
+
+  // a slow link where the better ratio pays off
+  ctx.linkBw = 1;
+  ctx.ratio[TRANS_COMP_LZ4] = 0.5;
+  ctx.cost[TRANS_COMP_LZ4] = 0.001;
+  ctx.ratio[TRANS_COMP_ZSTD] = 0.2;
+  ctx.cost[TRANS_COMP_ZSTD] = 0.002;
+  EXPECT_EQ(transCompChoose(&ctx, &inst, 4096), TRANS_COMP_ACCEPT ? TRANS_COMP_ZSTD : TRANS_COMP_LZ4);
+}
 #endif
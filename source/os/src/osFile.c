@@ -37,6 +37,7 @@
 #include <sys/sendfile.h>
 #endif
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #define LINUX_FILE_NO_TEXT_OPTION 0
 #define O_TEXT                    LINUX_FILE_NO_TEXT_OPTION
@@ -456,6 +457,17 @@ int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count) {
   return bytesWritten;
 }
 
+int64_t taosWritevFile(TdFilePtr pFile, const SFileIov *iov, int32_t iovcnt) {
+  int64_t total = 0;
+  for (int32_t i = 0; i < iovcnt; ++i) {
+    if (iov[i].len <= 0) continue;
+    int64_t written = taosWriteFile(pFile, iov[i].buf, iov[i].len);
+    if (written < 0) return -1;
+    total += written;
+  }
+  return total;
+}
+
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset) {
   if (pFile == NULL) {
     terrno = TSDB_CODE_INVALID_PARA;
@@ -841,6 +853,75 @@ int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count) {
   return count;
 }
 
+#define FILE_IOV_BATCH 64
+
+int64_t taosWritevFile(TdFilePtr pFile, const SFileIov *iov, int32_t iovcnt) {
+  STUB_RAND_IO_ERR(terrno)
+  if (pFile == NULL || iovcnt < 0 || (iovcnt > 0 && iov == NULL)) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return -1;
+  }
+#if FILE_WITH_LOCK
+  (void)taosThreadRwlockWrlock(&(pFile->rwlock));
+#endif
+  if (pFile->fd < 0) {
+#if FILE_WITH_LOCK
+    (void)taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+    terrno = TSDB_CODE_INVALID_PARA;
+    return -1;
+  }
+
+  struct iovec vec[FILE_IOV_BATCH];
+  int64_t      total = 0;
+  int32_t      i = 0;
+  int32_t      code = 0;
+
+  while (i < iovcnt) {
+    int32_t num = 0;
+    for (; i < iovcnt && num < FILE_IOV_BATCH; ++i) {
+      if (iov[i].len <= 0) continue;
+      vec[num].iov_base = (void *)iov[i].buf;
+      vec[num].iov_len = (size_t)iov[i].len;
+      num++;
+    }
+
+    struct iovec *pVec = vec;
+    while (num > 0) {
+      ssize_t nwritten = writev(pFile->fd, pVec, num);
+      if (nwritten < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        code = TAOS_SYSTEM_ERROR(errno);
+#if FILE_WITH_LOCK
+        (void)taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+        terrno = code;
+        return -1;
+      }
+      total += nwritten;
+
+      // skip the segments written completely and resume from the middle of a partial one
+      while (num > 0 && nwritten >= (ssize_t)pVec->iov_len) {
+        nwritten -= (ssize_t)pVec->iov_len;
+        pVec++;
+        num--;
+      }
+      if (num > 0) {
+        pVec->iov_base = (char *)pVec->iov_base + nwritten;
+        pVec->iov_len -= nwritten;
+      }
+    }
+  }
+
+#if FILE_WITH_LOCK
+  (void)taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+
+  return total;
+}
+
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset) {
   STUB_RAND_IO_ERR(terrno)
   if (pFile == NULL) {
@@ -170,6 +170,41 @@ TEST(osTest, osFile) {
   //printf("remove file success");
 }
 
+TEST(osTest, osWritevFile) {
+  char *fname = "./osfiletest2.txt";
+
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+
+  // more segments than one writev call takes, with empty ones in between
+  char     expect[1024] = {0};
+  char     data[200][4] = {0};
+  SFileIov iov[200] = {0};
+  int32_t  len = 0;
+  for (int32_t i = 0; i < 200; ++i) {
+    int32_t n = (i % 5 == 0) ? 0 : (i % 3) + 1;
+    for (int32_t j = 0; j < n; ++j) {
+      data[i][j] = 'a' + (i + j) % 26;
+      expect[len++] = data[i][j];
+    }
+    iov[i].buf = data[i];
+    iov[i].len = n;
+  }
+
+  ASSERT_EQ(taosWritevFile(pFile, iov, 200), len);
+  ASSERT_EQ(taosWritevFile(pFile, iov, 0), 0);
+  ASSERT_EQ(taosCloseFile(&pFile), 0);
+
+  pFile = taosOpenFile(fname, TD_FILE_READ);
+  ASSERT_NE(pFile, nullptr);
+  char buf[1024] = {0};
+  ASSERT_EQ(taosReadFile(pFile, buf, sizeof(buf)), len);
+  ASSERT_EQ(memcmp(buf, expect, len), 0);
+  ASSERT_EQ(taosCloseFile(&pFile), 0);
+
+  (void)taosRemoveFile(fname);
+}
+
 #ifndef OSFILE_PERFORMANCE_TEST
 
 #define MAX_WORDS          100
@@ -87,6 +87,11 @@ int32_t tsCompressDoubleImp2(const char *const input, const int32_t nelements, c
 int32_t tsDecompressDoubleImp2(const char *const input, int32_t ninput, const int32_t nelements, char *const output,
                                char const type);
 
+// alp
+int32_t tsCompressAlpImp2(const char *const input, const int32_t nelements, char *const output, char const type);
+int32_t tsDecompressAlpImp2(const char *const input, int32_t ninput, const int32_t nelements, char *const output,
+                            char const type);
+
 int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output);
 int32_t tsDecompressDoubleImp(const char *const input, int32_t ninput, const int32_t nelements, char *const output);
 int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output);
@@ -281,7 +286,8 @@ TCmprL1FnSet compressL1Dict[] = {{"PLAIN", NULL, tsCompressPlain2, tsDecompressP
                                  {"SIMPLE-8B", NULL, tsCompressINTImp2, tsDecompressINTImp2},
                                  {"DELTAI", NULL, tsCompressTimestampImp2, tsDecompressTimestampImp2},
                                  {"BIT-PACKING", NULL, tsCompressBoolImp2, tsDecompressBoolImp2},
-                                 {"DELTAD", NULL, tsCompressDoubleImp2, tsDecompressDoubleImp2}};
+                                 {"DELTAD", NULL, tsCompressDoubleImp2, tsDecompressDoubleImp2},
+                                 {"ALP", NULL, tsCompressAlpImp2, tsDecompressAlpImp2}};
 
 TCmprLvlSet compressL2LevelDict[] = {
     {"unknown", .lvl = {1, 2, 3}}, {"lz4", .lvl = {1, 2, 3}}, {"zlib", .lvl = {1, 6, 9}},
@@ -1271,6 +1277,274 @@ int32_t tsDecompressFloatImp(const char *const input, int32_t ninput, const int3
   return tsDecompressFloatImpHelper(input + 1, nelements, output);
 }
 
+/* --------------------------------------------ALP Compression ------------------------------------------------ */
+/*
+ * Adaptive lossless floating point encoding. Most float columns hold decimals with few significant digits, so a block
+ * picks an exponent e and a factor f from a sample, turns every value into the integer round(v * 10^e / 10^f) and
+ * keeps it only if it converts back to exactly the same bits. The integers are stored as bit packed offsets from the
+ * block minimum, the values that do not survive the round trip are stored verbatim as exceptions.
+ *
+ * | 0: flag | 1: e | 2: f | 3: bit width | 4~11: base | 12~15: exception num | packed offsets | positions | values |
+ *
+ * The flag is 0 for an encoded block and 1 for a block copied as it is.
+ */
+#define ALP_HEAD_LEN       16
+#define ALP_SAMPLE_NUM     32
+#define ALP_BATCH_NUM      1024
+#define ALP_DOUBLE_MAX_EXP 18
+#define ALP_FLOAT_MAX_EXP  10
+#define ALP_ENCODE_LIMIT   2251799813685248.0  // 2^51, the range where the magic number rounding below is exact
+#define ALP_ROUND_MAGIC    6755399441055744.0  // 2^52 + 2^51
+
+static const double alpExp10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+static const double alpFrac10[] = {1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+                                   1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+
+static FORCE_INLINE double alpGetValue(const char *input, int32_t i, char type) {
+  return type == TSDB_DATA_TYPE_FLOAT ? (double)((const float *)input)[i] : ((const double *)input)[i];
+}
+
+// Encode one value, return false if it can not be restored bit by bit and has to be kept as an exception.
+static FORCE_INLINE bool alpEncodeValue(const char *input, int32_t i, char type, uint8_t e, uint8_t f, int64_t *pVal) {
+  double tmp = alpGetValue(input, i, type) * alpExp10[e] * alpFrac10[f];
+  if (!(tmp >= -ALP_ENCODE_LIMIT && tmp <= ALP_ENCODE_LIMIT)) {
+    return false;
+  }
+
+  int64_t val = (int64_t)(tmp + ALP_ROUND_MAGIC - ALP_ROUND_MAGIC);
+  double  dec = (double)val * alpExp10[f] * alpFrac10[e];
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    float fdec = (float)dec;
+    if (memcmp(&fdec, (const float *)input + i, FLOAT_BYTES) != 0) return false;
+  } else {
+    if (memcmp(&dec, (const double *)input + i, DOUBLE_BYTES) != 0) return false;
+  }
+
+  *pVal = val;
+  return true;
+}
+
+static FORCE_INLINE int32_t alpBitWidth(uint64_t range) {
+  return range == 0 ? 0 : LONG_BYTES * BITS_PER_BYTE - BUILDIN_CLZL(range);
+}
+
+// Choose the exponent and factor that give the smallest estimated size for a sample of the block.
+static void alpChooseExpFactor(const char *input, int32_t nelements, char type, uint8_t *pExp, uint8_t *pFactor) {
+  int32_t bytes = type == TSDB_DATA_TYPE_FLOAT ? FLOAT_BYTES : DOUBLE_BYTES;
+  int32_t maxExp = type == TSDB_DATA_TYPE_FLOAT ? ALP_FLOAT_MAX_EXP : ALP_DOUBLE_MAX_EXP;
+  int32_t nsample = TMIN(nelements, ALP_SAMPLE_NUM);
+  int32_t step = nelements / nsample;
+  int64_t bestCost = INT64_MAX;
+
+  *pExp = 0;
+  *pFactor = 0;
+  for (int32_t e = 0; e <= maxExp; ++e) {
+    for (int32_t f = 0; f <= e; ++f) {
+      int64_t minVal = INT64_MAX, maxVal = INT64_MIN;
+      int32_t nexcept = 0;
+      for (int32_t i = 0; i < nsample; ++i) {
+        int64_t val = 0;
+        if (alpEncodeValue(input, i * step, type, e, f, &val)) {
+          minVal = TMIN(minVal, val);
+          maxVal = TMAX(maxVal, val);
+        } else {
+          nexcept++;
+        }
+      }
+
+      int64_t cost = (int64_t)nexcept * (sizeof(uint32_t) + bytes) * BITS_PER_BYTE;
+      if (nexcept < nsample) {
+        cost += (int64_t)(nsample - nexcept) * alpBitWidth((uint64_t)maxVal - (uint64_t)minVal);
+      }
+      if (cost < bestCost) {
+        bestCost = cost;
+        *pExp = e;
+        *pFactor = f;
+      }
+    }
+  }
+}
+
+static FORCE_INLINE void alpFlushWord(char *output, int32_t *opos, uint64_t word) {
+  memcpy(output + *opos, &word, LONG_BYTES);
+  *opos += LONG_BYTES;
+}
+
+int32_t tsCompressAlpImp2(const char *const input, const int32_t nelements, char *const output, char const type) {
+  int32_t bytes = type == TSDB_DATA_TYPE_FLOAT ? FLOAT_BYTES : DOUBLE_BYTES;
+  int32_t byte_limit = nelements * bytes + 1;
+  uint8_t e = 0, f = 0;
+
+  if (nelements <= 0 || (type != TSDB_DATA_TYPE_FLOAT && type != TSDB_DATA_TYPE_DOUBLE)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  alpChooseExpFactor(input, nelements, type, &e, &f);
+
+  // The first pass finds the frame of reference and the exceptions, exceptions take the first encoded value so that
+  // they do not widen the frame.
+  int64_t minVal = INT64_MAX, maxVal = INT64_MIN, fill = 0;
+  int32_t nexcept = 0;
+  for (int32_t i = 0; i < nelements; ++i) {
+    int64_t val = 0;
+    if (alpEncodeValue(input, i, type, e, f, &val)) {
+      if (minVal > maxVal) fill = val;
+      minVal = TMIN(minVal, val);
+      maxVal = TMAX(maxVal, val);
+    } else {
+      nexcept++;
+    }
+  }
+  if (minVal > maxVal) {
+    minVal = maxVal = 0;
+  }
+
+  int32_t width = alpBitWidth((uint64_t)maxVal - (uint64_t)minVal);
+  int64_t packed = ((int64_t)nelements * width + 63) / 64 * LONG_BYTES;
+  if (ALP_HEAD_LEN + packed + (int64_t)nexcept * (sizeof(uint32_t) + bytes) > byte_limit) {
+    output[0] = 1;
+    memcpy(output + 1, input, byte_limit - 1);
+    return byte_limit;
+  }
+
+  output[0] = 0;
+  output[1] = e;
+  output[2] = f;
+  output[3] = width;
+  memcpy(output + 4, &minVal, sizeof(int64_t));
+  memcpy(output + 12, &nexcept, sizeof(int32_t));
+
+  int32_t  opos = ALP_HEAD_LEN;
+  int32_t  epos = ALP_HEAD_LEN + packed;
+  int32_t  vpos = epos + nexcept * sizeof(uint32_t);
+  uint64_t word = 0;
+  int32_t  nbits = 0;
+  for (int32_t i = 0; i < nelements; ++i) {
+    int64_t val = 0;
+    if (!alpEncodeValue(input, i, type, e, f, &val)) {
+      uint32_t pos = i;
+      memcpy(output + epos, &pos, sizeof(uint32_t));
+      memcpy(output + vpos, input + i * bytes, bytes);
+      epos += sizeof(uint32_t);
+      vpos += bytes;
+      val = fill;
+    }
+    if (width == 0) continue;
+
+    uint64_t delta = (uint64_t)val - (uint64_t)minVal;
+    word |= delta << nbits;
+    if (nbits + width >= 64) {
+      alpFlushWord(output, &opos, word);
+      word = (nbits == 0 || nbits + width == 64) ? 0 : delta >> (64 - nbits);
+      nbits = nbits + width - 64;
+    } else {
+      nbits += width;
+    }
+  }
+  if (nbits > 0) {
+    alpFlushWord(output, &opos, word);
+  }
+
+  return vpos;
+}
+
+// Unpack nelements offsets starting from the start-th one, every 64 offsets take exactly width words.
+static void alpUnpack(const char *input, int32_t width, int32_t start, int32_t nelements, uint64_t *output) {
+  if (width == 0) {
+    memset(output, 0, nelements * sizeof(uint64_t));
+    return;
+  }
+
+  uint64_t mask = width == 64 ? UINT64_MAX : (((uint64_t)1 << width) - 1);
+  int64_t  bit = (int64_t)start * width;
+  for (int32_t i = 0; i < nelements; ++i, bit += width) {
+    int64_t  idx = bit >> 6;
+    int32_t  off = bit & 63;
+    uint64_t lo = 0;
+    memcpy(&lo, input + idx * LONG_BYTES, LONG_BYTES);
+    uint64_t val = lo >> off;
+    if (off + width > 64) {
+      uint64_t hi = 0;
+      memcpy(&hi, input + (idx + 1) * LONG_BYTES, LONG_BYTES);
+      val |= hi << (64 - off);
+    }
+    output[i] = val & mask;
+  }
+}
+
+static void alpDecodeBatch(const uint64_t *input, int32_t nelements, int64_t base, double factor, double fraction,
+                           char *output, char type) {
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    float *ostream = (float *)output;
+    for (int32_t i = 0; i < nelements; ++i) {
+      ostream[i] = (float)((double)(int64_t)(input[i] + (uint64_t)base) * factor * fraction);
+    }
+  } else {
+    double *ostream = (double *)output;
+    for (int32_t i = 0; i < nelements; ++i) {
+      ostream[i] = (double)(int64_t)(input[i] + (uint64_t)base) * factor * fraction;
+    }
+  }
+}
+
+int32_t tsDecompressAlpImp2(const char *const input, int32_t ninput, const int32_t nelements, char *const output,
+                            char const type) {
+  int32_t bytes = type == TSDB_DATA_TYPE_FLOAT ? FLOAT_BYTES : DOUBLE_BYTES;
+  if (ninput < 1) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+  if (input[0] == 1) {
+    if (ninput - 1 < (int64_t)nelements * bytes) {
+      return TSDB_CODE_INVALID_DATA_FMT;
+    }
+    memcpy(output, input + 1, nelements * bytes);
+    return nelements * bytes;
+  }
+  if (ninput < ALP_HEAD_LEN) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+
+  uint8_t e = input[1];
+  uint8_t f = input[2];
+  uint8_t width = input[3];
+  int64_t base = 0;
+  int32_t nexcept = 0;
+  memcpy(&base, input + 4, sizeof(int64_t));
+  memcpy(&nexcept, input + 12, sizeof(int32_t));
+  if (input[0] != 0 || e > ALP_DOUBLE_MAX_EXP || f > e || width > 64 || nexcept < 0 || nexcept > nelements) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+
+  int64_t packed = ((int64_t)nelements * width + 63) / 64 * LONG_BYTES;
+  if (ALP_HEAD_LEN + packed + (int64_t)nexcept * (sizeof(uint32_t) + bytes) > ninput) {
+    return TSDB_CODE_INVALID_DATA_FMT;
+  }
+
+  uint64_t buf[ALP_BATCH_NUM];
+  for (int32_t start = 0; start < nelements; start += ALP_BATCH_NUM) {
+    int32_t num = TMIN(ALP_BATCH_NUM, nelements - start);
+    alpUnpack(input + ALP_HEAD_LEN, width, start, num, buf);
+    if (!(tsSIMDEnable && tsAVX2Supported) ||
+        tsDecompressAlpImpAvx2(buf, num, base, alpExp10[f], alpFrac10[e], output + start * bytes, type) < 0) {
+      alpDecodeBatch(buf, num, base, alpExp10[f], alpFrac10[e], output + start * bytes, type);
+    }
+  }
+
+  const char *epos = input + ALP_HEAD_LEN + packed;
+  const char *vpos = epos + nexcept * sizeof(uint32_t);
+  for (int32_t i = 0; i < nexcept; ++i) {
+    uint32_t pos = 0;
+    memcpy(&pos, epos + i * sizeof(uint32_t), sizeof(uint32_t));
+    if (pos >= (uint32_t)nelements) {
+      return TSDB_CODE_INVALID_DATA_FMT;
+    }
+    memcpy(output + pos * bytes, vpos + i * bytes, bytes);
+  }
+
+  return nelements * bytes;
+}
+
 //
 //   ----------  float double lossy  -----------
 //
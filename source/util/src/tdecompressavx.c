@@ -445,6 +445,45 @@ int32_t tsDecompressDoubleImpAvx2(const char *input, const int32_t nelements, ch
 #endif
 }
 
+// Restore a batch of unpacked ALP offsets, the integers stay within 2^51 so the magic number conversion is exact and
+// the result matches the scalar decoder bit by bit.
+int32_t tsDecompressAlpImpAvx2(const uint64_t *input, int32_t nelements, int64_t base, double factor, double fraction,
+                               char *output, char type) {
+#ifdef __AVX2__
+  const __m256i baseVec = _mm256_set1_epi64x(base);
+  const __m256i magicInt = _mm256_set1_epi64x(0x4338000000000000LL);
+  const __m256d magicDbl = _mm256_set1_pd(6755399441055744.0);
+  const __m256d factorVec = _mm256_set1_pd(factor);
+  const __m256d fractionVec = _mm256_set1_pd(fraction);
+  int32_t       batchSize = M256_BYTES / LONG_BYTES;
+  int32_t       i = 0;
+
+  for (; i + batchSize <= nelements; i += batchSize) {
+    __m256i intVec = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)(input + i)), baseVec);
+    __m256d resVec = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(intVec, magicInt)), magicDbl);
+    resVec = _mm256_mul_pd(_mm256_mul_pd(resVec, factorVec), fractionVec);
+    if (type == TSDB_DATA_TYPE_FLOAT) {
+      _mm_storeu_ps((float *)output + i, _mm256_cvtpd_ps(resVec));
+    } else {
+      _mm256_storeu_pd((double *)output + i, resVec);
+    }
+  }
+
+  for (; i < nelements; ++i) {
+    double val = (double)(int64_t)(input[i] + (uint64_t)base) * factor * fraction;
+    if (type == TSDB_DATA_TYPE_FLOAT) {
+      ((float *)output)[i] = (float)val;
+    } else {
+      ((double *)output)[i] = val;
+    }
+  }
+  return nelements;
+#else
+  uError("unable run %s without avx2 instructions", __func__);
+  return -1;
+#endif
+}
+
 int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output,
                                   bool bigEndian) {
 #ifdef __AVX512VL__
@@ -45,12 +45,29 @@
 #define LOG_BUF_SIZE(x)   ((x)->buffSize)
 #define LOG_BUF_MUTEX(x)  ((x)->buffMutex)
 
+// every logging thread appends to a private ring, only the log thread consumes it, so no lock is taken per line. at
+// most tsAsyncLogRingNum rings are created, the threads beyond them share the locked buffer. a line too long for the
+// ring or pushed while the ring is full goes to the shared buffer, and the following lines of the thread go there too
+// until it is written out, so the lines of a thread are never reordered.
+#define LOG_RING_SIZE     (128 * 1024)
+#define LOG_RING_MAX_NUM  256
+#define LOG_RING_MAX_LINE (LOG_RING_SIZE / 4)
+#define LOG_RING_RETRY    1024
+#define LOG_IOV_MAX_NUM   (LOG_RING_MAX_NUM * 2 + 2)
+
 #ifdef TD_ENTERPRISE
 #define LOG_EDITION_FLG ("E")
 #else
 #define LOG_EDITION_FLG ("C")
 #endif
 
+typedef struct {
+  char   *buffer;
+  int32_t head;   // moved by the log thread only
+  int32_t tail;   // moved by the owner thread only
+  int32_t inUse;  // cleared when the owner thread exits, so the ring can be taken over
+} SLogRing;
+
 typedef struct {
   char         *buffer;
   int32_t       buffStart;
@@ -64,6 +81,14 @@ typedef struct {
   int32_t       writeInterval;
   int32_t       lastDuration;
   int32_t       lock;
+  bool          ringEnabled;
+  int32_t       ringGen;
+  int32_t       maxRings;
+  int32_t       numOfRings;
+  int64_t       buffPushed;   // bytes ever appended to the shared buffer
+  int64_t       buffWritten;  // bytes ever written out of the shared buffer
+  TdThreadKey   ringKey;
+  SLogRing     *rings[LOG_RING_MAX_NUM];
 } SLogBuff;
 
 typedef struct {
@@ -83,12 +108,19 @@ typedef struct {
 
 extern SConfig *tsCfg;
 static int8_t   tsLogInited = 0;
+static int32_t  tsLogRingGen = 0;
+
+static threadlocal SLogRing *tsLogRing = NULL;
+static threadlocal int32_t   tsLogRingGenOfThread = 0;
+static threadlocal int32_t   tsLogRingRetry = 0;
+static threadlocal int64_t   tsLogBuffSeq = 0;  // end of the last line of this thread in the shared buffer
 static SLogObj  tsLogObj = {.fileNum = 1, .slowHandle = NULL};
 static int64_t  tsAsyncLogLostLines = 0;
 static int32_t  tsDaylightActive; /* Currently in daylight saving time. */
 
 bool tsLogEmbedded = 0;
 bool tsAsyncLog = true;
+int32_t tsAsyncLogRingNum = 16;
 #ifdef ASSERT_NOT_CORE
 bool tsAssert = false;
 #else
@@ -138,7 +170,8 @@ int64_t dbgWSize = 0;
 
 static void     *taosAsyncOutputLog(void *param);
 static int32_t   taosPushLogBuffer(SLogBuff *pLogBuf, const char *msg, int32_t msgLen);
-static SLogBuff *taosLogBuffNew(int32_t bufSize);
+static SLogBuff *taosLogBuffNew(int32_t bufSize, bool ringEnabled);
+static void      taosLogBuffDestroy(SLogBuff *pLogBuf);
 static void      taosCloseLogByFd(TdFilePtr pFile);
 static int32_t   taosInitNormalLog(const char *fn, int32_t maxFileNum);
 static void      taosWriteLog(SLogBuff *pLogBuf);
@@ -207,7 +240,7 @@ int32_t taosInitSlowLog() {
   (void)snprintf(name, PATH_MAX + TD_TIME_STR_LEN, "%s.%s", tsLogObj.slowLogName, day);
 
   tsLogObj.timestampToday = getTimestampToday();
-  tsLogObj.slowHandle = taosLogBuffNew(LOG_SLOW_BUF_SIZE);
+  tsLogObj.slowHandle = taosLogBuffNew(LOG_SLOW_BUF_SIZE, false);
   if (tsLogObj.slowHandle == NULL) return terrno;
 
   TAOS_UNUSED(taosUmaskFile(0));
@@ -253,20 +286,17 @@ void taosCloseLog() {
   }
 
   if (tsLogObj.slowHandle != NULL) {
-    (void)taosThreadMutexDestroy(&tsLogObj.slowHandle->buffMutex);
     (void)taosCloseFile(&tsLogObj.slowHandle->pFile);
-    taosMemoryFreeClear(tsLogObj.slowHandle->buffer);
-    taosMemoryFreeClear(tsLogObj.slowHandle);
+    taosLogBuffDestroy(tsLogObj.slowHandle);
+    tsLogObj.slowHandle = NULL;
   }
 
   if (tsLogObj.logHandle != NULL) {
     tsLogInited = 0;
 
-    (void)taosThreadMutexDestroy(&tsLogObj.logHandle->buffMutex);
     (void)taosCloseFile(&tsLogObj.logHandle->pFile);
-    taosMemoryFreeClear(tsLogObj.logHandle->buffer);
     (void)taosThreadMutexDestroy(&tsLogObj.logMutex);
-    taosMemoryFreeClear(tsLogObj.logHandle);
+    taosLogBuffDestroy(tsLogObj.logHandle);
     tsLogObj.logHandle = NULL;
   }
 }
@@ -561,7 +591,7 @@ static int32_t taosInitNormalLog(const char *logName, int32_t maxFileNum) {
   (void)taosThreadMutexInit(&tsLogObj.logMutex, NULL);
 
   TAOS_UNUSED(taosUmaskFile(0));
-  tsLogObj.logHandle = taosLogBuffNew(LOG_DEFAULT_BUF_SIZE);
+  tsLogObj.logHandle = taosLogBuffNew(LOG_DEFAULT_BUF_SIZE, true);
   if (tsLogObj.logHandle == NULL) return terrno;
 
   tsLogObj.logHandle->pFile = taosOpenFile(name, TD_FILE_CREATE | TD_FILE_WRITE);
@@ -629,15 +659,26 @@ static void taosUpdateLogNums(ELogLevel level) {
 }
 
 static inline int32_t taosBuildLogHead(char *buffer, const char *flags) {
-  struct tm      Tm, *ptm;
-  struct timeval timeSecs;
+  // localtime takes the global timezone lock, so do it once per second per thread instead of once per line
+  static threadlocal int64_t lastSec = -1;
+  static threadlocal char    timeStr[32];
 
+  struct timeval timeSecs;
   TAOS_UNUSED(taosGetTimeOfDay(&timeSecs));
-  time_t curTime = timeSecs.tv_sec;
-  ptm = taosLocalTime(&curTime, &Tm, NULL, 0);
+  if (timeSecs.tv_sec != lastSec) {
+    struct tm Tm, *ptm;
+    time_t    curTime = timeSecs.tv_sec;
+    ptm = taosLocalTime(&curTime, &Tm, NULL, 0);
+    if (ptm == NULL) {
+      return sprintf(buffer, "00/00 00:00:00.%06d %08" PRId64 " %s %s", (int32_t)timeSecs.tv_usec,
+                     taosGetSelfPthreadId(), LOG_EDITION_FLG, flags);
+    }
+    (void)snprintf(timeStr, sizeof(timeStr), "%02d/%02d %02d:%02d:%02d", ptm->tm_mon + 1, ptm->tm_mday, ptm->tm_hour,
+                   ptm->tm_min, ptm->tm_sec);
+    lastSec = timeSecs.tv_sec;
+  }
 
-  return sprintf(buffer, "%02d/%02d %02d:%02d:%02d.%06d %08" PRId64 " %s %s", ptm->tm_mon + 1, ptm->tm_mday,
-                 ptm->tm_hour, ptm->tm_min, ptm->tm_sec, (int32_t)timeSecs.tv_usec, taosGetSelfPthreadId(),
+  return sprintf(buffer, "%s.%06d %08" PRId64 " %s %s", timeStr, (int32_t)timeSecs.tv_usec, taosGetSelfPthreadId(),
                  LOG_EDITION_FLG, flags);
 }
 
@@ -819,7 +860,14 @@ static void taosCloseLogByFd(TdFilePtr pFile) {
   }
 }
 
-static SLogBuff *taosLogBuffNew(int32_t bufSize) {
+static void taosLogRingRelease(void *param) {
+  SLogRing *pRing = param;
+  if (pRing != NULL) {
+    atomic_store_32(&pRing->inUse, 0);
+  }
+}
+
+static SLogBuff *taosLogBuffNew(int32_t bufSize, bool ringEnabled) {
   SLogBuff *pLogBuf = NULL;
 
   pLogBuf = taosMemoryCalloc(1, sizeof(SLogBuff));
@@ -837,6 +885,13 @@ static SLogBuff *taosLogBuffNew(int32_t bufSize) {
   if (taosThreadMutexInit(&LOG_BUF_MUTEX(pLogBuf), NULL) < 0) goto _err;
   // tsem_init(&(pLogBuf->buffNotEmpty), 0, 0);
 
+  // the rings are optional, without them all threads share the locked buffer
+  pLogBuf->maxRings = TMIN(tsAsyncLogRingNum, LOG_RING_MAX_NUM);
+  if (ringEnabled && pLogBuf->maxRings > 0 && taosThreadKeyCreate(&pLogBuf->ringKey, taosLogRingRelease) == 0) {
+    pLogBuf->ringEnabled = true;
+    pLogBuf->ringGen = atomic_add_fetch_32(&tsLogRingGen, 1);
+  }
+
   return pLogBuf;
 
 _err:
@@ -845,6 +900,104 @@ _err:
   return NULL;
 }
 
+static void taosLogBuffDestroy(SLogBuff *pLogBuf) {
+  if (pLogBuf->ringEnabled) {
+    // no destructor runs on a deleted key, so exiting threads never touch the freed rings
+    (void)taosThreadKeyDelete(pLogBuf->ringKey);
+    for (int32_t i = 0; i < pLogBuf->numOfRings; ++i) {
+      taosMemoryFreeClear(pLogBuf->rings[i]->buffer);
+      taosMemoryFreeClear(pLogBuf->rings[i]);
+    }
+  }
+
+  (void)taosThreadMutexDestroy(&LOG_BUF_MUTEX(pLogBuf));
+  taosMemoryFreeClear(LOG_BUF_BUFFER(pLogBuf));
+  taosMemoryFree(pLogBuf);
+}
+
+static SLogRing *taosLogRingAcquire(SLogBuff *pLogBuf) {
+  int32_t numOfRings = atomic_load_32(&pLogBuf->numOfRings);
+
+  // take over the ring of an exited thread first, the rest of its data is still drained in order
+  for (int32_t i = 0; i < numOfRings; ++i) {
+    SLogRing *pRing = pLogBuf->rings[i];
+    if (atomic_val_compare_exchange_32(&pRing->inUse, 0, 1) == 0) {
+      return pRing;
+    }
+  }
+
+  SLogRing *pRing = NULL;
+  (void)taosThreadMutexLock(&LOG_BUF_MUTEX(pLogBuf));
+  if (pLogBuf->numOfRings < pLogBuf->maxRings) {
+    pRing = taosMemoryCalloc(1, sizeof(SLogRing));
+    if (pRing != NULL) {
+      pRing->buffer = taosMemoryMalloc(LOG_RING_SIZE);
+      if (pRing->buffer == NULL) {
+        taosMemoryFreeClear(pRing);
+      } else {
+        pRing->inUse = 1;
+        pLogBuf->rings[pLogBuf->numOfRings] = pRing;
+        atomic_store_32(&pLogBuf->numOfRings, pLogBuf->numOfRings + 1);
+      }
+    }
+  }
+  (void)taosThreadMutexUnlock(&LOG_BUF_MUTEX(pLogBuf));
+
+  return pRing;
+}
+
+static SLogRing *taosGetLogRing(SLogBuff *pLogBuf) {
+  if (tsLogRingGenOfThread == pLogBuf->ringGen) {
+    if (tsLogRing != NULL) return tsLogRing;
+    // all rings are taken, use the shared buffer for a while before trying again
+    if (--tsLogRingRetry > 0) return NULL;
+  }
+
+  if (tsLogRingGenOfThread != pLogBuf->ringGen) {
+    tsLogBuffSeq = 0;
+  }
+  tsLogRingGenOfThread = pLogBuf->ringGen;
+  tsLogRing = taosLogRingAcquire(pLogBuf);
+  if (tsLogRing == NULL) {
+    tsLogRingRetry = LOG_RING_RETRY;
+    return NULL;
+  }
+
+  if (taosThreadSetSpecific(pLogBuf->ringKey, tsLogRing) != 0) {
+    atomic_store_32(&tsLogRing->inUse, 0);
+    tsLogRing = NULL;
+    tsLogRingRetry = LOG_RING_RETRY;
+  }
+  return tsLogRing;
+}
+
+static bool taosPushLogRing(SLogBuff *pLogBuf, const char *msg, int32_t msgLen) {
+  if (!pLogBuf->ringEnabled) return false;
+
+  SLogRing *pRing = taosGetLogRing(pLogBuf);
+  if (pRing == NULL) return false;
+
+  // the former lines of this thread in the shared buffer are not written out yet
+  if (tsLogBuffSeq > atomic_load_64(&pLogBuf->buffWritten)) return false;
+  if (msgLen > LOG_RING_MAX_LINE) return false;
+
+  int32_t head = atomic_load_32(&pRing->head);
+  int32_t tail = atomic_load_32(&pRing->tail);
+  int32_t remainSize = (head > tail) ? (head - tail - 1) : (head + LOG_RING_SIZE - tail - 1);
+  if (remainSize < msgLen) return false;
+
+  if (LOG_RING_SIZE - tail < msgLen) {
+    memcpy(pRing->buffer + tail, msg, LOG_RING_SIZE - tail);
+    memcpy(pRing->buffer, msg + LOG_RING_SIZE - tail, msgLen - LOG_RING_SIZE + tail);
+  } else {
+    memcpy(pRing->buffer + tail, msg, msgLen);
+  }
+
+  // publish the line to the log thread only after it is completely copied
+  atomic_store_32(&pRing->tail, (tail + msgLen) % LOG_RING_SIZE);
+  return true;
+}
+
 static void taosCopyLogBuffer(SLogBuff *pLogBuf, int32_t start, int32_t end, const char *msg, int32_t msgLen) {
   if (start > end) {
     memcpy(LOG_BUF_BUFFER(pLogBuf) + end, msg, msgLen);
@@ -856,7 +1009,8 @@ static void taosCopyLogBuffer(SLogBuff *pLogBuf, int32_t start, int32_t end, con
       memcpy(LOG_BUF_BUFFER(pLogBuf) + end, msg, msgLen);
     }
   }
-  LOG_BUF_END(pLogBuf) = (LOG_BUF_END(pLogBuf) + msgLen) % LOG_BUF_SIZE(pLogBuf);
+  pLogBuf->buffPushed += msgLen;
+  atomic_store_32(&LOG_BUF_END(pLogBuf), (LOG_BUF_END(pLogBuf) + msgLen) % LOG_BUF_SIZE(pLogBuf));
 }
 
 static int32_t taosPushLogBuffer(SLogBuff *pLogBuf, const char *msg, int32_t msgLen) {
@@ -869,6 +1023,8 @@ static int32_t taosPushLogBuffer(SLogBuff *pLogBuf, const char *msg, int32_t msg
 
   if (pLogBuf == NULL || pLogBuf->stop) return -1;
 
+  if (taosPushLogRing(pLogBuf, msg, msgLen)) return 0;
+
   (void)taosThreadMutexLock(&LOG_BUF_MUTEX(pLogBuf));
   start = LOG_BUF_START(pLogBuf);
   end = LOG_BUF_END(pLogBuf);
@@ -893,6 +1049,9 @@ static int32_t taosPushLogBuffer(SLogBuff *pLogBuf, const char *msg, int32_t msg
   }
 
   taosCopyLogBuffer(pLogBuf, LOG_BUF_START(pLogBuf), LOG_BUF_END(pLogBuf), msg, msgLen);
+  if (pLogBuf->ringEnabled) {
+    tsLogBuffSeq = pLogBuf->buffPushed;
+  }
 
   // int32_t w = atomic_sub_fetch_32(&waitLock, 1);
   /*
@@ -921,18 +1080,55 @@ static void taosWriteSlowLog(SLogBuff *pLogBuf) {
   taosWriteLog(pLogBuf);
   atomic_store_32(&pLogBuf->lock, 0);
 }
+static int32_t taosAddLogIov(SFileIov *iov, int32_t num, char *buffer, int32_t size, int32_t start, int32_t end) {
+  if (start < end) {
+    iov[num++] = (SFileIov){.buf = buffer + start, .len = end - start};
+  } else if (start > end) {
+    iov[num++] = (SFileIov){.buf = buffer + start, .len = size - start};
+    if (end > 0) {
+      iov[num++] = (SFileIov){.buf = buffer, .len = end};
+    }
+  }
+  return num;
+}
+
 static void taosWriteLog(SLogBuff *pLogBuf) {
+  SFileIov iov[LOG_IOV_MAX_NUM];
+  int32_t  ringEnd[LOG_RING_MAX_NUM];
+  int32_t  numOfIov = 0;
+  int32_t  numOfRings = atomic_load_32(&pLogBuf->numOfRings);
+  int32_t  pollSize = 0;
+  bool     ringBusy = false;
+
+  // the rings go first. the end of the shared buffer is taken before them, so the ring lines a thread pushed before
+  // its line in the shared buffer are always written out together with that line.
   int32_t start = LOG_BUF_START(pLogBuf);
-  int32_t end = LOG_BUF_END(pLogBuf);
+  int32_t end = atomic_load_32(&LOG_BUF_END(pLogBuf));
+
+  for (int32_t i = 0; i < numOfRings; ++i) {
+    SLogRing *pRing = pLogBuf->rings[i];
+    int32_t   head = pRing->head;
+    ringEnd[i] = atomic_load_32(&pRing->tail);
+    if (head != ringEnd[i]) {
+      int32_t ringPollSize = (ringEnd[i] - head + LOG_RING_SIZE) % LOG_RING_SIZE;
+      numOfIov = taosAddLogIov(iov, numOfIov, pRing->buffer, LOG_RING_SIZE, head, ringEnd[i]);
+      pollSize += ringPollSize;
+      ringBusy = ringBusy || (ringPollSize > LOG_RING_SIZE / 2);
+    }
+  }
 
-  if (start == end) {
+  int32_t buffPollSize = taosGetLogRemainSize(pLogBuf, start, end);
+  numOfIov = taosAddLogIov(iov, numOfIov, LOG_BUF_BUFFER(pLogBuf), LOG_BUF_SIZE(pLogBuf), start, end);
+  pollSize += buffPollSize;
+
+  if (pollSize == 0) {
     dbgEmptyW++;
     pLogBuf->writeInterval = LOG_MAX_INTERVAL;
     return;
   }
 
-  int32_t pollSize = taosGetLogRemainSize(pLogBuf, start, end);
-  if (pollSize < pLogBuf->minBuffSize) {
+  // a ring is much smaller than the shared buffer, do not wait for it to overflow
+  if (pollSize < pLogBuf->minBuffSize && !ringBusy) {
     pLogBuf->lastDuration += pLogBuf->writeInterval;
     if (pLogBuf->lastDuration < LOG_MAX_WAIT_MSEC) {
       return;
@@ -941,19 +1137,18 @@ static void taosWriteLog(SLogBuff *pLogBuf) {
 
   pLogBuf->lastDuration = 0;
 
-  if (start < end) {
-    TAOS_UNUSED(taosWriteFile(pLogBuf->pFile, LOG_BUF_BUFFER(pLogBuf) + start, pollSize));
-  } else {
-    int32_t tsize = LOG_BUF_SIZE(pLogBuf) - start;
-    TAOS_UNUSED(taosWriteFile(pLogBuf->pFile, LOG_BUF_BUFFER(pLogBuf) + start, tsize));
+  TAOS_UNUSED(taosWritevFile(pLogBuf->pFile, iov, numOfIov));
 
-    TAOS_UNUSED(taosWriteFile(pLogBuf->pFile, LOG_BUF_BUFFER(pLogBuf), end));
+  for (int32_t i = 0; i < numOfRings; ++i) {
+    atomic_store_32(&pLogBuf->rings[i]->head, ringEnd[i]);
   }
 
   dbgWN++;
   dbgWSize += pollSize;
 
-  if (pollSize < pLogBuf->minBuffSize) {
+  if (ringBusy) {
+    pLogBuf->writeInterval = LOG_MIN_INTERVAL;
+  } else if (pollSize < pLogBuf->minBuffSize) {
     dbgSmallWN++;
     if (pLogBuf->writeInterval < LOG_MAX_INTERVAL) {
       pLogBuf->writeInterval += LOG_INTERVAL_STEP;
@@ -967,7 +1162,8 @@ static void taosWriteLog(SLogBuff *pLogBuf) {
     }
   }
 
-  LOG_BUF_START(pLogBuf) = (LOG_BUF_START(pLogBuf) + pollSize) % LOG_BUF_SIZE(pLogBuf);
+  LOG_BUF_START(pLogBuf) = (LOG_BUF_START(pLogBuf) + buffPollSize) % LOG_BUF_SIZE(pLogBuf);
+  (void)atomic_add_fetch_64(&pLogBuf->buffWritten, buffPollSize);
 
   start = LOG_BUF_START(pLogBuf);
   end = LOG_BUF_END(pLogBuf);
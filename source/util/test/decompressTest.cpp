@@ -655,3 +655,51 @@ TEST(utilTest, decompressTimestampPerf) {
   refreshSeed();
   decompressPerfTest<int64_t>("timestamp", tsCompressTimestamp, tsDecompressTimestamp, 0, 1000000000L);
 }
+
+template <typename T, typename CompF, typename DecompF>
+static void decompressAlpTest(int32_t dataSize, uint16_t l2, const CompF& compress, const DecompF& decompress) {
+  // decimals with two digits, a constant run and a few values that can only be kept as exceptions
+  auto origData = utilTestRandomData<int32_t>(dataSize, -1000000, 1000000);
+  std::vector<T> data(dataSize);
+  for (int32_t i = 0; i < dataSize; ++i) {
+    if (i % 97 == 13) {
+      data[i] = (i & 0x1) ? NAN : -0.0;
+    } else if (i % 7 == 0) {
+      data[i] = (T)3.25;
+    } else {
+      data[i] = (T)(origData[i] / 100.0);
+    }
+  }
+
+  uint32_t cmprAlg = 0;
+  setColEncode(&cmprAlg, L1_ALP);
+  setColCompress(&cmprAlg, l2);
+  setColLevel(&cmprAlg, L2_LVL_MEDIUM);
+
+  int32_t           bytes = dataSize * sizeof(T);
+  std::vector<char> compData(bytes + 64);
+  std::vector<char> buf(bytes + 64);
+  int32_t cnt = compress(data.data(), bytes, dataSize, compData.data(), compData.size(), cmprAlg, buf.data(), buf.size());
+  ASSERT_GT(cnt, 0);
+
+  char oldSIMDEnable = tsSIMDEnable;
+  for (int32_t simd = 0; simd <= 1; ++simd) {
+    tsSIMDEnable = simd;
+    std::vector<T> decompData(dataSize);
+    int32_t size = decompress(compData.data(), cnt, dataSize, decompData.data(), bytes, cmprAlg, buf.data(), buf.size());
+    EXPECT_EQ(size, bytes);
+    EXPECT_EQ(memcmp(data.data(), decompData.data(), bytes), 0);
+  }
+  tsSIMDEnable = oldSIMDEnable;
+}
+
+TEST(utilTest, decompressAlpBasic) {
+  refreshSeed();
+  uint16_t l2s[] = {L2_DISABLED, L2_LZ4, L2_ZSTD};
+  for (uint16_t l2 : l2s) {
+    for (int32_t r = 1; r <= 4096; r += (r < 128 ? 1 : 127)) {
+      decompressAlpTest<float>(r, l2, tsCompressFloat2, tsDecompressFloat2);
+      decompressAlpTest<double>(r, l2, tsCompressDouble2, tsDecompressDouble2);
+    }
+  }
+}
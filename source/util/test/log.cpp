@@ -4,6 +4,7 @@
 #include <random>
 #include <tlog.h> 
 #include <iostream> 
+#include <vector>
 
 using namespace std;
 
@@ -44,3 +45,110 @@ TEST(log, check_log_refactor) {
   }
   taosCloseLog();
 }
+
+#define LOG_TEST_THREADS   16
+#define LOG_TEST_ROUNDS    2
+#define LOG_TEST_LINES     5000
+#define LOG_TEST_LONG_LINE (64 * 1024)
+
+typedef struct {
+  int id;
+  int lines;
+  int padLen;     // bytes appended to every line
+  int longEvery;  // every that many lines one is longer than a ring line, 0 for none
+} SLogTestParam;
+
+static void *logWriteThreadFp(void *param) {
+  SLogTestParam *p = (SLogTestParam *)param;
+  std::string    pad(p->padLen, 'p');
+  std::string    longPad(LOG_TEST_LONG_LINE, 'l');
+  for (int i = 0; i < p->lines; ++i) {
+    if (p->longEvery > 0 && i % p->longEvery == 0) {
+      uDebugL("thread %d write line %d to the async log %s", p->id, i, longPad.c_str());
+    } else {
+      uDebug("thread %d write line %d to the async log %s", p->id, i, pad.c_str());
+    }
+  }
+  return NULL;
+}
+
+static void asyncLogMultiThread(int32_t ringNum, int lines = LOG_TEST_LINES, int padLen = 0, int longEvery = 0) {
+  const char *logDir = "/tmp/asyncLogTest";
+  taosRemoveDir(logDir);
+  ASSERT_EQ(taosMulMkDir(logDir), 0);
+  strcpy(tsLogDir, (char *)logDir);
+  tsAsyncLog = 1;
+  tsAsyncLogRingNum = ringNum;
+  ASSERT_EQ(taosInitLog("asynclog", 1, false), 0);
+  uDebugFlag = 143;
+
+  // more threads than rings, the second round takes over the rings of the exited threads of the first one
+  for (int round = 0; round < LOG_TEST_ROUNDS; ++round) {
+    TdThread      threads[LOG_TEST_THREADS];
+    SLogTestParam params[LOG_TEST_THREADS];
+    for (int i = 0; i < LOG_TEST_THREADS; ++i) {
+      params[i].id = round * LOG_TEST_THREADS + i;
+      params[i].lines = lines;
+      params[i].padLen = padLen;
+      params[i].longEvery = longEvery;
+      ASSERT_EQ(taosThreadCreate(&threads[i], NULL, logWriteThreadFp, &params[i]), 0);
+    }
+    for (int i = 0; i < LOG_TEST_THREADS; ++i) {
+      (void)taosThreadJoin(threads[i], NULL);
+    }
+  }
+  taosCloseLog();
+
+  // every line is whole, the lines of one thread keep their order and none is lost without being reported
+  char fileName[PATH_MAX] = {0};
+  (void)snprintf(fileName, sizeof(fileName), "%s/asynclog.0", logDir);
+  TdFilePtr pFile = taosOpenFile(fileName, TD_FILE_READ | TD_FILE_STREAM);
+  ASSERT_NE(pFile, nullptr);
+
+  const int         numOfThreads = LOG_TEST_THREADS * LOG_TEST_ROUNDS;
+  int               next[numOfThreads] = {0};
+  int64_t           found = 0;
+  int64_t           lost = 0;
+  std::vector<char> buf(LOG_TEST_LONG_LINE + 1024);
+  char             *line = buf.data();
+  while (taosGetsFile(pFile, buf.size(), line) > 0) {
+    int64_t     lostLines = 0;
+    const char *p = strstr(line, "...Lost ");
+    if (p != NULL && sscanf(p, "...Lost %" PRId64 " lines here...", &lostLines) == 1) {
+      lost += lostLines;
+      continue;
+    }
+    p = strstr(line, "thread ");
+    if (p == NULL || strstr(line, "to the async log") == NULL) continue;
+
+    int id = -1, seq = -1;
+    ASSERT_EQ(sscanf(p, "thread %d write line %d to the async log", &id, &seq), 2) << line;
+    ASSERT_TRUE(id >= 0 && id < numOfThreads) << line;
+    ASSERT_GE(seq, next[id]) << line;
+    ASSERT_LT(seq, lines) << line;
+    next[id] = seq + 1;
+    found++;
+  }
+  (void)taosCloseFile(&pFile);
+
+  EXPECT_EQ(found + lost, (int64_t)numOfThreads * lines);
+  if (lost == 0) {
+    for (int i = 0; i < numOfThreads; ++i) {
+      EXPECT_EQ(next[i], lines) << "thread " << i;
+    }
+  }
+
+  tsAsyncLog = 0;
+  tsAsyncLogRingNum = 16;
+  taosRemoveDir(logDir);
+}
+
+TEST(log, async_log_multi_thread) { asyncLogMultiThread(8); }
+
+TEST(log, async_log_without_ring) { asyncLogMultiThread(0); }
+
+// lines too long for a ring go through the shared buffer between the ring lines of the same thread
+TEST(log, async_log_long_line) { asyncLogMultiThread(8, 500, 0, 7); }
+
+// bursts of lines close to the line limit fill the rings faster than the log thread drains them
+TEST(log, async_log_full_ring) { asyncLogMultiThread(8, 300, 9000, 0); }
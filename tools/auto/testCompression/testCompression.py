@@ -132,14 +132,16 @@ def getMatch(datatype, algo):
         return True
 
 
-def generateJsonFile(algo):
+def generateJsonFile(algo, encode):
     # replace datatype
     context = readFileContext(templateFile)
     # replace compress
     context = context.replace("@COMPRESS", algo)
+    # replace float/double encode
+    context = context.replace("@ENCODE", encode)
 
     # write to file
-    fileName = f"json/test_{algo}.json"
+    fileName = f"json/test_{encode}_{algo}.json"
     if os.path.exists(fileName):
       os.remove(fileName)
     writeFileContext(fileName, context)
@@ -245,7 +247,7 @@ def totalCompressRate(algo, resultFile, writeSpeed, querySpeed):
 
     # appand to file    
     Number += 1
-    context =  "%10s %10s %10s %10s %30s %15s\n"%( Number, algo, str(totalSize)+" MB", rate+"%", writeSpeed + " Records/second", querySpeed)
+    context =  "%10s %16s %10s %10s %30s %15s\n"%( Number, algo, str(totalSize)+" MB", rate+"%", writeSpeed + " Records/second", querySpeed)
     showLog(context)
     appendFileContext(resultFile, context)
 
@@ -304,11 +306,11 @@ def testQuery():
     else:
         return speed
 
-def doTest(algo, resultFile):
-    print(f"doTest algo: {algo} \n")
+def doTest(algo, encode, resultFile):
+    print(f"doTest algo: {algo} encode: {encode} \n")
 
     # json
-    jsonFile = generateJsonFile(algo)
+    jsonFile = generateJsonFile(algo, encode)
 
     # run taosBenchmark
     t1 = time.time()
@@ -318,7 +320,7 @@ def doTest(algo, resultFile):
     querySpeed = testQuery()
 
     # total compress rate
-    totalCompressRate(algo, resultFile, writeSpeed, querySpeed)
+    totalCompressRate(f"{encode}+{algo}", resultFile, writeSpeed, querySpeed)
 
 
 def main():
@@ -326,6 +328,8 @@ def main():
     # test compress method
     algos = ["lz4", "zlib", "zstd", "xz", "disabled"]
     #algos = ["lz4"]
+    # float/double encode method
+    encodes = ["delta-d", "alp"]
 
     # record result
     resultFile = "./result.txt"
@@ -337,14 +341,15 @@ def main():
     # json info
     writeTemplateInfo(resultFile)
     # head
-    context = "\n%10s %10s %10s %10s %30s %15s\n"%("No", "compress", "dataSize", "rate", "writeSpeed", "query-QPS")
+    context = "\n%10s %16s %10s %10s %30s %15s\n"%("No", "compress", "dataSize", "rate", "writeSpeed", "query-QPS")
     appendFileContext(resultFile, context)
 
 
     # loop for all compression
-    for algo in algos:
-        # do test
-        doTest(algo, resultFile)
+    for encode in encodes:
+        for algo in algos:
+            # do test
+            doTest(algo, encode, resultFile)
     appendFileContext(resultFile, "    \n")
 
     timestamp = time.time()